@@ -22,17 +22,17 @@ else
             then
                 gcc -std=c11 -g -Wall -pedantic -o simple_engine -L/home/derek/.src/simple_engine/lib/cimgui \
                     Wl,--enable-new-dtags,-rpath,/home/derek/.src/simple_engine/lib/cimgui ../src/engine/main.c \
-                    lm -lGL -lSDL3 -lGLEW -lcimgui -ldl 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' >& build.log
+                    lm -lGL -lSDL3 -lGLEW -lcimgui -ldl -lpthread 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' >& build.log
             else
                 if [ "$2" == "--warning" ]
                 then
                     gcc -std=c11 -g -pedantic -o simple_engine -L/home/derek/.src/simple_engine/lib/cimgui \
                         Wl,--enable-new-dtags,-rpath,/home/derek/.src/simple_engine/lib/cimgui ../src/engine/main.c \
-                        lm -lGL -lSDL3 -lGLEW -lcimgui -ldl 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' >& build.log
+                        lm -lGL -lSDL3 -lGLEW -lcimgui -ldl -lpthread 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' >& build.log
                 else
                     gcc -std=c11 -g -o simple_engine -L/home/derek/.src/simple_engine/lib/cimgui \
                         Wl,--enable-new-dtags,-rpath,/home/derek/.src/simple_engine/lib/cimgui ../src/engine/main.c \
-                        lm -lGL -lSDL3 -lGLEW -lcimgui -ldl 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' >& ./build.log
+                        lm -lGL -lSDL3 -lGLEW -lcimgui -ldl -lpthread 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' >& ./build.log
                 fi
             fi
 
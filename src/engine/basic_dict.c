@@ -1,41 +1,112 @@
 #include "basic_dict.h"
 #include "types.h"
 #include "utils.h"
-#include "basic_list.h"
 #include "memory.h"
 
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
 
-struct basic_dict_node
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define BASIC_DICT_USE_SSE2
+#endif
+
+// a flat open addressing table. Slots are grouped 16 at a time; every group has a control byte per slot
+// (empty, deleted, or the top 7 bits of the key's hash), and the control bytes of all groups sit together in
+// front of the slots. A lookup compares a whole group of tags at once, and only visits the slots whose tag
+// matched, so a hit is usually the control line plus the slot's line.
+#define BASIC_DICT_GROUP_SIZE 16
+#define BASIC_DICT_CONTROL_EMPTY ((u8)0x80)
+#define BASIC_DICT_CONTROL_DELETED ((u8)0xFE)
+#define BASIC_DICT_NULL_SLOT_INDEX UINT32_MAX
+// a resize moves the entries over a few groups at a time, so no single push or remove pays for all of them
+#define BASIC_DICT_MIGRATE_GROUP_COUNT 4
+// and empties the new table a few groups at a time before that; at least one group per push keeps the emptying
+// ahead of the pushes that fill the current table meanwhile
+#define BASIC_DICT_CLEAR_GROUP_COUNT 4
+
+struct basic_dict_slot
 {
-    const struct memory_raw_allocation_key rawKeyKey;
-    p64 dataByteOffset;
+    // the full hash, so a tag collision rarely costs a key compare
+    utils_hash hash;
+    b32 isKeyInline;
+    b32 isValueInline;
+
+    union
+    {
+        u8 keyArr[BASIC_DICT_INLINE_KEY_BYTE_SIZE];
+        const struct memory_raw_allocation_key rawKeyKey;
+    };
+
+    // the byte size of the referenced data, or of the inline value
     u64 dataByteSize;
-    const struct memory_allocation_key dataKey;
-    b32 isActive;
+
+    union
+    {
+        struct
+        {
+            p64 dataByteOffset;
+            const struct memory_allocation_key dataKey;
+        };
+
+        u8 valueArr[BASIC_DICT_INLINE_VALUE_BYTE_SIZE];
+    };
 };
 
 struct basic_dict
 {
     const struct memory_page_key pageKey;
-    const struct memory_allocation_key bucketTableKey;
-    const struct memory_allocation_key freeNodeList;
+    // groupCount*BASIC_DICT_GROUP_SIZE control bytes, then as many slots
+    const struct memory_allocation_key tableKey;
+    // while a resize is under way, the table the entries are moving out of; a null key otherwise
+    const struct memory_allocation_key prevTableKey;
+    // while a resize is starting, the table the entries will move into, whose groups are still being emptied; a
+    // null key otherwise
+    const struct memory_allocation_key nextTableKey;
     const struct memory_allocation_key userPtrKey;
-    u32 tableBucketCount;
+    u32 groupCount;
+    u32 prevGroupCount;
+    // the groups of the previous table in front of this one are moved already
+    u32 prevGroupIndex;
+    u32 nextGroupCount;
+    // the groups of the next table in front of this one are empty already
+    u32 nextGroupIndex;
+    // the table never shrinks below the size it was created with
+    u32 minGroupCount;
+    // entries in both tables
+    u32 count;
+    // deleted slots of the current table
+    u32 deletedCount;
     basic_dict_hash_func hashFunc;
     basic_dict_create_key_copy_func keyCopyFunc;
+    // 0 for the default, NUL terminated string keys
     u64 keyByteSize;
 };
 
+static u64
+_basic_dict_get_key_byte_size(const struct basic_dict *dictPtr, void *keyPtr)
+{
+    return dictPtr->keyByteSize ? dictPtr->keyByteSize : (u64)strlen(keyPtr) + 1;
+}
+
 static b32 
 _default_hash_func(struct basic_dict *dictPtr, void *key, 
     utils_hash *outHashPtr)
 {
     utils_hash resultHash;
 
-    if (!(utils_generate_hash_from_string(key, &resultHash)))
+    // fixed size keys hash their bytes. The default string keys take their string id hash, so they can be looked
+    // up by a string id hashed at compile time
+    if (!dictPtr->keyByteSize)
+    {
+        resultHash = utils_get_string_id_hash(key);
+    }
+    else if (!(utils_generate_hash_from_bytes(key, dictPtr->keyByteSize, &resultHash)))
     {
         return B32_FALSE;
     }
@@ -59,9 +130,9 @@ _default_key_copy_func(struct basic_dict *dictPtr, void *keyPtr,
         return B32_FALSE;
     }
 
-    size_t keySize = strlen(keyPtr) + 1;
+    u64 keySize = _basic_dict_get_key_byte_size(dictPtr, keyPtr);
 
-    const struct memory_raw_allocation_key rawKeyKey;
+    const struct memory_raw_allocation_key rawKeyKey = {0};
     void *rawKeyPtr;
     {
         memory_error_code resultCode = memory_raw_alloc(&rawKeyKey, 
@@ -82,813 +153,1280 @@ _default_key_copy_func(struct basic_dict *dictPtr, void *keyPtr,
 
     memcpy(rawKeyPtr, keyPtr, keySize);
 
-    memory_unmap_raw_allocation(&rawKeyKey, (void **)&rawKeyPtr);
+    memory_unmap_raw_allocation((void **)&rawKeyPtr);
 
     memcpy((void *)outRawKeyKeyPtr, &rawKeyKey, sizeof(struct memory_raw_allocation_key));
 
     return B32_TRUE;
 }
 
-static b32
-_basic_dict_get_bucket_by_index(const struct memory_allocation_key *dictKeyPtr,
-    u64 bucketIndex, const struct memory_allocation_key *outBucketKeyPtr)
+static u32
+_basic_dict_find_first_set_bit_u32(u32 value)
 {
-    if ((MEMORY_IS_ALLOCATION_NULL(dictKeyPtr)))
-    {
-        return B32_FALSE;
-    }
+    assert(value);
 
-    struct basic_dict *dictPtr;
-    {
-        memory_error_code resultCode = memory_map_alloc(dictKeyPtr, 
-        (void **)&dictPtr);
+#if defined(_MSC_VER)
+    unsigned long bitIndex;
+    _BitScanForward(&bitIndex, value);
 
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
-    }
+    return (u32)bitIndex;
+#else
+    return (u32)__builtin_ctz(value);
+#endif
+}
 
-    if (bucketIndex >= dictPtr->tableBucketCount)
-    {
-        memory_unmap_alloc((void **)&dictPtr);
-        memory_get_null_allocation_key(outBucketKeyPtr);
+// user hash functions aren't all well mixed in every bit (an id can be its own hash), and the table takes the
+// group index and the tag from different ends of the hash
+static utils_hash
+_basic_dict_mix_hash(utils_hash hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
 
-        return B32_FALSE;
-    }
+    return hash;
+}
 
-    const struct memory_allocation_key *tablePtr;
-    const struct memory_allocation_key *bucketKeyPtr;
-    {
+// bit i is set, if control byte i of the group equals 'control'
+static u32
+_basic_dict_match_group(const u8 *controlArr, u8 control)
+{
+#if defined(BASIC_DICT_USE_SSE2)
+    __m128i controlVec = _mm_loadu_si128((const __m128i *)controlArr);
 
-        memory_error_code resultCode = memory_map_alloc(&dictPtr->bucketTableKey, 
-        (void **)&tablePtr);
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(controlVec, _mm_set1_epi8((char)control)));
+#else
+    u32 matchMask = 0;
 
-        if (resultCode != MEMORY_OK)
-        {
-            memory_unmap_alloc((void **)&dictPtr);
+    for (u32 slotIndex = 0; slotIndex < BASIC_DICT_GROUP_SIZE; ++slotIndex)
+    {
+        matchMask |= (u32)(controlArr[slotIndex] == control) << slotIndex;
+    }
 
-            memory_get_null_allocation_key(outBucketKeyPtr);
+    return matchMask;
+#endif
+}
 
-            return B32_FALSE;
-        }
+// empty and deleted control bytes are the ones with the top bit set
+static u32
+_basic_dict_match_group_available(const u8 *controlArr)
+{
+#if defined(BASIC_DICT_USE_SSE2)
+    return (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)controlArr));
+#else
+    u32 matchMask = 0;
 
-        bucketKeyPtr = &tablePtr[bucketIndex];
+    for (u32 slotIndex = 0; slotIndex < BASIC_DICT_GROUP_SIZE; ++slotIndex)
+    {
+        matchMask |= (u32)(controlArr[slotIndex] >> 7) << slotIndex;
     }
 
-    memcpy((void *)outBucketKeyPtr, bucketKeyPtr, sizeof(struct memory_allocation_key));
+    return matchMask;
+#endif
+}
 
-    memory_unmap_alloc((void **)&tablePtr);
-    memory_unmap_alloc((void **)&dictPtr);
+static struct basic_dict_slot *
+_basic_dict_get_slot_arr(u8 *tablePtr, u32 groupCount)
+{
+    return (struct basic_dict_slot *)(tablePtr + (u64)groupCount*BASIC_DICT_GROUP_SIZE);
+}
 
-    return B32_TRUE;
+static u64
+_basic_dict_get_table_byte_size(u32 groupCount)
+{
+    return (u64)groupCount*BASIC_DICT_GROUP_SIZE*(1 + sizeof(struct basic_dict_slot));
 }
 
+// allocates and maps a table of 'groupCount' groups on the dict's page; none of its groups are emptied yet (see 
+// _basic_dict_clear_groups). The caller unmaps it
 static b32
-_basic_dict_get_node_by_key(const struct memory_allocation_key *dictKeyPtr,
-    void *keyPtr, const struct memory_allocation_key *outNodeKeyPtr,
-    const struct memory_allocation_key *outBucketKeyPtr)
+_basic_dict_alloc_table(struct basic_dict *dictPtr, u32 groupCount, 
+    const struct memory_allocation_key *outTableKeyPtr, u8 **outTablePtr)
 {
-    if ((MEMORY_IS_ALLOCATION_NULL(dictKeyPtr)))
+    if (memory_alloc(&dictPtr->pageKey, _basic_dict_get_table_byte_size(groupCount), NULL, 
+        outTableKeyPtr) != MEMORY_OK)
     {
-        if (outNodeKeyPtr)
-        {
-            memory_get_null_allocation_key(outNodeKeyPtr);
-        }
+        utils_fprintfln(stderr, "%s(Line: %d): Cannot allocate a table of %u groups.", __FUNCTION__, __LINE__, 
+            groupCount);
 
         return B32_FALSE;
     }
 
-    if (!keyPtr)
+    if (memory_map_alloc(outTableKeyPtr, (void **)outTablePtr) != MEMORY_OK)
     {
-        if (outNodeKeyPtr)
-        {
-            memory_get_null_allocation_key(outNodeKeyPtr);
-        }
-
-        if (outBucketKeyPtr)
-        {
-            memory_get_null_allocation_key(outBucketKeyPtr);
-        }
+        memory_free(outTableKeyPtr);
 
         return B32_FALSE;
     }
 
-    struct basic_dict *dictPtr;
-    {
-        memory_error_code resultCode = memory_map_alloc(dictKeyPtr, 
-        (void **)&dictPtr);
-
-        if (resultCode != MEMORY_OK)
-        {
-            memory_get_null_allocation_key(outNodeKeyPtr);
+    return B32_TRUE;
+}
 
-            return B32_FALSE;
-        }
-    }
+// empties the groups from 'groupIndex' up to 'endGroupIndex' of a table of 'groupCount' groups. Their slots are 
+// zeroed as well, so a new table's memory is first touched here, in order, rather than wherever the entries moving 
+// into it land
+static void
+_basic_dict_clear_groups(u8 *tablePtr, u32 groupCount, u32 groupIndex, u32 endGroupIndex)
+{
+    memset(&tablePtr[(u64)groupIndex*BASIC_DICT_GROUP_SIZE], BASIC_DICT_CONTROL_EMPTY, 
+        (u64)(endGroupIndex - groupIndex)*BASIC_DICT_GROUP_SIZE);
+    memset(&_basic_dict_get_slot_arr(tablePtr, groupCount)[(u64)groupIndex*BASIC_DICT_GROUP_SIZE], '\0', 
+        (u64)(endGroupIndex - groupIndex)*BASIC_DICT_GROUP_SIZE*sizeof(struct basic_dict_slot));
+}
 
-    utils_hash dictHash;
+static b32
+_basic_dict_get_is_key_equal(const struct basic_dict *dictPtr, const struct basic_dict_slot *slotPtr, 
+    void *keyPtr)
+{
+    void *slotKeyPtr = (void *)slotPtr->keyArr;
 
-    if (!(dictPtr->hashFunc(dictPtr, keyPtr, &dictHash)))
+    if (!slotPtr->isKeyInline && (memory_map_raw_allocation(&slotPtr->rawKeyKey, &slotKeyPtr) != MEMORY_OK))
     {
-        memory_unmap_alloc((void **)&dictPtr);
-        memory_get_null_allocation_key(outNodeKeyPtr);
-
         return B32_FALSE;
     }
 
-    const struct memory_allocation_key *bucketTablePtr;
-    {
-        memory_error_code resultCode = memory_map_alloc(&dictPtr->bucketTableKey, 
-        (void **)&bucketTablePtr);
-
-        if (resultCode != MEMORY_OK)
-        {
-            memory_unmap_alloc((void **)&dictPtr);
-            memory_get_null_allocation_key(outNodeKeyPtr);
-
-            return B32_FALSE;
-        }
-    }
-    
-    const struct memory_allocation_key *listKeyPtr = &bucketTablePtr[
-        dictPtr->tableBucketCount%(u64)dictHash];
+    b32 isEqual = (dictPtr->keyByteSize ? !memcmp(slotKeyPtr, keyPtr, dictPtr->keyByteSize) : 
+        !strcmp(slotKeyPtr, keyPtr)) ? B32_TRUE : B32_FALSE;
 
-    const struct memory_allocation_key headNodeKey;
-
-    if (!(basic_list_get_next_node(listKeyPtr, NULL, &headNodeKey)))
+    if (!slotPtr->isKeyInline)
     {
-        memory_unmap_alloc((void **)&bucketTablePtr);
-        memory_unmap_alloc((void **)&dictPtr);
-        memory_get_null_allocation_key(outNodeKeyPtr);
-
-        return B32_FALSE;
+        memory_unmap_raw_allocation(&slotKeyPtr);
     }
 
-    const struct memory_allocation_key currentNodeKey;
+    return isEqual;
+}
 
-    memcpy((void *)&currentNodeKey, &headNodeKey, sizeof(struct memory_allocation_key));
+// slot index into a table of 'groupCount' groups, or BASIC_DICT_NULL_SLOT_INDEX
+static u32
+_basic_dict_find_slot(const struct basic_dict *dictPtr, u8 *tablePtr, u32 groupCount, void *keyPtr, 
+    utils_hash hash)
+{
+    struct basic_dict_slot *slotArr = _basic_dict_get_slot_arr(tablePtr, groupCount);
+    u8 tag = (u8)(hash >> 57);
+    u32 groupIndex = (u32)hash & (groupCount - 1);
 
-    do 
+    for (u32 probeCount = 0; probeCount < groupCount; ++probeCount)
     {
-        struct basic_dict_node *currentNodePtr;
+        const u8 *controlArr = &tablePtr[groupIndex*BASIC_DICT_GROUP_SIZE];
 
-        if (!(basic_list_map_data(&currentNodeKey, (void **)&currentNodePtr)))
+        for (u32 matchMask = _basic_dict_match_group(controlArr, tag); matchMask; matchMask &= matchMask - 1)
         {
-            memory_unmap_alloc((void **)&bucketTablePtr);
-            memory_unmap_alloc((void **)&dictPtr);
-            memory_get_null_allocation_key(outNodeKeyPtr);
+            u32 slotIndex = groupIndex*BASIC_DICT_GROUP_SIZE + _basic_dict_find_first_set_bit_u32(matchMask);
 
-            return B32_FALSE;
+            if ((slotArr[slotIndex].hash == hash) && _basic_dict_get_is_key_equal(dictPtr, &slotArr[slotIndex], 
+                keyPtr))
+            {
+                return slotIndex;
+            }
         }
 
-        void *lhsKeyPtr;
-
-        memory_error_code resultCode = memory_map_raw_allocation(&currentNodePtr->rawKeyKey, &lhsKeyPtr);
-
-        if (resultCode != MEMORY_OK)
+        // a group with an empty slot never overflowed, so the key can't be further along
+        if (_basic_dict_match_group(controlArr, BASIC_DICT_CONTROL_EMPTY))
         {
-            basic_list_unmap_data(listKeyPtr, &currentNodeKey, (void **)&currentNodePtr);
-
-            const struct memory_allocation_key nextNodeKey;
-
-            if (!(basic_list_get_next_node(listKeyPtr, &currentNodeKey, &nextNodeKey)))
-            {
-                basic_list_unmap_data(listKeyPtr, &currentNodeKey, (void **)&currentNodePtr);
-                memory_unmap_alloc((void **)&bucketTablePtr);
-                memory_unmap_alloc((void **)&dictPtr);
-                memory_get_null_allocation_key(outNodeKeyPtr);
+            break;
+        }
 
-                return B32_FALSE;
-            }
+        groupIndex = (groupIndex + 1) & (groupCount - 1);
+    }
 
-            if (!(MEMORY_IS_ALLOCATION_KEY_EQUAL(&headNodeKey, &nextNodeKey)))
-            {
-                memcpy((void *)&currentNodeKey, &nextNodeKey, sizeof(struct memory_allocation_key));
+    return BASIC_DICT_NULL_SLOT_INDEX;
+}
 
-                continue;
-            }
-            else 
-            {
-                memory_get_null_allocation_key(&currentNodeKey);
+// takes the first empty or deleted slot on the hash's probe sequence; the key must not be in the table already
+static u32
+_basic_dict_place_slot(u8 *tablePtr, u32 groupCount, utils_hash hash, u32 *deletedCountPtr)
+{
+    u32 groupIndex = (u32)hash & (groupCount - 1);
 
-                break;
-            }
-        }
+    for (;;)
+    {
+        u8 *controlArr = &tablePtr[groupIndex*BASIC_DICT_GROUP_SIZE];
+        u32 availableMask = _basic_dict_match_group_available(controlArr);
 
-        if (!(memcmp(lhsKeyPtr, keyPtr, dictPtr->keyByteSize)))
+        if (availableMask)
         {
-            memory_unmap_raw_allocation(&currentNodePtr->rawKeyKey, &lhsKeyPtr);
-            basic_list_unmap_data(listKeyPtr, &currentNodeKey, (void **)&currentNodePtr);
-            memory_unmap_alloc((void **)&bucketTablePtr);
-            memory_unmap_alloc((void **)&dictPtr);
-
-            if (outNodeKeyPtr)
-            {
-                memcpy((void *)outNodeKeyPtr, &currentNodeKey, sizeof(struct memory_allocation_key));
-            }
+            u32 controlIndex = _basic_dict_find_first_set_bit_u32(availableMask);
 
-            if (outBucketKeyPtr)
+            if (controlArr[controlIndex] == BASIC_DICT_CONTROL_DELETED)
             {
-                memcpy((void *)outBucketKeyPtr, listKeyPtr, sizeof(struct memory_allocation_key));
+                --(*deletedCountPtr);
             }
 
-            return B32_TRUE;
-        }
-        
-        memory_unmap_raw_allocation(&currentNodePtr->rawKeyKey, &lhsKeyPtr);
-
-        const struct memory_allocation_key nextNodeKey;
-
-        if (!(basic_list_get_next_node(listKeyPtr, &currentNodeKey, &nextNodeKey)))
-        {
-            basic_list_unmap_data(listKeyPtr, &currentNodeKey, (void **)&currentNodePtr);
-            memory_unmap_alloc((void **)&bucketTablePtr);
-            memory_unmap_alloc((void **)&dictPtr);
-            memory_get_null_allocation_key(outNodeKeyPtr);
-
-            return B32_FALSE;
-        }
-        
-        basic_list_unmap_data(listKeyPtr, &currentNodeKey, (void **)&currentNodePtr);
+            controlArr[controlIndex] = (u8)(hash >> 57);
 
-        if (!(MEMORY_IS_ALLOCATION_KEY_EQUAL(&headNodeKey, &nextNodeKey)))
-        {
-            memcpy((void *)&currentNodeKey, &nextNodeKey, sizeof(struct memory_allocation_key));
-        }
-        else 
-        {
-            memory_get_null_allocation_key(&currentNodeKey);
+            return groupIndex*BASIC_DICT_GROUP_SIZE + controlIndex;
         }
-    } while (!(MEMORY_IS_ALLOCATION_NULL(&currentNodeKey)));
-
-    memory_unmap_alloc((void **)&bucketTablePtr);
-    memory_unmap_alloc((void **)&dictPtr);
 
-    return B32_FALSE;
+        groupIndex = (groupIndex + 1) & (groupCount - 1);
+    }
 }
 
-static b32
-_basic_dict_clear_bucket(const struct memory_allocation_key *dictKeyPtr,
-    u64 bucketIndex)
+// moves the entries of up to 'groupCount' more groups of the previous table into the current one, and frees the
+// previous table once it's been gone through. The slots move as they are; out of line keys and data stay put
+static void
+_basic_dict_migrate(struct basic_dict *dictPtr, u32 groupCount, u8 *tablePtr, u8 **prevTablePtrPtr)
 {
-    const struct memory_allocation_key bucketKey;
+    u8 *prevTablePtr = *prevTablePtrPtr;
 
-    if (!(_basic_dict_get_bucket_by_index(dictKeyPtr, bucketIndex, &bucketKey)))
+    if (!prevTablePtr)
     {
-        return B32_FALSE;
+        return;
     }
 
-    const struct memory_allocation_key headNodeKey;
-
-    if (!(basic_list_get_next_node(&bucketKey, NULL, &headNodeKey)))
-    {
-        return B32_FALSE;
-    }
+    struct basic_dict_slot *slotArr = _basic_dict_get_slot_arr(tablePtr, dictPtr->groupCount);
+    const struct basic_dict_slot *prevSlotArr = _basic_dict_get_slot_arr(prevTablePtr, dictPtr->prevGroupCount);
+    u32 endGroupIndex = (groupCount < (dictPtr->prevGroupCount - dictPtr->prevGroupIndex)) ? 
+        dictPtr->prevGroupIndex + groupCount : dictPtr->prevGroupCount;
 
-    struct basic_dict *dictPtr;
+    for (u32 slotIndex = dictPtr->prevGroupIndex*BASIC_DICT_GROUP_SIZE; 
+        slotIndex < endGroupIndex*BASIC_DICT_GROUP_SIZE; ++slotIndex)
     {
-        memory_error_code resultCode = memory_map_alloc(dictKeyPtr, (void **)&dictPtr);
-
-        if (resultCode != MEMORY_OK)
+        if (!(prevTablePtr[slotIndex] & BASIC_DICT_CONTROL_EMPTY))
         {
-            return B32_FALSE;
+            memcpy(&slotArr[_basic_dict_place_slot(tablePtr, dictPtr->groupCount, prevSlotArr[slotIndex].hash, 
+                &dictPtr->deletedCount)], &prevSlotArr[slotIndex], sizeof(struct basic_dict_slot));
+
+            // deleted rather than empty, so lookups of keys that haven't moved yet still probe past it
+            prevTablePtr[slotIndex] = BASIC_DICT_CONTROL_DELETED;
         }
     }
 
-    const struct memory_allocation_key currentNodeKey;
-
-    memcpy((void *)&currentNodeKey, &headNodeKey, sizeof(struct memory_allocation_key));
+    dictPtr->prevGroupIndex = endGroupIndex;
 
-    do 
+    if (endGroupIndex < dictPtr->prevGroupCount)
     {
-        const struct memory_allocation_key nextNodeKey;
+        return;
+    }
 
-        if (!(basic_list_get_next_node(&bucketKey, &currentNodeKey, &nextNodeKey)))
-        {
-            memory_unmap_alloc((void **)&dictPtr);
+    memory_unmap_alloc((void **)prevTablePtrPtr);
+    memory_free(&dictPtr->prevTableKey);
+    memory_get_null_allocation_key(&dictPtr->prevTableKey);
 
-            return B32_FALSE;
-        }
+    dictPtr->prevGroupCount = 0;
+    dictPtr->prevGroupIndex = 0;
+}
 
-        if (!(basic_list_move_node(&bucketKey, &dictPtr->freeNodeList, 
-        &currentNodeKey)))
-        {
-            memory_unmap_alloc((void **)&dictPtr);
+// starts a resize into a new table of 'groupCount' groups (a power of two), which also leaves every deleted slot 
+// behind. Pushes and removes empty BASIC_DICT_CLEAR_GROUP_COUNT groups of the new table each from then on, and 
+// move the entries of BASIC_DICT_MIGRATE_GROUP_COUNT groups each once it's empty (see _basic_dict_step_resize); 
+// entries that are still moving from an earlier resize are moved first
+static b32
+_basic_dict_begin_resize(struct basic_dict *dictPtr, u32 groupCount, u8 *tablePtr, u8 **prevTablePtrPtr)
+{
+    _basic_dict_migrate(dictPtr, UINT32_MAX, tablePtr, prevTablePtrPtr);
 
-            return B32_FALSE;
-        }
+    u8 *nextTablePtr;
 
-        if (!(MEMORY_IS_ALLOCATION_KEY_EQUAL(&nextNodeKey, &headNodeKey)))
-        {
-            memcpy((void *)&currentNodeKey, &nextNodeKey, sizeof(struct memory_allocation_key));
-        }
-        else 
-        {
-            memory_get_null_allocation_key(&currentNodeKey);
-        }
-    } while (!(MEMORY_IS_ALLOCATION_NULL(&currentNodeKey)));
+    if (!(_basic_dict_alloc_table(dictPtr, groupCount, &dictPtr->nextTableKey, &nextTablePtr)))
+    {
+        memory_get_null_allocation_key(&dictPtr->nextTableKey);
 
-    memory_unmap_alloc((void **)&dictPtr);
+        return B32_FALSE;
+    }
+
+    memory_unmap_alloc((void **)&nextTablePtr);
+
+    dictPtr->nextGroupCount = groupCount;
+    dictPtr->nextGroupIndex = 0;
 
     return B32_TRUE;
 }
 
-b32
-basic_dict_create(const struct memory_page_key *memoryPageKeyPtr, basic_dict_hash_func hashFunc,
-    basic_dict_create_key_copy_func keyCopyFunc, u32 initBucketCount, u64 *keySize, 
-    const struct memory_allocation_key *userPtrKeyPtr, const struct memory_allocation_key *outDictKeyPtr)
+// empties up to 'groupCount' more groups of the next table while a resize is starting, and makes it the current 
+// table once all of them are; the entries of BASIC_DICT_MIGRATE_GROUP_COUNT more groups move over otherwise
+static void
+_basic_dict_step_resize(struct basic_dict *dictPtr, u32 groupCount, u8 **tablePtrPtr, u8 **prevTablePtrPtr)
 {
-    if ((MEMORY_IS_PAGE_NULL(memoryPageKeyPtr)))
+    if (!dictPtr->nextGroupCount)
     {
-        if (outDictKeyPtr)
-        {
-            memory_get_null_allocation_key(outDictKeyPtr);
-        }
+        _basic_dict_migrate(dictPtr, BASIC_DICT_MIGRATE_GROUP_COUNT, *tablePtrPtr, prevTablePtrPtr);
 
-        return B32_FALSE;
+        return;
     }
 
-    if (!outDictKeyPtr)
+    u8 *nextTablePtr;
+
+    if (memory_map_alloc(&dictPtr->nextTableKey, (void **)&nextTablePtr) != MEMORY_OK)
     {
-        return B32_FALSE;
+        return;
     }
 
-    const struct memory_allocation_key dictKey;
-    {
-        memory_error_code resultCode;
+    u32 endGroupIndex = (groupCount < (dictPtr->nextGroupCount - dictPtr->nextGroupIndex)) ? 
+        dictPtr->nextGroupIndex + groupCount : dictPtr->nextGroupCount;
 
-        if ((resultCode = memory_alloc(memoryPageKeyPtr, 
-            sizeof(struct basic_dict) + sizeof(struct memory_raw_allocation_key), NULL, 
-            &dictKey) != MEMORY_OK))
-        {
-            utils_fprintfln(stderr, "basic_dict_create(Line: %d): Cannot allocate basic_dict.\n",
-                    __LINE__);
+    _basic_dict_clear_groups(nextTablePtr, dictPtr->nextGroupCount, dictPtr->nextGroupIndex, endGroupIndex);
 
-            return B32_FALSE;
-        }
-    }
+    dictPtr->nextGroupIndex = endGroupIndex;
 
-    struct basic_dict *dictPtr;
+    if (endGroupIndex < dictPtr->nextGroupCount)
     {
-        memory_error_code resultCode;
-            
-        if ((resultCode = memory_map_alloc(&dictKey, 
-            (void **)&dictPtr)) != MEMORY_OK)
-        {
-            memory_free(&dictKey);
-
-            utils_fprintfln(stderr, "basic_dict_create(Line: %d): Cannot map basic_dict allocation.",
-                    __LINE__);
+        memory_unmap_alloc((void **)&nextTablePtr);
 
-            return B32_FALSE;
-        }
+        return;
     }
-    
-    dictPtr->tableBucketCount = initBucketCount;
 
-    memory_error_code resultCode = memory_alloc(memoryPageKeyPtr, 
-        sizeof(struct memory_allocation_key)*initBucketCount, NULL, 
-        &dictPtr->bucketTableKey);
+    // no earlier resize is under way still, so the previous table is free to take the current one's place
+    memcpy((void *)&dictPtr->prevTableKey, &dictPtr->tableKey, sizeof(struct memory_allocation_key));
+    memcpy((void *)&dictPtr->tableKey, &dictPtr->nextTableKey, sizeof(struct memory_allocation_key));
+    memory_get_null_allocation_key(&dictPtr->nextTableKey);
+
+    dictPtr->prevGroupCount = dictPtr->groupCount;
+    dictPtr->prevGroupIndex = 0;
+    dictPtr->groupCount = dictPtr->nextGroupCount;
+    dictPtr->nextGroupCount = 0;
+    dictPtr->nextGroupIndex = 0;
+    dictPtr->deletedCount = 0;
 
-    if (resultCode != MEMORY_OK)
+    *prevTablePtrPtr = *tablePtrPtr;
+    *tablePtrPtr = nextTablePtr;
+}
+
+// frees the next table of a resize that hasn't started moving the entries yet
+static void
+_basic_dict_drop_next_table(struct basic_dict *dictPtr)
+{
+    if (!dictPtr->nextGroupCount)
     {
-        return B32_FALSE;
+        return;
     }
 
-    memory_set_alloc_offset_width(&dictPtr->bucketTableKey, 0, 
-        sizeof(struct memory_allocation_key)*initBucketCount, '\0');
+    memory_free(&dictPtr->nextTableKey);
+    memory_get_null_allocation_key(&dictPtr->nextTableKey);
 
-    dictPtr->hashFunc = hashFunc ? hashFunc : &_default_hash_func;
-
-    memcpy((struct memory_allocation_key*)&dictPtr->userPtrKey, userPtrKeyPtr, sizeof(struct memory_allocation_key));
+    dictPtr->nextGroupCount = 0;
+    dictPtr->nextGroupIndex = 0;
+}
 
-    basic_list_create(memoryPageKeyPtr, &dictPtr->freeNodeList);
+// keeps at most 7/8 of the slots taken (deleted ones included) after one more insert, so probe sequences
+// stay short. Growing to twice the size leaves the new table less than half full, and an insert moves more
+// slots than it adds, so the new table is never the one that runs out. The current table keeps taking the 
+// inserts while the new one is emptied, up to 15/16 of its slots
+static b32
+_basic_dict_reserve_one(struct basic_dict *dictPtr, u8 **tablePtrPtr, u8 **prevTablePtrPtr)
+{
+    u32 slotCount = dictPtr->groupCount*BASIC_DICT_GROUP_SIZE;
+    u64 takenSlotCount = (u64)dictPtr->count + dictPtr->deletedCount + 1;
 
-    if (keyCopyFunc)
+    if ((takenSlotCount*8) <= ((u64)slotCount*7))
     {
-        dictPtr->keyCopyFunc = keyCopyFunc;
-        dictPtr->keyByteSize = *keySize;
+        return B32_TRUE;
     }
-    else 
+
+    // mostly deleted slots: rebuild at the same size instead of growing
+    if (!dictPtr->nextGroupCount && !(_basic_dict_begin_resize(dictPtr, (((u64)(dictPtr->count + 1)*2) > 
+        slotCount) ? dictPtr->groupCount*2 : dictPtr->groupCount, *tablePtrPtr, prevTablePtrPtr)))
     {
-        dictPtr->keyCopyFunc = &_default_key_copy_func;
-        dictPtr->keyByteSize = sizeof(const char *);
+        return B32_FALSE;
     }
 
-    memory_unmap_alloc((void **)&dictPtr);
-
-    memcpy((void *)outDictKeyPtr, &dictKey, sizeof(struct memory_allocation_key));
+    // every push empties BASIC_DICT_CLEAR_GROUP_COUNT groups, so this only happens if the next table couldn't 
+    // be mapped on the way
+    if ((takenSlotCount*16) > ((u64)slotCount*15))
+    {
+        _basic_dict_step_resize(dictPtr, UINT32_MAX, tablePtrPtr, prevTablePtrPtr);
+    }
 
     return B32_TRUE;
 }
 
-b32
-basic_dict_map_data(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, 
-    void **outDataPtr)
+// halves the table once no more than 1/8 of its slots are taken, down to the size it was created with
+static b32
+_basic_dict_trim(struct basic_dict *dictPtr, u8 **tablePtrPtr, u8 **prevTablePtrPtr)
 {
-    if ((MEMORY_IS_ALLOCATION_NULL(dictKeyPtr)))
+    if ((*prevTablePtrPtr) || dictPtr->nextGroupCount || (dictPtr->groupCount <= dictPtr->minGroupCount) || 
+        (((u64)dictPtr->count*8) > ((u64)dictPtr->groupCount*BASIC_DICT_GROUP_SIZE)))
     {
-        return B32_FALSE;
+        return B32_TRUE;
     }
 
-    if (!keyPtr)
+    return _basic_dict_begin_resize(dictPtr, dictPtr->groupCount/2, *tablePtrPtr, prevTablePtrPtr);
+}
+
+// 'deletedCountPtr' is NULL for the previous table, whose deleted slots are never reused
+static void
+_basic_dict_release_slot(u8 *tablePtr, struct basic_dict_slot *slotPtr, u32 slotIndex, u32 *deletedCountPtr)
+{
+    u8 *controlArr = &tablePtr[(slotIndex/BASIC_DICT_GROUP_SIZE)*BASIC_DICT_GROUP_SIZE];
+
+    if (!slotPtr->isKeyInline)
     {
-        return B32_FALSE;
+        memory_raw_free(&slotPtr->rawKeyKey);
     }
 
-    if (!outDataPtr)
+    // probes only pass through full groups, so a group that still has an empty slot can take another
+    if (_basic_dict_match_group(controlArr, BASIC_DICT_CONTROL_EMPTY))
     {
-        return B32_FALSE;
+        tablePtr[slotIndex] = BASIC_DICT_CONTROL_EMPTY;
     }
+    else 
+    {
+        tablePtr[slotIndex] = BASIC_DICT_CONTROL_DELETED;
 
-    const struct memory_allocation_key foundNodeBucketKey;
-    const struct memory_allocation_key foundNodeKey;
+        if (deletedCountPtr)
+        {
+            ++(*deletedCountPtr);
+        }
+    }
+}
 
-    if (!(_basic_dict_get_node_by_key(dictKeyPtr, keyPtr, &foundNodeKey, 
-    &foundNodeBucketKey)))
+// maps the dict and its table, and the previous table while a resize is under way (NULL otherwise); the caller
+// unmaps them with _basic_dict_unmap
+static b32
+_basic_dict_map(const struct memory_allocation_key *dictKeyPtr, struct basic_dict **outDictPtr, 
+    u8 **outTablePtr, u8 **outPrevTablePtr)
+{
+    if ((MEMORY_IS_ALLOCATION_NULL(dictKeyPtr)))
     {
         return B32_FALSE;
     }
 
-    struct basic_dict_node *nodePtr;
-
-    if (!(basic_list_map_data(&foundNodeKey, (void **)&nodePtr)))
+    struct basic_dict *dictPtr;
     {
-        *outDataPtr = NULL;
+        memory_error_code resultCode = memory_map_alloc(dictKeyPtr, 
+        (void **)&dictPtr);
 
-        return B32_FALSE;
+        if (resultCode != MEMORY_OK)
+        {
+            return B32_FALSE;
+        }
     }
 
-    u8 *resultPtr;
-
-    memory_error_code resultCode = memory_map_alloc(&nodePtr->dataKey, 
-    (void **)&resultPtr);
+    u8 *tablePtr;
 
-    if (resultCode != MEMORY_OK)
+    if (memory_map_alloc(&dictPtr->tableKey, (void **)&tablePtr) != MEMORY_OK)
     {
-        basic_list_unmap_data(&foundNodeBucketKey, &foundNodeKey, 
-        (void **)&nodePtr);
+        memory_unmap_alloc((void **)&dictPtr);
 
         return B32_FALSE;
     }
 
-    resultPtr += nodePtr->dataByteOffset;
+    u8 *prevTablePtr = NULL;
+
+    if (dictPtr->prevGroupCount && (memory_map_alloc(&dictPtr->prevTableKey, 
+        (void **)&prevTablePtr) != MEMORY_OK))
+    {
+        memory_unmap_alloc((void **)&tablePtr);
+        memory_unmap_alloc((void **)&dictPtr);
 
-    *outDataPtr = resultPtr;
+        return B32_FALSE;
+    }
 
-    basic_list_unmap_data(&foundNodeBucketKey, &foundNodeKey, 
-    (void **)&nodePtr);
+    *outDictPtr = dictPtr;
+    *outTablePtr = tablePtr;
+    *outPrevTablePtr = prevTablePtr;
 
     return B32_TRUE;
 }
 
-b32
-basic_dict_unmap_data(const struct memory_allocation_key *dictKeyPtr, void *keyPtr,
-    void **outDataPtr)
+static void
+_basic_dict_unmap(struct basic_dict **dictPtrPtr, u8 **tablePtrPtr, u8 **prevTablePtrPtr)
 {
-    if ((MEMORY_IS_ALLOCATION_NULL(dictKeyPtr)))
+    if (*prevTablePtrPtr)
     {
-        return B32_FALSE;
+        memory_unmap_alloc((void **)prevTablePtrPtr);
     }
 
-    if (!keyPtr)
-    {
+    memory_unmap_alloc((void **)tablePtrPtr);
+    memory_unmap_alloc((void **)dictPtrPtr);
+}
+
+// finds the key in the current table, then in the previous one; the slot's table and index are written out,
+// if the key is found
+static b32
+_basic_dict_find(const struct basic_dict *dictPtr, u8 *tablePtr, u8 *prevTablePtr, void *keyPtr, 
+    utils_hash hash, u8 **outSlotTablePtr, u32 *outSlotIndex)
+{
+    u32 slotIndex = _basic_dict_find_slot(dictPtr, tablePtr, dictPtr->groupCount, keyPtr, hash);
+
+    if (slotIndex != BASIC_DICT_NULL_SLOT_INDEX)
+    {
+        *outSlotTablePtr = tablePtr;
+        *outSlotIndex = slotIndex;
+
+        return B32_TRUE;
+    }
+
+    if (!prevTablePtr)
+    {
         return B32_FALSE;
     }
 
-    if (!outDataPtr)
+    slotIndex = _basic_dict_find_slot(dictPtr, prevTablePtr, dictPtr->prevGroupCount, keyPtr, hash);
+
+    if (slotIndex == BASIC_DICT_NULL_SLOT_INDEX)
     {
         return B32_FALSE;
     }
 
-    const struct memory_allocation_key foundBucketKey;
-    const struct memory_allocation_key foundNodeKey;
-    
-    if (!(_basic_dict_get_node_by_key(dictKeyPtr, keyPtr, &foundNodeKey, 
-        &foundBucketKey)))
+    *outSlotTablePtr = prevTablePtr;
+    *outSlotIndex = slotIndex;
+
+    return B32_TRUE;
+}
+
+// maps the dict and its tables, and finds the key's slot; the caller unmaps them with _basic_dict_unmap. 'hashPtr'
+// is the key's string id hash when it's known already, NULL otherwise
+static b32
+_basic_dict_map_slot_by_key(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, const utils_hash *hashPtr, 
+    struct basic_dict **outDictPtr, u8 **outTablePtr, u8 **outPrevTablePtr, struct basic_dict_slot **outSlotPtr)
+{
+    if (!keyPtr)
     {
         return B32_FALSE;
     }
 
-    struct basic_dict_node *nodePtr;
+    struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
 
-    if (!(basic_list_map_data(&foundNodeKey, (void **)&nodePtr)))
+    if (!(_basic_dict_map(dictKeyPtr, &dictPtr, &tablePtr, &prevTablePtr)))
     {
         return B32_FALSE;
     }
 
-    u8 *resultPtr = *outDataPtr;
-    resultPtr -= nodePtr->dataByteOffset;
+    utils_hash dictHash;
+    u8 *slotTablePtr;
+    u32 slotIndex;
 
-    memory_unmap_alloc((void **)resultPtr);
+    // only the default string keys are hashed the way string ids are
+    if (hashPtr && ((dictPtr->hashFunc != &_default_hash_func) || dictPtr->keyByteSize))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Only dicts with the default string keys are looked up by string id.", 
+            __FUNCTION__, __LINE__);
 
-    *outDataPtr = NULL;
+        _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
 
-    basic_list_unmap_data(&foundBucketKey, &foundNodeKey, 
-    (void **)&nodePtr);
+        return B32_FALSE;
+    }
+
+    if (hashPtr)
+    {
+        dictHash = *hashPtr;
+    }
+    else if (!(dictPtr->hashFunc(dictPtr, keyPtr, &dictHash)))
+    {
+        _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+        return B32_FALSE;
+    }
+
+    if (!(_basic_dict_find(dictPtr, tablePtr, prevTablePtr, keyPtr, _basic_dict_mix_hash(dictHash), &slotTablePtr, 
+        &slotIndex)))
+    {
+        _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+        return B32_FALSE;
+    }
+
+    *outDictPtr = dictPtr;
+    *outTablePtr = tablePtr;
+    *outPrevTablePtr = prevTablePtr;
+    *outSlotPtr = &_basic_dict_get_slot_arr(slotTablePtr, (slotTablePtr == tablePtr) ? dictPtr->groupCount : 
+        dictPtr->prevGroupCount)[slotIndex];
 
     return B32_TRUE;
 }
 
+// frees every out of line key in a table of 'groupCount' groups, and leaves all its slots empty
+static void
+_basic_dict_release_all_slots(u8 *tablePtr, u32 groupCount)
+{
+    struct basic_dict_slot *slotArr = _basic_dict_get_slot_arr(tablePtr, groupCount);
+
+    for (u32 slotIndex = 0; slotIndex < groupCount*BASIC_DICT_GROUP_SIZE; ++slotIndex)
+    {
+        if (!(tablePtr[slotIndex] & BASIC_DICT_CONTROL_EMPTY) && !slotArr[slotIndex].isKeyInline)
+        {
+            memory_raw_free(&slotArr[slotIndex].rawKeyKey);
+        }
+    }
+
+    memset(tablePtr, BASIC_DICT_CONTROL_EMPTY, (u64)groupCount*BASIC_DICT_GROUP_SIZE);
+}
+
 b32
-basic_dict_push_data(const struct memory_allocation_key *dictKeyPtr,
-    void *keyPtr, p64 *dataByteOffset, u64 *dataByteSize,
-    const struct memory_allocation_key *dataKeyPtr)
+basic_dict_create(const struct memory_page_key *memoryPageKeyPtr, basic_dict_hash_func hashFunc, 
+    basic_dict_create_key_copy_func keyCopyFunc, u32 initBucketCount, u64 *keySize, 
+    const struct memory_allocation_key *userPtrKeyPtr, const struct memory_allocation_key *outDictKeyPtr)
 {
-    if ((MEMORY_IS_ALLOCATION_NULL(dictKeyPtr)))
+    if ((MEMORY_IS_PAGE_NULL(memoryPageKeyPtr)))
     {
+        if (outDictKeyPtr)
+        {
+            memory_get_null_allocation_key(outDictKeyPtr);
+        }
+
         return B32_FALSE;
     }
 
-    if (!keyPtr)
+    if (!outDictKeyPtr)
     {
         return B32_FALSE;
     }
 
-    const struct memory_allocation_key foundNodeKey;
-    const struct memory_allocation_key foundBucketKey;
-
-    if (!(_basic_dict_get_node_by_key(dictKeyPtr, keyPtr, &foundNodeKey,
-            &foundBucketKey)))
+    if (keyCopyFunc && (!keySize || !(*keySize)))
     {
-        struct basic_dict *dictPtr;
+        utils_fprintfln(stderr, "basic_dict_create(Line: %d): A key copy function needs a key size.", 
+                __LINE__);
 
-        memory_error_code resultCode = memory_map_alloc(dictKeyPtr, 
-        (void **)&dictPtr);
+        memory_get_null_allocation_key(outDictKeyPtr);
 
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
+        return B32_FALSE;
+    }
 
-        utils_hash dictHash;
+    const struct memory_allocation_key dictKey = {0};
+    {
+        memory_error_code resultCode;
 
-        if (!(dictPtr->hashFunc(dictPtr, keyPtr, &dictHash)))
+        if ((resultCode = memory_alloc(memoryPageKeyPtr, sizeof(struct basic_dict), NULL, 
+            &dictKey)) != MEMORY_OK)
         {
-            memory_unmap_alloc((void **)&dictPtr);
+            utils_fprintfln(stderr, "basic_dict_create(Line: %d): Cannot allocate basic_dict.", 
+                    __LINE__);
 
             return B32_FALSE;
         }
+    }
 
-        const struct memory_allocation_key *bucketTablePtr;
-
-        resultCode = memory_map_alloc(&dictPtr->bucketTableKey, (void **)&bucketTablePtr);
+    struct basic_dict *dictPtr;
+    {
+        memory_error_code resultCode;
 
-        if (resultCode != MEMORY_OK)
+        if ((resultCode = memory_map_alloc(&dictKey, 
+            (void **)&dictPtr)) != MEMORY_OK)
         {
-            memory_unmap_alloc((void **)&dictPtr);
+            memory_free(&dictKey);
+
+            utils_fprintfln(stderr, "basic_dict_create(Line: %d): Cannot map basic_dict allocation.", 
+                    __LINE__);
 
             return B32_FALSE;
         }
+    }
 
-        const struct memory_allocation_key *bucketKeyPtr = &bucketTablePtr[dictPtr->tableBucketCount%
-            (u64)dictHash];
+    memset(dictPtr, '\0', sizeof(struct basic_dict));
 
-        if (!(basic_list_get_next_node(&dictPtr->freeNodeList, 
-        NULL, &foundNodeKey)))
-        {
-            const struct memory_allocation_key dictNodeKey;
+    memcpy((void *)&dictPtr->pageKey, memoryPageKeyPtr, sizeof(struct memory_page_key));
 
-            resultCode = memory_alloc(&dictPtr->pageKey, sizeof(struct basic_dict_node), 
-            NULL, &dictNodeKey);
+    memory_get_null_allocation_key(&dictPtr->prevTableKey);
+    memory_get_null_allocation_key(&dictPtr->nextTableKey);
 
-            if (resultCode != MEMORY_OK)
-            {
-                memory_unmap_alloc((void **)&bucketTablePtr);
-                memory_unmap_alloc((void **)&dictPtr);
+    dictPtr->hashFunc = hashFunc ? hashFunc : &_default_hash_func;
 
-                return B32_FALSE;
-            }
+    if (userPtrKeyPtr)
+    {
+        memcpy((struct memory_allocation_key*)&dictPtr->userPtrKey, userPtrKeyPtr, sizeof(struct memory_allocation_key));
+    }
+    else 
+    {
+        memory_get_null_allocation_key(&dictPtr->userPtrKey);
+    }
 
-            if (!(basic_list_append(bucketKeyPtr, 0, 
-            sizeof(struct basic_dict_node), &dictNodeKey, 
-            &foundNodeKey)))
-            {
-                memory_free(&dictNodeKey);
-                memory_unmap_alloc((void **)&bucketTablePtr);
-                memory_unmap_alloc((void **)&dictPtr);
+    dictPtr->keyCopyFunc = keyCopyFunc ? keyCopyFunc : &_default_key_copy_func;
+    dictPtr->keyByteSize = keySize ? *keySize : 0;
 
-                return B32_FALSE;
-            }
-        }
-        else 
-        {
-            if (!(basic_list_move_node(&dictPtr->freeNodeList, 
-            bucketKeyPtr, &foundNodeKey)))
-            {
-                memory_unmap_alloc((void **)&bucketTablePtr);
-                memory_unmap_alloc((void **)&dictPtr);
+    // the bucket count is taken as the number of entries to make room for
+    u32 groupCount = 1;
 
-                return B32_FALSE;
-            }
-        }
+    while (((u64)groupCount*BASIC_DICT_GROUP_SIZE*7) < ((u64)initBucketCount*8))
+    {
+        groupCount *= 2;
+    }
 
-        memcpy((void *)&foundBucketKey, bucketKeyPtr, sizeof(struct memory_allocation_key));
+    u8 *tablePtr;
 
-        memory_unmap_alloc((void **)&bucketTablePtr);
+    if (!(_basic_dict_alloc_table(dictPtr, groupCount, &dictPtr->tableKey, &tablePtr)))
+    {
         memory_unmap_alloc((void **)&dictPtr);
+        memory_free(&dictKey);
+        memory_get_null_allocation_key(outDictKeyPtr);
+
+        return B32_FALSE;
     }
 
+    _basic_dict_clear_groups(tablePtr, groupCount, 0, groupCount);
+
+    memory_unmap_alloc((void **)&tablePtr);
+
+    dictPtr->groupCount = groupCount;
+    dictPtr->minGroupCount = groupCount;
+
+    memory_unmap_alloc((void **)&dictPtr);
+
+    memcpy((void *)outDictKeyPtr, &dictKey, sizeof(struct memory_allocation_key));
+
+    return B32_TRUE;
+}
+
+static b32
+_basic_dict_map_data(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, const utils_hash *hashPtr, 
+    void **outDataPtr)
+{
+    if (!outDataPtr)
+    {
+        return B32_FALSE;
+    }
+
+    *outDataPtr = NULL;
+
     struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+    struct basic_dict_slot *slotPtr;
+
+    if (!(_basic_dict_map_slot_by_key(dictKeyPtr, keyPtr, hashPtr, &dictPtr, &tablePtr, &prevTablePtr, &slotPtr)))
     {
-        memory_error_code resultCode = memory_map_alloc(dictKeyPtr, (void **)&dictPtr);
+        return B32_FALSE;
+    }
 
-        if (resultCode != MEMORY_OK)
-        {
-            basic_list_free_node(&foundBucketKey, &foundNodeKey);
+    // an inline value lives in the table, which can move before the caller unmaps it
+    if (slotPtr->isValueInline)
+    {
+        _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
 
-            return B32_FALSE;
-        }
+        return B32_FALSE;
+    }
+
+    u8 *resultPtr;
+
+    memory_error_code resultCode = memory_map_alloc(&slotPtr->dataKey, 
+    (void **)&resultPtr);
+
+    if (resultCode == MEMORY_OK)
+    {
+        *outDataPtr = resultPtr + slotPtr->dataByteOffset;
+    }
+
+    _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+    return (resultCode == MEMORY_OK) ? B32_TRUE : B32_FALSE;
+}
+
+b32
+basic_dict_map_data(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, 
+    void **outDataPtr)
+{
+    return _basic_dict_map_data(dictKeyPtr, keyPtr, NULL, outDataPtr);
+}
+
+b32
+basic_dict_map_data_by_id(const struct memory_allocation_key *dictKeyPtr, const struct utils_string_id *stringIdPtr, 
+    void **outDataPtr)
+{
+    if (!stringIdPtr)
+    {
+        return B32_FALSE;
     }
 
-    struct basic_dict_node *nodePtr;
-    const struct memory_raw_allocation_key rawKeyKey;
+    return _basic_dict_map_data(dictKeyPtr, (void *)stringIdPtr->str, &stringIdPtr->hash, outDataPtr);
+}
 
-    if (!(dictPtr->keyCopyFunc(dictPtr, keyPtr, &rawKeyKey)))
+static b32
+_basic_dict_unmap_data(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, const utils_hash *hashPtr, 
+    void **outDataPtr)
+{
+    if (!outDataPtr || !(*outDataPtr))
     {
-        basic_list_free_node(&foundBucketKey, &foundNodeKey);
+        return B32_FALSE;
+    }
 
+    struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+    struct basic_dict_slot *slotPtr;
+
+    if (!(_basic_dict_map_slot_by_key(dictKeyPtr, keyPtr, hashPtr, &dictPtr, &tablePtr, &prevTablePtr, &slotPtr)))
+    {
         return B32_FALSE;
     }
 
-    memory_unmap_alloc((void **)&dictPtr);
+    u8 *resultPtr = *outDataPtr;
+    resultPtr -= slotPtr->dataByteOffset;
+
+    memory_unmap_alloc((void **)&resultPtr);
+
+    *outDataPtr = NULL;
+
+    _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+    return B32_TRUE;
+}
 
-    if (!(basic_list_map_data(&foundNodeKey, (void **)&nodePtr)))
+b32
+basic_dict_unmap_data(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, 
+    void **outDataPtr)
+{
+    return _basic_dict_unmap_data(dictKeyPtr, keyPtr, NULL, outDataPtr);
+}
+
+b32
+basic_dict_unmap_data_by_id(const struct memory_allocation_key *dictKeyPtr, 
+    const struct utils_string_id *stringIdPtr, void **outDataPtr)
+{
+    if (!stringIdPtr)
     {
-        memory_raw_free(&rawKeyKey);
-        basic_list_free_node(&foundBucketKey, &foundNodeKey);
+        return B32_FALSE;
+    }
 
-        // TODO:
+    return _basic_dict_unmap_data(dictKeyPtr, (void *)stringIdPtr->str, &stringIdPtr->hash, outDataPtr);
+}
 
+// maps the dict and its tables, and finds the key's slot, or places a new one for it with an empty reference;
+// the caller unmaps them with _basic_dict_unmap_pushed_slot
+static b32
+_basic_dict_map_pushed_slot(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, 
+    struct basic_dict **outDictPtr, u8 **outTablePtr, u8 **outPrevTablePtr, struct basic_dict_slot **outSlotPtr)
+{
+    if (!keyPtr)
+    {
+        return B32_FALSE;
+    }
+
+    struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+
+    if (!(_basic_dict_map(dictKeyPtr, &dictPtr, &tablePtr, &prevTablePtr)))
+    {
         return B32_FALSE;
     }
 
-    memcpy((void *)&nodePtr->rawKeyKey, &rawKeyKey, sizeof(struct memory_raw_allocation_key));
+    utils_hash dictHash;
+
+    if (!(dictPtr->hashFunc(dictPtr, keyPtr, &dictHash)))
+    {
+        _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+        return B32_FALSE;
+    }
+
+    dictHash = _basic_dict_mix_hash(dictHash);
+
+    u8 *slotTablePtr;
+    u32 slotIndex;
+    struct basic_dict_slot *slotPtr;
+
+    // pushing an existing key replaces its data, and keeps its copy of the key
+    if (_basic_dict_find(dictPtr, tablePtr, prevTablePtr, keyPtr, dictHash, &slotTablePtr, &slotIndex))
+    {
+        slotPtr = &_basic_dict_get_slot_arr(slotTablePtr, (slotTablePtr == tablePtr) ? dictPtr->groupCount : 
+            dictPtr->prevGroupCount)[slotIndex];
+    }
+    else 
+    {
+        if (!(_basic_dict_reserve_one(dictPtr, &tablePtr, &prevTablePtr)))
+        {
+            _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+            return B32_FALSE;
+        }
+
+        u64 keyByteSize = _basic_dict_get_key_byte_size(dictPtr, keyPtr);
+        b32 isKeyInline = (keyByteSize <= BASIC_DICT_INLINE_KEY_BYTE_SIZE) ? B32_TRUE : B32_FALSE;
+        const struct memory_raw_allocation_key rawKeyKey;
+
+        if (!isKeyInline && !(dictPtr->keyCopyFunc(dictPtr, keyPtr, &rawKeyKey)))
+        {
+            _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+            return B32_FALSE;
+        }
+
+        // new keys only ever go in the current table
+        slotPtr = &_basic_dict_get_slot_arr(tablePtr, dictPtr->groupCount)[_basic_dict_place_slot(tablePtr, 
+            dictPtr->groupCount, dictHash, &dictPtr->deletedCount)];
+
+        ++dictPtr->count;
+
+        slotPtr->hash = dictHash;
+        slotPtr->isKeyInline = isKeyInline;
+        slotPtr->isValueInline = B32_FALSE;
+        slotPtr->dataByteOffset = 0;
+        slotPtr->dataByteSize = 0;
+
+        memory_get_null_allocation_key(&slotPtr->dataKey);
+
+        if (isKeyInline)
+        {
+            memcpy(slotPtr->keyArr, keyPtr, keyByteSize);
+        }
+        else  
+        {
+            memcpy((void *)&slotPtr->rawKeyKey, &rawKeyKey, sizeof(struct memory_raw_allocation_key));
+        }
+    }
+
+    *outDictPtr = dictPtr;
+    *outTablePtr = tablePtr;
+    *outPrevTablePtr = prevTablePtr;
+    *outSlotPtr = slotPtr;
+
+    return B32_TRUE;
+}
+
+// takes an ongoing resize a step further, which moves slots, and unmaps the dict and its tables
+static void
+_basic_dict_unmap_pushed_slot(struct basic_dict **dictPtrPtr, u8 **tablePtrPtr, u8 **prevTablePtrPtr)
+{
+    _basic_dict_step_resize(*dictPtrPtr, BASIC_DICT_CLEAR_GROUP_COUNT, tablePtrPtr, prevTablePtrPtr);
+
+    _basic_dict_unmap(dictPtrPtr, tablePtrPtr, prevTablePtrPtr);
+}
+
+b32
+basic_dict_push_data(const struct memory_allocation_key *dictKeyPtr, 
+    void *keyPtr, p64 *dataByteOffset, u64 *dataByteSize, 
+    const struct memory_allocation_key *dataKeyPtr)
+{
+    struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+    struct basic_dict_slot *slotPtr;
+
+    if (!(_basic_dict_map_pushed_slot(dictKeyPtr, keyPtr, &dictPtr, &tablePtr, &prevTablePtr, &slotPtr)))
+    {
+        return B32_FALSE;
+    }
+
+    // an inline value shares its bytes with the reference, so the reference starts over
+    if (slotPtr->isValueInline)
+    {
+        slotPtr->isValueInline = B32_FALSE;
+        slotPtr->dataByteOffset = 0;
+        slotPtr->dataByteSize = 0;
+    }
 
     if (dataByteOffset)
     {
-        nodePtr->dataByteOffset = *dataByteOffset;
+        slotPtr->dataByteOffset = *dataByteOffset;
     }
 
     if (dataByteSize)
     {
-        nodePtr->dataByteSize = *dataByteSize;
+        slotPtr->dataByteSize = *dataByteSize;
     }
 
     if (!(MEMORY_IS_ALLOCATION_NULL(dataKeyPtr)))
     {
-        memcpy((void *)&nodePtr->dataKey, dataKeyPtr, sizeof(struct memory_allocation_key));
+        memcpy((void *)&slotPtr->dataKey, dataKeyPtr, sizeof(struct memory_allocation_key));
     }
     else 
     {
-        memory_get_null_allocation_key(&nodePtr->dataKey);
+        memory_get_null_allocation_key(&slotPtr->dataKey);
     }
 
-    basic_list_unmap_data(&foundBucketKey, &foundNodeKey, (void **)&nodePtr);
+    _basic_dict_unmap_pushed_slot(&dictPtr, &tablePtr, &prevTablePtr);
 
     return B32_TRUE;
 }
 
 b32
-basic_dict_get_data(const struct memory_allocation_key *dictKeyPtr,
-    void *keyPtr, p64 *dataByteOffset, u64 *dataByteSize,
-    const struct memory_allocation_key *outDataKeyPtr)
+basic_dict_push_value(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, 
+    const void *valuePtr, u64 valueByteSize)
 {
-    const struct memory_allocation_key foundBucketKey;
-    const struct memory_allocation_key foundNodeKey;
+    if (!valuePtr || !valueByteSize)
+    {
+        return B32_FALSE;
+    }
 
-    if (!(_basic_dict_get_node_by_key(dictKeyPtr, keyPtr, &foundNodeKey, 
-    &foundBucketKey)))
+    if (valueByteSize > BASIC_DICT_INLINE_VALUE_BYTE_SIZE)
     {
+        utils_fprintfln(stderr, "%s(Line: %d): A value of %llu bytes is over the inline value size (%d bytes).", 
+            __FUNCTION__, __LINE__, (unsigned long long)valueByteSize, BASIC_DICT_INLINE_VALUE_BYTE_SIZE);
+
         return B32_FALSE;
     }
 
-    struct basic_dict_node *nodePtr;
+    struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+    struct basic_dict_slot *slotPtr;
 
-    if (!(basic_list_map_data(&foundNodeKey, (void **)&nodePtr)))
+    if (!(_basic_dict_map_pushed_slot(dictKeyPtr, keyPtr, &dictPtr, &tablePtr, &prevTablePtr, &slotPtr)))
     {
         return B32_FALSE;
     }
 
+    slotPtr->isValueInline = B32_TRUE;
+    slotPtr->dataByteSize = valueByteSize;
+
+    memcpy(slotPtr->valueArr, valuePtr, valueByteSize);
+
+    _basic_dict_unmap_pushed_slot(&dictPtr, &tablePtr, &prevTablePtr);
+
+    return B32_TRUE;
+}
+
+static b32
+_basic_dict_get_data(const struct memory_allocation_key *dictKeyPtr, 
+    void *keyPtr, const utils_hash *hashPtr, p64 *dataByteOffset, u64 *dataByteSize, 
+    const struct memory_allocation_key *outDataKeyPtr)
+{
+    struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+    struct basic_dict_slot *slotPtr;
+
+    if (!(_basic_dict_map_slot_by_key(dictKeyPtr, keyPtr, hashPtr, &dictPtr, &tablePtr, &prevTablePtr, &slotPtr)))
+    {
+        return B32_FALSE;
+    }
+
+    if (slotPtr->isValueInline)
+    {
+        _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+        return B32_FALSE;
+    }
+
     if (dataByteOffset)
     {
-        *dataByteOffset = nodePtr->dataByteOffset;
+        *dataByteOffset = slotPtr->dataByteOffset;
     }
 
     if (dataByteSize)
     {
-        *dataByteSize = nodePtr->dataByteSize;
+        *dataByteSize = slotPtr->dataByteSize;
     }
 
     if (outDataKeyPtr)
     {
-        memcpy((void *)outDataKeyPtr, &nodePtr->dataKey, sizeof(struct memory_allocation_key));
+        memcpy((void *)outDataKeyPtr, &slotPtr->dataKey, sizeof(struct memory_allocation_key));
     }
 
-    basic_list_unmap_data(&foundBucketKey, &foundNodeKey, (void **)&nodePtr);
+    _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
 
     return B32_TRUE;
 }
 
 b32
-basic_dict_remove(const struct memory_allocation_key *dictKeyPtr, void *keyPtr)
+basic_dict_get_data(const struct memory_allocation_key *dictKeyPtr, 
+    void *keyPtr, p64 *dataByteOffset, u64 *dataByteSize, 
+    const struct memory_allocation_key *outDataKeyPtr)
 {
-    const struct memory_allocation_key foundBucketKey;
-    const struct memory_allocation_key foundNodeKey;
+    return _basic_dict_get_data(dictKeyPtr, keyPtr, NULL, dataByteOffset, dataByteSize, outDataKeyPtr);
+}
 
-    if (!(_basic_dict_get_node_by_key(dictKeyPtr, keyPtr, &foundNodeKey, 
-    &foundBucketKey)))
+b32
+basic_dict_get_data_by_id(const struct memory_allocation_key *dictKeyPtr, 
+    const struct utils_string_id *stringIdPtr, p64 *dataByteOffset, u64 *dataByteSize, 
+    const struct memory_allocation_key *outDataKeyPtr)
+{
+    if (!stringIdPtr)
     {
         return B32_FALSE;
     }
 
-    struct basic_dict *dictPtr;
+    return _basic_dict_get_data(dictKeyPtr, (void *)stringIdPtr->str, &stringIdPtr->hash, dataByteOffset, 
+        dataByteSize, outDataKeyPtr);
+}
+
+static b32
+_basic_dict_get_value(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, const utils_hash *hashPtr, 
+    void *outValuePtr, u64 valueByteSize)
+{
+    if (!outValuePtr)
     {
-        memory_error_code resultCode = memory_map_alloc(dictKeyPtr, 
-        (void **)&dictPtr);
+        return B32_FALSE;
+    }
 
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
+    struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+    struct basic_dict_slot *slotPtr;
+
+    if (!(_basic_dict_map_slot_by_key(dictKeyPtr, keyPtr, hashPtr, &dictPtr, &tablePtr, &prevTablePtr, &slotPtr)))
+    {
+        return B32_FALSE;
     }
 
-    b32 isResult = basic_list_move_node(&foundBucketKey, 
-    &dictPtr->freeNodeList, &foundNodeKey);
+    b32 isResult = (slotPtr->isValueInline && (slotPtr->dataByteSize == valueByteSize)) ? B32_TRUE : B32_FALSE;
 
-    memory_unmap_alloc((void **)&dictPtr);
+    if (isResult)
+    {
+        memcpy(outValuePtr, slotPtr->valueArr, valueByteSize);
+    }
+
+    _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
 
     return isResult;
 }
 
+b32
+basic_dict_get_value(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, 
+    void *outValuePtr, u64 valueByteSize)
+{
+    return _basic_dict_get_value(dictKeyPtr, keyPtr, NULL, outValuePtr, valueByteSize);
+}
+
+b32
+basic_dict_get_value_by_id(const struct memory_allocation_key *dictKeyPtr, 
+    const struct utils_string_id *stringIdPtr, void *outValuePtr, u64 valueByteSize)
+{
+    if (!stringIdPtr)
+    {
+        return B32_FALSE;
+    }
+
+    return _basic_dict_get_value(dictKeyPtr, (void *)stringIdPtr->str, &stringIdPtr->hash, outValuePtr, 
+        valueByteSize);
+}
+
+b32
+basic_dict_remove(const struct memory_allocation_key *dictKeyPtr, void *keyPtr)
+{
+    if (!keyPtr)
+    {
+        return B32_FALSE;
+    }
+
+    struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+
+    if (!(_basic_dict_map(dictKeyPtr, &dictPtr, &tablePtr, &prevTablePtr)))
+    {
+        return B32_FALSE;
+    }
+
+    utils_hash dictHash;
+    u8 *slotTablePtr;
+    u32 slotIndex;
+
+    if (!(dictPtr->hashFunc(dictPtr, keyPtr, &dictHash)) || 
+        !(_basic_dict_find(dictPtr, tablePtr, prevTablePtr, keyPtr, _basic_dict_mix_hash(dictHash), 
+        &slotTablePtr, &slotIndex)))
+    {
+        _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+        return B32_FALSE;
+    }
+
+    if (slotTablePtr == tablePtr)
+    {
+        _basic_dict_release_slot(tablePtr, &_basic_dict_get_slot_arr(tablePtr, dictPtr->groupCount)[slotIndex], 
+            slotIndex, &dictPtr->deletedCount);
+    }
+    else 
+    {
+        _basic_dict_release_slot(prevTablePtr, &_basic_dict_get_slot_arr(prevTablePtr, 
+            dictPtr->prevGroupCount)[slotIndex], slotIndex, NULL);
+    }
+
+    --dictPtr->count;
+
+    _basic_dict_step_resize(dictPtr, BASIC_DICT_CLEAR_GROUP_COUNT, &tablePtr, &prevTablePtr);
+
+    // a failed shrink leaves the table as it is, which is still a valid table
+    _basic_dict_trim(dictPtr, &tablePtr, &prevTablePtr);
+
+    _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+    return B32_TRUE;
+}
+
 b32
 basic_dict_clear(const struct memory_allocation_key *dictKeyPtr)
 {
     struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+
+    if (!(_basic_dict_map(dictKeyPtr, &dictPtr, &tablePtr, &prevTablePtr)))
     {
-        memory_error_code resultCode = memory_map_alloc(dictKeyPtr, 
-        (void **)&dictPtr);
+        return B32_FALSE;
+    }
 
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
+    _basic_dict_release_all_slots(tablePtr, dictPtr->groupCount);
+
+    if (prevTablePtr)
+    {
+        _basic_dict_release_all_slots(prevTablePtr, dictPtr->prevGroupCount);
+
+        // nothing is left to move, so this only frees the previous table
+        _basic_dict_migrate(dictPtr, UINT32_MAX, tablePtr, &prevTablePtr);
     }
 
-    u32 bucketCount = dictPtr->tableBucketCount;
+    _basic_dict_drop_next_table(dictPtr);
 
-    memory_unmap_alloc((void **)&dictPtr);
+    dictPtr->count = 0;
+    dictPtr->deletedCount = 0;
+
+    // back down to the size the dict was created with, like removing every entry would; an empty table has 
+    // nothing to move, so it's swapped in right away. A failed allocation keeps the emptied table
+    const struct memory_allocation_key minTableKey;
+    u8 *minTablePtr;
+
+    if ((dictPtr->groupCount > dictPtr->minGroupCount) && _basic_dict_alloc_table(dictPtr, 
+        dictPtr->minGroupCount, &minTableKey, &minTablePtr))
+    {
+        _basic_dict_clear_groups(minTablePtr, dictPtr->minGroupCount, 0, dictPtr->minGroupCount);
+
+        memory_unmap_alloc((void **)&tablePtr);
+        memory_free(&dictPtr->tableKey);
+        memcpy((void *)&dictPtr->tableKey, &minTableKey, sizeof(struct memory_allocation_key));
+
+        dictPtr->groupCount = dictPtr->minGroupCount;
+        tablePtr = minTablePtr;
+    }
+
+    _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
+    return B32_TRUE;
+}
+
+static b32
+_basic_dict_get_is_found(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, const utils_hash *hashPtr)
+{
+    struct basic_dict *dictPtr;
+    u8 *tablePtr;
+    u8 *prevTablePtr;
+    struct basic_dict_slot *slotPtr;
 
-    for (u32 bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex)
+    if (!(_basic_dict_map_slot_by_key(dictKeyPtr, keyPtr, hashPtr, &dictPtr, &tablePtr, &prevTablePtr, &slotPtr)))
     {
-        _basic_dict_clear_bucket(dictKeyPtr, bucketIndex);
+        return B32_FALSE;
     }
 
+    _basic_dict_unmap(&dictPtr, &tablePtr, &prevTablePtr);
+
     return B32_TRUE;
 }
 
 b32
 basic_dict_get_is_found(const struct memory_allocation_key *dictKeyPtr, void *keyPtr)
 {
-    return _basic_dict_get_node_by_key(dictKeyPtr, keyPtr, NULL, NULL);
+    return _basic_dict_get_is_found(dictKeyPtr, keyPtr, NULL);
 }
 
 b32
-basic_dict_destroy(const struct memory_allocation_key *dictKeyPtr)
+basic_dict_get_is_found_by_id(const struct memory_allocation_key *dictKeyPtr, 
+    const struct utils_string_id *stringIdPtr)
 {
-    struct basic_dict *dictPtr;
-    const struct memory_allocation_key *bucketTableKeyPtr;
+    if (!stringIdPtr)
     {
-        memory_error_code resultCode = memory_map_alloc(dictKeyPtr, 
-        (void **)&dictPtr);
-
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
-
-        resultCode = memory_map_alloc(&dictPtr->bucketTableKey, 
-        (void **)&bucketTableKeyPtr);
+        return B32_FALSE;
     }
 
-    memory_unmap_alloc((void **)&dictPtr);
+    return _basic_dict_get_is_found(dictKeyPtr, (void *)stringIdPtr->str, &stringIdPtr->hash);
+}
 
-    for (u32 bucketIndex = 0; bucketIndex < dictPtr->tableBucketCount; ++bucketIndex)
+b32
+basic_dict_destroy(const struct memory_allocation_key *dictKeyPtr)
+{
+    if (!(basic_dict_clear(dictKeyPtr)))
     {
-        const struct memory_allocation_key bucketKey;
-
-        if ((_basic_dict_get_bucket_by_index(dictKeyPtr, bucketIndex, &bucketKey)))
-        {
-            basic_list_destroy(&bucketKey);
-        }
+        return B32_FALSE;
     }
 
+    struct basic_dict *dictPtr;
+
     memory_map_alloc(dictKeyPtr, (void **)&dictPtr);
-    basic_list_destroy(&dictPtr->freeNodeList);
-    memory_free(&dictPtr->bucketTableKey);
+    memory_free(&dictPtr->tableKey);
     memory_unmap_alloc((void **)&dictPtr);
     memory_free(dictKeyPtr);
 
     return B32_TRUE;
-}
\ No newline at end of file
+}
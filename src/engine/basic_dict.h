@@ -19,6 +19,18 @@ typedef b32 (*basic_dict_create_key_copy_func)(struct basic_dict *dictPtr, void
 
 #define BASIC_DICT_NULL_PTR ((p64)0)
 
+// keys (string keys with their NUL) and values of up to these sizes are stored in the dict's table itself, so
+// pushing and removing them never allocates; longer keys are copied out by the dict's key copy function
+#if !defined(BASIC_DICT_INLINE_KEY_BYTE_SIZE)
+    #define BASIC_DICT_INLINE_KEY_BYTE_SIZE 32
+#endif
+
+#if !defined(BASIC_DICT_INLINE_VALUE_BYTE_SIZE)
+    #define BASIC_DICT_INLINE_VALUE_BYTE_SIZE 32
+#endif
+
+// 'keySize' makes the keys fixed size byte strings rather than NUL terminated strings; 'keyCopyFunc' is only
+// called for keys over BASIC_DICT_INLINE_KEY_BYTE_SIZE, and may be NULL to copy them into a raw allocation
 b32
 basic_dict_create(const struct memory_page_key *memoryPageKeyPtr, basic_dict_hash_func hashFunc,
     basic_dict_create_key_copy_func keyCopyFunc, u32 initBucketCount, u64 *keySize, 
@@ -32,6 +44,16 @@ b32
 basic_dict_unmap_data(const struct memory_allocation_key *dictKeyPtr, void *keyPtr,
     void **outDataPtr);
 
+// the _by_id lookups take a string id (see UTILS_STRING_ID) instead of a string key, and skip hashing it; they
+// only work on dicts with the default string keys
+b32
+basic_dict_map_data_by_id(const struct memory_allocation_key *dictKeyPtr, const struct utils_string_id *stringIdPtr, 
+    void **outDataPtr);
+
+b32
+basic_dict_unmap_data_by_id(const struct memory_allocation_key *dictKeyPtr, 
+    const struct utils_string_id *stringIdPtr, void **outDataPtr);
+
 b32
 basic_dict_push_data(const struct memory_allocation_key *dictKeyPtr,
     void *keyPtr, p64 *dataByteOffset, u64 *dataByteSize,
@@ -42,6 +64,25 @@ basic_dict_get_data(const struct memory_allocation_key *dictKeyPtr,
     void *keyPtr, p64 *dataByteOffset, u64 *dataByteSize,
     const struct memory_allocation_key *outDataKeyPtr);
 
+b32
+basic_dict_get_data_by_id(const struct memory_allocation_key *dictKeyPtr, 
+    const struct utils_string_id *stringIdPtr, p64 *dataByteOffset, u64 *dataByteSize, 
+    const struct memory_allocation_key *outDataKeyPtr);
+
+// stores a copy of the value in the entry, instead of a reference to data
+b32
+basic_dict_push_value(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, 
+    const void *valuePtr, u64 valueByteSize);
+
+// fails if the entry's value isn't one pushed with basic_dict_push_value, or is of another size
+b32
+basic_dict_get_value(const struct memory_allocation_key *dictKeyPtr, void *keyPtr, 
+    void *outValuePtr, u64 valueByteSize);
+
+b32
+basic_dict_get_value_by_id(const struct memory_allocation_key *dictKeyPtr, 
+    const struct utils_string_id *stringIdPtr, void *outValuePtr, u64 valueByteSize);
+
 b32
 basic_dict_remove(const struct memory_allocation_key *dictKeyPtr, void *keyPtr);
 
@@ -54,6 +95,10 @@ basic_dict_reset(const struct memory_allocation_key *dictKeyPtr, const struct me
 b32
 basic_dict_get_is_found(const struct memory_allocation_key *dictKeyPtr, void *keyPtr);
 
+b32
+basic_dict_get_is_found_by_id(const struct memory_allocation_key *dictKeyPtr, 
+    const struct utils_string_id *stringIdPtr);
+
 b32
 basic_dict_destroy(const struct memory_allocation_key *dictKeyPtr);
 
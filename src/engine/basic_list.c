@@ -30,17 +30,6 @@ struct basic_list
     const struct memory_allocation_key freeNodeKeyList;
 };
 
-b32
-_basic_list_generate_id(basic_list_id *outIdPtr)
-{
-    if (!outIdPtr)
-    {
-        return B32_FALSE;
-    }
-
-    return utils_generate_random_u64(outIdPtr);
-}
-
 b32
 _basic_list_assign_id(const struct memory_allocation_key *listKeyPtr,
     const struct memory_allocation_key *nodeKeyPtr)
@@ -55,118 +44,26 @@ _basic_list_assign_id(const struct memory_allocation_key *listKeyPtr,
         return B32_FALSE;
     }
 
-    struct basic_list *listPtr;
-    struct basic_list_node *nodePtr;
-    {
-        memory_error_code resultCode = memory_map_alloc(listKeyPtr, (void **)&listPtr);
+    basic_list_id id = memory_get_allocation_handle(nodeKeyPtr);
 
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
+    if (id == BASIC_LIST_NULL_ID)
+    {
+        return B32_FALSE;
+    }
 
-        resultCode = memory_map_alloc(nodeKeyPtr, (void **)&nodePtr);
+    struct basic_list_node *nodePtr;
+    {
+        memory_error_code resultCode = memory_map_alloc(nodeKeyPtr, (void **)&nodePtr);
         
         if (resultCode != MEMORY_OK)
         {
-            memory_unmap_alloc((void **)&listPtr);
-
             return B32_FALSE;
         }
     }
 
-    basic_list_id id;
-    {
-        if (listPtr->activeListNodeCount > 0)
-        {
-            while (B32_TRUE)
-            {
-                if (!(_basic_list_generate_id(&id)))
-                {
-                    memory_unmap_alloc((void **)&nodePtr);
-                    memory_unmap_alloc((void **)&listPtr);
-
-                    return B32_FALSE;
-                }
-
-                if (id == BASIC_LIST_NULL_ID)
-                {
-                    continue;
-                }
-
-                const struct memory_allocation_key currentNodeKey;
-
-                memcpy((void *)&currentNodeKey, &listPtr->activeNodeKeyList, 
-                sizeof(struct memory_allocation_key));
-
-                do 
-                {
-                    struct basic_list_node *currentNodePtr;
-
-                    memory_error_code resultCode = memory_map_alloc(&currentNodeKey, 
-                    (void **)&currentNodePtr);
-
-                    if (resultCode != MEMORY_OK)
-                    {
-                        memory_unmap_alloc((void **)&nodePtr);
-                        memory_unmap_alloc((void **)&listPtr);
-
-                        return B32_FALSE;
-                    }
-
-                    if (currentNodePtr->id != id)
-                    {
-                        if (!(MEMORY_IS_ALLOCATION_KEY_EQUAL(&currentNodePtr->nextNodeKey, 
-                            &listPtr->activeNodeKeyList)))
-                        {
-                            const struct memory_allocation_key nextNodeKey;
-
-                            memcpy((void *)&nextNodeKey, &currentNodePtr->nextNodeKey,
-                                sizeof(struct memory_allocation_key));
-
-                            memory_unmap_alloc((void **)&currentNodePtr);
-
-                            memcpy((void *)&currentNodeKey, &nextNodeKey, 
-                            sizeof(struct memory_allocation_key));
-                        }
-                        else 
-                        {
-                            memory_unmap_alloc((void **)&currentNodePtr);
-                            memory_get_null_allocation_key(&currentNodeKey);
-
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        memory_unmap_alloc((void **)&currentNodePtr);
-
-                        break;
-                    }
-                } while (!(MEMORY_IS_ALLOCATION_NULL(&currentNodeKey)));
-
-                if ((MEMORY_IS_ALLOCATION_NULL(&currentNodeKey)))
-                {
-                    break;
-                }
-            }
-        }
-        else 
-        {
-            if (!(_basic_list_generate_id(&id)))
-            {
-                memory_unmap_alloc((void **)&nodePtr);
-                memory_unmap_alloc((void **)&listPtr);
-
-                return B32_FALSE;
-            }
-        }
-    }
-
     nodePtr->id = id;
 
     memory_unmap_alloc((void **)&nodePtr);
-    memory_unmap_alloc((void **)&listPtr);
 
     return B32_TRUE;
 }
@@ -665,50 +562,36 @@ basic_list_get_node_by_id(const struct memory_allocation_key *listKeyPtr,
         return B32_FALSE;
     }
 
-    const struct memory_allocation_key headNodeKey;
+    const struct memory_allocation_key nodeKey;
 
-    if (!(basic_list_get_next_node(listKeyPtr, NULL, &headNodeKey)))
+    if ((memory_get_allocation_key_from_handle(&listKeyPtr->managed.contextKey, nodeId, &nodeKey)) != MEMORY_OK)
     {
         return B32_FALSE;
     }
 
-    const struct memory_allocation_key currentNodeKey;
-
-    memcpy((void *)&currentNodeKey, &headNodeKey, sizeof(struct memory_allocation_key));
+    struct basic_list_node *nodePtr;
 
-    do 
+    if ((memory_map_alloc(&nodeKey, (void **)&nodePtr)) != MEMORY_OK)
     {
-        struct basic_list_node *nodePtr;
-
-        memory_error_code resultCode = memory_map_alloc(&currentNodeKey, (void **)&nodePtr);
-
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
+        return B32_FALSE;
+    }
 
-        if (nodePtr->id == nodeId)
-        {
-            memcpy((void *)outNodekeyPtr, &currentNodeKey, sizeof(const struct memory_allocation_key));
-            memory_unmap_alloc((void *)&nodePtr);
+    // the handle is only trusted if it is an active node of this list
+    b32 isListNode = (nodePtr->id == nodeId) && nodePtr->isActive && 
+        (MEMORY_IS_ALLOCATION_KEY_EQUAL(&nodePtr->listKey, listKeyPtr));
 
-            return B32_TRUE;
-        }
+    memory_unmap_alloc((void **)&nodePtr);
 
-        if (!(MEMORY_IS_ALLOCATION_KEY_EQUAL(&headNodeKey, &nodePtr->nextNodeKey)))
-        {
-            memcpy((void *)&currentNodeKey, &nodePtr->nextNodeKey, sizeof(struct memory_allocation_key));
-        }
-        else
-        {
-            memory_get_null_allocation_key(&currentNodeKey);
-        }
+    if (!isListNode)
+    {
+        return B32_FALSE;
+    }
 
-        memory_unmap_alloc((void **)&nodePtr);
-    } while (!(MEMORY_IS_ALLOCATION_NULL(&currentNodeKey)));
+    memcpy((void *)outNodekeyPtr, &nodeKey, sizeof(struct memory_allocation_key));
 
-    return B32_FALSE;
+    return B32_TRUE;
 }
+
 b32
 basic_list_get_is_node_active(const struct memory_allocation_key *nodeKeyPtr)
 {
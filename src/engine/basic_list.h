@@ -4,8 +4,9 @@
 #include "types.h"
 #include "memory.h"
 
-typedef u64 basic_list_id;
-#define BASIC_LIST_NULL_ID ((basic_list_id)0)
+// a node's id is its allocation handle, so finding a node by id is a generation check, not a list walk
+typedef memory_handle basic_list_id;
+#define BASIC_LIST_NULL_ID ((basic_list_id)MEMORY_HANDLE_NULL)
 
 b32
 basic_list_create(const struct memory_page_key *memoryPageKeyPtr, 
@@ -576,7 +576,7 @@ config_set_var(const struct memory_allocation_key *configKeyPtr, const char *nam
 
             memcpy(rawNamePtr, name, nameByteSize);
 
-            memory_unmap_raw_allocation(&((struct config_var_header *)varDataPtr)->rawNameKey, (void **)&rawNamePtr);
+            memory_unmap_raw_allocation((void **)&rawNamePtr);
         }
 
         ((struct config_var_header *)varDataPtr)->byteOffset = configPtr->varWriteByteOffset;
@@ -818,7 +818,7 @@ config_unmap_var(const struct memory_allocation_key *configKeyPtr, void **outMap
 
     *outMapPtr = resultPtr;
 
-    memory_unmap_raw_allocation(&varHeaderPtr->rawNameKey, (void **)&namePtr);
+    memory_unmap_raw_allocation((void **)&namePtr);
     memory_unmap_alloc((void **)&configPtr);
 
     return B32_TRUE;
@@ -13,8 +13,12 @@
 #define PHYSICS_MEMORY_SIZE (1024*1024*100)
 #define GAME_MEMORY_SIZE (1024*1024*100)
 #define INPUT_MEMORY_SIZE (4096)
+#define FRAME_MEMORY_SIZE (1024*1024*8)
 #define MEMORY_SAFE_PTR_REGION_SIZE (1024*1024)
 #define MEMORY_LABEL_REGION_SIZE (1024*1024)
+#define MEMORY_REORDER_BUDGET_NS (1000*250)
+#define MEMORY_EVENT_TRACE_CAPACITY (1024*64)
+#define MEMORY_DIAGNOSTICS_DUMP_FRAME_INTERVAL (FRAMES_PER_SEC*10)
 
 #define GAME_ASPECT_RATIO ((real32)SCREEN_WIDTH/(real32)SCREEN_HEIGHT)
 #define GAME_GRID_HEIGHT 100.f
@@ -17,6 +17,8 @@ struct context
     const struct memory_context_key inputMemoryKey;
     const struct memory_allocation_key statsKey;
     const struct memory_context_key statsMemoryKey;
+    const struct memory_context_key frameMemoryKey;
+    struct memory_frame_arena frameArena;
     b32 isRunning;
     u32 msSinceStart;
 };
@@ -261,7 +261,7 @@ input_add_keys(const struct memory_allocation_key *inputContextKeyPtr,
 
             strncpy(keyPtr, keys[i], strLength);
 
-            memory_unmap_raw_allocation(&keyArrPtr[keyIndex].rawKeyKey, (void **)&keyPtr);
+            memory_unmap_raw_allocation((void **)&keyPtr);
             
             memory_unmap_alloc((void **)&keyArrPtr);
 
@@ -398,8 +398,7 @@ input_bind_key(const struct memory_allocation_key *inputKeyPtr, const char *key,
 
         strncpy(rawMappedKeyPtr, key, keyLength);
 
-        memory_unmap_raw_allocation(&keybindArrPtr[keybindIndex].rawKeyKey, 
-        (void **)&rawMappedKeyPtr);
+        memory_unmap_raw_allocation((void **)&rawMappedKeyPtr);
     }
 
     keybindArrPtr[keybindIndex].callback = cb;
@@ -422,13 +421,27 @@ input_bind_key(const struct memory_allocation_key *inputKeyPtr, const char *key,
 b32
 input_get_key_down(const struct memory_allocation_key *inputKeyPtr, const char *key, 
     b32 *outIsDown)
+{
+    struct utils_string_id keyId;
+
+    if (!(utils_generate_string_id(key, &keyId)))
+    {
+        return B32_FALSE;
+    }
+
+    return input_get_key_down_by_id(inputKeyPtr, &keyId, outIsDown);
+}
+
+b32
+input_get_key_down_by_id(const struct memory_allocation_key *inputKeyPtr, const struct utils_string_id *keyIdPtr, 
+    b32 *outIsDown)
 {
     if ((MEMORY_IS_ALLOCATION_NULL(inputKeyPtr)))
     {
         return B32_FALSE;
     }
 
-    if (!key)
+    if (!keyIdPtr)
     {
         return B32_FALSE;
     }
@@ -450,7 +463,7 @@ input_get_key_down(const struct memory_allocation_key *inputKeyPtr, const char *
 
     struct input_key *keyPtr;
 
-    if (!(basic_dict_map_data(&inputPtr->keyDict, (void *)key, (void **)&keyPtr)))
+    if (!(basic_dict_map_data_by_id(&inputPtr->keyDict, keyIdPtr, (void **)&keyPtr)))
     {
         memory_unmap_alloc((void **)&inputPtr);
 
@@ -459,7 +472,7 @@ input_get_key_down(const struct memory_allocation_key *inputKeyPtr, const char *
 
     *outIsDown = keyPtr->isDown;
 
-    basic_dict_unmap_data(&inputPtr->keyDict, (void *)key, (void **)&keyPtr);
+    basic_dict_unmap_data_by_id(&inputPtr->keyDict, keyIdPtr, (void **)&keyPtr);
     memory_unmap_alloc((void **)&inputPtr);
 
     return B32_TRUE;
@@ -4,6 +4,8 @@
 #include "types.h"
 #include "memory.h"
 
+struct utils_string_id;
+
 typedef void (*input_key_callback)(const char *key, b32 isDown,
     struct memory_allocation_key *userKeyPtr);
 
@@ -23,4 +25,9 @@ b32
 input_get_key_down(const struct memory_allocation_key *inputKeyPtr, const char *key, 
     b32 *outIsDown);
 
+// for keys polled every frame: takes UTILS_STRING_ID("a") rather than "a", so the key isn't hashed
+b32
+input_get_key_down_by_id(const struct memory_allocation_key *inputKeyPtr, const struct utils_string_id *keyIdPtr, 
+    b32 *outIsDown);
+
 #endif
\ No newline at end of file
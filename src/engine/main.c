@@ -1,8 +1,9 @@
+#define MEMORY_DEBUG
+
 #include "constants.h"
 #include "memory.h"
 #include "utils.h"
 #include <SDL3/SDL_oldnames.h>
-#define MEMORY_DEBUG
 
 #include "engine.h"
 
@@ -141,6 +142,11 @@ main(int argc, char **argv)
         }
     }
 
+    #if defined(MEMORY_EVENT_TRACE)
+    memory_debug_context_begin_trace(&gameMemoryKey, MEMORY_EVENT_TRACE_CAPACITY, "game_memory.trace");
+    memory_debug_context_begin_trace(&physicsMemoryKey, MEMORY_EVENT_TRACE_CAPACITY, "physics_memory.trace");
+    #endif
+
     const struct memory_context_key graphicsMemoryKey;
     {
         memory_error_code resultCode;
@@ -165,6 +171,23 @@ main(int argc, char **argv)
         }
     }
 
+    {
+        memory_error_code resultCode;
+
+        if ((resultCode = memory_create_debug_context(MEMORY_SAFE_PTR_REGION_SIZE, 
+            FRAME_MEMORY_SIZE, MEMORY_LABEL_REGION_SIZE, "frame", &app.frameMemoryKey))
+            != MEMORY_OK)
+        {
+            return -1;
+        }
+
+        if ((resultCode = memory_frame_arena_create(&app.frameMemoryKey, 
+            FRAME_MEMORY_SIZE - memory_get_size_of_page_header()*2, &app.frameArena)) != MEMORY_OK)
+        {
+            return -1;
+        }
+    }
+
     ImGuiContext *imguiContext = igCreateContext(NULL);
     
     SDL_Init(SDL_INIT_VIDEO);
@@ -211,8 +234,27 @@ main(int argc, char **argv)
     utils_set_elapsed_time_ns_ptr(&elapsedNS);
     utils_set_elapsed_time_ms_ptr(&elapsedMS);
 
+    u64 frameIndex = 0;
+
     while (app.isRunning)
     {
+        // everything allocated from the frame arena lives for exactly one iteration; the reset stays here even 
+        // while no subsystem allocates from it yet, as the point per-frame scratch hooks into
+        memory_frame_arena_reset(&app.frameArena);
+
+        memory_context_next_frame(&gameMemoryKey);
+        memory_context_next_frame(&physicsMemoryKey);
+
+        #if defined(MEMORY_DIAGNOSTICS_DUMP)
+        if ((frameIndex % MEMORY_DIAGNOSTICS_DUMP_FRAME_INTERVAL) == 0)
+        {
+            memory_context_dump_diagnostics(&gameMemoryKey, stderr);
+            memory_context_dump_diagnostics(&physicsMemoryKey, stderr);
+        }
+        #endif
+
+        ++frameIndex;
+
         SDL_Event ev;
         while (SDL_PollEvent(&ev))
         {
@@ -344,11 +386,32 @@ main(int argc, char **argv)
             SDL_GL_SwapWindow(window);
 
             elapsedMS -= MS_PER_FRAME;
-            elapsedMS += MS_PER_FRAME;
             app.msSinceStart += MS_PER_FRAME;
         }
+
+        // compact the long-lived contexts with what's left of the frame (the frames above took their share), 
+        // split between them and capped at MEMORY_REORDER_BUDGET_NS each
+        u32 frameElapsedMS = elapsedMS + (SDL_GetTicks() - previousTicks);
+
+        if (frameElapsedMS < MS_PER_FRAME)
+        {
+            u64 reorderBudgetNS = (u64)((MS_PER_FRAME - (real32)frameElapsedMS)*1000000.f)/2;
+
+            if (reorderBudgetNS > MEMORY_REORDER_BUDGET_NS)
+            {
+                reorderBudgetNS = MEMORY_REORDER_BUDGET_NS;
+            }
+
+            memory_pages_reorder(&gameMemoryKey, reorderBudgetNS);
+            memory_pages_reorder(&physicsMemoryKey, reorderBudgetNS);
+        }
     }
 
+    #if defined(MEMORY_EVENT_TRACE)
+    memory_debug_context_end_trace(&gameMemoryKey);
+    memory_debug_context_end_trace(&physicsMemoryKey);
+    #endif
+
     SDL_Quit();
 
     return 0;
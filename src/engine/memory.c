@@ -6,40 +6,99 @@
 #include <math.h>
 #include <time.h>
 #include <assert.h>
+#include <stdio.h>
+#include <stdatomic.h>
 
 #if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
     #include <malloc.h>
-#elif defined(linux)
+    #include <windows.h>
+#elif defined(linux) || defined(__linux__)
     #include <malloc.h>
     #include <stdlib.h>
+    #include <sys/mman.h>
+    #include <sched.h>
+    #include <pthread.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define MEMORY_USE_SSE2
 #endif
 
 #define MEMORY_HEADER_ID ((u16)0xDEAD)
 
+// two-level segregated fit (TLSF) free allocator index, per page. The first level splits sizes by 
+// power of two, the second level linearly subdivides each power of two. Defining 
+// MEMORY_ALLOC_POLICY_FIRST_FIT collapses every class into one list, and searches it first-fit (the 
+// old policy), so the two can be compared.
+#define MEMORY_TLSF_SL_INDEX_COUNT_LOG2 4
+#define MEMORY_TLSF_SL_INDEX_COUNT (1 << MEMORY_TLSF_SL_INDEX_COUNT_LOG2)
+#define MEMORY_TLSF_ALIGN_SIZE_LOG2 3
+#define MEMORY_TLSF_ALIGN_SIZE ((u64)1 << MEMORY_TLSF_ALIGN_SIZE_LOG2)
+#define MEMORY_TLSF_FL_INDEX_MAX 32
+#define MEMORY_TLSF_FL_INDEX_SHIFT (MEMORY_TLSF_SL_INDEX_COUNT_LOG2 + MEMORY_TLSF_ALIGN_SIZE_LOG2)
+#define MEMORY_TLSF_FL_INDEX_COUNT (MEMORY_TLSF_FL_INDEX_MAX - MEMORY_TLSF_FL_INDEX_SHIFT + 1)
+#define MEMORY_TLSF_SMALL_BLOCK_SIZE ((u64)1 << MEMORY_TLSF_FL_INDEX_SHIFT)
+#define MEMORY_TLSF_MAX_BLOCK_SIZE ((u64)1 << MEMORY_TLSF_FL_INDEX_MAX)
+#define MEMORY_TLSF_NULL_BYTE_OFFSET ((p32)0)
+
+#define MEMORY_FRAME_ARENA_ALIGN_SIZE ((u64)16)
+#define MEMORY_STACK_ALIGN_SIZE ((u64)16)
+
+// managed allocations up to this size (at most 256 bytes) skip the allocator header: they take a slot of a 
+// slab, one regular allocation carved into equal sized slots with a free bitmap, shared by a size class. 
+// Define it to 0 to give every allocation a header of its own.
+#if !defined(MEMORY_SLAB_MAX_BYTE_SIZE)
+    #define MEMORY_SLAB_MAX_BYTE_SIZE ((u64)256)
+#endif
+
+#define MEMORY_SLAB_ID ((u16)0x51AB)
+// slab allocators (header included) are aligned to their size, so a slot pointer finds its slab by masking
+#define MEMORY_SLAB_BYTE_SIZE ((u64)4096)
+#define MEMORY_SLAB_SLOTS_BYTE_OFFSET ((u64)128)
+#define MEMORY_SLAB_CLASS_COUNT 10
+#define MEMORY_SLAB_BITMAP_WORD_COUNT ((((MEMORY_SLAB_BYTE_SIZE - MEMORY_SLAB_SLOTS_BYTE_OFFSET)/MEMORY_TLSF_ALIGN_SIZE) + 63)/64)
+
+// context heaps reserve address space up front and commit it in steps of this size as the regions grow
+#define MEMORY_HEAP_COMMIT_GRANULARITY ((u64)1024*64)
+#define MEMORY_HEAP_HUGE_PAGE_SIZE ((u64)1024*1024*2)
+// contexts at least this large are backed by huge pages (transparent, or MAP_HUGETLB with MEMORY_USE_HUGETLB)
+#define MEMORY_HEAP_HUGE_PAGE_THRESHOLD ((u64)1024*1024*64)
+
 struct memory_raw_allocator
 {
     u16 identifier;
     const struct memory_allocation_key allocKey;
     u64 byteSize;
+    u64 mappedByteSize; // size of the allocator's own mapping; 0 when it came from malloc
 };
 
-struct memory_raw_allocation
-{
-    struct memory_raw_allocator *allocatorPtr;
-    u16 prevAllocationIndex;
-    u16 nextAllocationIndex;
-};
+// raw allocations at least this large get a mapping of their own, so growing one is an mremap: the kernel 
+// extends it in place, or moves the page tables, but never copies the data
+#define MEMORY_RAW_MAP_THRESHOLD ((u64)1024*1024)
 
-struct memory_raw_allocation_info
+// raw allocations are found by index, like managed ones by their allocation info: a slot holds the allocator, 
+// and a generation that is bumped when it's freed, so a stale key fails a single compare
+#define MEMORY_RAW_ALLOCATION_TABLE_INITIAL_CAPACITY 64
+
+struct memory_raw_allocation_slot
 {
-    u16 rawAllocationIndex;
-    b32 isActive;
+    struct memory_raw_allocator *allocatorPtr; // NULL while the slot is free
+    memory_int_id generation;
+    u32 nextFreeSlotId; // slot index + 1; 0 ends the free list
 };
 
-struct memory_raw_allocation_info_map_branch_info
+struct memory_raw_allocation_table
 {
-    u16 branchCount;
-    u16 branchCapacity;
+    struct memory_raw_allocation_slot *slotArr;
+    u32 slotCapacity;
+    u32 slotCount; // slots handed out at least once; the free list only holds slots below it
+    u32 count;
+    u32 freeSlotListHeadId; // slot index + 1; 0 when no slot is free
 };
 
 struct memory_allocator
@@ -49,21 +108,63 @@ struct memory_allocator
     u64 byteSize;
     p64 prevAllocatorByteOffset;
     p64 nextAllocatorByteOffset;
+    // allocators tile the page heap back to back; the physical successor is found from byteSize
+    p64 prevPhysicalAllocatorByteOffset;
+};
+
+// sits at the start of a slab's payload; the slots follow at MEMORY_SLAB_SLOTS_BYTE_OFFSET
+struct memory_slab
+{
+    u16 identifier;
+    u8 classIndex;
+    u16 slotCount;
+    u16 freeSlotCount;
+    u32 slotByteSize;
+    u32 allocInfoIndex; // the slab's own allocation
+    // slabs of the same class with a free slot (allocator byte offsets; NULL terminated, not circular)
+    p64 prevSlabByteOffset;
+    p64 nextSlabByteOffset;
+    u64 freeSlotBitmapArr[MEMORY_SLAB_BITMAP_WORD_COUNT]; // set bit: free slot
+};
+
+static const u32 g_MEMORY_SLAB_SLOT_BYTE_SIZE_ARR[MEMORY_SLAB_CLASS_COUNT] = {
+    8, 16, 24, 32, 48, 64, 96, 128, 192, 256
+};
+
+// size class of a byteSize, indexed by (byteSize/8 - 1)
+static const u8 g_MEMORY_SLAB_CLASS_INDEX_ARR[256/MEMORY_TLSF_ALIGN_SIZE] = {
+    0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 
+    8, 8, 8, 8, 8, 8, 8, 8, 9, 9, 9, 9, 9, 9, 9, 9
 };
 
 struct memory_allocation_info
 {
     memory_short_id pageId;
-    memory_int_id allocationId;
-    p64 labelStrByteOffset;
+    // bumped on release, and when a thread cache parks the allocation, which it does without the context lock
+    _Atomic memory_int_id generation;
+    // newest generation handed out before a restore brought back an older one; the next bump skips past it
+    memory_int_id restoredGenerationFloor;
+    memory_short_id labelId; // debug contexts only; index + 1 into the context's interned label table
+    u8 alignmentLog2; // payload alignment the allocation was made with; compaction and realloc keep it
+    // size class + 1 of a slab slot; slot allocations have no header, so allocatorByteOffset is where one 
+    // would sit (the slot's byte offset, minus an allocator), and mapping stays the same arithmetic
+    u8 slabClassId;
     p64 allocatorByteOffset;
     u32 prevAllocationInfoIndex;
     u32 nextAllocationInfoIndex;
-    b32 isMapped; // TODO: implement; imagine having threads able to 
-                    // operate on particular allocations, and they're safely gated
+    u32 mapCount; // live pointers handed out by memory_map_alloc (debug builds or gated) or held by a pool; 
+                    // compaction never moves an allocation while it's mapped
+    _Atomic u32 mapGate; // memory_map_alloc_gated holders; see MEMORY_MAP_GATE_*
     b32 isActive;
+    b32 isSlab; // the slab's own allocation; a slab header in a payload can be stale bytes, this can't
 };
 
+// a gate is a reader count with two flag bits on top. A waiting writer raises the pending bit, which turns new 
+// readers away until it gets in, so a steady stream of readers can't starve it
+#define MEMORY_MAP_GATE_EXCLUSIVE ((u32)1 << 31)
+#define MEMORY_MAP_GATE_EXCLUSIVE_PENDING ((u32)1 << 30)
+#define MEMORY_MAP_GATE_SHARED_COUNT_MASK (MEMORY_MAP_GATE_EXCLUSIVE_PENDING - 1)
+
 struct memory_page_header
 {
     u16 identifier;
@@ -73,9 +174,20 @@ struct memory_page_header
     u32 activeAllocatorCount;
     p64 activeAllocatorByteOffsetList;
     u32 freeAllocatorCount;
-    p64 freeAllocatorByteOffsetList;
+    u32 tlsfFirstLevelBitmap;
+    u32 tlsfSecondLevelBitmapArr[MEMORY_TLSF_FL_INDEX_COUNT];
+    // free allocator list heads (byte offsets from the page header; NULL terminated, not circular)
+    p32 tlsfFreeAllocatorByteOffsetTable[MEMORY_TLSF_FL_INDEX_COUNT][MEMORY_TLSF_SL_INDEX_COUNT];
+    // every allocator below this offset is packed (no free allocator in between)
+    p64 compactionCursorByteOffset;
+    // default payload alignment for allocations on this page (memory_page_set_alignment)
+    u8 alignmentLog2;
+    // per size class, the slabs with a free slot
+    p64 slabByteOffsetArr[MEMORY_SLAB_CLASS_COUNT];
     p64 prevPageHeaderByteOffset;
     p64 nextPageHeaderByteOffset;
+    u64 liveByteCount;
+    u64 highWaterByteCount;
 };
 
 // (pageId, allocationKey) -->
@@ -87,6 +199,27 @@ struct memory_page_info
 {
     u64 pageHeaderByteOffset;
     enum memory_page_status_t status;
+    memory_int_id generation;
+    memory_short_id nextFreePageId;
+};
+
+// running counters only, so the alloc/free paths pay a few adds; fragmentation and histograms are 
+// computed from the free lists when they are asked for
+struct memory_context_stats
+{
+    u64 liveByteCount;
+    u64 highWaterByteCount;
+    u64 allocCount;
+    u64 freeCount;
+    u64 frameIndex;
+    u32 frameAllocCount;
+    u32 frameFreeCount;
+    u32 lastFrameAllocCount;
+    u32 lastFrameFreeCount;
+    u32 peakFrameAllocCount;
+    u32 peakFrameFreeCount;
+    u64 mapContendedCount;
+    u64 mapContendedWaitNS;
 };
 
 struct memory_context
@@ -100,6 +233,8 @@ struct memory_context
     struct memory_page_info *pagesRegionInfoArr;
     u16 pagesRegionInfoCount;
     u16 pagesRegionInfoCapacity;
+    memory_short_id pagesRegionInfoFreeListHeadId;
+    u16 pagesRegionReorderInfoIndex;
     p64 activePagesByteOffsetList;
     p64 freePagesByteOffsetList;
     u16 pagesRegionActiveCount;
@@ -108,10 +243,23 @@ struct memory_context
     u32 pagesRegionFreeAllocationInfoCount;
     p64 pagesRegionFreeAllocationInfoByteOffsetList;
     u64 reservedHeapBytes;
+    u64 allocationInfoRegionCommittedBytes;
+    u64 pagesRegionCommittedBytes;
+    u64 heapCommitGranularity;
     u8 *heap;
+    struct memory_context_stats stats;
+    b32 isHeapVirtual;
     b32 isDebug;
 };
 
+// one per distinct label string; the string itself lives in the label region
+struct memory_label_entry
+{
+    utils_hash hash;
+    p64 labelStrByteOffset;
+    u32 activeAllocationCount;
+};
+
 struct memory_debug_context
 {
     struct memory_context _;
@@ -120,46 +268,69 @@ struct memory_debug_context
     p64 labelRegionByteOffset;
     u64 labelRegionByteCapacity;
     p64 labelRegionNextAllocationByteOffset;
-    u32 eventQueueReadIndex;
-    u32 eventQueueWriteIndex;
-    u32 eventQueueCapacity;
+    u64 labelRegionCommittedBytes;
+    // interned labels: entries by label id - 1, plus a linear probing table of label ids keyed by hash
+    struct memory_label_entry *labelEntryArr;
+    memory_short_id *labelSlotArr;
+    u32 labelSlotCapacity;
+    u16 labelCount;
+    struct memory_event_queue *eventQueuePtr;
 };
 
+// fixed layout, since it is also the record format of the binary trace file
 struct memory_event
 {
-    memory_id eventId;
-    enum memory_event_type type;
-    u32 elapsedMS;
+    u64 eventId;
+    u64 timestampNS;
+    memory_handle allocHandle;
+    u64 byteSize;
+    p64 byteOffset; // allocator byte offset into its page, or the page header byte offset for page events
+    u16 contextId;
+    memory_short_id pageId;
+    u8 type;
+    u8 _reserved[3];
+};
+
+// a slot is published once its sequence is eventId + 1; the reader rejects anything else
+struct memory_event_slot
+{
+    _Atomic u64 sequence;
+    struct memory_event event;
+};
 
-    union
-    {
-        struct
-        {
-            memory_id userSectionId;
-            memory_id allocId;
-            u64 allocSize;
-            u64 allocByteOffset;
-        } as_alloc;
-        
-        struct
-        {
-            memory_id userSectionId;
-            memory_id allocId;
-            u64 allocSize;
-            u64 allocByteOffset;
-        } as_free;
-    };
+#define MEMORY_EVENT_TRACE_MAGIC "MEMTRACE"
+#define MEMORY_EVENT_TRACE_VERSION ((u32)1)
+#define MEMORY_EVENT_WRITER_INTERVAL_NS ((u64)1000*1000)
+
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+typedef HANDLE memory_thread;
+#elif defined(linux) || defined(__linux__)
+typedef pthread_t memory_thread;
+#endif
+
+// its own allocation, since the writer thread holds on to it while the debug context array may be reallocated
+struct memory_event_queue
+{
+    struct memory_event_slot *slotArr;
+    FILE *traceFilePtr;
+    u64 readIndex; // writer thread only, until it is joined
+    _Atomic u64 writeIndex;
+    u64 droppedCount;
+    u32 capacity;
+    _Atomic b32 isStopping;
+    memory_error_code writeResultCode;
+    memory_thread writerThread;
+};
+
+struct memory_event_trace_header
+{
+    char magic[8];
+    u32 version;
+    u32 eventByteSize;
+    u64 startTimestampNS;
 };
 
-static struct memory_raw_allocation *g_MEMORY_RAW_ALLOCATION_ARR;
-static u16 g_MEMORY_RAW_ALLOCATION_CAPACITY;
-static u16 g_MEMORY_RAW_ALLOCATION_ARR_ACTIVE_LIST_HEAD_INDEX;
-static u16 g_MEMORY_RAW_ALLOCATION_ACTIVE_LIST_COUNT;
-static u16 g_MEMORY_RAW_ALLOCATION_ARR_FREE_LIST_HEAD_INDEX;
-static u16 g_MEMORY_RAW_ALLOCATION_FREE_LIST_COUNT;
-static struct memory_raw_allocation_info **g_MEMORY_RAW_ALLOCATION_INFO_MAP;
-static struct memory_raw_allocation_info_map_branch_info *g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE;
-static u16 g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT;
+static struct memory_raw_allocation_table g_MEMORY_RAW_ALLOCATION_TABLE;
 static struct memory_debug_context *g_DEBUG_CONTEXT_ARR;
 static struct memory_context *g_CONTEXT_ARR;
 static u16 g_DEBUG_CONTEXT_CAPACITY;
@@ -168,2330 +339,6971 @@ static struct memory_debug_context *g_DEBUG_CONTEXT_ARR;
 static u16 g_CONTEXT_CAPACITY;
 static u16 g_CONTEXT_COUNT;
 
-static memory_error_code
-_memory_generate_unique_byte_id(memory_byte_id *outResult)
+// contexts are guarded by recursive spin locks, striped by context key. They live apart from the contexts, 
+// since the context arrays move when a context is created, and memory_context_restore overwrites a context 
+// wholesale. Being recursive, a locked entry point can call another one (a pool allocates its slots with 
+// memory_alloc_aligned).
+#define MEMORY_CONTEXT_LOCK_COUNT 64
+#define MEMORY_LOCK_SPIN_COUNT 64
+
+struct memory_lock
 {
-    assert(outResult);
+    _Atomic p64 ownerThreadId;
+    u32 depth; // only touched by the owner
+    // bumped whenever blocks held by thread caches may have gone stale (a page freed or realigned, or the 
+    // context restored), so the caches check one counter instead of every block
+    _Atomic u32 pageEpoch;
+    u8 _reserved[48]; // a cache line per lock
+};
 
-    memory_error_code errorResult;
+static struct memory_lock g_MEMORY_CONTEXT_LOCK_ARR[MEMORY_CONTEXT_LOCK_COUNT];
+static struct memory_lock g_MEMORY_RAW_LOCK;
+// its address tells threads apart
+static _Thread_local u8 g_MEMORY_THREAD_ID_ANCHOR;
+// locks the thread holds, counting recursion
+static _Thread_local u32 g_MEMORY_THREAD_LOCK_DEPTH;
+
+// each thread keeps the slab slots it frees (plus a batch taken ahead when it allocates) of a few pages, by size 
+// class, and hands them out again without taking the context lock; blocks go back to their page in batches. 
+// Debug contexts aren't cached, since they label, trace and validate every allocation. A parked block is still 
+// an allocation as far as its page and the diagnostics are concerned.
+#define MEMORY_THREAD_CACHE_PAGE_COUNT 4
+#define MEMORY_THREAD_CACHE_BIN_CAPACITY 32
+#define MEMORY_THREAD_CACHE_BATCH_COUNT 16
+
+struct memory_thread_cache_block
+{
+    u32 allocInfoIndex;
+    memory_int_id generation;
+};
 
-    if ((utils_get_is_random_seed_set()))
-    {
-        real64 resultRandomNumber;
+struct memory_thread_cache_bin
+{
+    u32 blockCount;
+    struct memory_thread_cache_block blockArr[MEMORY_THREAD_CACHE_BIN_CAPACITY];
+};
 
-        if (utils_generate_random_positive_normalized_real64(&resultRandomNumber))
-        {
-            *outResult = (memory_byte_id)(round(resultRandomNumber*(UINT8_MAX - 1))) + 1;
-            errorResult = MEMORY_OK;
-        }
-        else 
-        {
-            *outResult = MEMORY_BYTE_ID_NULL;
-            errorResult = MEMORY_ERROR_RANDOM_NOT_SEEDED;
-        }
+struct memory_thread_cache_page
+{
+    memory_short_id contextId; // NULL when the entry is unused
+    memory_short_id pageId;
+    memory_int_id pageGeneration;
+    u32 pageEpoch;
+    // allocation infos the context had at the last locked visit; a key past them takes the locked path, so the 
+    // cache never reads the growing end of the info region without the lock
+    u32 allocInfoCount;
+    // stats of the blocks handed out of, or parked in, the cache since its last locked visit, which moves them into 
+    // the context (see _memory_thread_cache_settle_stats). A parked block counts as freed
+    u32 pendingAllocCount;
+    u32 pendingFreeCount;
+    u64 pendingAllocByteCount;
+    u64 pendingFreeByteCount;
+    struct memory_thread_cache_bin binArr[MEMORY_SLAB_CLASS_COUNT];
+};
+
+static _Thread_local struct memory_thread_cache_page g_MEMORY_THREAD_CACHE_PAGE_ARR[MEMORY_THREAD_CACHE_PAGE_COUNT];
+static _Thread_local u32 g_MEMORY_THREAD_CACHE_EVICT_INDEX;
+
+static u32
+_memory_find_first_set_bit_u32(u32 value)
+{
+    assert(value);
+
+#if defined(_MSC_VER)
+    unsigned long bitIndex;
+    _BitScanForward(&bitIndex, value);
+
+    return (u32)bitIndex;
+#else
+    return (u32)__builtin_ctz(value);
+#endif
+}
+
+static u32
+_memory_find_first_set_bit_u64(u64 value)
+{
+    assert(value);
+
+#if defined(_MSC_VER)
+    unsigned long bitIndex;
+    _BitScanForward64(&bitIndex, value);
+
+    return (u32)bitIndex;
+#else
+    return (u32)__builtin_ctzll(value);
+#endif
+}
+
+static u32
+_memory_find_last_set_bit_u64(u64 value)
+{
+    assert(value);
+
+#if defined(_MSC_VER)
+    unsigned long bitIndex;
+    _BitScanReverse64(&bitIndex, value);
+
+    return (u32)bitIndex;
+#else
+    return (u32)(63 - __builtin_clzll(value));
+#endif
+}
+
+static void
+_memory_yield_thread(void)
+{
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+    SwitchToThread();
+#elif defined(linux) || defined(__linux__)
+    sched_yield();
+#endif
+}
+
+static void
+_memory_sleep_ns(u64 durationNS)
+{
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+    Sleep((DWORD)((durationNS + 999999)/1000000));
+#elif defined(linux) || defined(__linux__)
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(durationNS/1000000000ull);
+    ts.tv_nsec = (long)(durationNS%1000000000ull);
+
+    nanosleep(&ts, NULL);
+#endif
+}
+
+// busy-waits a little, then gives the core up
+static void
+_memory_wait_spin(u32 spinCount)
+{
+    if (spinCount < MEMORY_LOCK_SPIN_COUNT)
+    {
+#if defined(MEMORY_USE_SSE2)
+        _mm_pause();
+#endif
     }
-    else
+    else 
     {
-        *outResult = MEMORY_BYTE_ID_NULL;
-        errorResult = MEMORY_ERROR_RANDOM_NOT_SEEDED;
+        _memory_yield_thread();
     }
-
-   return errorResult;
 }
 
-static memory_error_code
-_memory_generate_unique_short_id(memory_short_id *outResult)
+// a NULL lock is a no-op, so entry points can lock whatever their (possibly NULL) key resolves to, and leave 
+// the argument checks to the locked body
+static void
+_memory_lock_acquire(struct memory_lock *lockPtr)
 {
-    assert(outResult);
+    if (!lockPtr)
+    {
+        return;
+    }
+
+    p64 threadId = (p64)&g_MEMORY_THREAD_ID_ANCHOR;
 
-    memory_error_code errorResult;
+    ++g_MEMORY_THREAD_LOCK_DEPTH;
 
-    if ((utils_get_is_random_seed_set()))
+    if (atomic_load_explicit(&lockPtr->ownerThreadId, memory_order_relaxed) == threadId)
     {
-        real64 resultRandomNumber;
-        
-        if (utils_generate_random_positive_normalized_real64(&resultRandomNumber))
-        {
-            *outResult = (memory_short_id)(round(resultRandomNumber*(UINT16_MAX - 1))) + 1;
-            errorResult = MEMORY_OK;
-        }
-        else 
+        ++lockPtr->depth;
+
+        return;
+    }
+
+    for (u32 spinCount = 0;; ++spinCount)
+    {
+        p64 expectedThreadId = 0;
+
+        if ((atomic_load_explicit(&lockPtr->ownerThreadId, memory_order_relaxed) == 0) && 
+            atomic_compare_exchange_weak_explicit(&lockPtr->ownerThreadId, &expectedThreadId, threadId, 
+            memory_order_acquire, memory_order_relaxed))
         {
-            *outResult = MEMORY_SHORT_ID_NULL;
-            errorResult = MEMORY_ERROR_RANDOM_NOT_SEEDED;
+            break;
         }
+
+        _memory_wait_spin(spinCount);
     }
-    else
+
+    lockPtr->depth = 1;
+}
+
+static void
+_memory_lock_release(struct memory_lock *lockPtr)
+{
+    if (!lockPtr)
     {
-        *outResult = MEMORY_SHORT_ID_NULL;
-        errorResult = MEMORY_ERROR_RANDOM_NOT_SEEDED;
+        return;
     }
 
-   return errorResult;
+    assert(atomic_load_explicit(&lockPtr->ownerThreadId, memory_order_relaxed) == (p64)&g_MEMORY_THREAD_ID_ANCHOR);
+
+    --g_MEMORY_THREAD_LOCK_DEPTH;
+
+    if ((--lockPtr->depth) == 0)
+    {
+        atomic_store_explicit(&lockPtr->ownerThreadId, 0, memory_order_release);
+    }
 }
 
-static memory_error_code
-_memory_generate_unique_int_id(memory_int_id *outResult)
+static struct memory_lock *
+_memory_get_context_lock(const struct memory_context_key *contextKeyPtr)
 {
-    assert(outResult);
-    
-    memory_error_code errorResult;
-
-    if ((utils_get_is_random_seed_set()))
+    if (MEMORY_IS_CONTEXT_NULL(contextKeyPtr))
     {
-        real64 resultRandomNumber;
-        
-        if (utils_generate_random_positive_normalized_real64(&resultRandomNumber))
-        {
-            *outResult = (memory_int_id)(round(resultRandomNumber*(UINT32_MAX - 1))) + 1;
-            errorResult = MEMORY_OK;
-        }
-        else 
-        {
-            *outResult = MEMORY_INT_ID_NULL;
-            errorResult = MEMORY_ERROR_RANDOM_NOT_SEEDED;
-        }
+        return NULL;
     }
-    else
+
+    return &g_MEMORY_CONTEXT_LOCK_ARR[((contextKeyPtr->contextId << 1) | (contextKeyPtr->isDebug ? 1 : 0)) % 
+        MEMORY_CONTEXT_LOCK_COUNT];
+}
+
+static struct memory_lock *
+_memory_get_page_lock(const struct memory_page_key *pageKeyPtr)
+{
+    return pageKeyPtr ? _memory_get_context_lock(&pageKeyPtr->contextKey) : NULL;
+}
+
+static struct memory_lock *
+_memory_get_allocation_lock(const struct memory_allocation_key *allocKeyPtr)
+{
+    if (!allocKeyPtr)
     {
-        *outResult = MEMORY_INT_ID_NULL;
-        errorResult = MEMORY_ERROR_RANDOM_NOT_SEEDED;
+        return NULL;
     }
 
-   return errorResult;
+    return allocKeyPtr->isManaged ? _memory_get_context_lock(&allocKeyPtr->managed.contextKey) : &g_MEMORY_RAW_LOCK;
 }
 
-static memory_error_code
-_memory_generate_unique_id(memory_id *outResult)
+static void
+_memory_bump_page_epoch(const struct memory_context_key *contextKeyPtr)
 {
-    assert(outResult);
-    
-    memory_error_code errorResult;
+    struct memory_lock *lockPtr = _memory_get_context_lock(contextKeyPtr);
 
-    if ((utils_get_is_random_seed_set()))
+    if (lockPtr)
     {
-        u64 resultRandomNumber;
-        
-        if (utils_generate_random_u64(&resultRandomNumber))
-        {
-            *outResult = (resultRandomNumber < MEMORY_ID_MAX) ? (resultRandomNumber + 1) : resultRandomNumber;
-            errorResult = MEMORY_OK;
-        }
-        else 
-        {
-            *outResult = MEMORY_ID_NULL;
-            errorResult = MEMORY_ERROR_RANDOM_NOT_SEEDED;
-        }
+        atomic_fetch_add_explicit(&lockPtr->pageEpoch, 1, memory_order_release);
     }
-    else
+}
+
+static void
+_memory_tlsf_mapping_insert(u64 byteSize, u32 *outFirstLevelIndex, u32 *outSecondLevelIndex)
+{
+#if defined(MEMORY_ALLOC_POLICY_FIRST_FIT)
+    // a single list, whatever the size
+    (void)byteSize;
+
+    *outFirstLevelIndex = 0;
+    *outSecondLevelIndex = 0;
+#else
+    if (byteSize < MEMORY_TLSF_SMALL_BLOCK_SIZE)
     {
-        *outResult = MEMORY_ID_NULL;
-        errorResult = MEMORY_ERROR_RANDOM_NOT_SEEDED;
+        *outFirstLevelIndex = 0;
+        *outSecondLevelIndex = (u32)(byteSize/(MEMORY_TLSF_SMALL_BLOCK_SIZE/MEMORY_TLSF_SL_INDEX_COUNT));
     }
+    else if (byteSize < MEMORY_TLSF_MAX_BLOCK_SIZE)
+    {
+        u32 lastBitIndex = _memory_find_last_set_bit_u64(byteSize);
 
-   return errorResult;
+        *outSecondLevelIndex = (u32)(byteSize >> (lastBitIndex - MEMORY_TLSF_SL_INDEX_COUNT_LOG2)) ^ 
+            (1 << MEMORY_TLSF_SL_INDEX_COUNT_LOG2);
+        *outFirstLevelIndex = lastBitIndex - (MEMORY_TLSF_FL_INDEX_SHIFT - 1);
+    }
+    else 
+    {
+        // anything this large can only ever be handed out by the top class
+        *outFirstLevelIndex = MEMORY_TLSF_FL_INDEX_COUNT - 1;
+        *outSecondLevelIndex = MEMORY_TLSF_SL_INDEX_COUNT - 1;
+    }
+#endif
 }
 
-static memory_error_code
-_memory_alloc_context(struct memory_context **outMemoryContext, b32 isDebug)
+static void
+_memory_tlsf_reset(struct memory_page_header *pageHeaderPtr)
 {
-    if (!outMemoryContext)
+    pageHeaderPtr->freeAllocatorCount = 0;
+    pageHeaderPtr->tlsfFirstLevelBitmap = 0;
+
+    memset(pageHeaderPtr->tlsfSecondLevelBitmapArr, '\0', sizeof(pageHeaderPtr->tlsfSecondLevelBitmapArr));
+    memset(pageHeaderPtr->tlsfFreeAllocatorByteOffsetTable, '\0', 
+        sizeof(pageHeaderPtr->tlsfFreeAllocatorByteOffsetTable));
+}
+
+static void
+_memory_tlsf_insert_free_allocator(struct memory_page_header *pageHeaderPtr, p64 allocatorByteOffset)
+{
+    struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+
+    u32 firstLevelIndex, secondLevelIndex;
+    _memory_tlsf_mapping_insert(allocatorPtr->byteSize, &firstLevelIndex, &secondLevelIndex);
+
+    p32 headAllocatorByteOffset = pageHeaderPtr->tlsfFreeAllocatorByteOffsetTable[firstLevelIndex][secondLevelIndex];
+
+    allocatorPtr->prevAllocatorByteOffset = MEMORY_TLSF_NULL_BYTE_OFFSET;
+    allocatorPtr->nextAllocatorByteOffset = headAllocatorByteOffset;
+
+    if (headAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
     {
-        return MEMORY_ERROR_NULL_ARGUMENT;
+        struct memory_allocator *headAllocatorPtr = (void *)((u8 *)pageHeaderPtr + headAllocatorByteOffset);
+
+        headAllocatorPtr->prevAllocatorByteOffset = allocatorByteOffset;
     }
 
-    #define MEMORY_DEBUG_CONTEXT_ARR_REALLOC_MULTIPLIER 2
+    pageHeaderPtr->tlsfFreeAllocatorByteOffsetTable[firstLevelIndex][secondLevelIndex] = (p32)allocatorByteOffset;
+    pageHeaderPtr->tlsfFirstLevelBitmap |= (1U << firstLevelIndex);
+    pageHeaderPtr->tlsfSecondLevelBitmapArr[firstLevelIndex] |= (1U << secondLevelIndex);
 
-    if (isDebug)
+    ++pageHeaderPtr->freeAllocatorCount;
+}
+
+static void
+_memory_tlsf_remove_free_allocator(struct memory_page_header *pageHeaderPtr, p64 allocatorByteOffset)
+{
+    struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+
+    u32 firstLevelIndex, secondLevelIndex;
+    _memory_tlsf_mapping_insert(allocatorPtr->byteSize, &firstLevelIndex, &secondLevelIndex);
+
+    if (allocatorPtr->prevAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
     {
-        u16 debugContextIndex = g_DEBUG_CONTEXT_COUNT;
+        struct memory_allocator *prevAllocatorPtr = (void *)((u8 *)pageHeaderPtr + 
+            allocatorPtr->prevAllocatorByteOffset);
 
-        if (g_DEBUG_CONTEXT_COUNT == g_DEBUG_CONTEXT_CAPACITY)
+        prevAllocatorPtr->nextAllocatorByteOffset = allocatorPtr->nextAllocatorByteOffset;
+    }
+    else 
+    {
+        pageHeaderPtr->tlsfFreeAllocatorByteOffsetTable[firstLevelIndex][secondLevelIndex] = 
+            (p32)allocatorPtr->nextAllocatorByteOffset;
+
+        if (allocatorPtr->nextAllocatorByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
         {
-            if (g_DEBUG_CONTEXT_CAPACITY > 0)
+            pageHeaderPtr->tlsfSecondLevelBitmapArr[firstLevelIndex] &= ~(1U << secondLevelIndex);
+
+            if (!pageHeaderPtr->tlsfSecondLevelBitmapArr[firstLevelIndex])
             {
-                struct memory_debug_context *reallocatedMemoryContext =
-                    realloc(g_DEBUG_CONTEXT_ARR, sizeof(struct memory_debug_context)*(g_DEBUG_CONTEXT_CAPACITY*
-                        MEMORY_DEBUG_CONTEXT_ARR_REALLOC_MULTIPLIER));
+                pageHeaderPtr->tlsfFirstLevelBitmap &= ~(1U << firstLevelIndex);
+            }
+        }
+    }
 
-                if (reallocatedMemoryContext)
-                {
-                    g_DEBUG_CONTEXT_ARR = reallocatedMemoryContext;
-                    g_DEBUG_CONTEXT_CAPACITY *= MEMORY_DEBUG_CONTEXT_ARR_REALLOC_MULTIPLIER;
-                }
-                else 
-                {
-                    utils_fprintf(stderr, "_memory_alloc_context(%d): Failure to reallocate context array. "
-                            "Cannot allocate new context.\n", __LINE__);
+    if (allocatorPtr->nextAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        struct memory_allocator *nextAllocatorPtr = (void *)((u8 *)pageHeaderPtr + 
+            allocatorPtr->nextAllocatorByteOffset);
 
-                    return MEMORY_ERROR_FAILED_ALLOCATION;
-                }
-            }
-            else 
-            {
-                g_DEBUG_CONTEXT_ARR = malloc(sizeof(struct memory_debug_context));
+        nextAllocatorPtr->prevAllocatorByteOffset = allocatorPtr->prevAllocatorByteOffset;
+    }
 
-                if (g_DEBUG_CONTEXT_ARR)
-                {
-                    ++g_DEBUG_CONTEXT_CAPACITY;
-                }
-                else 
-                {
-                    utils_fprintf(stderr, "_memory_alloc_context(%d): Failure to allocate debug context array. "
-                            "Cannot allocate new debug context.\n", __LINE__);
+    allocatorPtr->prevAllocatorByteOffset = allocatorPtr->nextAllocatorByteOffset = MEMORY_TLSF_NULL_BYTE_OFFSET;
 
-                    return MEMORY_ERROR_FAILED_ALLOCATION;
-                }
-            }
+    --pageHeaderPtr->freeAllocatorCount;
+}
+
+// returns the byte offset of a free allocator holding at least 'byteSize' bytes, or 
+// MEMORY_TLSF_NULL_BYTE_OFFSET. The allocator is not removed from the index.
+static p64
+_memory_tlsf_find_free_allocator(struct memory_page_header *pageHeaderPtr, u64 byteSize)
+{
+#if defined(MEMORY_ALLOC_POLICY_FIRST_FIT)
+    p64 allocatorByteOffset = pageHeaderPtr->tlsfFreeAllocatorByteOffsetTable[0][0];
 
+    while (allocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+
+        if (allocatorPtr->byteSize >= byteSize)
+        {
+            break;
         }
 
-        *outMemoryContext = (struct memory_context *)&g_DEBUG_CONTEXT_ARR[debugContextIndex];
-        ++g_DEBUG_CONTEXT_COUNT;
+        allocatorByteOffset = allocatorPtr->nextAllocatorByteOffset;
     }
-    else 
+
+    return allocatorByteOffset;
+#else
+    // round the request up to the next class boundary, so that any allocator found in the 
+    // resulting class is large enough (good-fit; no list walk)
+    if (byteSize >= MEMORY_TLSF_SMALL_BLOCK_SIZE)
     {
-        #define MEMORY_CONTEXT_ARR_REALLOC_MULTIPLIER 2
+        byteSize += ((u64)1 << (_memory_find_last_set_bit_u64(byteSize) - MEMORY_TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
 
-        u16 contextIndex = g_CONTEXT_COUNT;
+    if (byteSize >= MEMORY_TLSF_MAX_BLOCK_SIZE)
+    {
+        return MEMORY_TLSF_NULL_BYTE_OFFSET;
+    }
 
-        if (g_CONTEXT_COUNT == g_CONTEXT_CAPACITY)
+    u32 firstLevelIndex, secondLevelIndex;
+    _memory_tlsf_mapping_insert(byteSize, &firstLevelIndex, &secondLevelIndex);
+
+    u32 secondLevelBitmap = pageHeaderPtr->tlsfSecondLevelBitmapArr[firstLevelIndex] & (~0U << secondLevelIndex);
+
+    if (!secondLevelBitmap)
+    {
+        if ((firstLevelIndex + 1) >= MEMORY_TLSF_FL_INDEX_COUNT)
         {
-            if (g_CONTEXT_CAPACITY > 0)
-            {
-                struct memory_context *reallocatedMemoryContext =
-                    realloc(g_CONTEXT_ARR, sizeof(struct memory_context)*(g_CONTEXT_CAPACITY*
-                        MEMORY_CONTEXT_ARR_REALLOC_MULTIPLIER));
+            return MEMORY_TLSF_NULL_BYTE_OFFSET;
+        }
 
-                if (reallocatedMemoryContext)
-                {
-                    g_CONTEXT_ARR = reallocatedMemoryContext;
-                    g_CONTEXT_CAPACITY *= MEMORY_CONTEXT_ARR_REALLOC_MULTIPLIER;
-                }
-                else 
-                {
-                    utils_fprintf(stderr, "_memory_alloc_context(%d): Failure to reallocate context array. "
-                            "Cannot allocate new context.\n", __LINE__);
+        u32 firstLevelBitmap = pageHeaderPtr->tlsfFirstLevelBitmap & (~0U << (firstLevelIndex + 1));
 
-                    return MEMORY_ERROR_FAILED_ALLOCATION;
-                }
-            }
-            else 
-            {
-                g_CONTEXT_ARR = malloc(sizeof(struct memory_context));
+        if (!firstLevelBitmap)
+        {
+            return MEMORY_TLSF_NULL_BYTE_OFFSET;
+        }
 
-                if (g_CONTEXT_ARR)
-                {
-                    ++g_CONTEXT_CAPACITY;
-                }
-                else 
-                {
-                    utils_fprintf(stderr, "_memory_alloc_context(%d): Failure to allocate context array. "
-                            "Cannot allocate new context.\n", __LINE__);
+        firstLevelIndex = _memory_find_first_set_bit_u32(firstLevelBitmap);
+        secondLevelBitmap = pageHeaderPtr->tlsfSecondLevelBitmapArr[firstLevelIndex];
+    }
 
-                    return MEMORY_ERROR_FAILED_ALLOCATION;
-                }
-            }
-        }
+    secondLevelIndex = _memory_find_first_set_bit_u32(secondLevelBitmap);
 
-        *outMemoryContext = (struct memory_context *)&g_CONTEXT_ARR[contextIndex];
-        ++g_CONTEXT_COUNT;
+    return pageHeaderPtr->tlsfFreeAllocatorByteOffsetTable[firstLevelIndex][secondLevelIndex];
+#endif
+}
+
+#define MEMORY_IS_ALLOCATOR_FREE(allocatorPtr) (MEMORY_IS_ALLOCATION_NULL((&(allocatorPtr)->allocationKey)))
+
+static p64
+_memory_get_next_physical_allocator_byte_offset(struct memory_page_header *pageHeaderPtr, p64 allocatorByteOffset)
+{
+    struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+    p64 nextAllocatorByteOffset = allocatorByteOffset + sizeof(struct memory_allocator) + allocatorPtr->byteSize;
+
+    if (nextAllocatorByteOffset >= (sizeof(struct memory_page_header) + pageHeaderPtr->heapByteSize))
+    {
+        return MEMORY_TLSF_NULL_BYTE_OFFSET;
     }
-    
-    return MEMORY_OK;
+
+    return nextAllocatorByteOffset;
 }
 
-memory_error_code
-_memory_get_context(struct memory_context_key *contextKeyPtr, struct memory_context **outContextPtr)
+// merges a free allocator with its free physical neighbours and files the result into the TLSF lists
+static p64
+_memory_release_free_allocator(struct memory_page_header *pageHeaderPtr, p64 allocatorByteOffset)
 {
-    if (!contextKeyPtr)
+    struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+    p64 nextAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, allocatorByteOffset);
+
+    if (nextAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
     {
-        utils_fprintf(stderr, "_memory_get_context(%d): 'memoryContextKeyPtr' parameter is NULL. "
-                "Cannot find context.\n", __LINE__);
+        struct memory_allocator *nextAllocatorPtr = (void *)((u8 *)pageHeaderPtr + nextAllocatorByteOffset);
 
-        if (outContextPtr)
+        if ((MEMORY_IS_ALLOCATOR_FREE(nextAllocatorPtr)))
         {
-            *outContextPtr = NULL;
+            _memory_tlsf_remove_free_allocator(pageHeaderPtr, nextAllocatorByteOffset);
+
+            allocatorPtr->byteSize += sizeof(struct memory_allocator) + nextAllocatorPtr->byteSize;
         }
-                
-        return MEMORY_ERROR_NULL_ARGUMENT;
-    }
-    
-    if (!outContextPtr)
-    {
-        utils_fprintf(stderr, "_memory_get_context(%d): Output parameter is NULL. "
-                "Cannot get context.\n", __LINE__);
-                
-        return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
-    struct memory_context *contextPtr;
+    if (allocatorPtr->prevPhysicalAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
     {
-        memory_error_code contextSearchResultCode;
-        
-        if (!contextKeyPtr->isDebug)
-        {
-            if (contextKeyPtr->contextId > 0)
-            {
-                u16 contextIndex = contextKeyPtr->contextId - 1;
-                
-                if (contextIndex < g_CONTEXT_COUNT)
-                {
-                    contextPtr = &g_CONTEXT_ARR[contextKeyPtr->contextId - 1];
-                    contextSearchResultCode = MEMORY_OK;
-                }
-                else 
-                {
-                    contextSearchResultCode = MEMORY_ERROR_INDEX_OUT_OF_RANGE;
-                }
-            }
-            else 
-            {
-                contextSearchResultCode = MEMORY_ERROR_NULL_ID;
-            }
-        }
-        else 
-        {
-            if (contextKeyPtr->contextId > 0)
-            {
-                u16 contextIndex = contextKeyPtr->contextId - 1;
-                
-                if (contextIndex < g_DEBUG_CONTEXT_COUNT)
-                {
-                    contextPtr = (struct memory_context *)&g_DEBUG_CONTEXT_ARR[contextKeyPtr->contextId - 1];
-                    contextSearchResultCode = MEMORY_OK;
-                }
-                else 
-                {
-                    contextSearchResultCode = MEMORY_ERROR_INDEX_OUT_OF_RANGE;
-                }
-            }
-            else 
-            {
-                contextSearchResultCode = MEMORY_ERROR_NULL_ID;
-            }
-        }
-        
-        if (contextSearchResultCode != MEMORY_OK)
+        p64 prevAllocatorByteOffset = allocatorPtr->prevPhysicalAllocatorByteOffset;
+        struct memory_allocator *prevAllocatorPtr = (void *)((u8 *)pageHeaderPtr + prevAllocatorByteOffset);
+
+        if ((MEMORY_IS_ALLOCATOR_FREE(prevAllocatorPtr)))
         {
-            *outContextPtr = NULL;
-            
-            utils_fprintf(stderr, "memory_alloc_page(%d): Failure to identiy memory context from key. "
-                    "Cannot allocate a page.\n", __LINE__);
-                    
-            return contextSearchResultCode;
+            _memory_tlsf_remove_free_allocator(pageHeaderPtr, prevAllocatorByteOffset);
+
+            prevAllocatorPtr->byteSize += sizeof(struct memory_allocator) + allocatorPtr->byteSize;
+
+            allocatorByteOffset = prevAllocatorByteOffset;
+            allocatorPtr = prevAllocatorPtr;
         }
     }
 
-    *outContextPtr = contextPtr;
-    
-    return MEMORY_OK;
-}
+    nextAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, allocatorByteOffset);
 
-memory_error_code
-_memory_get_context_key_is_ok(const struct memory_context_key *contextKeyPtr)
-{
-    if (!contextKeyPtr)
+    if (nextAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
     {
-        return MEMORY_ERROR_NULL_ARGUMENT;
+        ((struct memory_allocator *)((u8 *)pageHeaderPtr + nextAllocatorByteOffset))->prevPhysicalAllocatorByteOffset = 
+            allocatorByteOffset;
     }
 
-    if (contextKeyPtr->contextId == MEMORY_SHORT_ID_NULL)
+    if (allocatorByteOffset < pageHeaderPtr->compactionCursorByteOffset)
     {
-        return MEMORY_ERROR_NULL_ID;
+        pageHeaderPtr->compactionCursorByteOffset = allocatorByteOffset;
     }
 
-    return MEMORY_OK;
+    _memory_tlsf_insert_free_allocator(pageHeaderPtr, allocatorByteOffset);
+
+    return allocatorByteOffset;
 }
 
-memory_error_code
-_memory_get_page_key_is_ok(const struct memory_page_key *pageKeyPtr)
+// worst case a free allocator has to hold for 'byteSize' bytes at 'alignment': the payload can be up to 
+// alignment - 1 bytes off, and a leading gap has to be large enough to become a free allocator of its own
+static u64
+_memory_get_aligned_search_byte_size(u64 byteSize, u64 alignment)
 {
-    if (!pageKeyPtr)
+    if (alignment <= MEMORY_TLSF_ALIGN_SIZE)
     {
-        return MEMORY_ERROR_NULL_ARGUMENT;
+        return byteSize;
     }
 
-    if (pageKeyPtr->pageId == MEMORY_SHORT_ID_NULL)
-    {
-        return MEMORY_ERROR_NULL_ID;
-    }
+    return byteSize + alignment + sizeof(struct memory_allocator) + MEMORY_TLSF_ALIGN_SIZE;
+}
 
-    if ((_memory_get_context_key_is_ok(&pageKeyPtr->contextKey)) != MEMORY_OK)
+// moves the payload of a free allocator (already taken out of the TLSF lists) up to 'alignment' by splitting 
+// the bytes in front of it off into a free allocator. alignment is by address, since pages are only 
+// MEMORY_TLSF_ALIGN_SIZE aligned within the heap; the payload lands 'alignedByteOffset' bytes past the boundary 
+// (0, but for slabs, which align their header). returns the byte offset of the aligned allocator.
+static p64
+_memory_split_allocator_alignment_gap(struct memory_page_header *pageHeaderPtr, p64 allocatorByteOffset, 
+    u64 alignment, p64 alignedByteOffset)
+{
+    if (alignment <= MEMORY_TLSF_ALIGN_SIZE)
     {
-        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+        return allocatorByteOffset;
     }
 
-    return MEMORY_OK;
-}
+    struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+    p64 payloadAddress = (p64)allocatorPtr + sizeof(struct memory_allocator) - alignedByteOffset;
+    u64 gapByteSize = ((payloadAddress + (alignment - 1)) & ~(alignment - 1)) - payloadAddress;
 
-memory_error_code
-_memory_get_is_raw_allocation_operation_ok()
-{
-    if ((g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT > 0) && (!g_MEMORY_RAW_ALLOCATION_INFO_MAP))
+    while (gapByteSize && (gapByteSize < (sizeof(struct memory_allocator) + MEMORY_TLSF_ALIGN_SIZE)))
     {
-        return MEMORY_ERROR_UNKNOWN;
+        gapByteSize += alignment;
     }
 
-    if ((g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT < 1) && (g_MEMORY_RAW_ALLOCATION_INFO_MAP))
+    if (!gapByteSize)
     {
-        return MEMORY_ERROR_UNKNOWN;
+        return allocatorByteOffset;
     }
 
-    if (g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT < 1)
-    {
-        u64 bucketCount = utils_generate_next_prime_number(100);
+    p64 alignedAllocatorByteOffset = allocatorByteOffset + gapByteSize;
+    struct memory_allocator *alignedAllocatorPtr = (void *)((u8 *)pageHeaderPtr + alignedAllocatorByteOffset);
 
-        g_MEMORY_RAW_ALLOCATION_INFO_MAP = malloc(sizeof(struct memory_raw_allocation_info *)*
-            (g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT = bucketCount));
-            
-        g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE = calloc(
-            sizeof(struct memory_raw_allocation_info_map_branch_info), 
-            g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT);
+    alignedAllocatorPtr->identifier = MEMORY_HEADER_ID;
+    alignedAllocatorPtr->byteSize = allocatorPtr->byteSize - gapByteSize;
+    alignedAllocatorPtr->prevPhysicalAllocatorByteOffset = allocatorByteOffset;
+
+    memory_get_null_allocation_key(&alignedAllocatorPtr->allocationKey);
+
+    allocatorPtr->byteSize = gapByteSize - sizeof(struct memory_allocator);
+
+    p64 nextAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, 
+        alignedAllocatorByteOffset);
 
-        memset(g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE, '\0', 
-            sizeof(struct memory_raw_allocation_info_map_branch_info)*g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT);
+    if (nextAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        ((struct memory_allocator *)((u8 *)pageHeaderPtr + nextAllocatorByteOffset))->prevPhysicalAllocatorByteOffset = 
+            alignedAllocatorByteOffset;
     }
 
-    return MEMORY_OK;
+    // the allocator was free, so the one in front of the gap is not; the aligned allocator is about to be taken
+    _memory_tlsf_insert_free_allocator(pageHeaderPtr, allocatorByteOffset);
+
+    return alignedAllocatorByteOffset;
 }
 
-memory_error_code
-memory_raw_alloc(u64 byteSize, const struct memory_allocation_key *outRawAllocKeyPtr)
+// carves everything past byteSize off an allocator as a new free allocator, if the tail can hold one. the 
+// allocator itself may not be marked active yet, so the tail only merges forward.
+static void
+_memory_split_allocator(struct memory_page_header *pageHeaderPtr, p64 allocatorByteOffset, u64 byteSize)
 {
-    u16 rawAllocationCount = g_MEMORY_RAW_ALLOCATION_ACTIVE_LIST_COUNT + g_MEMORY_RAW_ALLOCATION_FREE_LIST_COUNT;
-    {
-        b32 isOutNull = (!outRawAllocKeyPtr);
-        b32 isByteSizeLessThanOne = (byteSize < 1);
-        b32 isRawAllocsUnderMaxCount = (rawAllocationCount < MEMORY_MAX_RAW_ALLOCS);
-        
-        if (!isOutNull || isByteSizeLessThanOne || !isRawAllocsUnderMaxCount)
-        {
-            memory_error_code resultCode;
+    struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
 
-            if (!isOutNull)
-            {
-                utils_fprintf(stderr, "memory_alloc_raw_heap(%d): 'outRawAllocId' "
-                    "parameter cannot be NULL.\n", __LINE__);
+    if ((allocatorPtr->byteSize <= byteSize) || ((allocatorPtr->byteSize - byteSize) <= sizeof(struct memory_allocator)))
+    {
+        return;
+    }
 
-                resultCode = MEMORY_ERROR_NULL_ARGUMENT;
-            }
-            
-            if (byteSize < 1)
-            {
-                utils_fprintf(stderr, "memory_alloc_raw_heap(%d): ByteSize less than 1. "
-                    "Failure to allocate.\n", __LINE__);
-                
-                resultCode = MEMORY_ERROR_ZERO_PARAMETER;
-            }
+    p64 splitAllocatorByteOffset = allocatorByteOffset + sizeof(struct memory_allocator) + byteSize;
+    struct memory_allocator *splitAllocatorPtr = (void *)((u8 *)pageHeaderPtr + splitAllocatorByteOffset);
 
-            if (!isRawAllocsUnderMaxCount)
-            {
-                utils_fprintf(stderr, "memory_alloc_raw_heap(%d): Too many raw allocations. "
-                    "Cannot reserve memory.\n", __LINE__);
+    splitAllocatorPtr->identifier = MEMORY_HEADER_ID;
+    splitAllocatorPtr->byteSize = allocatorPtr->byteSize - byteSize - sizeof(struct memory_allocator);
+    splitAllocatorPtr->prevPhysicalAllocatorByteOffset = allocatorByteOffset;
 
-                resultCode = MEMORY_ERROR_FAILED_ALLOCATION;
-            }
+    memory_get_null_allocation_key(&splitAllocatorPtr->allocationKey);
 
-            return resultCode;
-        }
-    }
-    
-    {
-        memory_error_code resultCode;
+    allocatorPtr->byteSize = byteSize;
 
-        if ((resultCode = _memory_get_is_raw_allocation_operation_ok()) != MEMORY_OK)
-        {
-            memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
-            
-            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Cannot raw allocate!\n", 
-                __FUNCTION__, __LINE__, (u32)errorCode);
-            
-            return errorCode;
-        }
-    }
+    p64 nextAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, 
+        splitAllocatorByteOffset);
 
-    memory_short_id rawAllocationId;
+    if (nextAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
     {
-        memory_error_code genMemoryIdResultCode = _memory_generate_unique_short_id(&rawAllocationId);
+        struct memory_allocator *nextAllocatorPtr = (void *)((u8 *)pageHeaderPtr + nextAllocatorByteOffset);
 
-        if (genMemoryIdResultCode != MEMORY_OK)
+        if ((MEMORY_IS_ALLOCATOR_FREE(nextAllocatorPtr)))
         {
-            memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
+            _memory_tlsf_remove_free_allocator(pageHeaderPtr, nextAllocatorByteOffset);
 
-            utils_fprintf(stderr, 
-                "%s(Line: %d; Error Code: %u): Could not alloc raw allocation.\n", 
-                __FUNCTION__, __LINE__, (u32)errorCode);
+            splitAllocatorPtr->byteSize += sizeof(struct memory_allocator) + nextAllocatorPtr->byteSize;
 
-            return errorCode;
+            nextAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, 
+                splitAllocatorByteOffset);
         }
     }
 
-    u16 rawAllocationInfoMapBucketIndex = (u16)((real64)rawAllocationId/MEMORY_MAX_RAW_ALLOCS*
-        g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT) - 1;
-    
-    u16 rawAllocationInfoMapBranchIndex = 
-        g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocationInfoMapBucketIndex].branchCount;
-
-#define MEMORY_RAW_ALLOC_ALLOCATION_INFO_BRANCH_MULTIPLIER 2
-
-    if (g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocationInfoMapBucketIndex].branchCapacity > 0)
+    if (nextAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
     {
-        if (g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocationInfoMapBucketIndex].branchCapacity ==
-            g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocationInfoMapBucketIndex].branchCount)
-        {
+        ((struct memory_allocator *)((u8 *)pageHeaderPtr + nextAllocatorByteOffset))->prevPhysicalAllocatorByteOffset = 
+            splitAllocatorByteOffset;
+    }
 
-            struct memory_raw_allocation_info *tempPtr = realloc(
-                g_MEMORY_RAW_ALLOCATION_INFO_MAP[rawAllocationInfoMapBucketIndex],
-                sizeof(struct memory_raw_allocation_info)*
-                g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocationInfoMapBucketIndex].branchCapacity*
-                MEMORY_RAW_ALLOC_ALLOCATION_INFO_BRANCH_MULTIPLIER);
+    if (splitAllocatorByteOffset < pageHeaderPtr->compactionCursorByteOffset)
+    {
+        pageHeaderPtr->compactionCursorByteOffset = splitAllocatorByteOffset;
+    }
 
-            if (tempPtr)
-            {
-                g_MEMORY_RAW_ALLOCATION_INFO_MAP[rawAllocationInfoMapBucketIndex] = tempPtr;
+    _memory_tlsf_insert_free_allocator(pageHeaderPtr, splitAllocatorByteOffset);
+}
 
-                g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocationInfoMapBucketIndex].branchCapacity *=
-                    MEMORY_RAW_ALLOC_ALLOCATION_INFO_BRANCH_MULTIPLIER;
-            }
-            else 
-            {
-                memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
+static u8 *
+_memory_reserve_heap(u64 byteSize, b32 isHuge, b32 *outIsVirtualPtr)
+{
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+    void *heapPtr = VirtualAlloc(NULL, byteSize, MEM_RESERVE, PAGE_NOACCESS);
 
-                utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Failure to alloc "
-                    "raw allocation.\n", __FUNCTION__, __LINE__, (u32)errorCode);
+    if (heapPtr)
+    {
+        *outIsVirtualPtr = B32_TRUE;
 
-                return errorCode;
-            }
-        }
+        return heapPtr;
     }
-    else 
-    {
-        g_MEMORY_RAW_ALLOCATION_INFO_MAP[rawAllocationInfoMapBucketIndex] = 
-            malloc(sizeof(struct memory_raw_allocation_info));
+#elif defined(linux) || defined(__linux__)
+    void *heapPtr = MAP_FAILED;
 
-        if (!g_MEMORY_RAW_ALLOCATION_INFO_MAP)
+    #if defined(MEMORY_USE_HUGETLB) && defined(MAP_HUGETLB)
+        // needs huge pages reserved by the system (vm.nr_hugepages); silently falls back when there are none
+        if (isHuge)
         {
-            memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
+            heapPtr = mmap(NULL, byteSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_HUGETLB, 
+                -1, 0);
+        }
+    #endif
 
-            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Failure to alloc "
-                "raw allocation.\n", __FUNCTION__, __LINE__, (u32)errorCode);
+    if (heapPtr == MAP_FAILED)
+    {
+        heapPtr = mmap(NULL, byteSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
 
-            return errorCode;
+    #if defined(MADV_HUGEPAGE)
+        if ((heapPtr != MAP_FAILED) && isHuge)
+        {
+            madvise(heapPtr, byteSize, MADV_HUGEPAGE);
         }
-
-        ++g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocationInfoMapBucketIndex].branchCapacity;
+    #endif
     }
 
-    struct memory_raw_allocation_info *infoObjectPtr = &g_MEMORY_RAW_ALLOCATION_INFO_MAP[rawAllocationInfoMapBucketIndex][
-        rawAllocationInfoMapBranchIndex];
+    if (heapPtr != MAP_FAILED)
+    {
+        *outIsVirtualPtr = B32_TRUE;
 
-#define MEMORY_RAW_ALLOC_ALLOCATION_MULTIPLIER 2
+        return heapPtr;
+    }
+#endif
 
-    u16 freeAllocationCount = g_MEMORY_RAW_ALLOCATION_FREE_LIST_COUNT;
+    // no way to reserve address space here; fall back to a heap that is committed up front
+    *outIsVirtualPtr = B32_FALSE;
 
-    struct memory_raw_allocation *freeRawAllocationPtr;
+    return malloc(byteSize);
+}
 
-    if (g_MEMORY_RAW_ALLOCATION_FREE_LIST_COUNT > 0)
+// makes sure the first 'requiredByteSize' bytes of a heap region are backed by memory; regions only grow up
+static memory_error_code
+_memory_commit_heap_region(struct memory_context *contextPtr, p64 regionByteOffset, u64 *regionCommittedBytesPtr,
+    u64 requiredByteSize)
+{
+    if (requiredByteSize <= *regionCommittedBytesPtr)
     {
-        freeRawAllocationPtr = &g_MEMORY_RAW_ALLOCATION_ARR[g_MEMORY_RAW_ALLOCATION_ARR_FREE_LIST_HEAD_INDEX];
+        return MEMORY_OK;
     }
-    else 
+
+    if (!contextPtr->isHeapVirtual)
     {
-        freeRawAllocationPtr = NULL;
+        *regionCommittedBytesPtr = requiredByteSize;
+
+        return MEMORY_OK;
     }
 
-    struct memory_raw_allocation *rawAllocationPtr;
-    u16 rawAllocationIndex;
+    u64 granularity = contextPtr->heapCommitGranularity;
+    p64 commitStartByteOffset = (regionByteOffset + *regionCommittedBytesPtr) & ~(granularity - 1);
+    p64 commitEndByteOffset = (regionByteOffset + requiredByteSize + (granularity - 1)) & ~(granularity - 1);
 
-    if (freeRawAllocationPtr)
+    if (commitEndByteOffset > contextPtr->reservedHeapBytes)
     {
-        rawAllocationPtr = freeRawAllocationPtr;
-        rawAllocationIndex = g_MEMORY_RAW_ALLOCATION_ARR_FREE_LIST_HEAD_INDEX;
+        commitEndByteOffset = contextPtr->reservedHeapBytes;
     }
-    else if (!freeRawAllocationPtr && (rawAllocationCount == g_MEMORY_RAW_ALLOCATION_CAPACITY))
-    {
-        if (g_MEMORY_RAW_ALLOCATION_CAPACITY > 0)
-        {
-            struct memory_raw_allocation *tempPtr = realloc(g_MEMORY_RAW_ALLOCATION_ARR, 
-                sizeof(struct memory_raw_allocation)*g_MEMORY_RAW_ALLOCATION_CAPACITY*
-                MEMORY_RAW_ALLOC_ALLOCATION_MULTIPLIER);
 
-            if (tempPtr)
-            {
-                g_MEMORY_RAW_ALLOCATION_ARR = tempPtr;
+    if ((regionByteOffset + requiredByteSize) > commitEndByteOffset)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Commit request is past the end of the reserved heap.",
+            __func__, __LINE__);
 
-                rawAllocationIndex = g_MEMORY_RAW_ALLOCATION_FREE_LIST_COUNT;
-                rawAllocationPtr = &g_MEMORY_RAW_ALLOCATION_ARR[rawAllocationIndex];
-                
-                g_MEMORY_RAW_ALLOCATION_CAPACITY = g_MEMORY_RAW_ALLOCATION_CAPACITY*
-                    MEMORY_RAW_ALLOC_ALLOCATION_MULTIPLIER;
-            }
-            else 
-            {
-                memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
+        return MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE;
+    }
 
-                utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Failure to alloc "
-                    "raw allocation.\n", __FUNCTION__,
-                    __LINE__, (u32)errorCode);
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+    if (!VirtualAlloc(contextPtr->heap + commitStartByteOffset, commitEndByteOffset - commitStartByteOffset, 
+        MEM_COMMIT, PAGE_READWRITE))
+#elif defined(linux) || defined(__linux__)
+    if (mprotect(contextPtr->heap + commitStartByteOffset, commitEndByteOffset - commitStartByteOffset, 
+        PROT_READ | PROT_WRITE) != 0)
+#else
+    if (B32_FALSE)
+#endif
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Failure to commit %llu heap bytes.",
+            __func__, __LINE__, (unsigned long long)(commitEndByteOffset - commitStartByteOffset));
 
-                return errorCode;
-            }
-        }
-        else 
-        {
-            struct memory_raw_allocation *tempPtr = malloc(sizeof(struct memory_raw_allocation));
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
 
-            if (tempPtr)
-            {
-                g_MEMORY_RAW_ALLOCATION_ARR = tempPtr;
-                rawAllocationIndex = 0;
-                rawAllocationPtr = &g_MEMORY_RAW_ALLOCATION_ARR[rawAllocationIndex];
-                ++g_MEMORY_RAW_ALLOCATION_CAPACITY;
-            }
-            else 
-            {
-                memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
+    *regionCommittedBytesPtr = commitEndByteOffset - regionByteOffset;
 
-                utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Failure to alloc "
-                    "raw allocation.\n", __FUNCTION__,
-                    __LINE__, (u32)errorCode);
+    return MEMORY_OK;
+}
 
-                return errorCode;
-            }
-        }
-    }
-    else if (!freeRawAllocationPtr)
+// hands whole commit granules inside the range back to the os without decommitting them
+static void
+_memory_discard_heap_range(struct memory_context *contextPtr, p64 heapByteOffset, u64 byteSize)
+{
+    if (!contextPtr->isHeapVirtual)
     {
-        memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
-
-        return errorCode;
+        return;
     }
 
-    struct memory_raw_allocator *rawAllocatorPtr = malloc(sizeof(struct memory_raw_allocator) +
-        byteSize);
+    u64 granularity = contextPtr->heapCommitGranularity;
+    p64 discardStartByteOffset = (heapByteOffset + (granularity - 1)) & ~(granularity - 1);
+    p64 discardEndByteOffset = (heapByteOffset + byteSize) & ~(granularity - 1);
 
-    if (!rawAllocatorPtr)
+    if (discardEndByteOffset <= discardStartByteOffset)
     {
-        memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
+        return;
+    }
 
-        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Failure to alloc raw allocation.\n", __FUNCTION__,
-            __LINE__, (u32)errorCode);
-
-        return errorCode;
-    }
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+    VirtualAlloc(contextPtr->heap + discardStartByteOffset, discardEndByteOffset - discardStartByteOffset, 
+        MEM_RESET, PAGE_READWRITE);
+#elif defined(linux) || defined(__linux__)
+    madvise(contextPtr->heap + discardStartByteOffset, discardEndByteOffset - discardStartByteOffset, MADV_DONTNEED);
+#endif
+}
 
-    freeRawAllocationPtr->allocatorPtr = rawAllocatorPtr;
+static memory_error_code
+_memory_commit_pages_region(struct memory_context *contextPtr, p64 pagesRegionByteOffset, u64 byteSize)
+{
+    return _memory_commit_heap_region(contextPtr, contextPtr->pagesRegionByteOffset, 
+        &contextPtr->pagesRegionCommittedBytes, pagesRegionByteOffset + byteSize);
+}
 
-    rawAllocatorPtr->identifier = MEMORY_HEADER_ID;
-    rawAllocatorPtr->byteSize = byteSize;
-    ((struct memory_raw_allocation_key *)&(rawAllocatorPtr->allocKey))->rawAllocationId = rawAllocationId;
-    ((struct memory_raw_allocation_key *)&(rawAllocatorPtr->allocKey))->rawAllocationInfoBranchIndex = 
-        rawAllocationInfoMapBranchIndex;
+// commits a page's heap up to 'pageByteOffsetEnd' (relative to the page header), clamped to the page
+static memory_error_code
+_memory_commit_page_heap(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, 
+    p64 pageByteOffsetEnd)
+{
+    p64 pageHeaderByteOffset = (p64)pageHeaderPtr - ((p64)contextPtr->heap + contextPtr->pagesRegionByteOffset);
 
-    if (freeRawAllocationPtr)
+    if (pageByteOffsetEnd > (sizeof(struct memory_page_header) + pageHeaderPtr->heapByteSize))
     {
-        if (g_MEMORY_RAW_ALLOCATION_FREE_LIST_COUNT > 1)
-        {
-            struct memory_raw_allocation *nextPtr = &g_MEMORY_RAW_ALLOCATION_ARR[rawAllocationPtr->nextAllocationIndex];
-            struct memory_raw_allocation *tailPtr = &g_MEMORY_RAW_ALLOCATION_ARR[rawAllocationPtr->prevAllocationIndex];
+        pageByteOffsetEnd = sizeof(struct memory_page_header) + pageHeaderPtr->heapByteSize;
+    }
 
-            nextPtr->prevAllocationIndex = rawAllocationPtr->prevAllocationIndex;
-            tailPtr->nextAllocationIndex = rawAllocationPtr->nextAllocationIndex;
+    return _memory_commit_pages_region(contextPtr, pageHeaderByteOffset, pageByteOffsetEnd);
+}
 
-            g_MEMORY_RAW_ALLOCATION_ARR_FREE_LIST_HEAD_INDEX = freeRawAllocationPtr->nextAllocationIndex;
-        }
+// grows an active allocator over its free physical successor, giving back whatever is left past byteSize. 
+// returns B32_FALSE (and touches nothing) when the successor is not free or too small.
+static b32
+_memory_grow_allocator_in_place(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, 
+    p64 allocatorByteOffset, u64 byteSize)
+{
+    struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+    p64 nextAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, allocatorByteOffset);
 
-        --g_MEMORY_RAW_ALLOCATION_FREE_LIST_COUNT;
+    if (nextAllocatorByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        return B32_FALSE;
     }
 
-    if (g_MEMORY_RAW_ALLOCATION_ACTIVE_LIST_COUNT > 0)
-    {
-        struct memory_raw_allocation *headPtr = &g_MEMORY_RAW_ALLOCATION_ARR[
-            g_MEMORY_RAW_ALLOCATION_ARR_ACTIVE_LIST_HEAD_INDEX];
-        struct memory_raw_allocation *tailPtr = &g_MEMORY_RAW_ALLOCATION_ARR[headPtr->prevAllocationIndex];
+    struct memory_allocator *nextAllocatorPtr = (void *)((u8 *)pageHeaderPtr + nextAllocatorByteOffset);
 
-        rawAllocationPtr->prevAllocationIndex = headPtr->prevAllocationIndex;
-        rawAllocationPtr->nextAllocationIndex = g_MEMORY_RAW_ALLOCATION_ARR_ACTIVE_LIST_HEAD_INDEX;
-        headPtr->prevAllocationIndex = rawAllocationIndex;
-        tailPtr->nextAllocationIndex = rawAllocationIndex;
-    }
-    else 
+    if (!(MEMORY_IS_ALLOCATOR_FREE(nextAllocatorPtr)) || 
+        (allocatorPtr->byteSize + sizeof(struct memory_allocator) + nextAllocatorPtr->byteSize) < byteSize)
     {
-        rawAllocationPtr->prevAllocationIndex = rawAllocationPtr->nextAllocationIndex = rawAllocationIndex;
+        return B32_FALSE;
     }
 
-    g_MEMORY_RAW_ALLOCATION_ARR_ACTIVE_LIST_HEAD_INDEX = rawAllocationIndex;
-    
-    infoObjectPtr->rawAllocationIndex = rawAllocationIndex;
-    infoObjectPtr->isActive = B32_TRUE;
+    if (_memory_commit_page_heap(contextPtr, pageHeaderPtr, allocatorByteOffset + 
+        sizeof(struct memory_allocator)*2 + byteSize) != MEMORY_OK)
+    {
+        return B32_FALSE;
+    }
 
-    ++g_MEMORY_RAW_ALLOCATION_ACTIVE_LIST_COUNT;
-    ++g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocationInfoMapBucketIndex].branchCount;
-    g_MEMORY_RAW_ALLOCATION_FREE_LIST_COUNT = freeAllocationCount;
+    _memory_tlsf_remove_free_allocator(pageHeaderPtr, nextAllocatorByteOffset);
 
-    ((struct memory_raw_allocation_key *)outRawAllocKeyPtr)->rawAllocationId = rawAllocationId;
-    ((struct memory_raw_allocation_key *)outRawAllocKeyPtr)->rawAllocationInfoBranchIndex = rawAllocationInfoMapBranchIndex;
-    ((struct memory_allocation_key *)outRawAllocKeyPtr)->isManaged = B32_FALSE;
+    allocatorPtr->byteSize += sizeof(struct memory_allocator) + nextAllocatorPtr->byteSize;
 
-    return MEMORY_OK;
-}
+    p64 followingAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, 
+        allocatorByteOffset);
 
-memory_error_code
-memory_raw_realloc(const struct memory_allocation_key *rawAllocKeyPtr, u64 byteSize)
-{
-    if (!rawAllocKeyPtr)
+    if (followingAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
     {
-        return MEMORY_ERROR_NULL_ARGUMENT;
+        ((struct memory_allocator *)((u8 *)pageHeaderPtr + followingAllocatorByteOffset))->
+            prevPhysicalAllocatorByteOffset = allocatorByteOffset;
     }
 
-    if (rawAllocKeyPtr->isManaged)
+    // the absorbed allocator may have been the compaction cursor; the allocator after it is the next candidate
+    if (pageHeaderPtr->compactionCursorByteOffset == nextAllocatorByteOffset)
     {
-        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+        pageHeaderPtr->compactionCursorByteOffset = followingAllocatorByteOffset;
     }
 
-    const struct memory_raw_allocation_key *keyPtr = (void *)rawAllocKeyPtr;
+    _memory_split_allocator(pageHeaderPtr, allocatorByteOffset, byteSize);
+
+    return B32_TRUE;
+}
+
+// live bytes are counted in allocator sizes (aligned, without the allocator header)
+static void
+_memory_track_live_bytes(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, 
+    u64 addedByteCount, u64 removedByteCount)
+{
+    contextPtr->stats.liveByteCount += addedByteCount - removedByteCount;
+    pageHeaderPtr->liveByteCount += addedByteCount - removedByteCount;
 
-    if (keyPtr->rawAllocationId == MEMORY_SHORT_ID_NULL)
+    if (contextPtr->stats.liveByteCount > contextPtr->stats.highWaterByteCount)
     {
-        return MEMORY_ERROR_NULL_ID;
+        contextPtr->stats.highWaterByteCount = contextPtr->stats.liveByteCount;
     }
 
-    u16 rawAllocBranchInfoIndex = (u16)((real64)keyPtr->rawAllocationId/MEMORY_MAX_RAW_ALLOCS*
-        g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT);
-
-    struct memory_raw_allocation_info_map_branch_info *branchInfoPtr = 
-        &g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocBranchInfoIndex];
+    if (pageHeaderPtr->liveByteCount > pageHeaderPtr->highWaterByteCount)
+    {
+        pageHeaderPtr->highWaterByteCount = pageHeaderPtr->liveByteCount;
+    }
+}
 
-    struct memory_raw_allocation_info *allocInfoPtr = &g_MEMORY_RAW_ALLOCATION_INFO_MAP[
-        rawAllocBranchInfoIndex][keyPtr->rawAllocationInfoBranchIndex];
+static void
+_memory_add_free_block_diagnostic(struct memory_page_diagnostic_info *diagInfoPtr, u64 byteSize)
+{
+    u32 bucketIndex = _memory_find_last_set_bit_u64(byteSize);
 
-    if (!allocInfoPtr->isActive)
+    if (bucketIndex >= MEMORY_DIAGNOSTIC_HISTOGRAM_BUCKET_COUNT)
     {
-        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+        bucketIndex = MEMORY_DIAGNOSTIC_HISTOGRAM_BUCKET_COUNT - 1;
     }
 
-    struct memory_raw_allocation *allocationPtr = &g_MEMORY_RAW_ALLOCATION_ARR[allocInfoPtr->rawAllocationIndex];
+    ++diagInfoPtr->freeBlockHistogramArr[bucketIndex];
+    ++diagInfoPtr->freeBlockCount;
 
-    void *resultPtr = realloc(allocationPtr->allocatorPtr, sizeof(struct memory_raw_allocator) + 
-        byteSize);
+    diagInfoPtr->freeByteCount += byteSize;
 
-    if (!resultPtr)
+    if (byteSize > diagInfoPtr->largestFreeByteCount)
     {
-        return MEMORY_ERROR_FAILED_ALLOCATION;
+        diagInfoPtr->largestFreeByteCount = byteSize;
     }
-
-    allocationPtr->allocatorPtr = resultPtr;
-    allocationPtr->allocatorPtr->byteSize = byteSize;
-
-    return MEMORY_OK;
 }
 
-memory_error_code
-memory_raw_free(const struct memory_allocation_key *rawAllocKeyPtr)
+// walks the TLSF free lists only, so the cost follows the number of free blocks rather than the page size. 
+// locked pages (arenas, stacks) are not managed by the TLSF lists, and report no free blocks
+static void
+_memory_get_page_diagnostic_info(struct memory_page_header *pageHeaderPtr, enum memory_page_status_t pageStatus,
+    struct memory_page_diagnostic_info *outDiagInfoPtr)
 {
-    if (!rawAllocKeyPtr)
-    {
-        utils_fprintfln(stderr, "%s(Line: %d): 'rawAllocKeyPtr' argument "
-            "cannot be NULL. Cannot free allocation." , __func__, __LINE__);
+    memset(outDiagInfoPtr, '\0', sizeof(struct memory_page_diagnostic_info));
 
-        return MEMORY_ERROR_NULL_ARGUMENT;
-    }
+    outDiagInfoPtr->heapByteSize = pageHeaderPtr->heapByteSize;
+    outDiagInfoPtr->liveByteCount = pageHeaderPtr->liveByteCount;
+    outDiagInfoPtr->highWaterByteCount = pageHeaderPtr->highWaterByteCount;
+    outDiagInfoPtr->allocationCount = pageHeaderPtr->allocationInfoCount;
 
-    if (rawAllocKeyPtr->isManaged)
+    if (pageStatus == MEMORY_PAGE_STATUS_LOCKED)
     {
-        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+        return;
     }
 
-    const struct memory_raw_allocation_key *keyPtr = (void *)rawAllocKeyPtr;
-
-    if ((keyPtr->rawAllocationId == MEMORY_SHORT_ID_NULL))
+    // nothing was allocated on the page yet; its heap becomes one free allocator on the first allocation
+    if ((pageHeaderPtr->activeAllocatorCount < 1) && (pageHeaderPtr->freeAllocatorCount < 1))
     {
-        utils_fprintfln(stderr, "%s(Line: %d): 'rawAllocKeyPtr' argument "
-            "cannot be a NULL ID. Cannot free allocation." , __func__, __LINE__);
-
-        return MEMORY_ERROR_NULL_ID;
+        if (pageHeaderPtr->heapByteSize > sizeof(struct memory_allocator))
+        {
+            _memory_add_free_block_diagnostic(outDiagInfoPtr, pageHeaderPtr->heapByteSize - 
+                sizeof(struct memory_allocator));
+        }
     }
 
+    for (u32 firstLevelBitmap = pageHeaderPtr->tlsfFirstLevelBitmap; firstLevelBitmap; 
+        firstLevelBitmap &= firstLevelBitmap - 1)
     {
-        memory_error_code resultCode = _memory_get_is_raw_allocation_operation_ok();
+        u32 firstLevelIndex = _memory_find_first_set_bit_u32(firstLevelBitmap);
 
-        if (resultCode != MEMORY_OK)
+        for (u32 secondLevelBitmap = pageHeaderPtr->tlsfSecondLevelBitmapArr[firstLevelIndex]; secondLevelBitmap; 
+            secondLevelBitmap &= secondLevelBitmap - 1)
         {
-            utils_fprintfln(stderr, "%s(Line: %d): Raw Allocation functionality "
-                "is not available. Cannot free raw allocation."
-                "in page, for new allocation. Aborting.", __func__, __LINE__);
-            
-            return resultCode;
+            u32 secondLevelIndex = _memory_find_first_set_bit_u32(secondLevelBitmap);
+            p64 allocatorByteOffset = pageHeaderPtr->tlsfFreeAllocatorByteOffsetTable[firstLevelIndex][secondLevelIndex];
+
+            while (allocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
+            {
+                struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+
+                _memory_add_free_block_diagnostic(outDiagInfoPtr, allocatorPtr->byteSize);
+
+                allocatorByteOffset = allocatorPtr->nextAllocatorByteOffset;
+            }
         }
     }
 
-    u16 rawAllocationInfoMapBucketIndex = (u16)((real64)keyPtr->rawAllocationId/
-        MEMORY_MAX_RAW_ALLOCS*g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT) - 1;
+    if (outDiagInfoPtr->freeByteCount > 0)
+    {
+        outDiagInfoPtr->fragmentation = 1.f - ((real32)outDiagInfoPtr->largestFreeByteCount/
+            (real32)outDiagInfoPtr->freeByteCount);
+    }
+}
 
-    struct memory_raw_allocation_info *rawAllocInfoPtr = &g_MEMORY_RAW_ALLOCATION_INFO_MAP[
-        rawAllocationInfoMapBucketIndex][keyPtr->rawAllocationInfoBranchIndex];
+// circular page header lists (active/free), threaded through byte offsets into the pages region
+static void
+_memory_link_page_header(struct memory_context *contextPtr, p64 *listByteOffsetPtr, u16 *listCountPtr,
+    p64 pageHeaderByteOffset)
+{
+    p64 pagesRegionByteIndex = (p64)contextPtr->heap + contextPtr->pagesRegionByteOffset;
+    struct memory_page_header *pageHeaderPtr = (void *)(pagesRegionByteIndex + pageHeaderByteOffset);
 
-    if (!rawAllocInfoPtr->isActive)
+    if (*listCountPtr > 0)
     {
-        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Cannot free an "
-            "inactive raw allocation.\n", __FUNCTION__,
-            __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
+        struct memory_page_header *headPageHeaderPtr = (void *)(pagesRegionByteIndex + *listByteOffsetPtr);
+        struct memory_page_header *tailPageHeaderPtr = (void *)(pagesRegionByteIndex + 
+            headPageHeaderPtr->prevPageHeaderByteOffset);
 
-        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+        pageHeaderPtr->prevPageHeaderByteOffset = headPageHeaderPtr->prevPageHeaderByteOffset;
+        pageHeaderPtr->nextPageHeaderByteOffset = *listByteOffsetPtr;
+
+        tailPageHeaderPtr->nextPageHeaderByteOffset = pageHeaderByteOffset;
+        headPageHeaderPtr->prevPageHeaderByteOffset = pageHeaderByteOffset;
+    }
+    else 
+    {
+        pageHeaderPtr->prevPageHeaderByteOffset = pageHeaderPtr->nextPageHeaderByteOffset = pageHeaderByteOffset;
     }
 
-    struct memory_raw_allocation *allocationPtr = &g_MEMORY_RAW_ALLOCATION_ARR[
-        rawAllocInfoPtr->rawAllocationIndex];
+    *listByteOffsetPtr = pageHeaderByteOffset;
+    ++(*listCountPtr);
+}
 
-    free(allocationPtr->allocatorPtr);
+static void
+_memory_unlink_page_header(struct memory_context *contextPtr, p64 *listByteOffsetPtr, u16 *listCountPtr,
+    p64 pageHeaderByteOffset)
+{
+    p64 pagesRegionByteIndex = (p64)contextPtr->heap + contextPtr->pagesRegionByteOffset;
+    struct memory_page_header *pageHeaderPtr = (void *)(pagesRegionByteIndex + pageHeaderByteOffset);
 
-    if (g_MEMORY_RAW_ALLOCATION_ACTIVE_LIST_COUNT > 1)
+    if (*listCountPtr > 1)
     {
-        struct memory_raw_allocation *prevPtr = &g_MEMORY_RAW_ALLOCATION_ARR[
-            allocationPtr->prevAllocationIndex];
-        struct memory_raw_allocation *nextPtr = &g_MEMORY_RAW_ALLOCATION_ARR[
-            allocationPtr->nextAllocationIndex];
-
-        prevPtr->nextAllocationIndex = allocationPtr->nextAllocationIndex;
-        nextPtr->prevAllocationIndex = allocationPtr->prevAllocationIndex;
+        ((struct memory_page_header *)(pagesRegionByteIndex + pageHeaderPtr->prevPageHeaderByteOffset))->
+            nextPageHeaderByteOffset = pageHeaderPtr->nextPageHeaderByteOffset;
+        ((struct memory_page_header *)(pagesRegionByteIndex + pageHeaderPtr->nextPageHeaderByteOffset))->
+            prevPageHeaderByteOffset = pageHeaderPtr->prevPageHeaderByteOffset;
 
-        if (rawAllocInfoPtr->rawAllocationIndex == g_MEMORY_RAW_ALLOCATION_ARR_ACTIVE_LIST_HEAD_INDEX)
+        if (*listByteOffsetPtr == pageHeaderByteOffset)
         {
-            g_MEMORY_RAW_ALLOCATION_ARR_ACTIVE_LIST_HEAD_INDEX = allocationPtr->nextAllocationIndex;
+            *listByteOffsetPtr = pageHeaderPtr->nextPageHeaderByteOffset;
         }
     }
-
-    if (g_MEMORY_RAW_ALLOCATION_FREE_LIST_COUNT > 0)
-    {
-        struct memory_raw_allocation *headAllocationPtr = &g_MEMORY_RAW_ALLOCATION_ARR[
-            g_MEMORY_RAW_ALLOCATION_ARR_ACTIVE_LIST_HEAD_INDEX];
-
-        struct memory_raw_allocation *tailAllocationPtr = &g_MEMORY_RAW_ALLOCATION_ARR[
-            headAllocationPtr->prevAllocationIndex];
-    }
     else 
     {
-        allocationPtr->prevAllocationIndex = allocationPtr->nextAllocationIndex = 
-            rawAllocInfoPtr->rawAllocationIndex;
+        *listByteOffsetPtr = 0;
     }
 
-    g_MEMORY_RAW_ALLOCATION_ARR_ACTIVE_LIST_HEAD_INDEX = rawAllocInfoPtr->rawAllocationIndex;
+    --(*listCountPtr);
+}
 
-    rawAllocInfoPtr->isActive = B32_TRUE;
+// monotonic, so event timestamps and reorder budgets never jump with wall clock adjustments
+static u64
+_memory_get_time_ns()
+{
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
 
-    *(memory_short_id*)&(keyPtr->rawAllocationId) = MEMORY_SHORT_ID_NULL;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
 
-    return MEMORY_OK;
+    return (u64)(counter.QuadPart/frequency.QuadPart)*1000000000ull + 
+        (u64)(counter.QuadPart%frequency.QuadPart)*1000000000ull/(u64)frequency.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (u64)ts.tv_sec*1000000000ull + (u64)ts.tv_nsec;
+#endif
 }
 
-memory_error_code
-memory_map_raw_allocation(const struct memory_allocation_key *rawAllocKeyPtr, void **outDataPtr)
+// wait-free for any number of writers: claim an event id, fill its slot, publish it. If the ring wraps before it 
+// is drained, the oldest events are overwritten, and the writer thread counts them as dropped.
+static void
+_memory_record_event(struct memory_context *contextPtr, enum memory_event_type type, memory_handle allocHandle,
+    memory_short_id pageId, u64 byteSize, p64 byteOffset)
 {
-    if (!rawAllocKeyPtr)
+    if (!contextPtr->isDebug)
     {
-        return MEMORY_ERROR_NULL_ARGUMENT;
+        return;
     }
 
-    if (rawAllocKeyPtr->managed.rawAllocationId == MEMORY_SHORT_ID_NULL)
-    {
-        return MEMORY_ERROR_NULL_ID;
-    }
+    struct memory_debug_context *debugContextPtr = (void *)contextPtr;
+    struct memory_event_queue *queuePtr = debugContextPtr->eventQueuePtr;
 
-    if (!outDataPtr)
+    if (!queuePtr)
     {
-        return MEMORY_ERROR_NULL_ARGUMENT;
+        return;
     }
 
-    u16 rawAllocBranchInfoIndex = (u16)((real64)rawAllocKeyPtr->rawAllocationId/MEMORY_MAX_RAW_ALLOCS*
-        g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_COUNT);
-
-    struct memory_raw_allocation_info_map_branch_info *branchInfoPtr = 
-        &g_MEMORY_RAW_ALLOCATION_INFO_MAP_BUCKET_BRANCH_INFO_TABLE[rawAllocBranchInfoIndex];
+    u64 eventId = atomic_fetch_add_explicit(&queuePtr->writeIndex, 1, memory_order_relaxed);
+    struct memory_event_slot *slotPtr = &queuePtr->slotArr[eventId & (queuePtr->capacity - 1)];
 
-    struct memory_raw_allocation_info *allocInfoPtr = &g_MEMORY_RAW_ALLOCATION_INFO_MAP[
-        rawAllocBranchInfoIndex][rawAllocKeyPtr->rawAllocationInfoBranchIndex];
+    // unpublish first, so a drain racing with the rewrite can't take a torn event
+    atomic_store_explicit(&slotPtr->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
 
-    if (!allocInfoPtr->isActive)
-    {
-        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
-    }
-
-    struct memory_raw_allocation *allocationPtr = &g_MEMORY_RAW_ALLOCATION_ARR[allocInfoPtr->rawAllocationIndex];
+    slotPtr->event.eventId = eventId;
+    slotPtr->event.timestampNS = _memory_get_time_ns();
+    slotPtr->event.allocHandle = allocHandle;
+    slotPtr->event.byteSize = byteSize;
+    slotPtr->event.byteOffset = byteOffset;
+    slotPtr->event.contextId = contextPtr->id;
+    slotPtr->event.pageId = pageId;
+    slotPtr->event.type = (u8)type;
 
-    *outDataPtr = allocationPtr->allocatorPtr + 1;
-
-    return MEMORY_OK;
+    atomic_store_explicit(&slotPtr->sequence, eventId + 1, memory_order_release);
 }
 
-memory_error_code
-memory_unmap_raw_allocation(const struct memory_raw_allocation_key *rawAllocKeyPtr, void **outDataPtr)
+static memory_error_code
+_memory_init_context_heap(struct memory_context *contextPtr, u64 totalByteSize)
 {
-    if (!outDataPtr)
-    {
-        return MEMORY_ERROR_NULL_ARGUMENT;
-    }
+    b32 isHuge = totalByteSize >= MEMORY_HEAP_HUGE_PAGE_THRESHOLD;
 
-    struct memory_raw_allocator *allocatorPtr = (struct memory_raw_allocator *)(*outDataPtr) - 1;
+    contextPtr->heapCommitGranularity = isHuge ? MEMORY_HEAP_HUGE_PAGE_SIZE : MEMORY_HEAP_COMMIT_GRANULARITY;
+    contextPtr->reservedHeapBytes = (totalByteSize + (contextPtr->heapCommitGranularity - 1)) & 
+        ~(contextPtr->heapCommitGranularity - 1);
+    contextPtr->allocationInfoRegionCommittedBytes = 0;
+    contextPtr->pagesRegionCommittedBytes = 0;
 
-    if (allocatorPtr->identifier != MEMORY_HEADER_ID)
+    if (!(contextPtr->heap = _memory_reserve_heap(contextPtr->reservedHeapBytes, isHuge, &contextPtr->isHeapVirtual)))
     {
-        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
-    }
+        utils_fprintfln(stderr, "%s(Line: %d): Failure to reserve %llu heap bytes.",
+            __func__, __LINE__, (unsigned long long)contextPtr->reservedHeapBytes);
 
-    *outDataPtr = NULL;
+        contextPtr->reservedHeapBytes = 0;
 
-    // TODO: make mappings matter, and there can only be one active mapped raw allocation.
-    // same with normal allocations as well.
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
 
     return MEMORY_OK;
 }
 
-memory_error_code
-memory_get_is_raw_allocation_operation_ok()
-{
-    return _memory_get_is_raw_allocation_operation_ok();
-}
-
-memory_error_code
-memory_create_debug_context(u64 allocationInfoRegionByteCapacity, u64 pagesRegionByteCapacity, u64 labelRegionByteCapacity, 
-    const char *contextLabel, const struct memory_context_key *outputMemoryDebugContextKeyPtr)
+static memory_error_code
+_memory_alloc_context(struct memory_context **outMemoryContext, b32 isDebug)
 {
+    if (!outMemoryContext)
     {
-        memory_error_code errorCode;
-
-        if ((errorCode = _memory_get_context_key_is_ok(outputMemoryDebugContextKeyPtr)) != MEMORY_OK)
-        {
-            utils_fprintf(stderr, "memory_create_debug_context(%d): 'outputMemoryDebugContextKeyPtr' parameter is NULL.\n", 
-                __LINE__);
-            
-            return MEMORY_ERROR_NULL_ARGUMENT;
-        }
+        return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
-    u64 totalBytesToAllocate = allocationInfoRegionByteCapacity + pagesRegionByteCapacity + labelRegionByteCapacity;
+    #define MEMORY_DEBUG_CONTEXT_ARR_REALLOC_MULTIPLIER 2
 
-    struct memory_debug_context *debugContextPtr;
-    memory_short_id contextId = g_DEBUG_CONTEXT_COUNT;
+    if (isDebug)
     {
-        memory_error_code contextAllocResultCode;
+        u16 debugContextIndex = g_DEBUG_CONTEXT_COUNT;
 
-        if ((contextAllocResultCode = _memory_alloc_context((struct memory_context **)&debugContextPtr, B32_TRUE)) != MEMORY_OK)
+        if (g_DEBUG_CONTEXT_COUNT == g_DEBUG_CONTEXT_CAPACITY)
         {
-            switch (contextAllocResultCode)
+            if (g_DEBUG_CONTEXT_CAPACITY > 0)
             {
-                case MEMORY_ERROR_NULL_ID:
+                struct memory_debug_context *reallocatedMemoryContext =
+                    realloc(g_DEBUG_CONTEXT_ARR, sizeof(struct memory_debug_context)*(g_DEBUG_CONTEXT_CAPACITY*
+                        MEMORY_DEBUG_CONTEXT_ARR_REALLOC_MULTIPLIER));
+
+                if (reallocatedMemoryContext)
                 {
-                    utils_fprintf(stderr, "memory_create_debug_context(%d): Output parameter is NULL for internal '_memory_alloc_context' function result.\n",
-                         __LINE__);
+                    g_DEBUG_CONTEXT_ARR = reallocatedMemoryContext;
+                    g_DEBUG_CONTEXT_CAPACITY *= MEMORY_DEBUG_CONTEXT_ARR_REALLOC_MULTIPLIER;
+                }
+                else 
+                {
+                    utils_fprintf(stderr, "_memory_alloc_context(%d): Failure to reallocate context array. "
+                            "Cannot allocate new context.\n", __LINE__);
 
                     return MEMORY_ERROR_FAILED_ALLOCATION;
-                } break;
+                }
+            }
+            else 
+            {
+                g_DEBUG_CONTEXT_ARR = malloc(sizeof(struct memory_debug_context));
 
-                default:
+                if (g_DEBUG_CONTEXT_ARR)
                 {
-                    utils_fprintf(stderr, "memory_create_debug_context(%d): Unknown error for internal '_memory_alloc_context' function result.\n",
-                         __LINE__);
+                    ++g_DEBUG_CONTEXT_CAPACITY;
+                }
+                else 
+                {
+                    utils_fprintf(stderr, "_memory_alloc_context(%d): Failure to allocate debug context array. "
+                            "Cannot allocate new debug context.\n", __LINE__);
 
-                    return MEMORY_ERROR_UNKNOWN;
-                } break;
+                    return MEMORY_ERROR_FAILED_ALLOCATION;
+                }
             }
-        }
-    }
 
-    debugContextPtr->_.id = contextId;
-    debugContextPtr->_.allocationInfoRegionBytesReserved = 0;
-    debugContextPtr->_.pagesRegionFreeAllocationInfoByteOffsetList = 0;
-    debugContextPtr->_.pagesRegionFreeAllocationInfoCount = 0;
-    debugContextPtr->_.pagesRegionByteCapacity = pagesRegionByteCapacity;
-    debugContextPtr->_.pagesRegionByteOffset = (p64)(allocationInfoRegionByteCapacity);
-    debugContextPtr->_.pagesRegionInfoArr = NULL;
-    debugContextPtr->_.allocationInfoRegionByteCapacity = allocationInfoRegionByteCapacity;
-    debugContextPtr->_.allocationInfoRegionByteOffset = 0;
-    debugContextPtr->_.heap = malloc(totalBytesToAllocate);
-    debugContextPtr->_.reservedHeapBytes = 0;
-    debugContextPtr->_.pagesRegionInfoCount = 0;
-    debugContextPtr->_.pagesRegionInfoCapacity = 0;
-    debugContextPtr->_.activePagesByteOffsetList = debugContextPtr->_.freePagesByteOffsetList = MEMORY_SHORT_ID_NULL;
-    debugContextPtr->_.pagesRegionActiveCount = 0;
-    debugContextPtr->_.pagesRegionFreeCount = 0;
-    debugContextPtr->_.reservedHeapBytes = 0;
-    debugContextPtr->_.isDebug = B32_FALSE;
+        }
 
-    if (contextLabel)
-    {
-        strncpy(debugContextPtr->label, contextLabel, MEMORY_MAX_NAME_LENGTH);
+        *outMemoryContext = (struct memory_context *)&g_DEBUG_CONTEXT_ARR[debugContextIndex];
+        ++g_DEBUG_CONTEXT_COUNT;
     }
     else 
     {
-        debugContextPtr->label[0] = '\0';
-    }
-
-    debugContextPtr->eventQueueCapacity = 0;
-    debugContextPtr->eventQueueReadIndex = 0;
-    debugContextPtr->eventQueueWriteIndex = 0;
-    debugContextPtr->labelRegionByteCapacity = labelRegionByteCapacity;
-    debugContextPtr->labelRegionByteOffset = labelRegionByteCapacity;
-    debugContextPtr->labelRegionNextAllocationByteOffset = 0;
-    debugContextPtr->_.heap[debugContextPtr->labelRegionByteOffset] = '\0';
-
-    ((struct memory_context_key *)outputMemoryDebugContextKeyPtr)->contextId = contextId;
-    ((struct memory_context_key *)outputMemoryDebugContextKeyPtr)->isDebug = B32_TRUE;
-
-    return MEMORY_OK;
-}
-
-memory_error_code
-memory_create_context(u64 allocationInfoRegionByteCapacity, u64 pagesRegionByteCapacity, 
-    const struct memory_context_key *outputMemoryContextKeyPtr)
-{
-    if (!outputMemoryContextKeyPtr)
-    {
-        utils_fprintf(stderr, "memory_create_context(%d): 'outputMemoryContextKeyPtr' parameter is NULL.\n", __LINE__);
-
-        return MEMORY_ERROR_NULL_ARGUMENT;
-    }
-
-    u64 totalBytesToAllocate = allocationInfoRegionByteCapacity + pagesRegionByteCapacity;
+        #define MEMORY_CONTEXT_ARR_REALLOC_MULTIPLIER 2
 
-    struct memory_context *contextPtr;
-    memory_short_id contextId = g_CONTEXT_COUNT;
-    {
-        memory_error_code contextAllocResultCode;
+        u16 contextIndex = g_CONTEXT_COUNT;
 
-        if ((contextAllocResultCode = _memory_alloc_context(&contextPtr, B32_FALSE)) != MEMORY_OK)
+        if (g_CONTEXT_COUNT == g_CONTEXT_CAPACITY)
         {
-            switch (contextAllocResultCode)
+            if (g_CONTEXT_CAPACITY > 0)
             {
-                case MEMORY_ERROR_NULL_ID:
-                {
-                    utils_fprintf(stderr, "memory_create_context(%d): Output parameter is NULL for internal '_memory_alloc_context' function result.\n",
-                         __LINE__);
-                    
-                    memset((struct memory_context_key *)outputMemoryContextKeyPtr, '\0', sizeof(struct memory_context_key));
+                struct memory_context *reallocatedMemoryContext =
+                    realloc(g_CONTEXT_ARR, sizeof(struct memory_context)*(g_CONTEXT_CAPACITY*
+                        MEMORY_CONTEXT_ARR_REALLOC_MULTIPLIER));
+
+                if (reallocatedMemoryContext)
+                {
+                    g_CONTEXT_ARR = reallocatedMemoryContext;
+                    g_CONTEXT_CAPACITY *= MEMORY_CONTEXT_ARR_REALLOC_MULTIPLIER;
+                }
+                else 
+                {
+                    utils_fprintf(stderr, "_memory_alloc_context(%d): Failure to reallocate context array. "
+                            "Cannot allocate new context.\n", __LINE__);
 
                     return MEMORY_ERROR_FAILED_ALLOCATION;
-                } break;
+                }
+            }
+            else 
+            {
+                g_CONTEXT_ARR = malloc(sizeof(struct memory_context));
 
-                default:
+                if (g_CONTEXT_ARR)
                 {
-                    utils_fprintf(stderr, "memory_create_context(%d): Unknown error for internal '_memory_alloc_context' function result.\n",
-                         __LINE__);
-                    
-                    memset((struct memory_context_key *)outputMemoryContextKeyPtr, '\0', sizeof(struct memory_context_key));
+                    ++g_CONTEXT_CAPACITY;
+                }
+                else 
+                {
+                    utils_fprintf(stderr, "_memory_alloc_context(%d): Failure to allocate context array. "
+                            "Cannot allocate new context.\n", __LINE__);
 
-                    return MEMORY_ERROR_UNKNOWN;
-                } break;
+                    return MEMORY_ERROR_FAILED_ALLOCATION;
+                }
             }
         }
+
+        *outMemoryContext = (struct memory_context *)&g_CONTEXT_ARR[contextIndex];
+        ++g_CONTEXT_COUNT;
     }
+    
+    return MEMORY_OK;
+}
 
-    contextPtr->id = contextId;
-    contextPtr->pagesRegionAccumActiveAllocationCount = 0;
-    contextPtr->allocationInfoRegionBytesReserved = 0;
-    contextPtr->pagesRegionFreeAllocationInfoCount = 0;
-    contextPtr->reservedHeapBytes = 0;
-    contextPtr->pagesRegionByteCapacity = pagesRegionByteCapacity;
-    contextPtr->pagesRegionByteOffset = (p64)(allocationInfoRegionByteCapacity);
-    contextPtr->pagesRegionInfoArr = NULL;
-    contextPtr->allocationInfoRegionByteCapacity = allocationInfoRegionByteCapacity;
-    contextPtr->allocationInfoRegionByteOffset = 0;
-    contextPtr->heap = malloc(totalBytesToAllocate);
-    contextPtr->pagesRegionInfoCount = 0;
-    contextPtr->pagesRegionInfoCapacity = 0;
-    contextPtr->activePagesByteOffsetList = contextPtr->freePagesByteOffsetList = MEMORY_SHORT_ID_NULL;
-    contextPtr->pagesRegionActiveCount = 0;
-    contextPtr->pagesRegionFreeCount = 0;
-    contextPtr->reservedHeapBytes = 0;
-    contextPtr->isDebug = B32_FALSE;
+memory_error_code
+_memory_get_context(struct memory_context_key *contextKeyPtr, struct memory_context **outContextPtr)
+{
+    if (!contextKeyPtr)
+    {
+        utils_fprintf(stderr, "_memory_get_context(%d): 'memoryContextKeyPtr' parameter is NULL. "
+                "Cannot find context.\n", __LINE__);
+
+        if (outContextPtr)
+        {
+            *outContextPtr = NULL;
+        }
+                
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
     
-    ((struct memory_context_key *)outputMemoryContextKeyPtr)->contextId = contextId;
-    ((struct memory_context_key *)outputMemoryContextKeyPtr)->isDebug = B32_FALSE;
+    if (!outContextPtr)
+    {
+        utils_fprintf(stderr, "_memory_get_context(%d): Output parameter is NULL. "
+                "Cannot get context.\n", __LINE__);
+                
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code contextSearchResultCode;
+        
+        if (!contextKeyPtr->isDebug)
+        {
+            if (contextKeyPtr->contextId > 0)
+            {
+                u16 contextIndex = contextKeyPtr->contextId - 1;
+                
+                if (contextIndex < g_CONTEXT_COUNT)
+                {
+                    contextPtr = &g_CONTEXT_ARR[contextKeyPtr->contextId - 1];
+                    contextSearchResultCode = MEMORY_OK;
+                }
+                else 
+                {
+                    contextSearchResultCode = MEMORY_ERROR_INDEX_OUT_OF_RANGE;
+                }
+            }
+            else 
+            {
+                contextSearchResultCode = MEMORY_ERROR_NULL_ID;
+            }
+        }
+        else 
+        {
+            if (contextKeyPtr->contextId > 0)
+            {
+                u16 contextIndex = contextKeyPtr->contextId - 1;
+                
+                if (contextIndex < g_DEBUG_CONTEXT_COUNT)
+                {
+                    contextPtr = (struct memory_context *)&g_DEBUG_CONTEXT_ARR[contextKeyPtr->contextId - 1];
+                    contextSearchResultCode = MEMORY_OK;
+                }
+                else 
+                {
+                    contextSearchResultCode = MEMORY_ERROR_INDEX_OUT_OF_RANGE;
+                }
+            }
+            else 
+            {
+                contextSearchResultCode = MEMORY_ERROR_NULL_ID;
+            }
+        }
+        
+        if (contextSearchResultCode != MEMORY_OK)
+        {
+            *outContextPtr = NULL;
+            
+            utils_fprintf(stderr, "memory_alloc_page(%d): Failure to identiy memory context from key. "
+                    "Cannot allocate a page.\n", __LINE__);
+                    
+            return contextSearchResultCode;
+        }
+    }
+
+    *outContextPtr = contextPtr;
+    
+    return MEMORY_OK;
+}
+
+memory_error_code
+_memory_get_context_key_is_ok(const struct memory_context_key *contextKeyPtr)
+{
+    if (!contextKeyPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if (contextKeyPtr->contextId == MEMORY_SHORT_ID_NULL)
+    {
+        return MEMORY_ERROR_NULL_ID;
+    }
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+_memory_get_page_key_is_ok(const struct memory_page_key *pageKeyPtr)
+{
+    if (!pageKeyPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if (pageKeyPtr->pageId == MEMORY_SHORT_ID_NULL)
+    {
+        return MEMORY_ERROR_NULL_ID;
+    }
+
+    if ((_memory_get_context_key_is_ok(&pageKeyPtr->contextKey)) != MEMORY_OK)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+    }
+
+    return MEMORY_OK;
+}
+
+static memory_error_code
+_memory_get_page_info(struct memory_context *contextPtr, const struct memory_page_key *pageKeyPtr,
+    struct memory_page_info **outPageInfoPtr)
+{
+    assert(contextPtr && pageKeyPtr && outPageInfoPtr);
+
+    u16 pageInfoIndex = pageKeyPtr->pageId - 1;
+
+    if ((pageKeyPtr->pageId == MEMORY_SHORT_ID_NULL) || (pageInfoIndex >= contextPtr->pagesRegionInfoCount))
+    {
+        *outPageInfoPtr = NULL;
+
+        return MEMORY_ERROR_INDEX_OUT_OF_RANGE;
+    }
+
+    // a key to a freed (and possibly reused) page carries an older generation
+    if (contextPtr->pagesRegionInfoArr[pageInfoIndex].generation != pageKeyPtr->generation)
+    {
+        *outPageInfoPtr = NULL;
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
+    }
+
+    *outPageInfoPtr = &contextPtr->pagesRegionInfoArr[pageInfoIndex];
+
+    return MEMORY_OK;
+}
+
+static memory_error_code
+_memory_get_allocation_info(struct memory_context *contextPtr, const struct memory_allocation_key *allocKeyPtr,
+    struct memory_allocation_info **outAllocInfoPtr)
+{
+    assert(contextPtr && allocKeyPtr && outAllocInfoPtr);
+
+    if (allocKeyPtr->managed.allocInfoIndex >= (contextPtr->allocationInfoRegionBytesReserved/
+        sizeof(struct memory_allocation_info)))
+    {
+        *outAllocInfoPtr = NULL;
+
+        return MEMORY_ERROR_INDEX_OUT_OF_RANGE;
+    }
+
+    struct memory_allocation_info *allocInfoPtr = &((struct memory_allocation_info *)((p64)contextPtr->heap + 
+        contextPtr->allocationInfoRegionByteOffset))[allocKeyPtr->managed.allocInfoIndex];
+
+    // the generation is bumped on release, so this also rejects freed and reused allocation infos
+    if (allocInfoPtr->generation != allocKeyPtr->managed.generation)
+    {
+        *outAllocInfoPtr = NULL;
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+    }
+
+    *outAllocInfoPtr = allocInfoPtr;
+
+    return MEMORY_OK;
+}
+
+static memory_short_id
+_memory_find_label(struct memory_debug_context *debugContextPtr, const char *labelStr, utils_hash hash)
+{
+    if (debugContextPtr->labelSlotCapacity == 0)
+    {
+        return MEMORY_SHORT_ID_NULL;
+    }
+
+    u32 slotMask = debugContextPtr->labelSlotCapacity - 1;
+
+    for (u32 slotIndex = (u32)hash & slotMask; debugContextPtr->labelSlotArr[slotIndex] != MEMORY_SHORT_ID_NULL; 
+        slotIndex = (slotIndex + 1) & slotMask)
+    {
+        memory_short_id labelId = debugContextPtr->labelSlotArr[slotIndex];
+        struct memory_label_entry *entryPtr = &debugContextPtr->labelEntryArr[labelId - 1];
+
+        if (entryPtr->hash == hash && strcmp((const char *)&debugContextPtr->_.heap[
+            debugContextPtr->labelRegionByteOffset + entryPtr->labelStrByteOffset], labelStr) == 0)
+        {
+            return labelId;
+        }
+    }
+
+    return MEMORY_SHORT_ID_NULL;
+}
+
+// keeps the slot table at most half full; entries never move, so label ids stay stable
+static b32
+_memory_grow_label_table(struct memory_debug_context *debugContextPtr)
+{
+    u32 slotCapacity = (debugContextPtr->labelSlotCapacity > 0) ? debugContextPtr->labelSlotCapacity*2 : 64;
+
+    struct memory_label_entry *entryArr = realloc(debugContextPtr->labelEntryArr, 
+        sizeof(struct memory_label_entry)*(slotCapacity/2));
+    
+    if (!entryArr)
+    {
+        return B32_FALSE;
+    }
+
+    debugContextPtr->labelEntryArr = entryArr;
+
+    memory_short_id *slotArr = calloc(slotCapacity, sizeof(memory_short_id));
+
+    if (!slotArr)
+    {
+        return B32_FALSE;
+    }
+
+    for (u32 labelIndex = 0; labelIndex < debugContextPtr->labelCount; ++labelIndex)
+    {
+        u32 slotIndex = (u32)entryArr[labelIndex].hash & (slotCapacity - 1);
+
+        while (slotArr[slotIndex] != MEMORY_SHORT_ID_NULL)
+        {
+            slotIndex = (slotIndex + 1) & (slotCapacity - 1);
+        }
+
+        slotArr[slotIndex] = (memory_short_id)(labelIndex + 1);
+    }
+
+    free(debugContextPtr->labelSlotArr);
+
+    debugContextPtr->labelSlotArr = slotArr;
+    debugContextPtr->labelSlotCapacity = slotCapacity;
+
+    return B32_TRUE;
+}
+
+// returns the label's id, storing the string in the label region the first time it is seen. 
+// MEMORY_SHORT_ID_NULL if the region or the table is full.
+static memory_short_id
+_memory_intern_label(struct memory_debug_context *debugContextPtr, const char *labelStr)
+{
+    utils_hash hash;
+    utils_generate_hash_from_string(labelStr, &hash);
+
+    memory_short_id labelId = _memory_find_label(debugContextPtr, labelStr, hash);
+
+    if (labelId != MEMORY_SHORT_ID_NULL)
+    {
+        return labelId;
+    }
+
+    if (debugContextPtr->labelCount >= MEMORY_MAX_LABELS)
+    {
+        return MEMORY_SHORT_ID_NULL;
+    }
+
+    if (((u32)debugContextPtr->labelCount + 1)*2 > debugContextPtr->labelSlotCapacity && 
+        !_memory_grow_label_table(debugContextPtr))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Failure to grow the label table of context '%s'.",
+            __func__, __LINE__, debugContextPtr->label);
+
+        return MEMORY_SHORT_ID_NULL;
+    }
+
+    size_t labelLength = strlen(labelStr);
+    p64 labelStrByteOffset = debugContextPtr->labelRegionNextAllocationByteOffset;
+
+    if (((labelStrByteOffset + labelLength + 1) > debugContextPtr->labelRegionByteCapacity) ||
+        (_memory_commit_heap_region(&debugContextPtr->_, debugContextPtr->labelRegionByteOffset, 
+        &debugContextPtr->labelRegionCommittedBytes, labelStrByteOffset + labelLength + 1) != MEMORY_OK))
+    {
+        return MEMORY_SHORT_ID_NULL;
+    }
+
+    memcpy(&debugContextPtr->_.heap[debugContextPtr->labelRegionByteOffset + labelStrByteOffset], labelStr, 
+        labelLength + 1);
+
+    debugContextPtr->labelRegionNextAllocationByteOffset += labelLength + 1;
+
+    labelId = (memory_short_id)(++debugContextPtr->labelCount);
+
+    struct memory_label_entry *entryPtr = &debugContextPtr->labelEntryArr[labelId - 1];
+    entryPtr->hash = hash;
+    entryPtr->labelStrByteOffset = labelStrByteOffset;
+    entryPtr->activeAllocationCount = 0;
+
+    u32 slotMask = debugContextPtr->labelSlotCapacity - 1;
+    u32 slotIndex = (u32)hash & slotMask;
+
+    while (debugContextPtr->labelSlotArr[slotIndex] != MEMORY_SHORT_ID_NULL)
+    {
+        slotIndex = (slotIndex + 1) & slotMask;
+    }
+
+    debugContextPtr->labelSlotArr[slotIndex] = labelId;
+
+    return labelId;
+}
+
+static memory_int_id
+_memory_get_next_generation(memory_int_id lhsGeneration, memory_int_id rhsGeneration)
+{
+    memory_int_id generation = ((lhsGeneration > rhsGeneration) ? lhsGeneration : rhsGeneration) + 1;
+
+    return (generation == MEMORY_INT_ID_NULL) ? 1 : generation;
+}
+
+static void
+_memory_push_free_allocation_info(struct memory_context *contextPtr, u32 allocInfoIndex)
+{
+    struct memory_allocation_info *allocInfoArr = (void *)((p64)contextPtr->heap + 
+        contextPtr->allocationInfoRegionByteOffset);
+    struct memory_allocation_info *allocInfoPtr = &allocInfoArr[allocInfoIndex];
+
+    allocInfoPtr->isActive = B32_FALSE;
+    allocInfoPtr->mapCount = 0;
+    atomic_store_explicit(&allocInfoPtr->mapGate, 0, memory_order_relaxed);
+    allocInfoPtr->allocatorByteOffset = 0;
+    allocInfoPtr->slabClassId = 0;
+    allocInfoPtr->isSlab = B32_FALSE;
+
+    if (allocInfoPtr->labelId != MEMORY_SHORT_ID_NULL)
+    {
+        --((struct memory_debug_context *)contextPtr)->labelEntryArr[allocInfoPtr->labelId - 1].activeAllocationCount;
+
+        allocInfoPtr->labelId = MEMORY_SHORT_ID_NULL;
+    }
+
+    // every key handed out for this info is stale from here on
+    allocInfoPtr->generation = _memory_get_next_generation(allocInfoPtr->generation, 
+        allocInfoPtr->restoredGenerationFloor);
+    allocInfoPtr->restoredGenerationFloor = 0;
+
+    if (contextPtr->pagesRegionFreeAllocationInfoCount > 0)
+    {
+        u32 headAllocInfoIndex = contextPtr->pagesRegionFreeAllocationInfoByteOffsetList/
+            sizeof(struct memory_allocation_info);
+        struct memory_allocation_info *headAllocInfoPtr = &allocInfoArr[headAllocInfoIndex];
+        struct memory_allocation_info *tailAllocInfoPtr = &allocInfoArr[headAllocInfoPtr->prevAllocationInfoIndex];
+
+        allocInfoPtr->prevAllocationInfoIndex = headAllocInfoPtr->prevAllocationInfoIndex;
+        allocInfoPtr->nextAllocationInfoIndex = headAllocInfoIndex;
+
+        tailAllocInfoPtr->nextAllocationInfoIndex = allocInfoIndex;
+        headAllocInfoPtr->prevAllocationInfoIndex = allocInfoIndex;
+    }
+    else 
+    {
+        allocInfoPtr->prevAllocationInfoIndex = allocInfoPtr->nextAllocationInfoIndex = allocInfoIndex;
+    }
+
+    contextPtr->pagesRegionFreeAllocationInfoByteOffsetList = allocInfoIndex*sizeof(struct memory_allocation_info);
+    ++contextPtr->pagesRegionFreeAllocationInfoCount;
+}
+
+static memory_error_code
+_memory_pop_free_allocation_info(struct memory_context *contextPtr, u32 *outAllocInfoIndex)
+{
+    struct memory_allocation_info *allocInfoArr = (void *)((p64)contextPtr->heap + 
+        contextPtr->allocationInfoRegionByteOffset);
+
+    if (contextPtr->pagesRegionFreeAllocationInfoCount > 0)
+    {
+        u32 allocInfoIndex = contextPtr->pagesRegionFreeAllocationInfoByteOffsetList/
+            sizeof(struct memory_allocation_info);
+        struct memory_allocation_info *allocInfoPtr = &allocInfoArr[allocInfoIndex];
+
+        if (contextPtr->pagesRegionFreeAllocationInfoCount > 1)
+        {
+            allocInfoArr[allocInfoPtr->prevAllocationInfoIndex].nextAllocationInfoIndex = 
+                allocInfoPtr->nextAllocationInfoIndex;
+            allocInfoArr[allocInfoPtr->nextAllocationInfoIndex].prevAllocationInfoIndex = 
+                allocInfoPtr->prevAllocationInfoIndex;
+
+            contextPtr->pagesRegionFreeAllocationInfoByteOffsetList = allocInfoPtr->nextAllocationInfoIndex*
+                sizeof(struct memory_allocation_info);
+        }
+
+        --contextPtr->pagesRegionFreeAllocationInfoCount;
+
+        *outAllocInfoIndex = allocInfoIndex;
+
+        return MEMORY_OK;
+    }
+
+    if ((contextPtr->allocationInfoRegionByteCapacity - contextPtr->allocationInfoRegionBytesReserved) < 
+        sizeof(struct memory_allocation_info))
+    {
+        return MEMORY_ERROR_TOO_MANY_OBJECTS;
+    }
+
+    if (_memory_commit_heap_region(contextPtr, contextPtr->allocationInfoRegionByteOffset, 
+        &contextPtr->allocationInfoRegionCommittedBytes, contextPtr->allocationInfoRegionBytesReserved + 
+        sizeof(struct memory_allocation_info)) != MEMORY_OK)
+    {
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    u32 allocInfoIndex = contextPtr->allocationInfoRegionBytesReserved/sizeof(struct memory_allocation_info);
+
+    contextPtr->allocationInfoRegionBytesReserved += sizeof(struct memory_allocation_info);
+
+    // a fresh info starts at generation 1, so a zeroed key is never valid
+    allocInfoArr[allocInfoIndex].generation = 1;
+
+    *outAllocInfoIndex = allocInfoIndex;
+
+    return MEMORY_OK;
+}
+
+// the slot of a live raw allocation, or NULL
+static struct memory_raw_allocation_slot * 
+_memory_get_raw_allocation_slot(const struct memory_raw_allocation_key *rawAllocKeyPtr)
+{
+    if (!rawAllocKeyPtr || (rawAllocKeyPtr->generation == MEMORY_INT_ID_NULL) || 
+        (rawAllocKeyPtr->rawAllocIndex >= g_MEMORY_RAW_ALLOCATION_TABLE.slotCount))
+    {
+        return NULL;
+    }
+
+    struct memory_raw_allocation_slot *slotPtr = &g_MEMORY_RAW_ALLOCATION_TABLE.slotArr[rawAllocKeyPtr->rawAllocIndex];
+
+    return (slotPtr->allocatorPtr && (slotPtr->generation == rawAllocKeyPtr->generation)) ? slotPtr : NULL;
+}
+
+// a free slot, or a new one (growing the table when it's full)
+static memory_error_code
+_memory_pop_free_raw_allocation_slot(u32 *outSlotIndex)
+{
+    struct memory_raw_allocation_table *tablePtr = &g_MEMORY_RAW_ALLOCATION_TABLE;
+
+    if (tablePtr->freeSlotListHeadId != 0)
+    {
+        *outSlotIndex = tablePtr->freeSlotListHeadId - 1;
+        tablePtr->freeSlotListHeadId = tablePtr->slotArr[*outSlotIndex].nextFreeSlotId;
+
+        return MEMORY_OK;
+    }
+
+    if (tablePtr->slotCount == tablePtr->slotCapacity)
+    {
+        u32 slotCapacity = (tablePtr->slotCapacity > 0) ? tablePtr->slotCapacity*2 : 
+            MEMORY_RAW_ALLOCATION_TABLE_INITIAL_CAPACITY;
+        struct memory_raw_allocation_slot *slotArr = realloc(tablePtr->slotArr, 
+            sizeof(struct memory_raw_allocation_slot)*slotCapacity);
+
+        if (!slotArr)
+        {
+            return MEMORY_ERROR_FAILED_ALLOCATION;
+        }
+
+        tablePtr->slotArr = slotArr;
+        tablePtr->slotCapacity = slotCapacity;
+    }
+
+    *outSlotIndex = tablePtr->slotCount++;
+
+    // a fresh slot starts at generation 1, so a zeroed key is never valid
+    tablePtr->slotArr[*outSlotIndex].generation = 1;
+
+    return MEMORY_OK;
+}
+
+static void
+_memory_push_free_raw_allocation_slot(u32 slotIndex)
+{
+    struct memory_raw_allocation_table *tablePtr = &g_MEMORY_RAW_ALLOCATION_TABLE;
+    struct memory_raw_allocation_slot *slotPtr = &tablePtr->slotArr[slotIndex];
+
+    slotPtr->allocatorPtr = NULL;
+
+    // every key handed out for this slot is stale from here on
+    if ((++slotPtr->generation) == MEMORY_INT_ID_NULL)
+    {
+        slotPtr->generation = 1;
+    }
+
+    slotPtr->nextFreeSlotId = tablePtr->freeSlotListHeadId;
+    tablePtr->freeSlotListHeadId = slotIndex + 1;
+}
+
+#if (defined(linux) || defined(__linux__)) && defined(MREMAP_MAYMOVE)
+    #define MEMORY_USE_RAW_MAP
+#endif
+
+static struct memory_raw_allocator *
+_memory_raw_allocator_alloc(u64 byteSize)
+{
+    u64 allocatorByteSize = sizeof(struct memory_raw_allocator) + byteSize;
+    struct memory_raw_allocator *rawAllocatorPtr;
+
+#if defined(MEMORY_USE_RAW_MAP)
+    if (byteSize >= MEMORY_RAW_MAP_THRESHOLD)
+    {
+        rawAllocatorPtr = mmap(NULL, allocatorByteSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (rawAllocatorPtr == MAP_FAILED)
+        {
+            return NULL;
+        }
+
+        rawAllocatorPtr->mappedByteSize = allocatorByteSize;
+
+        return rawAllocatorPtr;
+    }
+#endif
+
+    if ((rawAllocatorPtr = malloc(allocatorByteSize)))
+    {
+        rawAllocatorPtr->mappedByteSize = 0;
+    }
+
+    return rawAllocatorPtr;
+}
+
+static struct memory_raw_allocator *
+_memory_raw_allocator_realloc(struct memory_raw_allocator *rawAllocatorPtr, u64 byteSize)
+{
+    u64 allocatorByteSize = sizeof(struct memory_raw_allocator) + byteSize;
+
+#if defined(MEMORY_USE_RAW_MAP)
+    if (rawAllocatorPtr->mappedByteSize > 0)
+    {
+        void *resultPtr = mremap(rawAllocatorPtr, rawAllocatorPtr->mappedByteSize, allocatorByteSize, MREMAP_MAYMOVE);
+
+        if (resultPtr == MAP_FAILED)
+        {
+            return NULL;
+        }
+
+        rawAllocatorPtr = resultPtr;
+        rawAllocatorPtr->mappedByteSize = allocatorByteSize;
+
+        return rawAllocatorPtr;
+    }
+
+    // outgrowing malloc: one last copy into a mapping, every later grow is an mremap
+    if (byteSize >= MEMORY_RAW_MAP_THRESHOLD)
+    {
+        struct memory_raw_allocator *mappedAllocatorPtr = _memory_raw_allocator_alloc(byteSize);
+
+        if (!mappedAllocatorPtr)
+        {
+            return NULL;
+        }
+
+        u64 mappedByteSize = mappedAllocatorPtr->mappedByteSize;
+
+        memcpy(mappedAllocatorPtr, rawAllocatorPtr, sizeof(struct memory_raw_allocator) + rawAllocatorPtr->byteSize);
+
+        mappedAllocatorPtr->mappedByteSize = mappedByteSize;
+
+        free(rawAllocatorPtr);
+
+        return mappedAllocatorPtr;
+    }
+#endif
+
+    return realloc(rawAllocatorPtr, allocatorByteSize);
+}
+
+static void
+_memory_raw_allocator_free(struct memory_raw_allocator *rawAllocatorPtr)
+{
+#if defined(MEMORY_USE_RAW_MAP)
+    if (rawAllocatorPtr->mappedByteSize > 0)
+    {
+        munmap(rawAllocatorPtr, rawAllocatorPtr->mappedByteSize);
+
+        return;
+    }
+#endif
+
+    free(rawAllocatorPtr);
+}
+
+static struct memory_raw_allocator *
+_memory_get_raw_allocator(const struct memory_raw_allocation_key *rawAllocKeyPtr)
+{
+    struct memory_raw_allocation_slot *slotPtr = _memory_get_raw_allocation_slot(rawAllocKeyPtr);
+
+    return slotPtr ? slotPtr->allocatorPtr : NULL;
+}
+
+memory_error_code
+_memory_get_is_raw_allocation_operation_ok()
+{
+    if ((g_MEMORY_RAW_ALLOCATION_TABLE.slotCapacity > 0) && (!g_MEMORY_RAW_ALLOCATION_TABLE.slotArr))
+    {
+        return MEMORY_ERROR_UNKNOWN;
+    }
+
+    if (g_MEMORY_RAW_ALLOCATION_TABLE.count >= MEMORY_MAX_RAW_ALLOCS)
+    {
+        return MEMORY_ERROR_TOO_MANY_OBJECTS;
+    }
+
+    return MEMORY_OK;
+}
+
+static memory_error_code
+_memory_raw_alloc_locked(const struct memory_raw_allocation_key *outRawAllocKeyPtr, u64 byteSize)
+{
+    if (!outRawAllocKeyPtr)
+    {
+        utils_fprintf(stderr, "%s(Line: %d): 'outRawAllocKeyPtr' "
+            "parameter cannot be NULL.\n", __FUNCTION__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    memset((void *)outRawAllocKeyPtr, '\0', sizeof(struct memory_raw_allocation_key));
+
+    if (byteSize < 1)
+    {
+        utils_fprintf(stderr, "%s(Line: %d): ByteSize less than 1. "
+            "Failure to allocate.\n", __FUNCTION__, __LINE__);
+        
+        return MEMORY_ERROR_ZERO_PARAMETER;
+    }
+    
+    {
+        memory_error_code resultCode;
+
+        if ((resultCode = _memory_get_is_raw_allocation_operation_ok()) != MEMORY_OK)
+        {
+            memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
+            
+            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Cannot raw allocate!\n", 
+                __FUNCTION__, __LINE__, (u32)errorCode);
+            
+            return errorCode;
+        }
+    }
+
+    u32 slotIndex;
+
+    if (_memory_pop_free_raw_allocation_slot(&slotIndex) != MEMORY_OK)
+    {
+        memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
+
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Failure to grow the raw allocation table.\n", 
+            __FUNCTION__, __LINE__, (u32)errorCode);
+
+        return errorCode;
+    }
+
+    struct memory_raw_allocator *rawAllocatorPtr = _memory_raw_allocator_alloc(byteSize);
+
+    if (!rawAllocatorPtr)
+    {
+        memory_error_code errorCode = MEMORY_ERROR_FAILED_ALLOCATION;
+
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Failure to alloc raw allocation.\n", __FUNCTION__,
+            __LINE__, (u32)errorCode);
+
+        _memory_push_free_raw_allocation_slot(slotIndex);
+
+        return errorCode;
+    }
+
+    struct memory_raw_allocation_slot *slotPtr = &g_MEMORY_RAW_ALLOCATION_TABLE.slotArr[slotIndex];
+
+    slotPtr->allocatorPtr = rawAllocatorPtr;
+    ++g_MEMORY_RAW_ALLOCATION_TABLE.count;
+
+    memset((void *)&rawAllocatorPtr->allocKey, '\0', sizeof(struct memory_allocation_key));
+
+    rawAllocatorPtr->identifier = MEMORY_HEADER_ID;
+    rawAllocatorPtr->byteSize = byteSize;
+    ((struct memory_allocation_key *)&(rawAllocatorPtr->allocKey))->raw.generation = slotPtr->generation;
+    ((struct memory_allocation_key *)&(rawAllocatorPtr->allocKey))->raw.rawAllocIndex = slotIndex;
+    ((struct memory_allocation_key *)&(rawAllocatorPtr->allocKey))->isManaged = B32_FALSE;
+
+    ((struct memory_raw_allocation_key *)outRawAllocKeyPtr)->generation = slotPtr->generation;
+    ((struct memory_raw_allocation_key *)outRawAllocKeyPtr)->rawAllocIndex = slotIndex;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_raw_alloc(const struct memory_raw_allocation_key *outRawAllocKeyPtr, u64 byteSize)
+{
+    struct memory_lock *lockPtr = &g_MEMORY_RAW_LOCK;
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_raw_alloc_locked(outRawAllocKeyPtr, byteSize);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_raw_realloc_locked(const struct memory_raw_allocation_key *rawAllocKeyPtr, u64 byteSize)
+{
+    if (!rawAllocKeyPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if (rawAllocKeyPtr->generation == MEMORY_INT_ID_NULL)
+    {
+        return MEMORY_ERROR_NULL_ID;
+    }
+
+    struct memory_raw_allocation_slot *slotPtr = _memory_get_raw_allocation_slot(rawAllocKeyPtr);
+
+    if (!slotPtr)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+    }
+
+    struct memory_raw_allocator **allocatorPtrPtr = &slotPtr->allocatorPtr;
+
+    struct memory_raw_allocator *resultPtr = _memory_raw_allocator_realloc(*allocatorPtrPtr, byteSize);
+
+    if (!resultPtr)
+    {
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    *allocatorPtrPtr = resultPtr;
+    (*allocatorPtrPtr)->byteSize = byteSize;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_raw_realloc(const struct memory_raw_allocation_key *rawAllocKeyPtr, u64 byteSize)
+{
+    struct memory_lock *lockPtr = &g_MEMORY_RAW_LOCK;
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_raw_realloc_locked(rawAllocKeyPtr, byteSize);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_raw_free_locked(const struct memory_raw_allocation_key *rawAllocKeyPtr)
+{
+    if (!rawAllocKeyPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'rawAllocKeyPtr' argument "
+            "cannot be NULL. Cannot free allocation." , __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if ((rawAllocKeyPtr->generation == MEMORY_INT_ID_NULL))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'rawAllocKeyPtr' argument "
+            "cannot be a NULL ID. Cannot free allocation." , __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ID;
+    }
+
+    struct memory_raw_allocation_slot *slotPtr = _memory_get_raw_allocation_slot(rawAllocKeyPtr);
+
+    if (!slotPtr)
+    {
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Cannot free an "
+            "inactive raw allocation.\n", __FUNCTION__,
+            __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+    }
+
+    _memory_raw_allocator_free(slotPtr->allocatorPtr);
+
+    _memory_push_free_raw_allocation_slot(rawAllocKeyPtr->rawAllocIndex);
+
+    --g_MEMORY_RAW_ALLOCATION_TABLE.count;
+
+    memset((void *)rawAllocKeyPtr, '\0', sizeof(struct memory_raw_allocation_key));
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_raw_free(const struct memory_raw_allocation_key *rawAllocKeyPtr)
+{
+    struct memory_lock *lockPtr = &g_MEMORY_RAW_LOCK;
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_raw_free_locked(rawAllocKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_map_raw_allocation_locked(const struct memory_raw_allocation_key *rawAllocKeyPtr, void **outDataPtr)
+{
+    if (!rawAllocKeyPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if (rawAllocKeyPtr->generation == MEMORY_INT_ID_NULL)
+    {
+        return MEMORY_ERROR_NULL_ID;
+    }
+
+    if (!outDataPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_raw_allocator *allocatorPtr = _memory_get_raw_allocator(rawAllocKeyPtr);
+
+    if (!allocatorPtr)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+    }
+
+    *outDataPtr = allocatorPtr + 1;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_map_raw_allocation(const struct memory_raw_allocation_key *rawAllocKeyPtr, void **outDataPtr)
+{
+    struct memory_lock *lockPtr = &g_MEMORY_RAW_LOCK;
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_map_raw_allocation_locked(rawAllocKeyPtr, outDataPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_unmap_raw_allocation_locked(void **outDataPtr)
+{
+    if (!outDataPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_raw_allocator *allocatorPtr = (struct memory_raw_allocator *)(*outDataPtr) - 1;
+
+    if (allocatorPtr->identifier != MEMORY_HEADER_ID)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+    }
+
+    *outDataPtr = NULL;
+
+    // TODO: make mappings matter, and there can only be one active mapped raw allocation.
+    // same with normal allocations as well.
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_unmap_raw_allocation(void **outDataPtr)
+{
+    struct memory_lock *lockPtr = &g_MEMORY_RAW_LOCK;
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_unmap_raw_allocation_locked(outDataPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+memory_error_code
+memory_get_is_raw_allocation_operation_ok()
+{
+    return _memory_get_is_raw_allocation_operation_ok();
+}
+
+memory_error_code
+memory_create_debug_context(u64 allocationInfoRegionByteCapacity, u64 pagesRegionByteCapacity, u64 labelRegionByteCapacity, 
+    const char *contextLabel, const struct memory_context_key *outputMemoryDebugContextKeyPtr)
+{
+    {
+        if (!outputMemoryDebugContextKeyPtr)
+        {
+            utils_fprintf(stderr, "memory_create_debug_context(%d): 'outputMemoryDebugContextKeyPtr' parameter is NULL.\n", 
+                __LINE__);
+            
+            return MEMORY_ERROR_NULL_ARGUMENT;
+        }
+    }
+
+    u64 totalBytesToAllocate = allocationInfoRegionByteCapacity + pagesRegionByteCapacity + labelRegionByteCapacity;
+
+    struct memory_debug_context *debugContextPtr;
+    memory_short_id contextId = g_DEBUG_CONTEXT_COUNT + 1;
+    {
+        memory_error_code contextAllocResultCode;
+
+        if ((contextAllocResultCode = _memory_alloc_context((struct memory_context **)&debugContextPtr, B32_TRUE)) != MEMORY_OK)
+        {
+            switch (contextAllocResultCode)
+            {
+                case MEMORY_ERROR_NULL_ID:
+                {
+                    utils_fprintf(stderr, "memory_create_debug_context(%d): Output parameter is NULL for internal '_memory_alloc_context' function result.\n",
+                         __LINE__);
+
+                    return MEMORY_ERROR_FAILED_ALLOCATION;
+                } break;
+
+                default:
+                {
+                    utils_fprintf(stderr, "memory_create_debug_context(%d): Unknown error for internal '_memory_alloc_context' function result.\n",
+                         __LINE__);
+
+                    return MEMORY_ERROR_UNKNOWN;
+                } break;
+            }
+        }
+    }
+
+    debugContextPtr->_.id = contextId;
+    debugContextPtr->_.pagesRegionAccumActiveAllocationCount = 0;
+    debugContextPtr->_.allocationInfoRegionBytesReserved = 0;
+    debugContextPtr->_.pagesRegionFreeAllocationInfoByteOffsetList = 0;
+    debugContextPtr->_.pagesRegionFreeAllocationInfoCount = 0;
+    debugContextPtr->_.pagesRegionByteCapacity = pagesRegionByteCapacity;
+    debugContextPtr->_.pagesRegionByteOffset = (p64)(allocationInfoRegionByteCapacity);
+    debugContextPtr->_.pagesRegionInfoArr = NULL;
+    debugContextPtr->_.allocationInfoRegionByteCapacity = allocationInfoRegionByteCapacity;
+    debugContextPtr->_.allocationInfoRegionByteOffset = 0;
+    debugContextPtr->_.pagesRegionInfoCount = 0;
+    debugContextPtr->_.pagesRegionInfoCapacity = 0;
+    debugContextPtr->_.pagesRegionInfoFreeListHeadId = MEMORY_SHORT_ID_NULL;
+    debugContextPtr->_.pagesRegionReorderInfoIndex = 0;
+    debugContextPtr->_.activePagesByteOffsetList = debugContextPtr->_.freePagesByteOffsetList = MEMORY_SHORT_ID_NULL;
+    debugContextPtr->_.pagesRegionActiveCount = 0;
+    debugContextPtr->_.pagesRegionFreeCount = 0;
+    debugContextPtr->_.isDebug = B32_TRUE;
+
+    memset(&debugContextPtr->_.stats, '\0', sizeof(struct memory_context_stats));
+
+    if (_memory_init_context_heap(&debugContextPtr->_, totalBytesToAllocate) != MEMORY_OK)
+    {
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    if (contextLabel)
+    {
+        strncpy(debugContextPtr->label, contextLabel, MEMORY_MAX_NAME_LENGTH);
+    }
+    else 
+    {
+        debugContextPtr->label[0] = '\0';
+    }
+
+    debugContextPtr->eventQueuePtr = NULL;
+    debugContextPtr->labelRegionByteCapacity = labelRegionByteCapacity;
+    debugContextPtr->labelRegionByteOffset = allocationInfoRegionByteCapacity + pagesRegionByteCapacity;
+    // byte 0 stays an empty string, so a zero offset never reads as a real label
+    debugContextPtr->labelRegionNextAllocationByteOffset = 1;
+    debugContextPtr->labelRegionCommittedBytes = 0;
+    debugContextPtr->labelEntryArr = NULL;
+    debugContextPtr->labelSlotArr = NULL;
+    debugContextPtr->labelSlotCapacity = 0;
+    debugContextPtr->labelCount = 0;
+
+    if (_memory_commit_heap_region(&debugContextPtr->_, debugContextPtr->labelRegionByteOffset, 
+        &debugContextPtr->labelRegionCommittedBytes, 1) != MEMORY_OK)
+    {
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    debugContextPtr->_.heap[debugContextPtr->labelRegionByteOffset] = '\0';
+
+    ((struct memory_context_key *)outputMemoryDebugContextKeyPtr)->contextId = contextId;
+    ((struct memory_context_key *)outputMemoryDebugContextKeyPtr)->isDebug = B32_TRUE;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_create_context(u64 allocationInfoRegionByteCapacity, u64 pagesRegionByteCapacity, 
+    const struct memory_context_key *outputMemoryContextKeyPtr)
+{
+    if (!outputMemoryContextKeyPtr)
+    {
+        utils_fprintf(stderr, "memory_create_context(%d): 'outputMemoryContextKeyPtr' parameter is NULL.\n", __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    u64 totalBytesToAllocate = allocationInfoRegionByteCapacity + pagesRegionByteCapacity;
+
+    struct memory_context *contextPtr;
+    memory_short_id contextId = g_CONTEXT_COUNT + 1;
+    {
+        memory_error_code contextAllocResultCode;
+
+        if ((contextAllocResultCode = _memory_alloc_context(&contextPtr, B32_FALSE)) != MEMORY_OK)
+        {
+            switch (contextAllocResultCode)
+            {
+                case MEMORY_ERROR_NULL_ID:
+                {
+                    utils_fprintf(stderr, "memory_create_context(%d): Output parameter is NULL for internal '_memory_alloc_context' function result.\n",
+                         __LINE__);
+                    
+                    memset((struct memory_context_key *)outputMemoryContextKeyPtr, '\0', sizeof(struct memory_context_key));
+
+                    return MEMORY_ERROR_FAILED_ALLOCATION;
+                } break;
+
+                default:
+                {
+                    utils_fprintf(stderr, "memory_create_context(%d): Unknown error for internal '_memory_alloc_context' function result.\n",
+                         __LINE__);
+                    
+                    memset((struct memory_context_key *)outputMemoryContextKeyPtr, '\0', sizeof(struct memory_context_key));
+
+                    return MEMORY_ERROR_UNKNOWN;
+                } break;
+            }
+        }
+    }
+
+    contextPtr->id = contextId;
+    contextPtr->pagesRegionAccumActiveAllocationCount = 0;
+    contextPtr->allocationInfoRegionBytesReserved = 0;
+    contextPtr->pagesRegionFreeAllocationInfoCount = 0;
+    contextPtr->pagesRegionByteCapacity = pagesRegionByteCapacity;
+    contextPtr->pagesRegionByteOffset = (p64)(allocationInfoRegionByteCapacity);
+    contextPtr->pagesRegionInfoArr = NULL;
+    contextPtr->allocationInfoRegionByteCapacity = allocationInfoRegionByteCapacity;
+    contextPtr->allocationInfoRegionByteOffset = 0;
+    contextPtr->pagesRegionInfoCount = 0;
+    contextPtr->pagesRegionInfoCapacity = 0;
+    contextPtr->pagesRegionInfoFreeListHeadId = MEMORY_SHORT_ID_NULL;
+    contextPtr->pagesRegionReorderInfoIndex = 0;
+    contextPtr->activePagesByteOffsetList = contextPtr->freePagesByteOffsetList = MEMORY_SHORT_ID_NULL;
+    contextPtr->pagesRegionActiveCount = 0;
+    contextPtr->pagesRegionFreeCount = 0;
+    contextPtr->isDebug = B32_FALSE;
+
+    memset(&contextPtr->stats, '\0', sizeof(struct memory_context_stats));
+
+    if (_memory_init_context_heap(contextPtr, totalBytesToAllocate) != MEMORY_OK)
+    {
+        memset((struct memory_context_key *)outputMemoryContextKeyPtr, '\0', sizeof(struct memory_context_key));
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+    
+    ((struct memory_context_key *)outputMemoryContextKeyPtr)->contextId = contextId;
+    ((struct memory_context_key *)outputMemoryContextKeyPtr)->isDebug = B32_FALSE;
+
+    return MEMORY_OK;
+}
+
+// single reader, run on the writer thread only. Streams every published event to the trace file; events that 
+// were overwritten before they could be read are counted as dropped. Stops at the first slot still being written.
+static memory_error_code
+_memory_event_queue_drain(struct memory_event_queue *queuePtr)
+{
+    #define MEMORY_EVENT_DRAIN_BATCH_COUNT 256
+
+    u64 writeIndex = atomic_load_explicit(&queuePtr->writeIndex, memory_order_acquire);
+
+    if ((writeIndex - queuePtr->readIndex) > queuePtr->capacity)
+    {
+        queuePtr->droppedCount += writeIndex - queuePtr->capacity - queuePtr->readIndex;
+        queuePtr->readIndex = writeIndex - queuePtr->capacity;
+    }
+
+    struct memory_event eventBatchArr[MEMORY_EVENT_DRAIN_BATCH_COUNT];
+    u32 eventBatchCount = 0;
+    memory_error_code resultCode = MEMORY_OK;
+
+    while (queuePtr->readIndex < writeIndex)
+    {
+        u64 eventId = queuePtr->readIndex;
+        struct memory_event_slot *slotPtr = &queuePtr->slotArr[eventId & (queuePtr->capacity - 1)];
+        u64 sequence = atomic_load_explicit(&slotPtr->sequence, memory_order_acquire);
+
+        if ((sequence == 0) || (sequence < (eventId + 1)))
+        {
+            // claimed, but not published yet; pick it up next drain
+            break;
+        }
+        else if (sequence == (eventId + 1))
+        {
+            eventBatchArr[eventBatchCount] = slotPtr->event;
+
+            atomic_thread_fence(memory_order_acquire);
+
+            if (atomic_load_explicit(&slotPtr->sequence, memory_order_relaxed) == sequence)
+            {
+                ++eventBatchCount;
+            }
+            else 
+            {
+                ++queuePtr->droppedCount;
+            }
+        }
+        else
+        {
+            ++queuePtr->droppedCount;
+        }
+
+        ++queuePtr->readIndex;
+
+        if (eventBatchCount == MEMORY_EVENT_DRAIN_BATCH_COUNT)
+        {
+            if (fwrite(eventBatchArr, sizeof(struct memory_event), eventBatchCount, 
+                queuePtr->traceFilePtr) != eventBatchCount)
+            {
+                resultCode = MEMORY_ERROR_FAILED_ALLOCATION;
+            }
+
+            eventBatchCount = 0;
+        }
+    }
+
+    if ((eventBatchCount > 0) && (fwrite(eventBatchArr, sizeof(struct memory_event), eventBatchCount, 
+        queuePtr->traceFilePtr) != eventBatchCount))
+    {
+        resultCode = MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    return resultCode;
+}
+
+// drains the ring every MEMORY_EVENT_WRITER_INTERVAL_NS, so the file I/O stays off the threads that record events. 
+// After the stop request it drains once more, which picks up everything recorded before the queue was detached.
+static void
+_memory_event_queue_write_loop(struct memory_event_queue *queuePtr)
+{
+    while (!atomic_load_explicit(&queuePtr->isStopping, memory_order_acquire))
+    {
+        if (_memory_event_queue_drain(queuePtr) != MEMORY_OK)
+        {
+            utils_fprintfln(stderr, "%s(Line: %d): Failure to write events to the trace file.", 
+                __func__, __LINE__);
+
+            queuePtr->writeResultCode = MEMORY_ERROR_FAILED_ALLOCATION;
+
+            return;
+        }
+
+        _memory_sleep_ns(MEMORY_EVENT_WRITER_INTERVAL_NS);
+    }
+
+    if (_memory_event_queue_drain(queuePtr) != MEMORY_OK)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Failure to write events to the trace file.",
+            __func__, __LINE__);
+
+        queuePtr->writeResultCode = MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+}
+
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+static DWORD WINAPI
+_memory_event_queue_writer_main(LPVOID queuePtr)
+{
+    _memory_event_queue_write_loop(queuePtr);
+
+    return 0;
+}
+#elif defined(linux) || defined(__linux__)
+static void * 
+_memory_event_queue_writer_main(void *queuePtr)
+{
+    _memory_event_queue_write_loop(queuePtr);
+
+    return NULL;
+}
+#endif
+
+static b32
+_memory_event_queue_start_writer(struct memory_event_queue *queuePtr)
+{
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+    queuePtr->writerThread = CreateThread(NULL, 0, _memory_event_queue_writer_main, queuePtr, 0, NULL);
+
+    return queuePtr->writerThread != NULL;
+#elif defined(linux) || defined(__linux__)
+    return pthread_create(&queuePtr->writerThread, NULL, _memory_event_queue_writer_main, queuePtr) == 0;
+#endif
+}
+
+static void
+_memory_event_queue_join_writer(struct memory_event_queue *queuePtr)
+{
+#if defined(_WIN32) || defined(__WIN32) || defined(WIN32)
+    WaitForSingleObject(queuePtr->writerThread, INFINITE);
+    CloseHandle(queuePtr->writerThread);
+#elif defined(linux) || defined(__linux__)
+    pthread_join(queuePtr->writerThread, NULL);
+#endif
+}
+
+static memory_error_code
+_memory_debug_context_begin_trace_locked(const struct memory_context_key *memoryContextKeyPtr, u32 eventCapacity,
+    const char *traceFilePathStr)
+{
+    if (!traceFilePathStr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'traceFilePathStr' argument cannot be NULL.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+    else if (eventCapacity < 2)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'eventCapacity' argument is too small for an event queue.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_SIZE_TOO_SMALL;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    if (!contextPtr->isDebug)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Only debug contexts record events.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+    }
+
+    struct memory_debug_context *debugContextPtr = (void *)contextPtr;
+
+    if (debugContextPtr->eventQueuePtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Context is already tracing.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_UNKNOWN;
+    }
+
+    // power of two, so a slot is a mask away from its event id
+    u32 capacity = 2;
+
+    while ((capacity < eventCapacity) && (capacity < (1u << 31)))
+    {
+        capacity <<= 1;
+    }
+
+    FILE *traceFilePtr = fopen(traceFilePathStr, "wb");
+
+    if (!traceFilePtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Failure to open trace file '%s'.",
+            __func__, __LINE__, traceFilePathStr);
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    struct memory_event_trace_header traceHeader;
+
+    memset(&traceHeader, '\0', sizeof(struct memory_event_trace_header));
+    memcpy(traceHeader.magic, MEMORY_EVENT_TRACE_MAGIC, sizeof(traceHeader.magic));
+    traceHeader.version = MEMORY_EVENT_TRACE_VERSION;
+    traceHeader.eventByteSize = sizeof(struct memory_event);
+    traceHeader.startTimestampNS = _memory_get_time_ns();
+
+    struct memory_event_queue *queuePtr = malloc(sizeof(struct memory_event_queue));
+    struct memory_event_slot *slotArr = calloc(capacity, sizeof(struct memory_event_slot));
+
+    if (!queuePtr || !slotArr || (fwrite(&traceHeader, sizeof(struct memory_event_trace_header), 1, 
+        traceFilePtr) != 1))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Failure to set up the event queue.",
+            __func__, __LINE__);
+
+        free(slotArr);
+        free(queuePtr);
+        fclose(traceFilePtr);
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    queuePtr->slotArr = slotArr;
+    queuePtr->traceFilePtr = traceFilePtr;
+    queuePtr->readIndex = 0;
+    atomic_init(&queuePtr->writeIndex, 0);
+    queuePtr->droppedCount = 0;
+    queuePtr->capacity = capacity;
+    atomic_init(&queuePtr->isStopping, B32_FALSE);
+    queuePtr->writeResultCode = MEMORY_OK;
+
+    if (!_memory_event_queue_start_writer(queuePtr))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Failure to start the trace writer thread.", 
+            __func__, __LINE__);
+
+        free(slotArr);
+        free(queuePtr);
+        fclose(traceFilePtr);
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    debugContextPtr->eventQueuePtr = queuePtr;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_debug_context_begin_trace(const struct memory_context_key *memoryContextKeyPtr, u32 eventCapacity,
+    const char *traceFilePathStr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_debug_context_begin_trace_locked(memoryContextKeyPtr, eventCapacity,
+        traceFilePathStr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_debug_context_end_trace_locked(const struct memory_context_key *memoryContextKeyPtr)
+{
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    struct memory_debug_context *debugContextPtr = (void *)contextPtr;
+    struct memory_event_queue *queuePtr = debugContextPtr->eventQueuePtr;
+
+    if (!contextPtr->isDebug || !queuePtr)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+    }
+
+    // detached under the lock, so no new event lands in the ring; the writer drains what is left before it exits
+    debugContextPtr->eventQueuePtr = NULL;
+
+    atomic_store_explicit(&queuePtr->isStopping, B32_TRUE, memory_order_release);
+    _memory_event_queue_join_writer(queuePtr);
+
+    if (queuePtr->droppedCount > 0)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Trace of context '%s' dropped %llu events.",
+            __func__, __LINE__, debugContextPtr->label, (unsigned long long)queuePtr->droppedCount);
+    }
+
+    memory_error_code resultCode = queuePtr->writeResultCode;
+
+    fclose(queuePtr->traceFilePtr);
+    free(queuePtr->slotArr);
+    free(queuePtr);
+
+    return resultCode;
+}
+
+memory_error_code
+memory_debug_context_end_trace(const struct memory_context_key *memoryContextKeyPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_debug_context_end_trace_locked(memoryContextKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_debug_context_get_label_count_locked(const struct memory_context_key *memoryContextKeyPtr,
+    u16 *outLabelCount)
+{
+    if (!outLabelCount)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    *outLabelCount = 0;
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    if (!contextPtr->isDebug)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+    }
+
+    *outLabelCount = ((struct memory_debug_context *)contextPtr)->labelCount;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_debug_context_get_label_count(const struct memory_context_key *memoryContextKeyPtr, u16 *outLabelCount)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_debug_context_get_label_count_locked(memoryContextKeyPtr, outLabelCount);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_debug_context_get_label_locked(const struct memory_context_key *memoryContextKeyPtr,
+    memory_short_id labelId,
+    const char **outLabelStr, u32 *outActiveAllocationCount)
+{
+    if (!outLabelStr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    *outLabelStr = NULL;
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    if (!contextPtr->isDebug)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+    }
+
+    struct memory_debug_context *debugContextPtr = (void *)contextPtr;
+
+    if (labelId == MEMORY_SHORT_ID_NULL)
+    {
+        return MEMORY_ERROR_NULL_ID;
+    }
+
+    if (labelId > debugContextPtr->labelCount)
+    {
+        return MEMORY_ERROR_INDEX_OUT_OF_RANGE;
+    }
+
+    struct memory_label_entry *entryPtr = &debugContextPtr->labelEntryArr[labelId - 1];
+
+    *outLabelStr = (const char *)&contextPtr->heap[debugContextPtr->labelRegionByteOffset + 
+        entryPtr->labelStrByteOffset];
+
+    if (outActiveAllocationCount)
+    {
+        *outActiveAllocationCount = entryPtr->activeAllocationCount;
+    }
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_debug_context_get_label(const struct memory_context_key *memoryContextKeyPtr, memory_short_id labelId,
+    const char **outLabelStr, u32 *outActiveAllocationCount)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_debug_context_get_label_locked(memoryContextKeyPtr, labelId,
+        outLabelStr, outActiveAllocationCount);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+memory_error_code
+memory_get_context_key_is_ok(const struct memory_context_key *contextKeyPtr)
+{
+    return _memory_get_context_key_is_ok(contextKeyPtr);
+}
+
+static memory_error_code
+_memory_alloc_page_locked(const struct memory_context_key *memoryContextKeyPtr, u64 byteSize,
+    const struct memory_page_key *outPageKeyPtr)
+{
+    if ((_memory_get_context_key_is_ok(memoryContextKeyPtr)) != MEMORY_OK)
+    {
+        utils_fprintf(stderr, "%s(%d): Cannot allocate page, context key is not valid!\n", 
+                __FUNCTION__, __LINE__);
+        
+        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+    }
+    else if (!outPageKeyPtr)
+    {
+        utils_fprintf(stderr, "%s(%d): Cannot allocate page, 'cause 'outPageKeyPtr' argument is NULL!\n", 
+                __FUNCTION__, __LINE__);
+        
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+    else if (byteSize >= MEMORY_TLSF_MAX_BLOCK_SIZE)
+    {
+        utils_fprintf(stderr, "%s(%d): Cannot allocate page, 'cause 'byteSize' is larger than the allocator index "
+                "can address!\n", __FUNCTION__, __LINE__);
+        
+        return MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode;
+
+        if ((resultCode =_memory_get_context((struct memory_context_key *)memoryContextKeyPtr, 
+            &contextPtr)) != MEMORY_OK)
+        {
+            ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
+            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
+            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
+
+            return resultCode;
+        }
+    }
+
+    // get/allocate a page header and allocated bytes
+    p64 pagesRegionByteIndex = (p64)contextPtr->heap + contextPtr->pagesRegionByteOffset;
+    struct memory_page_header *pageHeaderPtr;
+
+    byteSize = (byteSize + 7) & ~(u64)7;
+
+    // if there are no free pages, and there are no active pages, then there are zero allocated pages! 
+    // Therefore the whole pages region becomes the first (free) page.
+    if ((contextPtr->pagesRegionFreeCount < 1) && (contextPtr->pagesRegionActiveCount < 1) && 
+        (contextPtr->pagesRegionByteCapacity > sizeof(struct memory_page_header)))
+    {
+        if (_memory_commit_pages_region(contextPtr, 0, sizeof(struct memory_page_header)) != MEMORY_OK)
+        {
+            ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
+            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
+            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
+
+            return MEMORY_ERROR_FAILED_ALLOCATION;
+        }
+
+        pageHeaderPtr = (struct memory_page_header *)pagesRegionByteIndex;
+
+        memset(pageHeaderPtr, '\0', sizeof(struct memory_page_header));
+
+        pageHeaderPtr->identifier = MEMORY_HEADER_ID;
+        pageHeaderPtr->heapByteSize = contextPtr->pagesRegionByteCapacity - sizeof(struct memory_page_header);
+
+        _memory_link_page_header(contextPtr, &contextPtr->freePagesByteOffsetList, &contextPtr->pagesRegionFreeCount, 0);
+    }
+
+    p64 pageHeaderByteOffset;
+    {
+        memory_error_code resultCode = MEMORY_ERROR_FAILED_ALLOCATION;
+
+        if (contextPtr->pagesRegionFreeCount > 0)
+        {
+            pageHeaderByteOffset = contextPtr->freePagesByteOffsetList;
+
+            do
+            {
+                pageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + pageHeaderByteOffset);
+
+                if (pageHeaderPtr->heapByteSize >= byteSize)
+                {
+                    resultCode = MEMORY_OK;
+
+                    break;
+                }
+            } while ((pageHeaderByteOffset = pageHeaderPtr->nextPageHeaderByteOffset) != 
+                contextPtr->freePagesByteOffsetList);
+        }
+
+        if (resultCode != MEMORY_OK)
+        {
+            ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
+            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
+            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
+            
+            utils_fprintf(stderr, "memory_alloc_page(%d): Failure to locate page large enough. "
+                    "Cannot allocate a page.\n", __LINE__);
+
+            return resultCode;
+        }
+    }
+
+    // split the page for future page allocations, if we can
+    u64 diffByteSize = pageHeaderPtr->heapByteSize - byteSize;
+    
+    if (diffByteSize > sizeof(struct memory_page_header))
+    {
+        p64 splitPageHeaderByteOffset = pageHeaderByteOffset + sizeof(struct memory_page_header) + byteSize;
+
+        if (_memory_commit_pages_region(contextPtr, splitPageHeaderByteOffset, 
+            sizeof(struct memory_page_header)) == MEMORY_OK)
+        {
+            struct memory_page_header *splitPageHeader = (struct memory_page_header *)(pagesRegionByteIndex + 
+                splitPageHeaderByteOffset);
+
+            memset(splitPageHeader, '\0', sizeof(struct memory_page_header));
+
+            splitPageHeader->identifier = MEMORY_HEADER_ID;
+            splitPageHeader->heapByteSize = diffByteSize - sizeof(struct memory_page_header);
+            
+            pageHeaderPtr->heapByteSize = byteSize;
+
+            _memory_link_page_header(contextPtr, &contextPtr->freePagesByteOffsetList, &contextPtr->pagesRegionFreeCount,
+                splitPageHeaderByteOffset);
+        }
+    }
+
+    _memory_unlink_page_header(contextPtr, &contextPtr->freePagesByteOffsetList, &contextPtr->pagesRegionFreeCount,
+        pageHeaderByteOffset);
+    _memory_link_page_header(contextPtr, &contextPtr->activePagesByteOffsetList, &contextPtr->pagesRegionActiveCount,
+        pageHeaderByteOffset);
+
+    pageHeaderPtr->identifier = MEMORY_HEADER_ID;
+    pageHeaderPtr->activeAllocatorCount = 0;
+    pageHeaderPtr->allocationInfoCount = 0;
+    pageHeaderPtr->compactionCursorByteOffset = sizeof(struct memory_page_header);
+    pageHeaderPtr->liveByteCount = 0;
+    pageHeaderPtr->highWaterByteCount = 0;
+    pageHeaderPtr->alignmentLog2 = MEMORY_TLSF_ALIGN_SIZE_LOG2;
+
+    memset(pageHeaderPtr->slabByteOffsetArr, '\0', sizeof(pageHeaderPtr->slabByteOffsetArr));
+
+    _memory_tlsf_reset(pageHeaderPtr);
+
+    #define PAGES_REGION_INFO_ARR_REALLOC_MULTIPLIER 4
+
+    memory_short_id pageId;
+    struct memory_page_info *pageInfoPtr;
+
+    if (contextPtr->pagesRegionInfoFreeListHeadId != MEMORY_SHORT_ID_NULL)
+    {
+        // reuse a freed page info; its generation was already bumped when it was freed
+        pageId = contextPtr->pagesRegionInfoFreeListHeadId;
+        pageInfoPtr = &contextPtr->pagesRegionInfoArr[pageId - 1];
+
+        contextPtr->pagesRegionInfoFreeListHeadId = pageInfoPtr->nextFreePageId;
+    }
+    else if (contextPtr->pagesRegionInfoCount < contextPtr->pagesRegionInfoCapacity)
+    {
+        pageId = contextPtr->pagesRegionInfoCount + 1;
+        pageInfoPtr = &contextPtr->pagesRegionInfoArr[pageId - 1];
+        pageInfoPtr->generation = 0;
+
+        ++contextPtr->pagesRegionInfoCount;
+    }
+    else
+    {
+        if (contextPtr->pagesRegionInfoCount > 0)
+        {
+            // not a realloc: release builds map allocations without the context lock, so another thread may 
+            // still be reading the old array. Old arrays are kept for the life of the context instead, chained 
+            // through an element in front of each one (together they're at most a third of the newest).
+            struct memory_page_info *tempPtr = malloc(sizeof(struct memory_page_info)*
+                (contextPtr->pagesRegionInfoCapacity*PAGES_REGION_INFO_ARR_REALLOC_MULTIPLIER + 1));
+            
+            if (tempPtr)
+            {
+                pageId = contextPtr->pagesRegionInfoCount + 1;
+
+                struct memory_page_info *retiredArr = contextPtr->pagesRegionInfoArr - 1;
+
+                memcpy(tempPtr, &retiredArr, sizeof(struct memory_page_info *));
+
+                tempPtr += 1;
+
+                memcpy(tempPtr, contextPtr->pagesRegionInfoArr, sizeof(struct memory_page_info)*
+                    contextPtr->pagesRegionInfoCount);
+
+                // the copy is complete before another thread can see the new array
+                atomic_thread_fence(memory_order_release);
+
+                contextPtr->pagesRegionInfoArr = tempPtr;
+                pageInfoPtr = &tempPtr[pageId - 1];
+                pageInfoPtr->generation = 0;
+
+                contextPtr->pagesRegionInfoCapacity *= PAGES_REGION_INFO_ARR_REALLOC_MULTIPLIER;
+            }
+            else 
+            {
+                ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
+                ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
+                ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
+
+                utils_fprintf(stderr, "memory_alloc_page(%d): Could not reallocate the pages info array. "
+                        "Cannot allocate a page.\n", __LINE__);
+                        
+                return MEMORY_ERROR_FAILED_ALLOCATION;
+            }
+        }
+        else 
+        {
+            struct memory_page_info *tempPtr = malloc(sizeof(struct memory_page_info)*2);
+
+            if (tempPtr)
+            {
+                memset(tempPtr, '\0', sizeof(struct memory_page_info));
+
+                contextPtr->pagesRegionInfoArr = tempPtr + 1;
+
+                pageId = contextPtr->pagesRegionInfoCount + 1;
+                pageInfoPtr = &contextPtr->pagesRegionInfoArr[pageId - 1];
+                pageInfoPtr->generation = 0;
+
+                ++contextPtr->pagesRegionInfoCapacity;
+            }
+            else 
+            {
+                ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
+                ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
+                ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
+
+                utils_fprintf(stderr, "memory_alloc_page(%d): Could not allocate the pages info array. "
+                        "Cannot allocate a page.\n", __LINE__);
+                        
+                return MEMORY_ERROR_FAILED_ALLOCATION;
+            }
+        }
+
+        ++contextPtr->pagesRegionInfoCount;
+    }
+
+    pageInfoPtr->pageHeaderByteOffset = (p64)pageHeaderPtr - pagesRegionByteIndex;
+    pageInfoPtr->status = MEMORY_PAGE_STATUS_UNLOCKED;
+    pageInfoPtr->nextFreePageId = MEMORY_SHORT_ID_NULL;
+
+    _memory_record_event(contextPtr, MEMORY_EVENT_PAGE_ALLOC, MEMORY_HANDLE_NULL, pageId, pageHeaderPtr->heapByteSize,
+        pageInfoPtr->pageHeaderByteOffset);
+
+    ((struct memory_page_key *)outPageKeyPtr)->pageId = pageId;
+    ((struct memory_page_key *)outPageKeyPtr)->generation = pageInfoPtr->generation;
+    ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = contextPtr->id;
+    ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = contextPtr->isDebug;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_alloc_page(const struct memory_context_key *memoryContextKeyPtr, u64 byteSize, const struct memory_page_key *outPageKeyPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_alloc_page_locked(memoryContextKeyPtr, byteSize, outPageKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_free_page_locked(const struct memory_page_key *pageKeyPtr)
+{
+    {
+        memory_error_code errorCode;
+
+        if ((errorCode = _memory_get_page_key_is_ok(pageKeyPtr)) != MEMORY_OK)
+        {
+            return errorCode;
+        }
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode;
+
+        if ((resultCode = _memory_get_context((struct memory_context_key *)&pageKeyPtr->contextKey, 
+            &contextPtr)) != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    struct memory_page_info *pageInfoPtr;
+    {
+        memory_error_code resultCode = _memory_get_page_info(contextPtr, pageKeyPtr, &pageInfoPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            utils_fprintf(stderr, "memory_free_page(%d): 'pageKeyPtr' does not refer to an active page. "
+                    "Cannot free a non-existent page.\n", __LINE__);
+
+            return resultCode;
+        }
+    }
+
+    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_FREED)
+    {
+        utils_fprintf(stderr, "memory_free_page(%d): Page is already freed.\n", __LINE__);
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
+    }
+
+    pageInfoPtr->status = MEMORY_PAGE_STATUS_FREED;
+
+    _memory_record_event(contextPtr, MEMORY_EVENT_PAGE_FREE, MEMORY_HANDLE_NULL, pageKeyPtr->pageId, 
+        ((struct memory_page_header *)((p64)contextPtr->heap + contextPtr->pagesRegionByteOffset + 
+        pageInfoPtr->pageHeaderByteOffset))->heapByteSize, pageInfoPtr->pageHeaderByteOffset);
+
+    p64 pagesRegionByteIndex = (p64)contextPtr->heap + contextPtr->pagesRegionByteOffset;
+    struct memory_page_header *pageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + 
+        pageInfoPtr->pageHeaderByteOffset);
+
+    _memory_unlink_page_header(contextPtr, &contextPtr->activePagesByteOffsetList, &contextPtr->pagesRegionActiveCount,
+        pageInfoPtr->pageHeaderByteOffset);
+    _memory_link_page_header(contextPtr, &contextPtr->freePagesByteOffsetList, &contextPtr->pagesRegionFreeCount,
+        pageInfoPtr->pageHeaderByteOffset);
+
+    // the page heap stays reserved and committed, but the os can take the physical memory back until it is touched
+    _memory_discard_heap_range(contextPtr, contextPtr->pagesRegionByteOffset + pageInfoPtr->pageHeaderByteOffset + 
+        sizeof(struct memory_page_header), pageHeaderPtr->heapByteSize);
+
+    // every allocation on the page dies with it; bumping the generations invalidates their keys
+    contextPtr->pagesRegionAccumActiveAllocationCount -= pageHeaderPtr->allocationInfoCount;
+    contextPtr->stats.freeCount += pageHeaderPtr->allocationInfoCount;
+    contextPtr->stats.frameFreeCount += pageHeaderPtr->allocationInfoCount;
+
+    _memory_track_live_bytes(contextPtr, pageHeaderPtr, 0, pageHeaderPtr->liveByteCount);
+
+    {
+        struct memory_allocation_info *allocInfoArr = (void *)&contextPtr->heap[contextPtr->allocationInfoRegionByteOffset];
+        u32 allocInfoIndex = pageHeaderPtr->allocationInfoByteOffsetList/sizeof(struct memory_allocation_info);
+
+        for (u32 allocInfoCount = pageHeaderPtr->allocationInfoCount; allocInfoCount > 0; --allocInfoCount)
+        {
+            u32 nextAllocInfoIndex = allocInfoArr[allocInfoIndex].nextAllocationInfoIndex;
+
+            _memory_push_free_allocation_info(contextPtr, allocInfoIndex);
+
+            allocInfoIndex = nextAllocInfoIndex;
+        }
+
+        pageHeaderPtr->allocationInfoCount = 0;
+    }
+
+    ++pageInfoPtr->generation;
+    pageInfoPtr->nextFreePageId = contextPtr->pagesRegionInfoFreeListHeadId;
+    contextPtr->pagesRegionInfoFreeListHeadId = pageKeyPtr->pageId;
+
+    // blocks of the page parked in thread caches are gone too
+    _memory_bump_page_epoch(&pageKeyPtr->contextKey);
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_free_page(const struct memory_page_key *pageKeyPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(pageKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_free_page_locked(pageKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+// grows the page over the free page physically after it, so the page header (and every allocation offset) stays 
+// where it is; keys and mapped pointers stay valid. shrinking would mean moving allocations out of the tail, so 
+// pages only ever grow
+static memory_error_code
+_memory_realloc_page_locked(const struct memory_page_key *pageKeyPtr, u64 byteSize)
+{
+    {
+        memory_error_code errorCode;
+
+        if ((errorCode = _memory_get_page_key_is_ok(pageKeyPtr)) != MEMORY_OK)
+        {
+            return errorCode;
+        }
+    }
+
+    if (byteSize >= MEMORY_TLSF_MAX_BLOCK_SIZE)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'byteSize' is larger than the allocator index can address.", 
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode;
+
+        if ((resultCode = _memory_get_context((struct memory_context_key *)&pageKeyPtr->contextKey, 
+            &contextPtr)) != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    struct memory_page_info *pageInfoPtr;
+    {
+        memory_error_code resultCode = _memory_get_page_info(contextPtr, pageKeyPtr, &pageInfoPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_FREED)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
+    }
+
+    p64 pagesRegionByteIndex = (p64)contextPtr->heap + contextPtr->pagesRegionByteOffset;
+    struct memory_page_header *pageHeaderPtr = (void *)(pagesRegionByteIndex + pageInfoPtr->pageHeaderByteOffset);
+
+    byteSize = (byteSize + 7) & ~(u64)7;
+
+    if (byteSize <= pageHeaderPtr->heapByteSize)
+    {
+        return MEMORY_OK;
+    }
+
+    b32 hasAllocators = (pageHeaderPtr->activeAllocatorCount > 0) || (pageHeaderPtr->freeAllocatorCount > 0);
+    u64 growByteSize = byteSize - pageHeaderPtr->heapByteSize;
+
+    // the grown tail becomes a free allocator before it merges with whatever is in front of it
+    if (hasAllocators && (growByteSize < (sizeof(struct memory_allocator) + MEMORY_TLSF_ALIGN_SIZE)))
+    {
+        growByteSize = sizeof(struct memory_allocator) + MEMORY_TLSF_ALIGN_SIZE;
+    }
+
+    // pages tile the pages region, so the page after this one starts right past its heap
+    p64 nextPageHeaderByteOffset = pageInfoPtr->pageHeaderByteOffset + sizeof(struct memory_page_header) + 
+        pageHeaderPtr->heapByteSize;
+    struct memory_page_header *nextPageHeaderPtr = NULL;
+
+    if ((nextPageHeaderByteOffset < contextPtr->pagesRegionByteCapacity) && (contextPtr->pagesRegionFreeCount > 0))
+    {
+        p64 freePageHeaderByteOffset = contextPtr->freePagesByteOffsetList;
+
+        do
+        {
+            if (freePageHeaderByteOffset == nextPageHeaderByteOffset)
+            {
+                nextPageHeaderPtr = (void *)(pagesRegionByteIndex + nextPageHeaderByteOffset);
+
+                break;
+            }
+
+            freePageHeaderByteOffset = ((struct memory_page_header *)(pagesRegionByteIndex + 
+                freePageHeaderByteOffset))->nextPageHeaderByteOffset;
+        } while (freePageHeaderByteOffset != contextPtr->freePagesByteOffsetList);
+    }
+
+    if (!nextPageHeaderPtr || ((sizeof(struct memory_page_header) + nextPageHeaderPtr->heapByteSize) < growByteSize))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): The page is not followed by a free page large enough to grow "
+            "into.", __func__, __LINE__);
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    u64 availableByteSize = sizeof(struct memory_page_header) + nextPageHeaderPtr->heapByteSize;
+
+    _memory_unlink_page_header(contextPtr, &contextPtr->freePagesByteOffsetList, &contextPtr->pagesRegionFreeCount,
+        nextPageHeaderByteOffset);
+
+    // whatever the page does not need stays a free page
+    if ((availableByteSize - growByteSize) > sizeof(struct memory_page_header))
+    {
+        p64 splitPageHeaderByteOffset = nextPageHeaderByteOffset + growByteSize;
+
+        if (_memory_commit_pages_region(contextPtr, splitPageHeaderByteOffset, 
+            sizeof(struct memory_page_header)) == MEMORY_OK)
+        {
+            struct memory_page_header *splitPageHeader = (struct memory_page_header *)(pagesRegionByteIndex + 
+                splitPageHeaderByteOffset);
+
+            memset(splitPageHeader, '\0', sizeof(struct memory_page_header));
+
+            splitPageHeader->identifier = MEMORY_HEADER_ID;
+            splitPageHeader->heapByteSize = availableByteSize - growByteSize - sizeof(struct memory_page_header);
+
+            _memory_link_page_header(contextPtr, &contextPtr->freePagesByteOffsetList, &contextPtr->pagesRegionFreeCount,
+                splitPageHeaderByteOffset);
+        }
+        else 
+        {
+            growByteSize = availableByteSize;
+        }
+    }
+    else 
+    {
+        growByteSize = availableByteSize;
+    }
+
+    p64 tailAllocatorByteOffset = sizeof(struct memory_page_header) + pageHeaderPtr->heapByteSize;
+
+    pageHeaderPtr->heapByteSize += growByteSize;
+
+    // a page nothing was allocated on yet picks up the new size with its first allocation
+    if (hasAllocators)
+    {
+        // the tail allocator's header lands on the absorbed page's header, which is already committed
+        p64 lastAllocatorByteOffset = sizeof(struct memory_page_header);
+        p64 nextAllocatorByteOffset;
+
+        while (((nextAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, 
+            lastAllocatorByteOffset)) != MEMORY_TLSF_NULL_BYTE_OFFSET) && 
+            (nextAllocatorByteOffset != tailAllocatorByteOffset))
+        {
+            lastAllocatorByteOffset = nextAllocatorByteOffset;
+        }
+
+        struct memory_allocator *tailAllocatorPtr = (void *)((u8 *)pageHeaderPtr + tailAllocatorByteOffset);
+
+        tailAllocatorPtr->identifier = MEMORY_HEADER_ID;
+        tailAllocatorPtr->byteSize = growByteSize - sizeof(struct memory_allocator);
+        tailAllocatorPtr->prevPhysicalAllocatorByteOffset = lastAllocatorByteOffset;
+
+        memory_get_null_allocation_key(&tailAllocatorPtr->allocationKey);
+
+        _memory_release_free_allocator(pageHeaderPtr, tailAllocatorByteOffset);
+    }
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_realloc_page(const struct memory_page_key *pageKeyPtr, u64 byteSize)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(pageKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_realloc_page_locked(pageKeyPtr, byteSize);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+memory_error_code
+memory_get_page_key_is_ok(const struct memory_page_key *pageKeyPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(pageKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_get_page_key_is_ok(pageKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_page_set_alignment_locked(const struct memory_page_key *pageKeyPtr, u64 alignment)
+{
+    if (!pageKeyPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if (alignment < MEMORY_TLSF_ALIGN_SIZE)
+    {
+        alignment = MEMORY_TLSF_ALIGN_SIZE;
+    }
+
+    if ((alignment & (alignment - 1)) || (alignment > MEMORY_MAX_ALIGNMENT))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'alignment' argument must be a power of two, no larger than "
+            "MEMORY_MAX_ALIGNMENT (alignment: %llu).", __func__, __LINE__, (unsigned long long)alignment);
+
+        return MEMORY_ERROR_UNKNOWN;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&pageKeyPtr->contextKey, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    struct memory_page_info *pageInfoPtr;
+    {
+        memory_error_code resultCode = _memory_get_page_info(contextPtr, pageKeyPtr, &pageInfoPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_FREED)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
+    }
+
+    ((struct memory_page_header *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+        pageInfoPtr->pageHeaderByteOffset])->alignmentLog2 = (u8)_memory_find_last_set_bit_u64(alignment);
+
+    // slots parked in thread caches were carved out at the old alignment
+    _memory_bump_page_epoch(&pageKeyPtr->contextKey);
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_page_set_alignment(const struct memory_page_key *pageKeyPtr, u64 alignment)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(pageKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_page_set_alignment_locked(pageKeyPtr, alignment);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_page_get_alignment_locked(const struct memory_page_key *pageKeyPtr, u64 *outAlignment)
+{
+    if (!pageKeyPtr || !outAlignment)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    *outAlignment = 0;
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&pageKeyPtr->contextKey, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    struct memory_page_info *pageInfoPtr;
+    {
+        memory_error_code resultCode = _memory_get_page_info(contextPtr, pageKeyPtr, &pageInfoPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_FREED)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
+    }
+
+    *outAlignment = (u64)1 << ((struct memory_page_header *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+        pageInfoPtr->pageHeaderByteOffset])->alignmentLog2;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_page_get_alignment(const struct memory_page_key *pageKeyPtr, u64 *outAlignment)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(pageKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_page_get_alignment_locked(pageKeyPtr, outAlignment);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+// slides the first active allocator past the page's compaction cursor down into the free allocator in front of 
+// it. returns B32_FALSE once the page is packed.
+static b32
+_memory_compact_page_step(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr)
+{
+    struct memory_allocation_info *allocInfoArr = (void *)((p64)contextPtr->heap + 
+        contextPtr->allocationInfoRegionByteOffset);
+
+    p64 freeAllocatorByteOffset = pageHeaderPtr->compactionCursorByteOffset;
+
+    while (freeAllocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        if ((MEMORY_IS_ALLOCATOR_FREE(((struct memory_allocator *)((u8 *)pageHeaderPtr + freeAllocatorByteOffset)))))
+        {
+            break;
+        }
+
+        freeAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, 
+            freeAllocatorByteOffset);
+    }
+
+    if (freeAllocatorByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        pageHeaderPtr->compactionCursorByteOffset = sizeof(struct memory_page_header) + pageHeaderPtr->heapByteSize;
+
+        return B32_FALSE;
+    }
+
+    p64 movedAllocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, 
+        freeAllocatorByteOffset);
+
+    // a free tail is as packed as the page gets
+    if (movedAllocatorByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        pageHeaderPtr->compactionCursorByteOffset = freeAllocatorByteOffset;
+
+        return B32_FALSE;
+    }
+
+    struct memory_allocator *freeAllocatorPtr = (void *)((u8 *)pageHeaderPtr + freeAllocatorByteOffset);
+    struct memory_allocator *movedAllocatorPtr = (void *)((u8 *)pageHeaderPtr + movedAllocatorByteOffset);
+    // a null key has no allocation info behind it, and index 0 belongs to some other allocation
+    struct memory_allocation_info *movedAllocInfoPtr = (MEMORY_IS_ALLOCATOR_FREE(movedAllocatorPtr)) ? NULL : 
+        &allocInfoArr[movedAllocatorPtr->allocationKey.managed.allocInfoIndex];
+
+    // mapped allocations have live pointers into them, slabs have slots at fixed offsets (and a slot is never an 
+    // allocator of the page at all), and sliding an over-aligned allocation down by the hole would misalign it; 
+    // leave the hole and carry on past them
+    if (!movedAllocInfoPtr || movedAllocInfoPtr->isSlab || movedAllocInfoPtr->slabClassId || 
+        (movedAllocInfoPtr->mapCount > 0) || (((p64)freeAllocatorPtr + sizeof(struct memory_allocator)) & 
+        (((u64)1 << movedAllocInfoPtr->alignmentLog2) - 1)))
+    {
+        pageHeaderPtr->compactionCursorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, 
+            movedAllocatorByteOffset);
+
+        if (pageHeaderPtr->compactionCursorByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+        {
+            pageHeaderPtr->compactionCursorByteOffset = sizeof(struct memory_page_header) + pageHeaderPtr->heapByteSize;
+
+            return B32_FALSE;
+        }
+
+        return B32_TRUE;
+    }
+
+    u64 holeByteSize = freeAllocatorPtr->byteSize;
+    p64 holePrevPhysicalAllocatorByteOffset = freeAllocatorPtr->prevPhysicalAllocatorByteOffset;
+    u64 movedByteSize = movedAllocatorPtr->byteSize;
+
+    _memory_tlsf_remove_free_allocator(pageHeaderPtr, freeAllocatorByteOffset);
+
+    memmove(freeAllocatorPtr, movedAllocatorPtr, sizeof(struct memory_allocator) + movedByteSize);
+
+    movedAllocatorPtr = freeAllocatorPtr;
+    movedAllocatorPtr->prevPhysicalAllocatorByteOffset = holePrevPhysicalAllocatorByteOffset;
+
+    if (pageHeaderPtr->activeAllocatorCount > 1)
+    {
+        ((struct memory_allocator *)((u8 *)pageHeaderPtr + movedAllocatorPtr->prevAllocatorByteOffset))->
+            nextAllocatorByteOffset = freeAllocatorByteOffset;
+        ((struct memory_allocator *)((u8 *)pageHeaderPtr + movedAllocatorPtr->nextAllocatorByteOffset))->
+            prevAllocatorByteOffset = freeAllocatorByteOffset;
+    }
+    else 
+    {
+        movedAllocatorPtr->prevAllocatorByteOffset = movedAllocatorPtr->nextAllocatorByteOffset = freeAllocatorByteOffset;
+    }
+
+    if (pageHeaderPtr->activeAllocatorByteOffsetList == movedAllocatorByteOffset)
+    {
+        pageHeaderPtr->activeAllocatorByteOffsetList = freeAllocatorByteOffset;
+    }
+
+    // the key stays valid; only the allocation info knows where the allocator lives
+    movedAllocInfoPtr->allocatorByteOffset = freeAllocatorByteOffset;
+
+    p64 holeAllocatorByteOffset = freeAllocatorByteOffset + sizeof(struct memory_allocator) + movedByteSize;
+    struct memory_allocator *holeAllocatorPtr = (void *)((u8 *)pageHeaderPtr + holeAllocatorByteOffset);
+
+    holeAllocatorPtr->identifier = MEMORY_HEADER_ID;
+    holeAllocatorPtr->byteSize = holeByteSize;
+    holeAllocatorPtr->prevPhysicalAllocatorByteOffset = freeAllocatorByteOffset;
+
+    memory_get_null_allocation_key(&holeAllocatorPtr->allocationKey);
+
+    pageHeaderPtr->compactionCursorByteOffset = holeAllocatorByteOffset;
+
+    _memory_release_free_allocator(pageHeaderPtr, holeAllocatorByteOffset);
+
+    return B32_TRUE;
+}
+
+static memory_error_code
+_memory_pages_reorder_locked(const struct memory_context_key *memoryContextKeyPtr, u64 timeBudgetNS)
+{
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    if (contextPtr->pagesRegionInfoCount < 1)
+    {
+        return MEMORY_OK;
+    }
+
+    u64 startNS = _memory_get_time_ns();
+
+    // round robin over the pages, picking up where the last call ran out of time
+    for (u16 visitedPageCount = 0; visitedPageCount < contextPtr->pagesRegionInfoCount; ++visitedPageCount)
+    {
+        if (contextPtr->pagesRegionReorderInfoIndex >= contextPtr->pagesRegionInfoCount)
+        {
+            contextPtr->pagesRegionReorderInfoIndex = 0;
+        }
+
+        struct memory_page_info *pageInfoPtr = &contextPtr->pagesRegionInfoArr[contextPtr->pagesRegionReorderInfoIndex];
+
+        struct memory_page_header *pageHeaderPtr = (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+            pageInfoPtr->pageHeaderByteOffset];
+
+        // locked pages belong to something holding raw pointers into them (e.g. a frame arena), and a page 
+        // nothing was allocated from yet has no allocators to walk, only zeroed (or uncommitted) heap
+        if ((pageInfoPtr->status == MEMORY_PAGE_STATUS_UNLOCKED) && 
+            ((pageHeaderPtr->activeAllocatorCount > 0) || (pageHeaderPtr->freeAllocatorCount > 0)))
+        {
+            while ((_memory_compact_page_step(contextPtr, pageHeaderPtr)))
+            {
+                if ((_memory_get_time_ns() - startNS) >= timeBudgetNS)
+                {
+                    return MEMORY_OK;
+                }
+            }
+        }
+
+        ++contextPtr->pagesRegionReorderInfoIndex;
+    }
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_pages_reorder(const struct memory_context_key *memoryContextKeyPtr, u64 timeBudgetNS)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_pages_reorder_locked(memoryContextKeyPtr, timeBudgetNS);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+// snapshot layout: context struct | page infos | reserved allocation infos | committed pages region
+static memory_error_code
+_memory_context_snapshot_locked(const struct memory_context_key *memoryContextKeyPtr, 
+    struct memory_context_snapshot *snapshotPtr)
+{
+    if (!snapshotPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'snapshotPtr' argument cannot be NULL.", __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            utils_fprintfln(stderr, "%s(Line: %d): Not an active memory context.", __func__, __LINE__);
+
+            return resultCode;
+        }
+    }
+
+    u64 pageInfoByteSize = sizeof(struct memory_page_info)*contextPtr->pagesRegionInfoCount;
+    u64 byteSize = sizeof(struct memory_context) + pageInfoByteSize + 
+        contextPtr->allocationInfoRegionBytesReserved + contextPtr->pagesRegionCommittedBytes;
+
+    if (byteSize > snapshotPtr->byteCapacity)
+    {
+        void *dataPtr = realloc(snapshotPtr->dataPtr, byteSize);
+
+        if (!dataPtr)
+        {
+            utils_fprintfln(stderr, "%s(Line: %d): Failure to allocate %llu bytes for the snapshot.", 
+                __func__, __LINE__, (unsigned long long)byteSize);
+
+            return MEMORY_ERROR_FAILED_ALLOCATION;
+        }
+
+        snapshotPtr->dataPtr = dataPtr;
+        snapshotPtr->byteCapacity = byteSize;
+    }
+
+    u8 *dataPtr = snapshotPtr->dataPtr;
+
+    memcpy(dataPtr, contextPtr, sizeof(struct memory_context));
+    dataPtr += sizeof(struct memory_context);
+
+    if (pageInfoByteSize > 0)
+    {
+        memcpy(dataPtr, contextPtr->pagesRegionInfoArr, pageInfoByteSize);
+        dataPtr += pageInfoByteSize;
+    }
+
+    memcpy(dataPtr, &contextPtr->heap[contextPtr->allocationInfoRegionByteOffset], 
+        contextPtr->allocationInfoRegionBytesReserved);
+    dataPtr += contextPtr->allocationInfoRegionBytesReserved;
+
+    memcpy(dataPtr, &contextPtr->heap[contextPtr->pagesRegionByteOffset], contextPtr->pagesRegionCommittedBytes);
+
+    memcpy((void *)&snapshotPtr->contextKey, memoryContextKeyPtr, sizeof(struct memory_context_key));
+    snapshotPtr->byteSize = byteSize;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_context_snapshot(const struct memory_context_key *memoryContextKeyPtr, 
+    struct memory_context_snapshot *snapshotPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_context_snapshot_locked(memoryContextKeyPtr, snapshotPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_context_restore_locked(const struct memory_context_snapshot *snapshotPtr)
+{
+    if (!snapshotPtr || !snapshotPtr->dataPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'snapshotPtr' argument cannot be NULL or empty.", 
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&snapshotPtr->contextKey, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            utils_fprintfln(stderr, "%s(Line: %d): The snapshot's context is not active.", __func__, __LINE__);
+
+            return resultCode;
+        }
+    }
+
+    const u8 *dataPtr = snapshotPtr->dataPtr;
+
+    struct memory_context snapshotContext;
+    memcpy(&snapshotContext, dataPtr, sizeof(struct memory_context));
+    dataPtr += sizeof(struct memory_context);
+
+    const struct memory_page_info *snapshotPageInfoArr = (const void *)dataPtr;
+    dataPtr += sizeof(struct memory_page_info)*snapshotContext.pagesRegionInfoCount;
+
+    const struct memory_allocation_info *snapshotAllocInfoArr = (const void *)dataPtr;
+    dataPtr += snapshotContext.allocationInfoRegionBytesReserved;
+
+    // page infos and allocation infos only ever grow, so the live context always covers the snapshot
+    if (snapshotContext.id != contextPtr->id || 
+        snapshotContext.pagesRegionInfoCount > contextPtr->pagesRegionInfoCount ||
+        snapshotContext.allocationInfoRegionBytesReserved > contextPtr->allocationInfoRegionBytesReserved)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): The snapshot does not belong to this context.", __func__, __LINE__);
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+    }
+
+    if (_memory_commit_heap_region(contextPtr, contextPtr->pagesRegionByteOffset, 
+        &contextPtr->pagesRegionCommittedBytes, snapshotContext.pagesRegionCommittedBytes) != MEMORY_OK)
+    {
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    memcpy(&contextPtr->heap[contextPtr->pagesRegionByteOffset], dataPtr, snapshotContext.pagesRegionCommittedBytes);
+
+    // whatever was free in the snapshot gets a generation newer than anything handed out since, and whatever was 
+    // active keeps its snapshot generation but bumps past that on its next release, so keys taken after the 
+    // snapshot can never resolve again
+    struct memory_page_info *pageInfoArr = contextPtr->pagesRegionInfoArr;
+    u16 livePageInfoCount = contextPtr->pagesRegionInfoCount;
+
+    for (u16 pageInfoIndex = 0; pageInfoIndex < snapshotContext.pagesRegionInfoCount; ++pageInfoIndex)
+    {
+        memory_int_id liveGeneration = pageInfoArr[pageInfoIndex].generation;
+
+        pageInfoArr[pageInfoIndex] = snapshotPageInfoArr[pageInfoIndex];
+
+        if (pageInfoArr[pageInfoIndex].status == MEMORY_PAGE_STATUS_FREED)
+        {
+            pageInfoArr[pageInfoIndex].generation = _memory_get_next_generation(liveGeneration, 
+                pageInfoArr[pageInfoIndex].generation);
+        }
+    }
+
+    struct memory_allocation_info *allocInfoArr = (void *)&contextPtr->heap[contextPtr->allocationInfoRegionByteOffset];
+    u32 snapshotAllocInfoCount = snapshotContext.allocationInfoRegionBytesReserved/
+        sizeof(struct memory_allocation_info);
+    u32 liveAllocInfoCount = contextPtr->allocationInfoRegionBytesReserved/sizeof(struct memory_allocation_info);
+
+    for (u32 allocInfoIndex = 0; allocInfoIndex < snapshotAllocInfoCount; ++allocInfoIndex)
+    {
+        memory_int_id liveGeneration = (allocInfoArr[allocInfoIndex].generation > 
+            allocInfoArr[allocInfoIndex].restoredGenerationFloor) ? allocInfoArr[allocInfoIndex].generation : 
+            allocInfoArr[allocInfoIndex].restoredGenerationFloor;
+
+        allocInfoArr[allocInfoIndex] = snapshotAllocInfoArr[allocInfoIndex];
+        // a snapshot taken while gated would otherwise bring back holders that are long gone
+        atomic_store_explicit(&allocInfoArr[allocInfoIndex].mapGate, 0, memory_order_relaxed);
+
+        if (allocInfoArr[allocInfoIndex].isActive)
+        {
+            allocInfoArr[allocInfoIndex].restoredGenerationFloor = liveGeneration;
+        }
+        else 
+        {
+            allocInfoArr[allocInfoIndex].generation = _memory_get_next_generation(liveGeneration, 
+                allocInfoArr[allocInfoIndex].generation);
+            allocInfoArr[allocInfoIndex].restoredGenerationFloor = 0;
+        }
+    }
+
+    // the bookkeeping comes back from the snapshot; the heap itself, its commits and the page info array stay
+    struct memory_context liveContext = *contextPtr;
+
+    *contextPtr = snapshotContext;
+
+    contextPtr->heap = liveContext.heap;
+    contextPtr->isHeapVirtual = liveContext.isHeapVirtual;
+    contextPtr->reservedHeapBytes = liveContext.reservedHeapBytes;
+    contextPtr->heapCommitGranularity = liveContext.heapCommitGranularity;
+    contextPtr->allocationInfoRegionCommittedBytes = liveContext.allocationInfoRegionCommittedBytes;
+    contextPtr->pagesRegionCommittedBytes = liveContext.pagesRegionCommittedBytes;
+    contextPtr->pagesRegionInfoArr = liveContext.pagesRegionInfoArr;
+    contextPtr->pagesRegionInfoCapacity = liveContext.pagesRegionInfoCapacity;
+    contextPtr->pagesRegionInfoCount = livePageInfoCount;
+    contextPtr->allocationInfoRegionBytesReserved = liveContext.allocationInfoRegionBytesReserved;
+    // the running totals keep counting across a restore; only the live byte count goes back
+    contextPtr->stats = liveContext.stats;
+    contextPtr->stats.liveByteCount = snapshotContext.stats.liveByteCount;
+
+    // infos created after the snapshot are kept (their slots are committed) but released
+    for (u16 pageInfoIndex = snapshotContext.pagesRegionInfoCount; pageInfoIndex < livePageInfoCount; ++pageInfoIndex)
+    {
+        pageInfoArr[pageInfoIndex].status = MEMORY_PAGE_STATUS_FREED;
+        pageInfoArr[pageInfoIndex].generation = _memory_get_next_generation(pageInfoArr[pageInfoIndex].generation, 0);
+        pageInfoArr[pageInfoIndex].nextFreePageId = contextPtr->pagesRegionInfoFreeListHeadId;
+        contextPtr->pagesRegionInfoFreeListHeadId = pageInfoIndex + 1;
+    }
+
+    for (u32 allocInfoIndex = snapshotAllocInfoCount; allocInfoIndex < liveAllocInfoCount; ++allocInfoIndex)
+    {
+        allocInfoArr[allocInfoIndex].labelId = MEMORY_SHORT_ID_NULL;
+
+        _memory_push_free_allocation_info(contextPtr, allocInfoIndex);
+    }
+
+    if (contextPtr->isDebug)
+    {
+        struct memory_debug_context *debugContextPtr = (void *)contextPtr;
+
+        for (u16 labelIndex = 0; labelIndex < debugContextPtr->labelCount; ++labelIndex)
+        {
+            debugContextPtr->labelEntryArr[labelIndex].activeAllocationCount = 0;
+        }
+
+        for (u32 allocInfoIndex = 0; allocInfoIndex < snapshotAllocInfoCount; ++allocInfoIndex)
+        {
+            if (allocInfoArr[allocInfoIndex].isActive && allocInfoArr[allocInfoIndex].labelId != MEMORY_SHORT_ID_NULL)
+            {
+                ++debugContextPtr->labelEntryArr[allocInfoArr[allocInfoIndex].labelId - 1].activeAllocationCount;
+            }
+        }
+    }
+
+    _memory_bump_page_epoch(&snapshotPtr->contextKey);
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_context_restore(const struct memory_context_snapshot *snapshotPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(snapshotPtr ? &snapshotPtr->contextKey : NULL);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_context_restore_locked(snapshotPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+memory_error_code
+memory_context_snapshot_free(struct memory_context_snapshot *snapshotPtr)
+{
+    if (!snapshotPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    free(snapshotPtr->dataPtr);
+
+    memset(snapshotPtr, '\0', sizeof(struct memory_context_snapshot));
+
+    return MEMORY_OK;
+}
+
+static memory_error_code
+_memory_frame_arena_create_locked(const struct memory_context_key *memoryContextKeyPtr, u64 byteCapacity,
+    struct memory_frame_arena *outArenaPtr)
+{
+    if (!outArenaPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'outArenaPtr' argument cannot be NULL.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    memset(outArenaPtr, '\0', sizeof(struct memory_frame_arena));
+
+    if (byteCapacity < MEMORY_FRAME_ARENA_ALIGN_SIZE)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'byteCapacity' argument is too small for an arena.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_SIZE_TOO_SMALL;
+    }
+
+    {
+        memory_error_code resultCode = memory_alloc_page(memoryContextKeyPtr, byteCapacity, 
+            &outArenaPtr->pageKey);
+
+        if (resultCode != MEMORY_OK)
+        {
+            utils_fprintfln(stderr, "%s(Line: %d): Failure to allocate the arena's page.",
+                __func__, __LINE__);
+
+            return resultCode;
+        }
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            memory_free_page(&outArenaPtr->pageKey);
+
+            return resultCode;
+        }
+    }
+
+    struct memory_page_info *pageInfoPtr = &contextPtr->pagesRegionInfoArr[outArenaPtr->pageKey.pageId - 1];
+    struct memory_page_header *pageHeaderPtr = (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+        pageInfoPtr->pageHeaderByteOffset];
+
+    // the bump path never checks for commits, so the arena is committed whole up front
+    if (_memory_commit_page_heap(contextPtr, pageHeaderPtr, sizeof(struct memory_page_header) + 
+        pageHeaderPtr->heapByteSize) != MEMORY_OK)
+    {
+        memory_free_page(&outArenaPtr->pageKey);
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    // the page belongs to the arena; locking it keeps memory_alloc from carving allocators out of it
+    pageInfoPtr->status = MEMORY_PAGE_STATUS_LOCKED;
+
+    outArenaPtr->basePtr = (u8 *)pageHeaderPtr + sizeof(struct memory_page_header);
+    outArenaPtr->byteCapacity = pageHeaderPtr->heapByteSize;
+    outArenaPtr->byteOffset = 0;
+    outArenaPtr->highWaterByteOffset = 0;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_frame_arena_create(const struct memory_context_key *memoryContextKeyPtr, u64 byteCapacity,
+    struct memory_frame_arena *outArenaPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_frame_arena_create_locked(memoryContextKeyPtr, byteCapacity,
+        outArenaPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+memory_error_code
+memory_frame_arena_alloc(struct memory_frame_arena *arenaPtr, u64 byteSize, void **outDataPtr)
+{
+    // hot path: no key resolution, no allocation info, just a bump
+    assert(arenaPtr && outDataPtr);
+
+    u64 alignedByteOffset = (arenaPtr->byteOffset + (MEMORY_FRAME_ARENA_ALIGN_SIZE - 1)) & 
+        ~(MEMORY_FRAME_ARENA_ALIGN_SIZE - 1);
+
+    if ((alignedByteOffset + byteSize) > arenaPtr->byteCapacity)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Frame arena is out of space (capacity: %llu bytes). "
+            "Cannot allocate %llu bytes.", __func__, __LINE__, (unsigned long long)arenaPtr->byteCapacity,
+            (unsigned long long)byteSize);
+
+        *outDataPtr = NULL;
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    *outDataPtr = arenaPtr->basePtr + alignedByteOffset;
+    arenaPtr->byteOffset = alignedByteOffset + byteSize;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_frame_arena_reset(struct memory_frame_arena *arenaPtr)
+{
+    if (!arenaPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if (arenaPtr->byteOffset > arenaPtr->highWaterByteOffset)
+    {
+        arenaPtr->highWaterByteOffset = arenaPtr->byteOffset;
+    }
+
+    arenaPtr->byteOffset = 0;
+
+    return MEMORY_OK;
+}
+
+static memory_error_code
+_memory_frame_arena_destroy_locked(struct memory_frame_arena *arenaPtr)
+{
+    if (!arenaPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&arenaPtr->pageKey.contextKey, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    contextPtr->pagesRegionInfoArr[arenaPtr->pageKey.pageId - 1].status = MEMORY_PAGE_STATUS_UNLOCKED;
+
+    memory_error_code resultCode = memory_free_page(&arenaPtr->pageKey);
+
+    memset(arenaPtr, '\0', sizeof(struct memory_frame_arena));
+
+    return resultCode;
+}
+
+memory_error_code
+memory_frame_arena_destroy(struct memory_frame_arena *arenaPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(arenaPtr ? &arenaPtr->pageKey : NULL);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_frame_arena_destroy_locked(arenaPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_stack_create_locked(const struct memory_context_key *memoryContextKeyPtr, u64 byteCapacity,
+    struct memory_stack *outStackPtr)
+{
+    if (!outStackPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'outStackPtr' argument cannot be NULL.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    memset(outStackPtr, '\0', sizeof(struct memory_stack));
+
+    if (byteCapacity < MEMORY_STACK_ALIGN_SIZE)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'byteCapacity' argument is too small for a stack.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_SIZE_TOO_SMALL;
+    }
+
+    {
+        memory_error_code resultCode = memory_alloc_page(memoryContextKeyPtr, byteCapacity, 
+            &outStackPtr->pageKey);
+
+        if (resultCode != MEMORY_OK)
+        {
+            utils_fprintfln(stderr, "%s(Line: %d): Failure to allocate the stack's page.",
+                __func__, __LINE__);
+
+            return resultCode;
+        }
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            memory_free_page(&outStackPtr->pageKey);
+
+            return resultCode;
+        }
+    }
+
+    struct memory_page_info *pageInfoPtr = &contextPtr->pagesRegionInfoArr[outStackPtr->pageKey.pageId - 1];
+    struct memory_page_header *pageHeaderPtr = (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+        pageInfoPtr->pageHeaderByteOffset];
+
+    // same as the frame arena, the page belongs to the stack and memory_alloc must stay out of it
+    pageInfoPtr->status = MEMORY_PAGE_STATUS_LOCKED;
+
+    outStackPtr->basePtr = (u8 *)pageHeaderPtr + sizeof(struct memory_page_header);
+    outStackPtr->byteCapacity = pageHeaderPtr->heapByteSize;
+    outStackPtr->byteOffset = 0;
+    outStackPtr->committedByteOffset = 0;
+    outStackPtr->highWaterByteOffset = 0;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_stack_create(const struct memory_context_key *memoryContextKeyPtr, u64 byteCapacity,
+    struct memory_stack *outStackPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_stack_create_locked(memoryContextKeyPtr, byteCapacity, outStackPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_stack_commit_locked(struct memory_stack *stackPtr, u64 byteOffsetEnd)
+{
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&stackPtr->pageKey.contextKey, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    struct memory_page_header *pageHeaderPtr = (void *)(stackPtr->basePtr - sizeof(struct memory_page_header));
+
+    {
+        memory_error_code resultCode = _memory_commit_page_heap(contextPtr, pageHeaderPtr, 
+            sizeof(struct memory_page_header) + byteOffsetEnd);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    // commits are granule sized, so usually a good deal more than asked for is usable now
+    p64 pageHeaderByteOffset = (p64)pageHeaderPtr - ((p64)contextPtr->heap + contextPtr->pagesRegionByteOffset);
+    u64 committedByteOffset = contextPtr->pagesRegionCommittedBytes - pageHeaderByteOffset - 
+        sizeof(struct memory_page_header);
+
+    if (committedByteOffset > stackPtr->byteCapacity)
+    {
+        committedByteOffset = stackPtr->byteCapacity;
+    }
+
+    stackPtr->committedByteOffset = (committedByteOffset > byteOffsetEnd) ? committedByteOffset : byteOffsetEnd;
+
+    return MEMORY_OK;
+}
+
+// slow path of memory_stack_push, only taken when the stack grows past what it has committed so far; the 
+// commit state is the context's, so unlike the push itself it needs the context lock
+static memory_error_code
+_memory_stack_commit(struct memory_stack *stackPtr, u64 byteOffsetEnd)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(&stackPtr->pageKey);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_stack_commit_locked(stackPtr, byteOffsetEnd);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+memory_error_code
+memory_stack_push(struct memory_stack *stackPtr, u64 byteSize, void **outDataPtr)
+{
+    assert(stackPtr && outDataPtr);
+
+    // aligned by address, since the page header in front of basePtr is not a multiple of the alignment
+    u64 alignedByteOffset = ((((p64)stackPtr->basePtr + stackPtr->byteOffset) + (MEMORY_STACK_ALIGN_SIZE - 1)) & 
+        ~(MEMORY_STACK_ALIGN_SIZE - 1)) - (p64)stackPtr->basePtr;
+
+    if ((alignedByteOffset + byteSize) > stackPtr->byteCapacity)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Stack is out of space (capacity: %llu bytes). "
+            "Cannot push %llu bytes.", __func__, __LINE__, (unsigned long long)stackPtr->byteCapacity,
+            (unsigned long long)byteSize);
+
+        *outDataPtr = NULL;
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    if ((alignedByteOffset + byteSize) > stackPtr->committedByteOffset &&
+        _memory_stack_commit(stackPtr, alignedByteOffset + byteSize) != MEMORY_OK)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Failure to commit stack memory. Cannot push %llu bytes.", 
+            __func__, __LINE__, (unsigned long long)byteSize);
+
+        *outDataPtr = NULL;
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    *outDataPtr = stackPtr->basePtr + alignedByteOffset;
+    stackPtr->byteOffset = alignedByteOffset + byteSize;
+
+    if (stackPtr->byteOffset > stackPtr->highWaterByteOffset)
+    {
+        stackPtr->highWaterByteOffset = stackPtr->byteOffset;
+    }
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_stack_get_marker(const struct memory_stack *stackPtr, memory_stack_marker *outMarkerPtr)
+{
+    if (!stackPtr || !outMarkerPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    *outMarkerPtr = (memory_stack_marker)stackPtr->byteOffset;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_stack_rollback_to_marker(struct memory_stack *stackPtr, memory_stack_marker marker)
+{
+    if (!stackPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    // a marker above the current depth was taken inside a scope that has already been rolled back
+    if (marker > stackPtr->byteOffset)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Marker %llu is above the stack depth %llu. Rollbacks must "
+            "happen in reverse order.", __func__, __LINE__, (unsigned long long)marker, 
+            (unsigned long long)stackPtr->byteOffset);
+
+        return MEMORY_ERROR_INDEX_OUT_OF_RANGE;
+    }
+
+#if defined(MEMORY_DEBUG)
+    // stale pointers into a released scope read garbage instead of plausible leftovers
+    memset(stackPtr->basePtr + marker, 0xCD, stackPtr->byteOffset - marker);
+#endif
+
+    stackPtr->byteOffset = marker;
+
+    return MEMORY_OK;
+}
+
+static memory_error_code
+_memory_stack_destroy_locked(struct memory_stack *stackPtr)
+{
+    if (!stackPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&stackPtr->pageKey.contextKey, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    contextPtr->pagesRegionInfoArr[stackPtr->pageKey.pageId - 1].status = MEMORY_PAGE_STATUS_UNLOCKED;
+
+    memory_error_code resultCode = memory_free_page(&stackPtr->pageKey);
+
+    memset(stackPtr, '\0', sizeof(struct memory_stack));
+
+    return resultCode;
+}
+
+memory_error_code
+memory_stack_destroy(struct memory_stack *stackPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(stackPtr ? &stackPtr->pageKey : NULL);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_stack_destroy_locked(stackPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_pool_create_locked(const struct memory_page_key *pageKeyPtr, u64 objectByteSize, u64 alignment,
+    u32 capacity, struct memory_pool *outPoolPtr)
+{
+    if (!outPoolPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'outPoolPtr' argument cannot be NULL.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    memset(outPoolPtr, '\0', sizeof(struct memory_pool));
+
+    if (objectByteSize == 0 || capacity == 0)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'objectByteSize' and 'capacity' arguments cannot be zero.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_ZERO_PARAMETER;
+    }
+
+    if (capacity == MEMORY_POOL_NULL_SLOT_INDEX)
+    {
+        return MEMORY_ERROR_TOO_MANY_OBJECTS;
+    }
+
+    if (alignment == 0)
+    {
+        alignment = MEMORY_TLSF_ALIGN_SIZE;
+    }
+
+    if (alignment & (alignment - 1))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'alignment' argument must be a power of two (alignment: %llu).",
+            __func__, __LINE__, (unsigned long long)alignment);
+
+        return MEMORY_ERROR_UNKNOWN;
+    }
+
+    // a free slot has to be able to hold the index of the next free slot
+    if (objectByteSize < sizeof(u32))
+    {
+        objectByteSize = sizeof(u32);
+    }
+
+    u64 slotByteSize = (objectByteSize + (alignment - 1)) & ~(alignment - 1);
+
+    if (alignment > MEMORY_MAX_ALIGNMENT)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'alignment' argument cannot be larger than MEMORY_MAX_ALIGNMENT "
+            "(alignment: %llu).", __func__, __LINE__, (unsigned long long)alignment);
+
+        return MEMORY_ERROR_UNKNOWN;
+    }
+
+    {
+        memory_error_code resultCode = memory_alloc_aligned(pageKeyPtr, slotByteSize*capacity, alignment, 
+            "memory_pool", &outPoolPtr->slotsAllocKey);
+
+        if (resultCode != MEMORY_OK)
+        {
+            utils_fprintfln(stderr, "%s(Line: %d): Failure to allocate the pool's slots.",
+                __func__, __LINE__);
+
+            return resultCode;
+        }
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&pageKeyPtr->contextKey, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            memory_free(&outPoolPtr->slotsAllocKey);
+            memset(outPoolPtr, '\0', sizeof(struct memory_pool));
+
+            return resultCode;
+        }
+    }
+
+    struct memory_allocation_info *allocInfoPtr = &((struct memory_allocation_info *)((p64)contextPtr->heap + 
+        contextPtr->allocationInfoRegionByteOffset))[outPoolPtr->slotsAllocKey.managed.allocInfoIndex];
+
+    struct memory_page_header *pageHeaderPtr = (void *)((p64)contextPtr->heap + contextPtr->pagesRegionByteOffset + 
+        contextPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1].pageHeaderByteOffset);
+
+    // the pool hands out raw slot pointers, so its allocation stays mapped (and in place) for its lifetime
+    ++allocInfoPtr->mapCount;
+
+    outPoolPtr->slotsBasePtr = (u8 *)pageHeaderPtr + allocInfoPtr->allocatorByteOffset + sizeof(struct memory_allocator);
+    outPoolPtr->slotByteSize = slotByteSize;
+    outPoolPtr->alignment = alignment;
+    outPoolPtr->capacity = capacity;
+    outPoolPtr->activeCount = 0;
+    outPoolPtr->freeListHeadSlotIndex = MEMORY_POOL_NULL_SLOT_INDEX;
+    outPoolPtr->untouchedSlotIndex = 0;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_pool_create(const struct memory_page_key *pageKeyPtr, u64 objectByteSize, u64 alignment, u32 capacity,
+    struct memory_pool *outPoolPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(pageKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_pool_create_locked(pageKeyPtr, objectByteSize, alignment, capacity,
+        outPoolPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+memory_error_code
+memory_pool_alloc(struct memory_pool *poolPtr, void **outDataPtr, u32 *outSlotIndexPtr)
+{
+    // hot path: no key resolution, no allocation info, just a pop off the free list
+    assert(poolPtr && outDataPtr);
+
+    u32 slotIndex;
+
+    if (poolPtr->freeListHeadSlotIndex != MEMORY_POOL_NULL_SLOT_INDEX)
+    {
+        slotIndex = poolPtr->freeListHeadSlotIndex;
+        poolPtr->freeListHeadSlotIndex = *(u32 *)&poolPtr->slotsBasePtr[slotIndex*poolPtr->slotByteSize];
+    }
+    else if (poolPtr->untouchedSlotIndex < poolPtr->capacity)
+    {
+        // slots are threaded lazily, so creating a large pool doesn't touch all of its memory
+        slotIndex = poolPtr->untouchedSlotIndex++;
+    }
+    else
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Pool is out of slots (capacity: %u).",
+            __func__, __LINE__, poolPtr->capacity);
+
+        *outDataPtr = NULL;
+
+        return MEMORY_ERROR_TOO_MANY_OBJECTS;
+    }
+
+    ++poolPtr->activeCount;
+
+    *outDataPtr = &poolPtr->slotsBasePtr[slotIndex*poolPtr->slotByteSize];
+
+    if (outSlotIndexPtr)
+    {
+        *outSlotIndexPtr = slotIndex;
+    }
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_pool_free(struct memory_pool *poolPtr, void *dataPtr)
+{
+    assert(poolPtr);
+
+    if (!dataPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    p64 slotByteOffset = (p64)dataPtr - (p64)poolPtr->slotsBasePtr;
+    u32 slotIndex = (u32)(slotByteOffset/poolPtr->slotByteSize);
+
+    if ((p64)dataPtr < (p64)poolPtr->slotsBasePtr || slotIndex >= poolPtr->untouchedSlotIndex || 
+        (slotByteOffset % poolPtr->slotByteSize) != 0)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Pointer does not address a slot of this pool.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_INDEX_OUT_OF_RANGE;
+    }
+
+    assert(poolPtr->activeCount > 0);
+
+    *(u32 *)dataPtr = poolPtr->freeListHeadSlotIndex;
+    poolPtr->freeListHeadSlotIndex = slotIndex;
+
+    --poolPtr->activeCount;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_pool_get_slot(const struct memory_pool *poolPtr, u32 slotIndex, void **outDataPtr)
+{
+    assert(poolPtr && outDataPtr);
+
+    if (slotIndex >= poolPtr->untouchedSlotIndex)
+    {
+        *outDataPtr = NULL;
+
+        return MEMORY_ERROR_INDEX_OUT_OF_RANGE;
+    }
+
+    *outDataPtr = &poolPtr->slotsBasePtr[slotIndex*poolPtr->slotByteSize];
+
+    return MEMORY_OK;
+}
+
+static memory_error_code
+_memory_pool_destroy_locked(struct memory_pool *poolPtr)
+{
+    if (!poolPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if ((MEMORY_IS_ALLOCATION_NULL((&poolPtr->slotsAllocKey))))
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&poolPtr->slotsAllocKey.managed.contextKey, 
+            &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
+    }
+
+    struct memory_allocation_info *allocInfoPtr;
+
+    if (_memory_get_allocation_info(contextPtr, &poolPtr->slotsAllocKey, &allocInfoPtr) == MEMORY_OK)
+    {
+        --allocInfoPtr->mapCount;
+    }
+
+    memory_error_code resultCode = memory_free(&poolPtr->slotsAllocKey);
+
+    memset(poolPtr, '\0', sizeof(struct memory_pool));
+
+    return resultCode;
+}
+
+memory_error_code
+memory_pool_destroy(struct memory_pool *poolPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_allocation_lock(poolPtr ? &poolPtr->slotsAllocKey : NULL);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_pool_destroy_locked(poolPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static u64
+_memory_get_allocation_byte_size(const struct memory_page_header *pageHeaderPtr, 
+    const struct memory_allocation_info *allocInfoPtr)
+{
+    if (allocInfoPtr->slabClassId)
+    {
+        return g_MEMORY_SLAB_SLOT_BYTE_SIZE_ARR[allocInfoPtr->slabClassId - 1];
+    }
+
+    return ((const struct memory_allocator *)((const u8 *)pageHeaderPtr + allocInfoPtr->allocatorByteOffset))->byteSize;
+}
+
+// circular list of the page's allocation infos
+static void
+_memory_link_allocation_info(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, 
+    u32 infoIndex)
+{
+    struct memory_allocation_info *allocInfoArr = (void *)&contextPtr->heap[contextPtr->allocationInfoRegionByteOffset];
+    struct memory_allocation_info *allocInfoPtr = &allocInfoArr[infoIndex];
+
+    if (pageHeaderPtr->allocationInfoCount > 0)
+    {
+        u32 nextInfoIndex = pageHeaderPtr->allocationInfoByteOffsetList/sizeof(struct memory_allocation_info);
+        struct memory_allocation_info *nextInfoPtr = &allocInfoArr[nextInfoIndex];
+        u32 prevInfoIndex = nextInfoPtr->prevAllocationInfoIndex;
+        struct memory_allocation_info *prevInfoPtr = &allocInfoArr[prevInfoIndex];
+
+        allocInfoPtr->nextAllocationInfoIndex = nextInfoIndex;
+        allocInfoPtr->prevAllocationInfoIndex = prevInfoIndex;
+
+        nextInfoPtr->prevAllocationInfoIndex = infoIndex;
+        prevInfoPtr->nextAllocationInfoIndex = infoIndex;
+    }
+    else 
+    {
+        allocInfoPtr->prevAllocationInfoIndex = allocInfoPtr->nextAllocationInfoIndex = infoIndex;
+    }
+
+    pageHeaderPtr->allocationInfoByteOffsetList = infoIndex*sizeof(struct memory_allocation_info);
+    ++pageHeaderPtr->allocationInfoCount;
+}
+
+static void
+_memory_unlink_allocation_info(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, 
+    u32 infoIndex)
+{
+    struct memory_allocation_info *allocInfoArr = (void *)&contextPtr->heap[contextPtr->allocationInfoRegionByteOffset];
+    struct memory_allocation_info *allocInfoPtr = &allocInfoArr[infoIndex];
+
+    if (pageHeaderPtr->allocationInfoCount > 1)
+    {
+        allocInfoArr[allocInfoPtr->prevAllocationInfoIndex].nextAllocationInfoIndex = 
+            allocInfoPtr->nextAllocationInfoIndex;
+        allocInfoArr[allocInfoPtr->nextAllocationInfoIndex].prevAllocationInfoIndex = 
+            allocInfoPtr->prevAllocationInfoIndex;
+
+        if (pageHeaderPtr->allocationInfoByteOffsetList == (infoIndex*sizeof(struct memory_allocation_info)))
+        {
+            pageHeaderPtr->allocationInfoByteOffsetList = allocInfoPtr->nextAllocationInfoIndex*
+                sizeof(struct memory_allocation_info);
+        }
+    }
+
+    --pageHeaderPtr->allocationInfoCount;
+}
+
+// takes a free allocator big enough for byteSize at the alignment (see _memory_split_allocator_alignment_gap), and 
+// links it into the page's active list. The caller writes the allocation key into it. Returns NULL when the page 
+// is out of space.
+static p64
+_memory_take_allocator(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, u64 byteSize, 
+    u64 alignment, p64 alignedByteOffset)
+{
+    // nothing has been allocated on this page yet, so the whole page heap becomes one free allocator
+    if ((pageHeaderPtr->activeAllocatorCount < 1) && (pageHeaderPtr->freeAllocatorCount < 1))
+    {
+        if (_memory_commit_page_heap(contextPtr, pageHeaderPtr, sizeof(struct memory_page_header) + 
+            sizeof(struct memory_allocator)) != MEMORY_OK)
+        {
+            return MEMORY_TLSF_NULL_BYTE_OFFSET;
+        }
+
+        struct memory_allocator *heapAllocatorPtr = (void *)((u8 *)pageHeaderPtr + sizeof(struct memory_page_header));
+        
+        heapAllocatorPtr->identifier = MEMORY_HEADER_ID;
+        heapAllocatorPtr->byteSize = pageHeaderPtr->heapByteSize - sizeof(struct memory_allocator);
+        heapAllocatorPtr->prevPhysicalAllocatorByteOffset = MEMORY_TLSF_NULL_BYTE_OFFSET;
+
+        memory_get_null_allocation_key(&heapAllocatorPtr->allocationKey);
+
+        _memory_tlsf_insert_free_allocator(pageHeaderPtr, sizeof(struct memory_page_header));
+    }
+
+    u64 searchByteSize = _memory_get_aligned_search_byte_size(byteSize, alignment);
+    p64 allocatorByteOffset = _memory_tlsf_find_free_allocator(pageHeaderPtr, searchByteSize);
+
+    if (allocatorByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        return MEMORY_TLSF_NULL_BYTE_OFFSET;
+    }
+
+    // the allocation, plus the header of whatever free tail gets split off of it
+    if (_memory_commit_page_heap(contextPtr, pageHeaderPtr, allocatorByteOffset + 
+        sizeof(struct memory_allocator)*2 + searchByteSize) != MEMORY_OK)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Failure to commit page memory for new allocation.", 
+            __func__, __LINE__);
+
+        return MEMORY_TLSF_NULL_BYTE_OFFSET;
+    }
+
+    _memory_tlsf_remove_free_allocator(pageHeaderPtr, allocatorByteOffset);
+
+    allocatorByteOffset = _memory_split_allocator_alignment_gap(pageHeaderPtr, allocatorByteOffset, alignment, 
+        alignedByteOffset);
+
+    struct memory_allocator *allocatorPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+
+    if (pageHeaderPtr->activeAllocatorCount > 0)
+    {
+        struct memory_allocator *nextAllocatorPtr = (void *)((p64)pageHeaderPtr + pageHeaderPtr->activeAllocatorByteOffsetList);
+        struct memory_allocator *prevAllocatorPtr = (void *)((p64)pageHeaderPtr + nextAllocatorPtr->prevAllocatorByteOffset);
+
+        allocatorPtr->prevAllocatorByteOffset = nextAllocatorPtr->prevAllocatorByteOffset;
+        allocatorPtr->nextAllocatorByteOffset = pageHeaderPtr->activeAllocatorByteOffsetList;
+
+        prevAllocatorPtr->nextAllocatorByteOffset = allocatorByteOffset;
+        nextAllocatorPtr->prevAllocatorByteOffset = allocatorByteOffset;
+    }
+    else
+    {
+        allocatorPtr->prevAllocatorByteOffset = allocatorPtr->nextAllocatorByteOffset = allocatorByteOffset;
+    }
+
+    _memory_split_allocator(pageHeaderPtr, allocatorByteOffset, byteSize);
+
+    pageHeaderPtr->activeAllocatorByteOffsetList = allocatorByteOffset;
+
+    ++pageHeaderPtr->activeAllocatorCount;
+
+    return allocatorByteOffset;
+}
+
+static void
+_memory_give_back_allocator(struct memory_page_header *pageHeaderPtr, p64 allocatorByteOffset)
+{
+    struct memory_allocator *allocatorPtr = (void *)((p64)pageHeaderPtr + allocatorByteOffset);
+
+    if (pageHeaderPtr->activeAllocatorCount > 1)
+    {
+        struct memory_allocator *prevAllocator = (void *)((p64)pageHeaderPtr + allocatorPtr->prevAllocatorByteOffset);
+        struct memory_allocator *nextAllocator = (void *)((p64)pageHeaderPtr + allocatorPtr->nextAllocatorByteOffset);
+
+        prevAllocator->nextAllocatorByteOffset = allocatorPtr->nextAllocatorByteOffset;
+        nextAllocator->prevAllocatorByteOffset = allocatorPtr->prevAllocatorByteOffset;
+        
+        if (allocatorByteOffset == pageHeaderPtr->activeAllocatorByteOffsetList)
+        {
+            pageHeaderPtr->activeAllocatorByteOffsetList = allocatorPtr->nextAllocatorByteOffset;
+        }
+    }
+
+    --pageHeaderPtr->activeAllocatorCount;
+
+    memory_get_null_allocation_key(&allocatorPtr->allocationKey);
+
+    _memory_release_free_allocator(pageHeaderPtr, allocatorByteOffset);
+}
+
+static inline struct memory_slab *
+_memory_get_slab(struct memory_page_header *pageHeaderPtr, p64 slabByteOffset)
+{
+    return (void *)((u8 *)pageHeaderPtr + slabByteOffset + sizeof(struct memory_allocator));
+}
+
+static void
+_memory_link_slab(struct memory_page_header *pageHeaderPtr, p64 slabByteOffset)
+{
+    struct memory_slab *slabPtr = _memory_get_slab(pageHeaderPtr, slabByteOffset);
+    p64 *headByteOffsetPtr = &pageHeaderPtr->slabByteOffsetArr[slabPtr->classIndex];
+
+    slabPtr->prevSlabByteOffset = MEMORY_TLSF_NULL_BYTE_OFFSET;
+    slabPtr->nextSlabByteOffset = *headByteOffsetPtr;
+
+    if (*headByteOffsetPtr != MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        _memory_get_slab(pageHeaderPtr, *headByteOffsetPtr)->prevSlabByteOffset = slabByteOffset;
+    }
+
+    *headByteOffsetPtr = slabByteOffset;
+}
+
+static void
+_memory_unlink_slab(struct memory_page_header *pageHeaderPtr, p64 slabByteOffset)
+{
+    struct memory_slab *slabPtr = _memory_get_slab(pageHeaderPtr, slabByteOffset);
+
+    if (slabPtr->prevSlabByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        _memory_get_slab(pageHeaderPtr, slabPtr->prevSlabByteOffset)->nextSlabByteOffset = 
+            slabPtr->nextSlabByteOffset;
+    }
+    else
+    {
+        pageHeaderPtr->slabByteOffsetArr[slabPtr->classIndex] = slabPtr->nextSlabByteOffset;
+    }
+
+    if (slabPtr->nextSlabByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        _memory_get_slab(pageHeaderPtr, slabPtr->nextSlabByteOffset)->prevSlabByteOffset = 
+            slabPtr->prevSlabByteOffset;
+    }
+}
+
+// a slab is a regular allocation of the page, pinned (mapped for good) so compaction leaves its slots in place
+static p64
+_memory_create_slab(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, 
+    const struct memory_page_key *pageKeyPtr, u8 classIndex)
+{
+    u32 infoIndex;
+
+    if (_memory_pop_free_allocation_info(contextPtr, &infoIndex) != MEMORY_OK)
+    {
+        return MEMORY_TLSF_NULL_BYTE_OFFSET;
+    }
+
+    // the header sits on the boundary, so back to back slabs tile without alignment gaps in between
+    p64 slabByteOffset = _memory_take_allocator(contextPtr, pageHeaderPtr, MEMORY_SLAB_BYTE_SIZE - 
+        sizeof(struct memory_allocator), MEMORY_SLAB_BYTE_SIZE, sizeof(struct memory_allocator));
+
+    if (slabByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        _memory_push_free_allocation_info(contextPtr, infoIndex);
+
+        return MEMORY_TLSF_NULL_BYTE_OFFSET;
+    }
+
+    struct memory_allocation_info *allocInfoPtr = &((struct memory_allocation_info *)&(contextPtr->heap[
+        contextPtr->allocationInfoRegionByteOffset]))[infoIndex];
+
+    allocInfoPtr->pageId = pageKeyPtr->pageId;
+    allocInfoPtr->allocatorByteOffset = slabByteOffset;
+    allocInfoPtr->isActive = B32_TRUE;
+    allocInfoPtr->mapCount = 1;
+    allocInfoPtr->alignmentLog2 = MEMORY_TLSF_ALIGN_SIZE_LOG2;
+    allocInfoPtr->slabClassId = 0;
+    allocInfoPtr->isSlab = B32_TRUE;
+    allocInfoPtr->labelId = MEMORY_SHORT_ID_NULL;
+
+    _memory_link_allocation_info(contextPtr, pageHeaderPtr, infoIndex);
+
+    struct memory_allocation_key *slabAllocKeyPtr = (void *)&((struct memory_allocator *)((u8 *)pageHeaderPtr + 
+        slabByteOffset))->allocationKey;
+
+    memory_get_null_allocation_key(slabAllocKeyPtr);
+    memcpy((void *)&slabAllocKeyPtr->managed.contextKey, &pageKeyPtr->contextKey, sizeof(struct memory_context_key));
+
+    slabAllocKeyPtr->isManaged = B32_TRUE;
+    slabAllocKeyPtr->managed.generation = allocInfoPtr->generation;
+    slabAllocKeyPtr->managed.allocInfoIndex = infoIndex;
+
+    struct memory_slab *slabPtr = _memory_get_slab(pageHeaderPtr, slabByteOffset);
+
+    slabPtr->identifier = MEMORY_SLAB_ID;
+    slabPtr->classIndex = classIndex;
+    slabPtr->slotByteSize = g_MEMORY_SLAB_SLOT_BYTE_SIZE_ARR[classIndex];
+    slabPtr->slotCount = (u16)((MEMORY_SLAB_BYTE_SIZE - sizeof(struct memory_allocator) - 
+        MEMORY_SLAB_SLOTS_BYTE_OFFSET)/slabPtr->slotByteSize);
+    slabPtr->freeSlotCount = slabPtr->slotCount;
+    slabPtr->allocInfoIndex = infoIndex;
+
+    memset(slabPtr->freeSlotBitmapArr, '\0', sizeof(slabPtr->freeSlotBitmapArr));
+
+    for (u32 slotIndex = 0; slotIndex < slabPtr->slotCount; slotIndex += 64)
+    {
+        u32 bitCount = slabPtr->slotCount - slotIndex;
+
+        slabPtr->freeSlotBitmapArr[slotIndex/64] = (bitCount >= 64) ? ~(u64)0 : (((u64)1 << bitCount) - 1);
+    }
+
+    _memory_link_slab(pageHeaderPtr, slabByteOffset);
+
+    ++contextPtr->pagesRegionAccumActiveAllocationCount;
+
+    return slabByteOffset;
+}
+
+static void
+_memory_destroy_slab(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, 
+    p64 slabByteOffset)
+{
+    u32 infoIndex = _memory_get_slab(pageHeaderPtr, slabByteOffset)->allocInfoIndex;
+
+    _memory_unlink_slab(pageHeaderPtr, slabByteOffset);
+
+    _memory_get_slab(pageHeaderPtr, slabByteOffset)->identifier = 0;
+
+    _memory_give_back_allocator(pageHeaderPtr, slabByteOffset);
+    _memory_unlink_allocation_info(contextPtr, pageHeaderPtr, infoIndex);
+    _memory_push_free_allocation_info(contextPtr, infoIndex);
+
+    --contextPtr->pagesRegionAccumActiveAllocationCount;
+}
+
+// takes a slot of the size class, and returns its allocation info allocatorByteOffset (see 
+// memory_allocation_info.slabClassId). Returns NULL when no slab can be made.
+static p64
+_memory_take_slab_slot(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, 
+    const struct memory_page_key *pageKeyPtr, u8 classIndex)
+{
+    p64 slabByteOffset = pageHeaderPtr->slabByteOffsetArr[classIndex];
+
+    if (slabByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        if ((slabByteOffset = _memory_create_slab(contextPtr, pageHeaderPtr, pageKeyPtr, classIndex)) == 
+            MEMORY_TLSF_NULL_BYTE_OFFSET)
+        {
+            return MEMORY_TLSF_NULL_BYTE_OFFSET;
+        }
+    }
+
+    struct memory_slab *slabPtr = _memory_get_slab(pageHeaderPtr, slabByteOffset);
+    u32 wordIndex = 0;
+
+    while (!slabPtr->freeSlotBitmapArr[wordIndex])
+    {
+        ++wordIndex;
+    }
+
+    u32 bitIndex = _memory_find_first_set_bit_u64(slabPtr->freeSlotBitmapArr[wordIndex]);
+    u32 slotIndex = wordIndex*64 + bitIndex;
+
+    slabPtr->freeSlotBitmapArr[wordIndex] &= ~((u64)1 << bitIndex);
+
+    if ((--slabPtr->freeSlotCount) == 0)
+    {
+        _memory_unlink_slab(pageHeaderPtr, slabByteOffset);
+    }
+
+    return slabByteOffset + MEMORY_SLAB_SLOTS_BYTE_OFFSET + (p64)slotIndex*slabPtr->slotByteSize;
+}
+
+static void
+_memory_release_slab_slot(struct memory_context *contextPtr, struct memory_page_header *pageHeaderPtr, 
+    p64 allocatorByteOffset)
+{
+    u8 *slotPtr = (u8 *)pageHeaderPtr + allocatorByteOffset + sizeof(struct memory_allocator);
+    struct memory_slab *slabPtr = (void *)(((p64)slotPtr & ~(MEMORY_SLAB_BYTE_SIZE - 1)) + 
+        sizeof(struct memory_allocator));
+    p64 slabByteOffset = (p64)slabPtr - sizeof(struct memory_allocator) - (p64)pageHeaderPtr;
+    u32 slotIndex = (u32)(((p64)slotPtr - (p64)slabPtr - MEMORY_SLAB_SLOTS_BYTE_OFFSET)/slabPtr->slotByteSize);
+
+    assert(slabPtr->identifier == MEMORY_SLAB_ID);
+    assert(!(slabPtr->freeSlotBitmapArr[slotIndex/64] & ((u64)1 << (slotIndex % 64))));
+
+    slabPtr->freeSlotBitmapArr[slotIndex/64] |= (u64)1 << (slotIndex % 64);
+
+    if ((slabPtr->freeSlotCount++) == 0)
+    {
+        _memory_link_slab(pageHeaderPtr, slabByteOffset);
+    }
+
+    // an empty slab goes back to the page, unless it's the last one of its class with room (so alternating 
+    // an alloc and a free doesn't make and destroy a slab every time)
+    if ((slabPtr->freeSlotCount == slabPtr->slotCount) && ((slabPtr->prevSlabByteOffset != 
+        MEMORY_TLSF_NULL_BYTE_OFFSET) || (slabPtr->nextSlabByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET)))
+    {
+        _memory_destroy_slab(contextPtr, pageHeaderPtr, slabByteOffset);
+    }
+}
+
+memory_error_code
+memory_alloc(const struct memory_page_key *pageKeyPtr, u64 byteSize, const char *debugLabelStr,
+    const struct memory_allocation_key *outAllocKeyPtr)
+{
+    return memory_alloc_aligned(pageKeyPtr, byteSize, 0, debugLabelStr, outAllocKeyPtr);
+}
+
+static memory_error_code
+_memory_alloc_aligned_locked(const struct memory_page_key *pageKeyPtr, u64 byteSize, u64 alignment, 
+    const char *debugLabelStr, const struct memory_allocation_key *outAllocKeyPtr)
+{
+    if (!pageKeyPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'pageKeyPtr' argument cannot be NULL.",
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if (MEMORY_IS_PAGE_NULL(pageKeyPtr))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'pageKeyPtr' argument cannot be a NULL key value.", 
+            __func__, __LINE__);
+
+        return MEMORY_ERROR_NULL_ID;
+    }
+
+    if (!outAllocKeyPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'outAllocKeyPtr' argument cannot be NULL.");
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if ((alignment & (alignment - 1)) || (alignment > MEMORY_MAX_ALIGNMENT))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): 'alignment' argument must be a power of two, no larger than "
+            "MEMORY_MAX_ALIGNMENT (alignment: %llu).", __func__, __LINE__, (unsigned long long)alignment);
+
+        return MEMORY_ERROR_UNKNOWN;
+    }
+
+    struct memory_context *contextPtr;
+    const struct memory_allocation_key resultKey;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&pageKeyPtr->contextKey, 
+        (void *)&contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            utils_fprintfln(stderr, "%s(Line: %d): Could not get an active memory context "
+                "from the provided key.", __func__, __LINE__);
+
+            return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+        }
+
+        memset((void *)&resultKey, '\0', sizeof(struct memory_allocation_key));
+        memcpy((void *)&resultKey.managed.contextKey, &pageKeyPtr->contextKey, sizeof(struct memory_context_key));
+
+        ((struct memory_allocation_key *)&resultKey)->isManaged = B32_TRUE;
+    }
+
+    struct memory_page_header *pageHeaderPtr;
+    {
+        struct memory_page_info *pageInfoPtr;
+
+        if ((_memory_get_page_info(contextPtr, pageKeyPtr, &pageInfoPtr) == MEMORY_OK) && 
+            (pageInfoPtr->status == MEMORY_PAGE_STATUS_UNLOCKED))
+        {
+            pageHeaderPtr = (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+                pageInfoPtr->pageHeaderByteOffset];
+        }
+        else 
+        {
+            pageHeaderPtr = NULL;
+        }
+    }
+
+    if (!pageHeaderPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): Page is not unlocked, or safe for "
+            "allocating memory.", __func__, __LINE__);
+        
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    // keep every allocator header aligned
+    byteSize = (byteSize + (MEMORY_TLSF_ALIGN_SIZE - 1)) & ~(MEMORY_TLSF_ALIGN_SIZE - 1);
+
+    // the page's alignment is a floor for everything allocated on it
+    if (alignment < ((u64)1 << pageHeaderPtr->alignmentLog2))
+    {
+        alignment = (u64)1 << pageHeaderPtr->alignmentLog2;
+    }
+
+    u32 infoIndex;
+
+    if (_memory_pop_free_allocation_info(contextPtr, &infoIndex) != MEMORY_OK)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d): "
+            "Could not find enough free space, "
+            "in the allocation info region, for new allocation. Aborting.", __func__, __LINE__);
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    p64 allocatorByteOffset;
+    u8 slabClassId = 0;
+
+    if ((MEMORY_SLAB_MAX_BYTE_SIZE > 0) && (byteSize <= MEMORY_SLAB_MAX_BYTE_SIZE) && 
+        (alignment <= MEMORY_TLSF_ALIGN_SIZE))
+    {
+        u8 classIndex = g_MEMORY_SLAB_CLASS_INDEX_ARR[(byteSize ? byteSize : MEMORY_TLSF_ALIGN_SIZE)/
+            MEMORY_TLSF_ALIGN_SIZE - 1];
+
+        allocatorByteOffset = _memory_take_slab_slot(contextPtr, pageHeaderPtr, pageKeyPtr, classIndex);
+        slabClassId = classIndex + 1;
+    }
+    else 
+    {
+        allocatorByteOffset = _memory_take_allocator(contextPtr, pageHeaderPtr, byteSize, alignment, 0);
+    }
+
+    if (allocatorByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+    {
+        _memory_push_free_allocation_info(contextPtr, infoIndex);
+
+        utils_fprintfln(stderr, "%s(Line: %d): " "Could not find enough free space, "
+            "in page, for new allocation. Aborting.", __func__, __LINE__);
+
+        return MEMORY_ERROR_FAILED_ALLOCATION;
+    }
+
+    struct memory_allocation_info *allocationInfoPtr = &((struct memory_allocation_info *)&(contextPtr->heap[
+        contextPtr->allocationInfoRegionByteOffset]))[infoIndex];
+
+    allocationInfoPtr->pageId = pageKeyPtr->pageId;
+    allocationInfoPtr->allocatorByteOffset = allocatorByteOffset;
+    allocationInfoPtr->isActive = B32_TRUE;
+    allocationInfoPtr->mapCount = 0;
+    allocationInfoPtr->alignmentLog2 = slabClassId ? (u8)MEMORY_TLSF_ALIGN_SIZE_LOG2 : 
+        (u8)_memory_find_last_set_bit_u64(alignment);
+    allocationInfoPtr->slabClassId = slabClassId;
+
+    _memory_link_allocation_info(contextPtr, pageHeaderPtr, infoIndex);
+
+    ((struct memory_allocation_key *)&resultKey)->managed.generation = allocationInfoPtr->generation;
+    ((struct memory_allocation_key *)(&resultKey))->managed.allocInfoIndex = infoIndex;
+
+    if (!slabClassId)
+    {
+        memcpy((void *)&((struct memory_allocator *)((u8 *)pageHeaderPtr + allocatorByteOffset))->allocationKey, 
+            &resultKey, sizeof(struct memory_allocation_key));
+    }
+
+    allocationInfoPtr->labelId = MEMORY_SHORT_ID_NULL;
+
+    if (contextPtr->isDebug && debugLabelStr)
+    {
+        struct memory_debug_context *debugContextPtr = (void *)contextPtr;
+
+        if ((allocationInfoPtr->labelId = _memory_intern_label(debugContextPtr, debugLabelStr)) != 
+            MEMORY_SHORT_ID_NULL)
+        {
+            ++debugContextPtr->labelEntryArr[allocationInfoPtr->labelId - 1].activeAllocationCount;
+        }
+    }
+
+    memcpy((void *)outAllocKeyPtr, &resultKey, sizeof(struct memory_allocation_key));
+
+    u64 allocationByteSize = _memory_get_allocation_byte_size(pageHeaderPtr, allocationInfoPtr);
+
+    ++contextPtr->pagesRegionAccumActiveAllocationCount;
+    ++contextPtr->stats.allocCount;
+    ++contextPtr->stats.frameAllocCount;
+
+    _memory_track_live_bytes(contextPtr, pageHeaderPtr, allocationByteSize, 0);
+
+    _memory_record_event(contextPtr, MEMORY_EVENT_ALLOC, memory_get_allocation_handle(&resultKey), pageKeyPtr->pageId,
+        allocationByteSize, allocatorByteOffset);
+
+    return MEMORY_OK;
+}
+
+static memory_error_code
+_memory_realloc_locked(const struct memory_allocation_key *allocKeyPtr, u64 byteSize,
+    const struct memory_allocation_key *outAllocKeyPtr)
+{
+    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)))
+    {
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): 'allocKeyPtr' "
+            "argument cannot be NULL.\n", 
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
+
+        if (outAllocKeyPtr)
+        {
+            memory_get_null_allocation_key(outAllocKeyPtr);
+        }
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    if (!outAllocKeyPtr)
+    {
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): 'outAllocKeyPtr' "
+            "argument cannot be NULL.\n", 
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
+
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_context *memoryPtr;
+    {
+        memory_error_code resultCode;
+
+        if ((resultCode = _memory_get_context_key_is_ok(&allocKeyPtr->managed.contextKey)) == MEMORY_OK)
+        {
+            resultCode = _memory_get_context((struct memory_context_key *)
+                &allocKeyPtr->managed.contextKey, &memoryPtr);
+
+            if (resultCode != MEMORY_OK)
+            {
+                utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Could not "
+                    "find the intended context.\n", 
+                    __FUNCTION__, __LINE__, (u32)resultCode);
+
+                memory_get_null_allocation_key(outAllocKeyPtr);
+
+                return resultCode;
+            }
+        }
+        else 
+        {
+            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Could not "
+                "find the intended context.\n", 
+                __FUNCTION__, __LINE__, (u32)resultCode);
+            
+            memory_get_null_allocation_key(outAllocKeyPtr);
+
+            return resultCode;
+        }
+    }
+
+    struct memory_allocation_info *allocInfoPtr;
+    {
+        memory_error_code resultCode = _memory_get_allocation_info(memoryPtr, allocKeyPtr, &allocInfoPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): 'allocKeyPtr' does not "
+                "refer to an active allocation.\n", 
+                __FUNCTION__, __LINE__, (u32)resultCode);
+
+            memory_get_null_allocation_key(outAllocKeyPtr);
+
+            return resultCode;
+        }
+    }
+
+    // gated holders have pointers into it, and resizing can move it
+    if (atomic_load_explicit(&allocInfoPtr->mapGate, memory_order_acquire) != 0)
+    {
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Allocation is mapped "
+            "through its gate. Cannot reallocate.\n", 
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_ALLOCATION_BUSY);
+
+        memory_get_null_allocation_key(outAllocKeyPtr);
+
+        return MEMORY_ERROR_ALLOCATION_BUSY;
+    }
+
+    struct memory_page_info *pageInfoPtr = &memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1];
+
+    struct memory_page_header *pagePtr;
+    {
+        if (pageInfoPtr->status == MEMORY_PAGE_STATUS_UNLOCKED)
+        {
+            pagePtr = (struct memory_page_header *)(&(memoryPtr->heap[
+                memoryPtr->pagesRegionByteOffset + pageInfoPtr->pageHeaderByteOffset]));
+        }
+        else 
+        {
+            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): The page "
+                "is currently locked.\n", 
+                __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
+            
+            memory_get_null_allocation_key(outAllocKeyPtr);
+
+            return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
+        }
+    }
+
+    u64 prevByteSize = _memory_get_allocation_byte_size(pagePtr, allocInfoPtr);
+
+    byteSize = (byteSize + (MEMORY_TLSF_ALIGN_SIZE - 1)) & ~(MEMORY_TLSF_ALIGN_SIZE - 1);
+
+    // a slot never shrinks, and outgrowing it moves the allocation to a bigger class's slot (or an allocator 
+    // of its own); the allocation info stays, so the key does too
+    if (allocInfoPtr->slabClassId)
+    {
+        if (prevByteSize < byteSize)
+        {
+            p64 allocatorByteOffset;
+            u8 slabClassId = 0;
+
+            if (byteSize <= MEMORY_SLAB_MAX_BYTE_SIZE)
+            {
+                u8 classIndex = g_MEMORY_SLAB_CLASS_INDEX_ARR[byteSize/MEMORY_TLSF_ALIGN_SIZE - 1];
+                struct memory_page_key pageKey = {.pageId = allocInfoPtr->pageId};
+
+                memcpy((void *)&pageKey.contextKey, &allocKeyPtr->managed.contextKey, 
+                    sizeof(struct memory_context_key));
+
+                allocatorByteOffset = _memory_take_slab_slot(memoryPtr, pagePtr, &pageKey, classIndex);
+                slabClassId = classIndex + 1;
+            }
+            else
+            {
+                allocatorByteOffset = _memory_take_allocator(memoryPtr, pagePtr, byteSize, 
+                    (u64)1 << allocInfoPtr->alignmentLog2, 0);
+            }
+
+            if (allocatorByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+            {
+                utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): The page "
+                    "has no free allocators available that can meet the requested byteSize. "
+                    "Likely out of space to reallocate alloc.", 
+                    __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_FAILED_ALLOCATION);
+                
+                memory_get_null_allocation_key(outAllocKeyPtr);
+
+                return MEMORY_ERROR_FAILED_ALLOCATION;
+            }
+
+            if (!slabClassId)
+            {
+                memcpy((void *)&((struct memory_allocator *)((u8 *)pagePtr + allocatorByteOffset))->allocationKey, 
+                    allocKeyPtr, sizeof(struct memory_allocation_key));
+            }
+
+            memcpy((u8 *)pagePtr + allocatorByteOffset + sizeof(struct memory_allocator), (u8 *)pagePtr + 
+                allocInfoPtr->allocatorByteOffset + sizeof(struct memory_allocator), prevByteSize);
+
+            _memory_release_slab_slot(memoryPtr, pagePtr, allocInfoPtr->allocatorByteOffset);
+
+            allocInfoPtr->allocatorByteOffset = allocatorByteOffset;
+            allocInfoPtr->slabClassId = slabClassId;
+        }
+    }
+    else
+    {
+        struct memory_allocator *lhsAllocPtr = (void *)((u8 *)pagePtr + allocInfoPtr->allocatorByteOffset);
+        p64 rhsAllocatorByteOffset;
+        struct memory_allocator *rhsAllocatorPtr;
+
+        // append patterns (grow by one element) mostly end up here: the tail split off by the previous grow is 
+        // still free right behind the allocation, so it is absorbed instead of allocating and copying
+        if (lhsAllocPtr->byteSize < byteSize)
+        {
+            _memory_grow_allocator_in_place(memoryPtr, pagePtr, allocInfoPtr->allocatorByteOffset, byteSize);
+        }
+
+        if (lhsAllocPtr->byteSize < byteSize)
+        {
+            u64 alignment = (u64)1 << allocInfoPtr->alignmentLog2;
+            u64 searchByteSize = _memory_get_aligned_search_byte_size(byteSize, alignment);
+
+            rhsAllocatorByteOffset = _memory_tlsf_find_free_allocator(pagePtr, searchByteSize);
+
+            if (rhsAllocatorByteOffset == MEMORY_TLSF_NULL_BYTE_OFFSET)
+            {
+                utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): The page "
+                    "has no free allocators available that can meet the requested byteSize. "
+                    "Likely out of space to reallocate alloc.", 
+                    __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_FAILED_ALLOCATION);
+            
+                memory_get_null_allocation_key(outAllocKeyPtr);
+
+                return MEMORY_ERROR_FAILED_ALLOCATION;
+            }
+
+            if (_memory_commit_page_heap(memoryPtr, pagePtr, rhsAllocatorByteOffset + 
+                sizeof(struct memory_allocator)*2 + searchByteSize) != MEMORY_OK)
+            {
+                utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Failure to commit page memory "
+                    "for the reallocation.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_FAILED_ALLOCATION);
+            
+                memory_get_null_allocation_key(outAllocKeyPtr);
+
+                return MEMORY_ERROR_FAILED_ALLOCATION;
+            }
+
+            _memory_tlsf_remove_free_allocator(pagePtr, rhsAllocatorByteOffset);
+
+            rhsAllocatorByteOffset = _memory_split_allocator_alignment_gap(pagePtr, rhsAllocatorByteOffset, 
+                alignment, 0);
+            rhsAllocatorPtr = (void *)((u8 *)pagePtr + rhsAllocatorByteOffset);
+
+            _memory_split_allocator(pagePtr, rhsAllocatorByteOffset, byteSize);
+
+            // note: do not need to inc active count, since we're simply replacing 
+            // with new allocator the old one
+            if (pagePtr->activeAllocatorCount > 1)
+            {
+                struct memory_allocator *prevActiveAllocatorPtr = (void *)((u8 *)pagePtr + 
+                    lhsAllocPtr->prevAllocatorByteOffset);
+                struct memory_allocator *nextActiveAllocatorPtr = (void *)((u8 *)pagePtr + 
+                    lhsAllocPtr->nextAllocatorByteOffset);
+
+                rhsAllocatorPtr->prevAllocatorByteOffset = lhsAllocPtr->prevAllocatorByteOffset;
+                rhsAllocatorPtr->nextAllocatorByteOffset = lhsAllocPtr->nextAllocatorByteOffset;
+
+                prevActiveAllocatorPtr->nextAllocatorByteOffset = rhsAllocatorByteOffset;
+                nextActiveAllocatorPtr->prevAllocatorByteOffset = rhsAllocatorByteOffset;
+            }
+            else
+            {
+                rhsAllocatorPtr->prevAllocatorByteOffset = rhsAllocatorPtr->nextAllocatorByteOffset =
+                    rhsAllocatorByteOffset;
+            }
+
+            if (pagePtr->activeAllocatorByteOffsetList == allocInfoPtr->allocatorByteOffset)
+            {
+                pagePtr->activeAllocatorByteOffsetList = rhsAllocatorByteOffset;
+            }
+
+            memcpy((void *)&rhsAllocatorPtr->allocationKey, &lhsAllocPtr->allocationKey, 
+                sizeof(struct memory_allocation_key));
+            memcpy((u8 *)rhsAllocatorPtr + sizeof(struct memory_allocator), (u8 *)lhsAllocPtr + sizeof(
+                struct memory_allocator), lhsAllocPtr->byteSize);
+
+            memory_get_null_allocation_key(&lhsAllocPtr->allocationKey);
+
+            _memory_release_free_allocator(pagePtr, allocInfoPtr->allocatorByteOffset);
+
+            allocInfoPtr->allocatorByteOffset = rhsAllocatorByteOffset;
+        }
+        else if (lhsAllocPtr->byteSize > byteSize)
+        {
+            _memory_split_allocator(pagePtr, allocInfoPtr->allocatorByteOffset, byteSize);
+        }
+    }
+
+    u64 nextByteSize = _memory_get_allocation_byte_size(pagePtr, allocInfoPtr);
+
+    _memory_track_live_bytes(memoryPtr, pagePtr, nextByteSize, prevByteSize);
+
+    _memory_record_event(memoryPtr, MEMORY_EVENT_REALLOC, memory_get_allocation_handle(allocKeyPtr), 
+        allocInfoPtr->pageId, nextByteSize, allocInfoPtr->allocatorByteOffset);
+
+    if (outAllocKeyPtr != allocKeyPtr)
+    {
+        memcpy((void *)outAllocKeyPtr, allocKeyPtr, sizeof(struct memory_allocation_key));
+    }
 
     return MEMORY_OK;
 }
 
 memory_error_code
-memory_get_context_key_is_ok(const struct memory_context_key *contextKeyPtr)
+memory_realloc(const struct memory_allocation_key *allocKeyPtr, u64 byteSize,
+    const struct memory_allocation_key *outAllocKeyPtr)
 {
-    return _memory_get_context_key_is_ok(contextKeyPtr);
+    struct memory_lock *lockPtr = _memory_get_allocation_lock(allocKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_realloc_locked(allocKeyPtr, byteSize, outAllocKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
 }
 
-memory_error_code
-memory_alloc_page(const struct memory_context_key *memoryContextKeyPtr, u64 byteSize, const struct memory_page_key *outPageKeyPtr)
+static memory_error_code
+_memory_free_locked(const struct memory_allocation_key *allocKeyPtr)
 {
-    if ((_memory_get_context_key_is_ok(memoryContextKeyPtr)) != MEMORY_OK)
-    {
-        utils_fprintf(stderr, "%s(%d): Cannot allocate page, context key is not valid!\n", 
-                __FUNCTION__, __LINE__);
-        
-        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
-    }
-    else if (!outPageKeyPtr)
+    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)))
     {
-        utils_fprintf(stderr, "%s(%d): Cannot allocate page, 'cause 'outPageKeyPtr' argument is NULL!\n", 
-                __FUNCTION__, __LINE__);
-        
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): 'allocKeyPtr' argument "
+            "cannot be NULL.\n", 
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
+    
         return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
-    struct memory_context *contextPtr;
+    if ((MEMORY_IS_CONTEXT_NULL(&allocKeyPtr->managed.contextKey)))
     {
-        memory_error_code resultCode;
-
-        if ((resultCode =_memory_get_context((struct memory_context_key *)memoryContextKeyPtr, 
-            &contextPtr)) != MEMORY_OK)
-        {
-            ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
-            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
-            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Not an "
+            "active memory context.\n", 
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT);
 
-            return resultCode;
-        }
+        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
     }
 
-    // get/allocate a page header and allocated bytes
-    p64 pagesRegionByteIndex = (p64)contextPtr->heap + contextPtr->pagesRegionByteOffset;
-    struct memory_page_header *pageHeaderPtr;
-
-    if (contextPtr->pagesRegionFreeCount > 0)
+    struct memory_context *memoryPtr;
     {
-        pageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + contextPtr->freePagesByteOffsetList);
+        memory_error_code resultCode = _memory_get_context_key_is_ok(&allocKeyPtr->managed.contextKey);
 
-        memory_error_code resultCode = MEMORY_ERROR_FAILED_ALLOCATION;
-
-        do
+        if (resultCode != MEMORY_OK)
         {
-            if (pageHeaderPtr->heapByteSize >= byteSize)
-            {
-                resultCode = MEMORY_OK;
+            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Context key "
+                "is not valid.\n", 
+                __FUNCTION__, __LINE__, (u32)resultCode);
 
-                break;
-            }
-        } while((pageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + ((pageHeaderPtr->nextPageHeaderByteOffset !=
-                contextPtr->freePagesByteOffsetList) ? pageHeaderPtr->nextPageHeaderByteOffset : -pagesRegionByteIndex))));
+            return resultCode;
+        }
+
+        resultCode = _memory_get_context((void *)&allocKeyPtr->managed.contextKey, 
+        &memoryPtr);
 
         if (resultCode != MEMORY_OK)
         {
-            ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
-            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
-            ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
-            
-            utils_fprintf(stderr, "memory_alloc_page(%d): Failure to locate page large enough. "
-                    "Cannot allocate a page.\n", __LINE__);
+            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Could not "
+                "get the context using the provided key.\n", 
+                __FUNCTION__, __LINE__, (u32)resultCode);
 
             return resultCode;
         }
-
-        --contextPtr->pagesRegionFreeCount;
     }
-    // if there are no free pages, and there are no active pages, then there are zero allocated pages! 
-    // Therefore allocate the first one.
-    else if (contextPtr->pagesRegionActiveCount < 1)
-    {
-        pageHeaderPtr = (struct memory_page_header *)(contextPtr->heap + contextPtr->pagesRegionByteOffset);
 
-        memset(pageHeaderPtr, '\0', sizeof(struct memory_page_header));
+    struct memory_allocation_info *allocInfoPtr;
 
-        pageHeaderPtr->identifier = MEMORY_HEADER_ID;
-    }
-    else 
+    if (_memory_get_allocation_info(memoryPtr, allocKeyPtr, &allocInfoPtr) != MEMORY_OK)
     {
-        ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
-        ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
-        ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
-
-        utils_fprintf(stderr, "memory_alloc_page(%d): Out of space. "
-                "Cannot allocate a page.\n", __LINE__);
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): 'allocKeyPtr' does not "
+            "refer to an active allocation.\n", 
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
 
-        return MEMORY_ERROR_FAILED_ALLOCATION;
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
     }
 
-    if (contextPtr->pagesRegionActiveCount > 0)
+    struct memory_page_info *pageInfoPtr = &memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1];
+
+    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_LOCKED)
     {
-        struct memory_page_header *headActivePageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex +
-            contextPtr->activePagesByteOffsetList);
-        pageHeaderPtr->prevPageHeaderByteOffset = headActivePageHeaderPtr->prevPageHeaderByteOffset;
-        pageHeaderPtr->nextPageHeaderByteOffset = contextPtr->activePagesByteOffsetList;
-        
-        struct memory_page_header *prevActivePageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex +
-            headActivePageHeaderPtr->prevPageHeaderByteOffset);
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Page is locked. "
+            "Cannot free allocation..\n", 
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
 
-        prevActivePageHeaderPtr->nextPageHeaderByteOffset = (p64)pageHeaderPtr - pagesRegionByteIndex;
-        headActivePageHeaderPtr->prevPageHeaderByteOffset = (p64)pageHeaderPtr - pagesRegionByteIndex;
+        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
     }
-    else 
+
+    if (atomic_load_explicit(&allocInfoPtr->mapGate, memory_order_acquire) != 0)
     {
-        pageHeaderPtr->prevPageHeaderByteOffset = pageHeaderPtr->nextPageHeaderByteOffset = (p64)pageHeaderPtr - 
-            pagesRegionByteIndex;
+        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Allocation is mapped "
+            "through its gate. Cannot free allocation.\n", 
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_ALLOCATION_BUSY);
+
+        return MEMORY_ERROR_ALLOCATION_BUSY;
     }
 
-    pageHeaderPtr->identifier = MEMORY_HEADER_ID;
+    struct memory_page_header *pagePtr = (void *)((p64)memoryPtr->heap + memoryPtr->pagesRegionByteOffset +
+        pageInfoPtr->pageHeaderByteOffset);
 
-    contextPtr->activePagesByteOffsetList = (p64)pageHeaderPtr - pagesRegionByteIndex;
-    ++contextPtr->pagesRegionActiveCount;
+    u64 byteSize = _memory_get_allocation_byte_size(pagePtr, allocInfoPtr);
 
-    // split the page for future page allocations, if we can
-    u64 diffByteSize = pageHeaderPtr->heapByteSize - byteSize;
-    
-    if (diffByteSize > sizeof(struct memory_page_header))
+    _memory_record_event(memoryPtr, MEMORY_EVENT_FREE, memory_get_allocation_handle(allocKeyPtr), 
+        allocInfoPtr->pageId, byteSize, allocInfoPtr->allocatorByteOffset);
+
+    --memoryPtr->pagesRegionAccumActiveAllocationCount;
+    ++memoryPtr->stats.freeCount;
+    ++memoryPtr->stats.frameFreeCount;
+
+    _memory_track_live_bytes(memoryPtr, pagePtr, 0, byteSize);
+
+    if (allocInfoPtr->slabClassId)
+    {
+        _memory_release_slab_slot(memoryPtr, pagePtr, allocInfoPtr->allocatorByteOffset);
+    }
+    else
     {
-        p64 splitPageHeaderByteOffset = contextPtr->pagesRegionByteOffset + sizeof(struct memory_page_header) + pageHeaderPtr->heapByteSize;
-        struct memory_page_header *splitPageHeader = (struct memory_page_header *)(contextPtr->heap + splitPageHeaderByteOffset);
+        _memory_give_back_allocator(pagePtr, allocInfoPtr->allocatorByteOffset);
+    }
 
-        memset(splitPageHeader, '\0', sizeof(struct memory_page_header));
+    _memory_unlink_allocation_info(memoryPtr, pagePtr, allocKeyPtr->managed.allocInfoIndex);
 
-        splitPageHeader->identifier = MEMORY_HEADER_ID;
-        splitPageHeader->heapByteSize = diffByteSize - sizeof(struct memory_page_header);
-        
-        pageHeaderPtr->heapByteSize = byteSize;
+    _memory_push_free_allocation_info(memoryPtr, allocKeyPtr->managed.allocInfoIndex);
 
-        if (contextPtr->pagesRegionFreeCount > 0)
-        {
-            struct memory_page_header *headFreePageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + 
-                contextPtr->freePagesByteOffsetList);
-            
-            struct memory_page_header *prevFreePageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + 
-                headFreePageHeaderPtr->prevPageHeaderByteOffset);
+    memory_get_null_allocation_key(allocKeyPtr);
 
-            prevFreePageHeaderPtr->nextPageHeaderByteOffset = splitPageHeaderByteOffset;
-            splitPageHeader->prevPageHeaderByteOffset = pagesRegionByteIndex;
+    return MEMORY_OK;
+}
 
-            splitPageHeader->nextPageHeaderByteOffset = contextPtr->freePagesByteOffsetList;
-        }
-        else 
+static void
+_memory_thread_cache_get_block_key(memory_short_id contextId, const struct memory_thread_cache_block *blockPtr, 
+    const struct memory_allocation_key *outAllocKeyPtr)
+{
+    memory_get_null_allocation_key(outAllocKeyPtr);
+
+    ((struct memory_context_key *)&outAllocKeyPtr->managed.contextKey)->contextId = contextId;
+    ((struct memory_allocation_key *)outAllocKeyPtr)->managed.generation = blockPtr->generation;
+    ((struct memory_allocation_key *)outAllocKeyPtr)->managed.allocInfoIndex = blockPtr->allocInfoIndex;
+    ((struct memory_allocation_key *)outAllocKeyPtr)->isManaged = B32_TRUE;
+}
+
+// under the context lock. A block is only freed if it's still the one the cache parked: freeing its page, or 
+// restoring the context, already took it back (and bumped its generation). It was counted as freed when it was 
+// parked, so the count of the free is taken back.
+static void
+_memory_thread_cache_give_back_block(struct memory_context *contextPtr, 
+    const struct memory_thread_cache_page *cachePagePtr, const struct memory_thread_cache_block *blockPtr)
+{
+    const struct memory_allocation_key allocKey;
+    struct memory_allocation_info *allocInfoPtr;
+
+    _memory_thread_cache_get_block_key(cachePagePtr->contextId, blockPtr, &allocKey);
+
+    if ((_memory_get_allocation_info(contextPtr, &allocKey, &allocInfoPtr) == MEMORY_OK) && 
+        allocInfoPtr->isActive && allocInfoPtr->slabClassId && (allocInfoPtr->pageId == cachePagePtr->pageId))
+    {
+        u64 byteSize = g_MEMORY_SLAB_SLOT_BYTE_SIZE_ARR[allocInfoPtr->slabClassId - 1];
+
+        if (_memory_free_locked(&allocKey) == MEMORY_OK)
         {
-            splitPageHeader->prevPageHeaderByteOffset = splitPageHeader->nextPageHeaderByteOffset = splitPageHeaderByteOffset;
+            --contextPtr->stats.freeCount;
+            --contextPtr->stats.frameFreeCount;
+
+            _memory_track_live_bytes(contextPtr, (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+                contextPtr->pagesRegionInfoArr[cachePagePtr->pageId - 1].pageHeaderByteOffset], byteSize, 0);
         }
-        
-        contextPtr->freePagesByteOffsetList = splitPageHeaderByteOffset;
-        ++contextPtr->pagesRegionFreeCount;
     }
-    else 
+}
+
+// under the context lock. The live bytes are dropped if the page was freed (or the context restored) since, as 
+// the page's own count went with it
+static void
+_memory_thread_cache_settle_stats(struct memory_context *contextPtr, struct memory_thread_cache_page *cachePagePtr)
+{
+    contextPtr->stats.allocCount += cachePagePtr->pendingAllocCount;
+    contextPtr->stats.freeCount += cachePagePtr->pendingFreeCount;
+    contextPtr->stats.frameAllocCount += cachePagePtr->pendingAllocCount;
+    contextPtr->stats.frameFreeCount += cachePagePtr->pendingFreeCount;
+
+    if (contextPtr->pagesRegionInfoArr[cachePagePtr->pageId - 1].generation == cachePagePtr->pageGeneration)
     {
-        pageHeaderPtr->heapByteSize = contextPtr->pagesRegionByteCapacity - sizeof(struct memory_page_header);
+        _memory_track_live_bytes(contextPtr, (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+            contextPtr->pagesRegionInfoArr[cachePagePtr->pageId - 1].pageHeaderByteOffset], 
+            cachePagePtr->pendingAllocByteCount, cachePagePtr->pendingFreeByteCount);
     }
 
-    #define PAGES_REGION_INFO_ARR_REALLOC_MULTIPLIER 4
-
-    memory_short_id pageId = contextPtr->pagesRegionInfoCount + 1;
-    struct memory_page_info *pageInfoPtr;
+    cachePagePtr->pendingAllocCount = 0;
+    cachePagePtr->pendingFreeCount = 0;
+    cachePagePtr->pendingAllocByteCount = 0;
+    cachePagePtr->pendingFreeByteCount = 0;
+}
 
-    if (contextPtr->pagesRegionInfoCount < contextPtr->pagesRegionInfoCapacity)
+static void
+_memory_thread_cache_flush_page(struct memory_thread_cache_page *cachePagePtr)
+{
+    if (cachePagePtr->contextId == MEMORY_SHORT_ID_NULL)
     {
-        pageInfoPtr = &contextPtr->pagesRegionInfoArr[pageId - 1];
+        return;
     }
-    else
+
+    const struct memory_context_key contextKey = { .contextId = cachePagePtr->contextId, .isDebug = B32_FALSE };
+    struct memory_lock *lockPtr = _memory_get_context_lock(&contextKey);
+    struct memory_context *contextPtr;
+
+    _memory_lock_acquire(lockPtr);
+
+    if (_memory_get_context((void *)&contextKey, &contextPtr) == MEMORY_OK)
     {
-        if (contextPtr->pagesRegionInfoCount > 0)
+        for (u32 classIndex = 0; classIndex < MEMORY_SLAB_CLASS_COUNT; ++classIndex)
         {
-            struct memory_page_info *tempPtr = realloc(contextPtr->pagesRegionInfoArr, sizeof(struct memory_page_info)*
-                (contextPtr->pagesRegionInfoCapacity*PAGES_REGION_INFO_ARR_REALLOC_MULTIPLIER));
-            
-            if (tempPtr)
-            {
-                contextPtr->pagesRegionInfoArr = tempPtr;
-                pageInfoPtr = &tempPtr[pageId - 1];
+            struct memory_thread_cache_bin *binPtr = &cachePagePtr->binArr[classIndex];
 
-                contextPtr->pagesRegionInfoCapacity *= PAGES_REGION_INFO_ARR_REALLOC_MULTIPLIER;
-            }
-            else 
+            for (u32 blockIndex = 0; blockIndex < binPtr->blockCount; ++blockIndex)
             {
-                ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
-                ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
-                ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
-
-                utils_fprintf(stderr, "memory_alloc_page(%d): Could not reallocate the pages info array. "
-                        "Cannot allocate a page.\n", __LINE__);
-                        
-                return MEMORY_ERROR_FAILED_ALLOCATION;
+                _memory_thread_cache_give_back_block(contextPtr, cachePagePtr, &binPtr->blockArr[blockIndex]);
             }
         }
-        else 
-        {
-            contextPtr->pagesRegionInfoArr = malloc(sizeof(struct memory_page_info));
 
-            if (contextPtr->pagesRegionInfoArr)
-            {
-                pageInfoPtr = &contextPtr->pagesRegionInfoArr[pageId - 1];
+        _memory_thread_cache_settle_stats(contextPtr, cachePagePtr);
+    }
 
-                ++contextPtr->pagesRegionInfoCapacity;
-            }
-            else 
-            {
-                ((struct memory_page_key *)outPageKeyPtr)->pageId = MEMORY_SHORT_ID_NULL;
-                ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = MEMORY_SHORT_ID_NULL;
-                ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = B32_FALSE;
+    _memory_lock_release(lockPtr);
 
-                utils_fprintf(stderr, "memory_alloc_page(%d): Could not allocate the pages info array. "
-                        "Cannot allocate a page.\n", __LINE__);
-                        
-                return MEMORY_ERROR_FAILED_ALLOCATION;
+    memset(cachePagePtr, '\0', sizeof(struct memory_thread_cache_page));
+}
+
+// the thread's entry for the page, made (evicting another page's, round robin) if it has none. An entry from 
+// before the last page epoch bump is flushed first.
+static struct memory_thread_cache_page *
+_memory_thread_cache_get_page(const struct memory_page_key *pageKeyPtr)
+{
+    u32 pageEpoch = atomic_load_explicit(&_memory_get_page_lock(pageKeyPtr)->pageEpoch, memory_order_acquire);
+    struct memory_thread_cache_page *unusedCachePagePtr = NULL;
+
+    for (u32 cachePageIndex = 0; cachePageIndex < MEMORY_THREAD_CACHE_PAGE_COUNT; ++cachePageIndex)
+    {
+        struct memory_thread_cache_page *cachePagePtr = &g_MEMORY_THREAD_CACHE_PAGE_ARR[cachePageIndex];
+
+        if ((cachePagePtr->contextId == pageKeyPtr->contextKey.contextId) && 
+            (cachePagePtr->pageId == pageKeyPtr->pageId) && (cachePagePtr->pageGeneration == pageKeyPtr->generation))
+        {
+            if (cachePagePtr->pageEpoch == pageEpoch)
+            {
+                return cachePagePtr;
             }
+
+            _memory_thread_cache_flush_page(cachePagePtr);
+
+            unusedCachePagePtr = cachePagePtr;
+
+            break;
+        }
+
+        if (!unusedCachePagePtr && (cachePagePtr->contextId == MEMORY_SHORT_ID_NULL))
+        {
+            unusedCachePagePtr = cachePagePtr;
         }
     }
 
-    ++contextPtr->pagesRegionInfoCount;
+    if (!unusedCachePagePtr)
+    {
+        unusedCachePagePtr = &g_MEMORY_THREAD_CACHE_PAGE_ARR[(g_MEMORY_THREAD_CACHE_EVICT_INDEX++) % 
+            MEMORY_THREAD_CACHE_PAGE_COUNT];
 
-    pageInfoPtr->pageHeaderByteOffset = (p64)pageHeaderPtr - (p64)contextPtr->heap;
-    pageInfoPtr->status = MEMORY_PAGE_STATUS_UNLOCKED;
+        _memory_thread_cache_flush_page(unusedCachePagePtr);
+    }
 
-    ((struct memory_page_key *)outPageKeyPtr)->pageId = pageId;
-    ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->contextId = contextPtr->id;
-    ((struct memory_context_key *)&((struct memory_page_key *)outPageKeyPtr)->contextKey)->isDebug = contextPtr->isDebug;
+    unusedCachePagePtr->contextId = pageKeyPtr->contextKey.contextId;
+    unusedCachePagePtr->pageId = pageKeyPtr->pageId;
+    unusedCachePagePtr->pageGeneration = pageKeyPtr->generation;
+    unusedCachePagePtr->pageEpoch = pageEpoch;
 
-    return MEMORY_OK;
+    return unusedCachePagePtr;
 }
 
-memory_error_code
-memory_free_page(const struct memory_page_key *pageKeyPtr)
+// under the context lock, right after allocAllocKeyPtr was allocated for the bin's class: tops the (empty) bin 
+// up from the slabs the page already has. It never makes a slab of its own, so it can't fail, or grow the page's 
+// footprint; when the allocation didn't get a slot (the page is aligned past the slabs), there's nothing to cache.
+static void
+_memory_thread_cache_refill_bin(struct memory_thread_cache_page *cachePagePtr, const struct memory_page_key *pageKeyPtr, 
+    u8 classIndex, const struct memory_allocation_key *allocKeyPtr)
 {
+    struct memory_context *contextPtr;
+    struct memory_allocation_info *allocInfoPtr;
+
+    if ((_memory_get_context((void *)&pageKeyPtr->contextKey, &contextPtr) != MEMORY_OK) || 
+        (_memory_get_allocation_info(contextPtr, allocKeyPtr, &allocInfoPtr) != MEMORY_OK) || 
+        !allocInfoPtr->slabClassId || (atomic_load_explicit(&_memory_get_page_lock(pageKeyPtr)->pageEpoch, 
+        memory_order_relaxed) != cachePagePtr->pageEpoch))
     {
-        memory_error_code errorCode;
+        return;
+    }
 
-        if ((errorCode = _memory_get_page_key_is_ok(pageKeyPtr)) != MEMORY_OK)
+    struct memory_page_header *pageHeaderPtr = (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+        contextPtr->pagesRegionInfoArr[pageKeyPtr->pageId - 1].pageHeaderByteOffset];
+    struct memory_thread_cache_bin *binPtr = &cachePagePtr->binArr[classIndex];
+    u32 parkedBlockCount = binPtr->blockCount;
+    // the blocks are parked right away, so they never were live to anyone
+    u64 highWaterByteCount = contextPtr->stats.highWaterByteCount;
+    u64 pageHighWaterByteCount = pageHeaderPtr->highWaterByteCount;
+
+    while ((binPtr->blockCount < MEMORY_THREAD_CACHE_BATCH_COUNT) && 
+        (pageHeaderPtr->slabByteOffsetArr[classIndex] != MEMORY_TLSF_NULL_BYTE_OFFSET) && 
+        ((contextPtr->pagesRegionFreeAllocationInfoCount > 0) || ((contextPtr->allocationInfoRegionByteCapacity - 
+        contextPtr->allocationInfoRegionBytesReserved) >= sizeof(struct memory_allocation_info))))
+    {
+        const struct memory_allocation_key blockAllocKey;
+
+        if (_memory_alloc_aligned_locked(pageKeyPtr, g_MEMORY_SLAB_SLOT_BYTE_SIZE_ARR[classIndex], 0, NULL, 
+            &blockAllocKey) != MEMORY_OK)
         {
-            return errorCode;
+            break;
         }
+
+        binPtr->blockArr[binPtr->blockCount].allocInfoIndex = blockAllocKey.managed.allocInfoIndex;
+        binPtr->blockArr[binPtr->blockCount].generation = blockAllocKey.managed.generation;
+
+        ++binPtr->blockCount;
     }
 
-    struct memory_context *contextPtr;
+    parkedBlockCount = binPtr->blockCount - parkedBlockCount;
+
+    contextPtr->stats.allocCount -= parkedBlockCount;
+    contextPtr->stats.frameAllocCount -= parkedBlockCount;
+
+    _memory_track_live_bytes(contextPtr, pageHeaderPtr, 0, 
+        (u64)parkedBlockCount*g_MEMORY_SLAB_SLOT_BYTE_SIZE_ARR[classIndex]);
+
+    contextPtr->stats.highWaterByteCount = highWaterByteCount;
+    pageHeaderPtr->highWaterByteCount = pageHighWaterByteCount;
+
+    _memory_thread_cache_settle_stats(contextPtr, cachePagePtr);
+
+    cachePagePtr->allocInfoCount = (u32)(contextPtr->allocationInfoRegionBytesReserved/
+        sizeof(struct memory_allocation_info));
+}
+
+// parks a freed slot in the thread's cache, if the thread has an entry for its page. The allocation stays 
+// active, under a new generation, so the key being freed is stale from here on all the same.
+static b32
+_memory_thread_cache_free(const struct memory_allocation_key *allocKeyPtr)
+{
+    if (MEMORY_IS_ALLOCATION_NULL(allocKeyPtr) || !allocKeyPtr->isManaged || allocKeyPtr->managed.contextKey.isDebug || 
+        (g_MEMORY_THREAD_LOCK_DEPTH > 0))
     {
-        memory_error_code resultCode;
+        return B32_FALSE;
+    }
 
-        if ((resultCode = _memory_get_context((struct memory_context_key *)&pageKeyPtr->contextKey, 
-            &contextPtr)) != MEMORY_OK)
+    struct memory_context *contextPtr = NULL;
+
+    for (u32 cachePageIndex = 0; cachePageIndex < MEMORY_THREAD_CACHE_PAGE_COUNT; ++cachePageIndex)
+    {
+        struct memory_thread_cache_page *cachePagePtr = &g_MEMORY_THREAD_CACHE_PAGE_ARR[cachePageIndex];
+
+        if ((cachePagePtr->contextId != allocKeyPtr->managed.contextKey.contextId) || 
+            (allocKeyPtr->managed.allocInfoIndex >= cachePagePtr->allocInfoCount))
         {
-            return resultCode;
+            continue;
         }
-    }
 
-    struct memory_page_info *pageInfoPtr;
-    {
-        u16 infoIndex = pageKeyPtr->pageId - 1;
+        if (!contextPtr && (_memory_get_context((void *)&allocKeyPtr->managed.contextKey, &contextPtr) != MEMORY_OK))
+        {
+            return B32_FALSE;
+        }
+
+        struct memory_allocation_info *allocInfoPtr = &((struct memory_allocation_info *)&contextPtr->heap[
+            contextPtr->allocationInfoRegionByteOffset])[allocKeyPtr->managed.allocInfoIndex];
+
+        // a stale or foreign key is left to the locked path to report
+        if ((atomic_load_explicit(&allocInfoPtr->generation, memory_order_acquire) != allocKeyPtr->managed.generation) || 
+            !allocInfoPtr->isActive || !allocInfoPtr->slabClassId || 
+            atomic_load_explicit(&allocInfoPtr->mapGate, memory_order_relaxed))
+        {
+            return B32_FALSE;
+        }
+
+        if ((allocInfoPtr->pageId != cachePagePtr->pageId) || (cachePagePtr->pageEpoch != atomic_load_explicit(
+            &_memory_get_allocation_lock(allocKeyPtr)->pageEpoch, memory_order_acquire)))
+        {
+            continue;
+        }
 
-        if (infoIndex < contextPtr->pagesRegionInfoCount)
+        // the key goes stale right here; a page free or a restore that got to the info first keeps it
+        memory_int_id generation = allocKeyPtr->managed.generation;
+        memory_int_id nextGeneration = _memory_get_next_generation(generation, allocInfoPtr->restoredGenerationFloor);
+
+        if (!atomic_compare_exchange_strong_explicit(&allocInfoPtr->generation, &generation, nextGeneration, 
+            memory_order_acq_rel, memory_order_relaxed))
         {
-            pageInfoPtr = &contextPtr->pagesRegionInfoArr[infoIndex];
+            return B32_FALSE;
         }
-        else 
-        {
-            utils_fprintf(stderr, "memory_free_page(%d): 'pageId' produced pageInfo index out of range. "
-                    "Cannot free a non-existent page.\n", __LINE__);
 
-            return MEMORY_ERROR_INDEX_OUT_OF_RANGE;
-        }
-    }
+        struct memory_thread_cache_bin *binPtr = &cachePagePtr->binArr[allocInfoPtr->slabClassId - 1];
 
-    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_FREED)
-    {
-        utils_fprintf(stderr, "memory_free_page(%d): Page is already freed.\n", __LINE__);
+        ++cachePagePtr->pendingFreeCount;
+        cachePagePtr->pendingFreeByteCount += g_MEMORY_SLAB_SLOT_BYTE_SIZE_ARR[allocInfoPtr->slabClassId - 1];
 
-        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
-    }
+        // a full bin gives its oldest batch back to the page
+        if (binPtr->blockCount == MEMORY_THREAD_CACHE_BIN_CAPACITY)
+        {
+            struct memory_lock *lockPtr = _memory_get_allocation_lock(allocKeyPtr);
 
-    pageInfoPtr->status = MEMORY_PAGE_STATUS_FREED;
+            _memory_lock_acquire(lockPtr);
 
-    p64 pagesRegionByteIndex = (p64)contextPtr->heap + contextPtr->pagesRegionByteOffset;
-    struct memory_page_header *pageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + 
-        pageInfoPtr->pageHeaderByteOffset);
+            for (u32 blockIndex = 0; blockIndex < MEMORY_THREAD_CACHE_BATCH_COUNT; ++blockIndex)
+            {
+                _memory_thread_cache_give_back_block(contextPtr, cachePagePtr, &binPtr->blockArr[blockIndex]);
+            }
 
-    if (contextPtr->pagesRegionActiveCount > 1)
-    {
-        struct memory_page_header *headActivePageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + 
-            contextPtr->activePagesByteOffsetList);
-        struct memory_page_header *prevActivePageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + 
-            headActivePageHeaderPtr->prevPageHeaderByteOffset);
-        struct memory_page_header *nextActivePageHeaderPtr = (struct memory_page_header *)(pagesRegionByteIndex + 
-            headActivePageHeaderPtr->nextPageHeaderByteOffset);
+            _memory_thread_cache_settle_stats(contextPtr, cachePagePtr);
 
-        prevActivePageHeaderPtr->nextPageHeaderByteOffset = headActivePageHeaderPtr->nextPageHeaderByteOffset;
-        nextActivePageHeaderPtr->prevPageHeaderByteOffset = headActivePageHeaderPtr->prevPageHeaderByteOffset;
+            cachePagePtr->allocInfoCount = (u32)(contextPtr->allocationInfoRegionBytesReserved/
+                sizeof(struct memory_allocation_info));
 
-        if (contextPtr->activePagesByteOffsetList == pageInfoPtr->pageHeaderByteOffset)
-        {
-            contextPtr->activePagesByteOffsetList = headActivePageHeaderPtr->nextPageHeaderByteOffset;
+            _memory_lock_release(lockPtr);
+
+            binPtr->blockCount -= MEMORY_THREAD_CACHE_BATCH_COUNT;
+
+            memmove(binPtr->blockArr, &binPtr->blockArr[MEMORY_THREAD_CACHE_BATCH_COUNT], 
+                sizeof(struct memory_thread_cache_block)*binPtr->blockCount);
         }
-    }
-    else 
-    {
-        contextPtr->activePagesByteOffsetList = 0;
-    }
 
-    --contextPtr->pagesRegionActiveCount;
+        binPtr->blockArr[binPtr->blockCount].allocInfoIndex = allocKeyPtr->managed.allocInfoIndex;
+        binPtr->blockArr[binPtr->blockCount].generation = nextGeneration;
 
-    if (contextPtr->pagesRegionFreeCount > 0)
-    {
-        struct memory_page_header *headPtr = (struct memory_page_header *)(pagesRegionByteIndex + contextPtr->freePagesByteOffsetList);
-        struct memory_page_header *prevPtr = (struct memory_page_header *)(pagesRegionByteIndex + headPtr->prevPageHeaderByteOffset);
+        ++binPtr->blockCount;
 
-        prevPtr->nextPageHeaderByteOffset = (p64)pageHeaderPtr - pagesRegionByteIndex;
-        pageHeaderPtr->prevPageHeaderByteOffset = headPtr->prevPageHeaderByteOffset;
-        headPtr->prevPageHeaderByteOffset = prevPtr->nextPageHeaderByteOffset;
-        pageHeaderPtr->nextPageHeaderByteOffset = contextPtr->freePagesByteOffsetList;
-    }
-    else 
-    {
-        pageHeaderPtr->prevPageHeaderByteOffset = pageHeaderPtr->nextPageHeaderByteOffset = (p64)pageHeaderPtr - pagesRegionByteIndex;
+        memory_get_null_allocation_key(allocKeyPtr);
+
+        return B32_TRUE;
     }
 
-    for (struct memory_allocation_info *allocationInfo = (void *)&(&contextPtr->heap[contextPtr->allocationInfoRegionByteOffset])[
-            pageHeaderPtr->activeAllocatorByteOffsetList - 1];
-        allocationInfo && (allocationInfo->nextAllocationInfoIndex != (pageHeaderPtr->
-            allocationInfoByteOffsetList/sizeof(struct memory_allocation_info)));)
-    {
-        u32 nextAllocationIndex = allocationInfo->nextAllocationInfoIndex;
+    return B32_FALSE;
+}
 
-        allocationInfo->prevAllocationInfoIndex = allocationInfo->nextAllocationInfoIndex = MEMORY_INT_ID_NULL;
-        
-        allocationInfo->isActive = B32_FALSE;
-        allocationInfo->allocatorByteOffset = 0;
+memory_error_code
+memory_alloc_aligned(const struct memory_page_key *pageKeyPtr, u64 byteSize, u64 alignment, 
+    const char *debugLabelStr, const struct memory_allocation_key *outAllocKeyPtr)
+{
+    struct memory_thread_cache_page *cachePagePtr = NULL;
+    u8 classIndex = 0;
 
-        if (contextPtr->pagesRegionFreeAllocationInfoCount > 0)
-        {
-            struct memory_allocation_info *nextInfoPtr = (struct memory_allocation_info *)&(&contextPtr->heap[
-                contextPtr->allocationInfoRegionByteOffset])[
-                    contextPtr->pagesRegionFreeAllocationInfoByteOffsetList/sizeof(struct memory_allocation_info)];
+    // calls nested in another entry point (a pool allocating its slots) go straight to the page: evicting a 
+    // cache entry of some other context would take a second lock
+    if ((MEMORY_SLAB_MAX_BYTE_SIZE > 0) && (byteSize <= MEMORY_SLAB_MAX_BYTE_SIZE) && 
+        (alignment <= MEMORY_TLSF_ALIGN_SIZE) && !(alignment & (alignment - 1)) && outAllocKeyPtr && 
+        !MEMORY_IS_PAGE_NULL(pageKeyPtr) && !MEMORY_IS_CONTEXT_NULL(&pageKeyPtr->contextKey) && 
+        !pageKeyPtr->contextKey.isDebug && (g_MEMORY_THREAD_LOCK_DEPTH == 0))
+    {
+        cachePagePtr = _memory_thread_cache_get_page(pageKeyPtr);
+        classIndex = g_MEMORY_SLAB_CLASS_INDEX_ARR[(byteSize ? ((byteSize + (MEMORY_TLSF_ALIGN_SIZE - 1))/
+            MEMORY_TLSF_ALIGN_SIZE) : 1) - 1];
 
-            struct memory_allocation_info *prevInfoPtr = (struct memory_allocation_info *)&(&contextPtr->heap[
-                contextPtr->allocationInfoRegionByteOffset])[nextInfoPtr->prevAllocationInfoIndex];
+        struct memory_thread_cache_bin *binPtr = &cachePagePtr->binArr[classIndex];
 
-            allocationInfo->prevAllocationInfoIndex = nextInfoPtr->prevAllocationInfoIndex;
-            allocationInfo->nextAllocationInfoIndex = contextPtr->pagesRegionFreeAllocationInfoByteOffsetList/
-                sizeof(struct memory_allocation_info);
+        if (binPtr->blockCount > 0)
+        {
+            _memory_thread_cache_get_block_key(cachePagePtr->contextId, &binPtr->blockArr[--binPtr->blockCount], 
+                outAllocKeyPtr);
 
-            u32 infoIndex = (u32)((p64)allocationInfo - 
-                (p64)(&contextPtr->heap[contextPtr->allocationInfoRegionByteOffset]))/
-                    sizeof(struct memory_allocation_info);
+            ++cachePagePtr->pendingAllocCount;
+            cachePagePtr->pendingAllocByteCount += g_MEMORY_SLAB_SLOT_BYTE_SIZE_ARR[classIndex];
 
-            prevInfoPtr->nextAllocationInfoIndex = infoIndex;
-            nextInfoPtr->prevAllocationInfoIndex = infoIndex;
+            return MEMORY_OK;
         }
-        else 
-        {
-            u32 infoIndex = (u32)((p64)allocationInfo - 
-                (p64)(&contextPtr->heap[contextPtr->allocationInfoRegionByteOffset]))/
-                    sizeof(struct memory_allocation_info);
+    }
 
-            allocationInfo->prevAllocationInfoIndex = allocationInfo->nextAllocationInfoIndex = infoIndex;
-        }
+    struct memory_lock *lockPtr = _memory_get_page_lock(pageKeyPtr);
 
-        allocationInfo = (struct memory_allocation_info *)&(&contextPtr->heap[
-            contextPtr->allocationInfoRegionByteOffset])[nextAllocationIndex - 1];
-    }
+    _memory_lock_acquire(lockPtr);
 
-    contextPtr->pagesRegionFreeAllocationInfoCount += pageHeaderPtr->allocationInfoCount;
+    memory_error_code resultCode = _memory_alloc_aligned_locked(pageKeyPtr, byteSize, alignment, debugLabelStr, 
+        outAllocKeyPtr);
 
-    contextPtr->freePagesByteOffsetList = (p64)pageHeaderPtr - pagesRegionByteIndex;
+    if (cachePagePtr && (resultCode == MEMORY_OK))
+    {
+        _memory_thread_cache_refill_bin(cachePagePtr, pageKeyPtr, classIndex, outAllocKeyPtr);
+    }
 
-    ++contextPtr->pagesRegionFreeCount;
+    _memory_lock_release(lockPtr);
 
-    return MEMORY_OK;
+    return resultCode;
 }
 
 memory_error_code
-memory_realloc_page(const struct memory_page_key *pageKeyPtr, u64 byteSize)
+memory_free(const struct memory_allocation_key *allocKeyPtr)
 {
-    return MEMORY_ERROR_NOT_IMPLEMENTED;
+    if (_memory_thread_cache_free(allocKeyPtr))
+    {
+        return MEMORY_OK;
+    }
+
+    struct memory_lock *lockPtr = _memory_get_allocation_lock(allocKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_free_locked(allocKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
 }
 
 memory_error_code
-memory_get_page_key_is_ok(const struct memory_page_key *pageKeyPtr)
+memory_thread_cache_flush(void)
 {
-    return _memory_get_page_key_is_ok(pageKeyPtr);
+    for (u32 cachePageIndex = 0; cachePageIndex < MEMORY_THREAD_CACHE_PAGE_COUNT; ++cachePageIndex)
+    {
+        _memory_thread_cache_flush_page(&g_MEMORY_THREAD_CACHE_PAGE_ARR[cachePageIndex]);
+    }
+
+    return MEMORY_OK;
 }
 
-memory_error_code
-memory_alloc(const struct memory_page_key *pageKeyPtr, u64 byteSize, const char *debugLabelStr,
-    const struct memory_allocation_key *outAllocKeyPtr)
+#if defined(MEMORY_DEBUG)
+static memory_error_code
+_memory_map_alloc_locked(const struct memory_allocation_key *allocKeyPtr, void **outAllocationPtr)
 {
-    if (!pageKeyPtr)
+    if (!outAllocationPtr)
     {
-        utils_fprintfln(stderr, "%s(Line: %d): 'pageKeyPtr' argument cannot be NULL.",
-            __func__, __LINE__);
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'outAllocationPtr' argument "
+            "cannot be NULL.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
 
         return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
-    if (MEMORY_IS_PAGE_NULL(pageKeyPtr))
-    {
-        utils_fprintfln(stderr, "%s(Line: %d): 'pageKeyPtr' argument cannot be a NULL key value.", 
-            __func__, __LINE__);
-
-        return MEMORY_ERROR_NULL_ID;
-    }
+    *outAllocationPtr = NULL;
 
-    if (!outAllocKeyPtr)
+    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)) || (!allocKeyPtr->isManaged))
     {
-        utils_fprintfln(stderr, "%s(Line: %d): 'outAllocKeyPtr' argument cannot be NULL.");
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'allocKeyPtr' argument "
+            "is not a managed allocation key.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
 
         return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
-    struct memory_context *contextPtr;
-    const struct memory_allocation_key resultKey;
+    struct memory_context *memoryPtr;
     {
-        memory_error_code resultCode = _memory_get_context((void *)&pageKeyPtr->contextKey, 
-        (void *)&contextPtr);
+        memory_error_code resultCode = _memory_get_context((void *)&allocKeyPtr->managed.contextKey, &memoryPtr);
 
         if (resultCode != MEMORY_OK)
         {
-            utils_fprintfln(stderr, "%s(Line: %d): Could not get an active memory context "
-                "from the provided key.", __func__, __LINE__);
+            utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Context key " 
+                "is not valid. Cannot map allocation.", __FUNCTION__, __LINE__, (u32)resultCode);
 
-            return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+            return resultCode;
         }
+    }
 
-        resultCode = _memory_generate_unique_int_id((void *)&resultKey.allocId);
-
-        if (resultCode != MEMORY_OK)
-        {
-            utils_fprintfln(stderr, "%s(Line: %d): Failure to generate unique ID for allocation. "
-                "Aborting.", __func__, __LINE__);
+    struct memory_allocation_info *allocInfoPtr;
 
-            return MEMORY_ERROR_FAILED_ALLOCATION;
-        }
+    if (_memory_get_allocation_info(memoryPtr, allocKeyPtr, &allocInfoPtr) != MEMORY_OK)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Allocation " 
+            "is not active. Cannot map allocation.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
 
-        memcpy((void *)&resultKey.contextKey, &pageKeyPtr->contextKey, sizeof(struct memory_context_key));
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
     }
 
-    p64 pageHeaderByteOffset;
-    u16 pageInfoIndex = pageKeyPtr->pageId - 1;
-    struct memory_page_header *pageHeaderPtr;
+    struct memory_allocator *allocatorPtr = (void *)(memoryPtr->heap + memoryPtr->pagesRegionByteOffset + 
+        memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1].pageHeaderByteOffset + allocInfoPtr->allocatorByteOffset);
+
+    // slots have no header to check, and never move (their slab is pinned), so there's no map count to keep
+    if (allocInfoPtr->slabClassId)
     {
-        if (contextPtr->pagesRegionInfoArr[pageInfoIndex].status == MEMORY_PAGE_STATUS_UNLOCKED)
-        {
-            pageHeaderByteOffset = contextPtr->pagesRegionInfoArr[pageInfoIndex].pageHeaderByteOffset;
-            pageHeaderPtr = (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
-                contextPtr->pagesRegionInfoArr[pageInfoIndex].pageHeaderByteOffset];
-        }
-        else 
-        {
-            pageHeaderPtr = NULL;
-        }
+        *outAllocationPtr = allocatorPtr + 1;
+
+        return MEMORY_OK;
     }
 
-    if (!pageHeaderPtr)
+    if ((allocatorPtr->identifier != MEMORY_HEADER_ID) || 
+        (!MEMORY_IS_ALLOCATION_KEY_EQUAL(&allocatorPtr->allocationKey, allocKeyPtr)))
     {
-        utils_fprintfln(stderr, "%s(Line: %d): Page is not unlocked, or safe for "
-            "allocating memory.", __func__, __LINE__);
-        
-        return MEMORY_ERROR_FAILED_ALLOCATION;
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Allocator header " 
+            "is corrupted. Cannot map allocation.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_UNKNOWN);
+
+        return MEMORY_ERROR_UNKNOWN;
     }
 
-    // TODO: find an allocator with enough space
-    p64 allocatorByteOffset;
-    struct memory_allocator *allocatorPtr;
+    ++allocInfoPtr->mapCount;
+
+    *outAllocationPtr = allocatorPtr + 1;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_map_alloc(const struct memory_allocation_key *allocKeyPtr, void **outAllocationPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_allocation_lock(allocKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_map_alloc_locked(allocKeyPtr, outAllocationPtr);
+
+    _memory_lock_release(lockPtr);
 
-    if (pageHeaderPtr->freeAllocatorCount > 0)
+    return resultCode;
+}
+
+// the live allocation info of a header, or NULL when it isn't one. Quiet, as the header may be any bytes
+static struct memory_allocation_info * 
+_memory_find_allocator_info(const struct memory_allocator *allocatorPtr)
+{
+    const struct memory_allocation_key *allocKeyPtr = &allocatorPtr->allocationKey;
+    const struct memory_context_key *contextKeyPtr = &allocKeyPtr->managed.contextKey;
+
+    if ((allocatorPtr->identifier != MEMORY_HEADER_ID) || (!allocKeyPtr->isManaged) || 
+        (contextKeyPtr->contextId == MEMORY_SHORT_ID_NULL) || 
+        (contextKeyPtr->contextId > (contextKeyPtr->isDebug ? g_DEBUG_CONTEXT_COUNT : g_CONTEXT_COUNT)))
     {
-        allocatorByteOffset = pageHeaderPtr->freeAllocatorByteOffsetList;
-        allocatorPtr = (void *)&contextPtr->heap[(p64)pageHeaderPtr + allocatorByteOffset];
+        return NULL;
+    }
 
-        do
-        {
-            if (allocatorPtr->byteSize >= byteSize)
-            {
-                break;
-            }
-            else if (allocatorPtr->nextAllocatorByteOffset == pageHeaderPtr->freeAllocatorByteOffsetList)
-            {
-                allocatorPtr = NULL;
+    struct memory_context *memoryPtr = contextKeyPtr->isDebug ? 
+        (struct memory_context *)&g_DEBUG_CONTEXT_ARR[contextKeyPtr->contextId - 1] : 
+        &g_CONTEXT_ARR[contextKeyPtr->contextId - 1];
+    struct memory_allocation_info *allocInfoPtr;
 
-                break;
-            }
+    if ((_memory_get_allocation_info(memoryPtr, allocKeyPtr, &allocInfoPtr) != MEMORY_OK) || 
+        (!allocInfoPtr->isActive) || ((const void *)allocatorPtr != (const void *)(memoryPtr->heap + 
+        memoryPtr->pagesRegionByteOffset + memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1].pageHeaderByteOffset + 
+        allocInfoPtr->allocatorByteOffset)))
+    {
+        return NULL;
+    }
+
+    return allocInfoPtr;
+}
 
-            allocatorByteOffset = allocatorPtr->nextAllocatorByteOffset;
-            allocatorPtr = (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
-                pageHeaderByteOffset + allocatorByteOffset];
-        } while(allocatorPtr);
+// the header whose key a mapped pointer belongs to, or NULL. A slot has no header of its own (the bytes in front 
+// of it are the previous slot's), so its slab is checked first, and only then the header in front of the pointer
+static const struct memory_allocator * 
+_memory_find_mapped_allocator(p64 allocationAddress, b32 *outIsSlabSlotPtr)
+{
+    const struct memory_allocator *allocatorPtr = (const void *)(allocationAddress & ~(MEMORY_SLAB_BYTE_SIZE - 1));
+    const struct memory_slab *slabPtr = (const void *)(allocatorPtr + 1);
+    const struct memory_allocation_info *allocInfoPtr;
 
-        if (!allocatorPtr)
-        {
-            utils_fprintfln(stderr, "%s(Line: %d): " "Could not find enough free space, "
-                "in page, for new allocation. Aborting.", __func__, __LINE__);
+    *outIsSlabSlotPtr = B32_FALSE;
 
-            return MEMORY_ERROR_FAILED_ALLOCATION;
-        }
+    if ((slabPtr->identifier == MEMORY_SLAB_ID) && (allocationAddress >= ((p64)slabPtr + MEMORY_SLAB_SLOTS_BYTE_OFFSET)) && 
+        (allocInfoPtr = _memory_find_allocator_info(allocatorPtr)) && allocInfoPtr->isSlab)
+    {
+        p64 slotByteOffset = allocationAddress - (p64)slabPtr - MEMORY_SLAB_SLOTS_BYTE_OFFSET;
+        p64 slotIndex = slotByteOffset/slabPtr->slotByteSize;
 
-        if (pageHeaderPtr->freeAllocatorCount > 1)
+        if ((slotByteOffset % slabPtr->slotByteSize) || (slotIndex >= slabPtr->slotCount) || 
+            (slabPtr->freeSlotBitmapArr[slotIndex/64] & ((u64)1 << (slotIndex % 64))))
         {
-            struct memory_allocator *prevAllocatorPtr = (void *)((p64)pageHeaderPtr + allocatorPtr->prevAllocatorByteOffset);
-            struct memory_allocator *nextAllocatorPtr = (void *)((p64)pageHeaderPtr + allocatorPtr->nextAllocatorByteOffset);
+            return NULL;
+        }
 
-            prevAllocatorPtr->nextAllocatorByteOffset = allocatorPtr->nextAllocatorByteOffset;
-            nextAllocatorPtr->prevAllocatorByteOffset = allocatorPtr->prevAllocatorByteOffset;
+        *outIsSlabSlotPtr = B32_TRUE;
 
-            pageHeaderPtr->freeAllocatorByteOffsetList = allocatorByteOffset;
-        }
-        
-        --pageHeaderPtr->freeAllocatorCount;
+        return allocatorPtr;
     }
-    // nothing has been allocated on this page yet, so we create some allocators
-    else if (pageHeaderPtr->activeAllocatorCount < 1)
+
+    allocatorPtr = (const struct memory_allocator *)allocationAddress - 1;
+
+    if (!(allocInfoPtr = _memory_find_allocator_info(allocatorPtr)) || allocInfoPtr->slabClassId)
     {
-        allocatorByteOffset = sizeof(struct memory_page_header);
-        allocatorPtr = (void *)((p64)pageHeaderPtr + allocatorByteOffset);
-        
-        allocatorPtr->identifier = MEMORY_HEADER_ID;
-        allocatorPtr->byteSize = pageHeaderPtr->heapByteSize - sizeof(struct memory_allocator);
+        return NULL;
     }
-    // signifier all free space of the page is reserved
-    else 
+
+    return allocatorPtr;
+}
+
+static memory_error_code
+_memory_unmap_alloc_locked(void **outAllocationPtr)
+{
+    if (!outAllocationPtr || !(*outAllocationPtr))
     {
-        utils_fprintfln(stderr, "%s(Line: %d): "
-            "Could not find enough free space, "
-            "in page, for new allocation. Aborting.", __func__, __LINE__);
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'outAllocationPtr' argument "
+            "cannot be NULL.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
 
-        return MEMORY_ERROR_FAILED_ALLOCATION;
+        return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
-    // TODO: find/allocate an allocationInfo structure
-    p64 allocationInfoByteOffset;
-    u64 allocationInfoIndex = contextPtr->allocationInfoRegionBytesReserved/sizeof(struct memory_allocation_info);
-    struct memory_allocation_info *allocationInfoPtr;
+    b32 isSlabSlot;
+    const struct memory_allocator *allocatorPtr = _memory_find_mapped_allocator((p64)(*outAllocationPtr), &isSlabSlot);
 
-    if (contextPtr->pagesRegionFreeAllocationInfoCount > 0)
+    *outAllocationPtr = NULL;
+
+    if (!allocatorPtr)
     {
-        allocationInfoByteOffset = contextPtr->pagesRegionFreeAllocationInfoByteOffsetList;
-        allocationInfoPtr = &((struct memory_allocation_info *)&(contextPtr->heap[contextPtr->allocationInfoRegionByteOffset]))[allocationInfoIndex];
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Pointer was not mapped " 
+            "from an allocation.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
 
-        if (allocationInfoPtr->nextAllocationInfoIndex != allocationInfoIndex)
-        {
-            struct memory_allocation_info *prevInfoPtr = &((struct memory_allocation_info *)&(contextPtr->heap[contextPtr->
-                allocationInfoRegionByteOffset]))[allocationInfoPtr->prevAllocationInfoIndex];
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+    }
 
-            struct memory_allocation_info *nextInfoPtr = &((struct memory_allocation_info *)&(contextPtr->heap[contextPtr->
-                allocationInfoRegionByteOffset]))[allocationInfoPtr->nextAllocationInfoIndex];
+    // slots are never counted (see _memory_map_alloc_locked)
+    if (isSlabSlot)
+    {
+        return MEMORY_OK;
+    }
 
-            prevInfoPtr->nextAllocationInfoIndex = allocationInfoPtr->nextAllocationInfoIndex;
-            nextInfoPtr->prevAllocationInfoIndex = allocationInfoPtr->prevAllocationInfoIndex;
-        }
+    struct memory_allocation_info *allocInfoPtr = _memory_find_allocator_info(allocatorPtr);
 
-        --contextPtr->pagesRegionFreeAllocationInfoCount;
+    if (allocInfoPtr->mapCount < 1)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Allocation " 
+            "is not mapped.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
     }
-    else 
+
+    --allocInfoPtr->mapCount;
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_unmap_alloc(void **outAllocationPtr)
+{
+    struct memory_lock *lockPtr = NULL;
+
+    // the key is only known from the allocation's header, which is looked for again under the lock
+    if (outAllocationPtr && *outAllocationPtr)
     {
-        if ((contextPtr->allocationInfoRegionByteCapacity - contextPtr->allocationInfoRegionBytesReserved) >= sizeof(struct memory_allocation_info))
-        {
-            allocationInfoPtr = (struct memory_allocation_info *)((p64)contextPtr->heap + contextPtr->allocationInfoRegionByteOffset + 
-                allocationInfoIndex);
-            allocationInfoByteOffset = contextPtr->allocationInfoRegionByteOffset;
+        b32 isSlabSlot;
+        const struct memory_allocator *allocatorPtr = _memory_find_mapped_allocator((p64)(*outAllocationPtr), 
+            &isSlabSlot);
 
-            contextPtr->allocationInfoRegionBytesReserved += sizeof(struct memory_allocation_info);
-        }
-        else 
+        if (allocatorPtr)
         {
-            utils_fprintfln(stderr, "%s(Line: %d): "
-                "Could not find enough free space, "
-                "in page, for new allocation. Aborting.", __func__, __LINE__);
-
-            return MEMORY_ERROR_FAILED_ALLOCATION;
+            lockPtr = _memory_get_allocation_lock(&allocatorPtr->allocationKey);
         }
     }
 
-    allocationInfoPtr->pageId = pageKeyPtr->pageId;
-    allocationInfoPtr->allocatorByteOffset = allocatorByteOffset;
-    allocationInfoPtr->isActive = B32_TRUE;
-    allocationInfoPtr->isMapped = B32_FALSE;
-    allocationInfoPtr->allocationId = resultKey.allocId;
+    _memory_lock_acquire(lockPtr);
 
-    u32 infoIndex = allocationInfoByteOffset/sizeof(struct memory_allocation_info);
+    memory_error_code resultCode = _memory_unmap_alloc_locked(outAllocationPtr);
 
-    if (pageHeaderPtr->allocationInfoCount > 0)
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+#else
+// the whole release-mode map: heap + page offset + allocator offset. Nothing is counted, so only a gated map 
+// keeps compaction from moving the allocation
+static inline memory_error_code
+_memory_map_alloc_unchecked(const struct memory_allocation_key *allocKeyPtr, void **outAllocationPtr)
+{
+    const struct memory_context *contextPtr = allocKeyPtr->managed.contextKey.isDebug ? 
+        (const struct memory_context *)&g_DEBUG_CONTEXT_ARR[allocKeyPtr->managed.contextKey.contextId - 1] : 
+        &g_CONTEXT_ARR[allocKeyPtr->managed.contextKey.contextId - 1];
+    const struct memory_allocation_info *allocInfoPtr = &((const struct memory_allocation_info *)(contextPtr->heap + 
+        contextPtr->allocationInfoRegionByteOffset))[allocKeyPtr->managed.allocInfoIndex];
+
+    *outAllocationPtr = contextPtr->heap + contextPtr->pagesRegionByteOffset + 
+        contextPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1].pageHeaderByteOffset + 
+        allocInfoPtr->allocatorByteOffset + sizeof(struct memory_allocator);
+
+    return MEMORY_OK;
+}
+
+static inline memory_error_code
+_memory_unmap_alloc_unchecked(void **outAllocationPtr)
+{
+    *outAllocationPtr = NULL;
+
+    return MEMORY_OK;
+}
+#endif
+
+static b32
+_memory_map_gate_try_acquire(_Atomic u32 *gatePtr, enum memory_map_mode_t mapMode)
+{
+    u32 gate = atomic_load_explicit(gatePtr, memory_order_relaxed);
+
+    if (mapMode == MEMORY_MAP_MODE_SHARED)
     {
-        u32 nextInfoIndex = pageHeaderPtr->allocationInfoByteOffsetList/sizeof(struct memory_allocation_info);
-        struct memory_allocation_info *nextInfoPtr = &((struct memory_allocation_info *)&(contextPtr->heap[contextPtr->allocationInfoRegionByteOffset]))[
-            nextInfoIndex];
+        return (!(gate & (MEMORY_MAP_GATE_EXCLUSIVE | MEMORY_MAP_GATE_EXCLUSIVE_PENDING)) && 
+            ((gate & MEMORY_MAP_GATE_SHARED_COUNT_MASK) < MEMORY_MAP_GATE_SHARED_COUNT_MASK) && 
+            atomic_compare_exchange_weak_explicit(gatePtr, &gate, gate + 1, memory_order_acquire, 
+            memory_order_relaxed)) ? B32_TRUE : B32_FALSE;
+    }
 
-        allocationInfoPtr->nextAllocationInfoIndex = nextInfoIndex;
-        
-        u32 prevInfoIndex = nextInfoPtr->prevAllocationInfoIndex;
-        struct memory_allocation_info *prevInfoPtr = &((struct memory_allocation_info *)&(contextPtr->heap[contextPtr->allocationInfoRegionByteOffset]))[
-            prevInfoIndex];
-        
-        allocationInfoPtr->prevAllocationInfoIndex = prevInfoIndex;
+    // taking the gate clears the pending bit; other waiting writers raise it again
+    return (!(gate & ~MEMORY_MAP_GATE_EXCLUSIVE_PENDING) && atomic_compare_exchange_weak_explicit(gatePtr, 
+        &gate, MEMORY_MAP_GATE_EXCLUSIVE, memory_order_acquire, memory_order_relaxed)) ? B32_TRUE : B32_FALSE;
+}
 
-        nextInfoPtr->prevAllocationInfoIndex = infoIndex;
-        prevInfoPtr->nextAllocationInfoIndex = infoIndex;
+static void
+_memory_map_gate_release(_Atomic u32 *gatePtr, enum memory_map_mode_t mapMode)
+{
+    if (mapMode == MEMORY_MAP_MODE_SHARED)
+    {
+        atomic_fetch_sub_explicit(gatePtr, 1, memory_order_release);
     }
     else 
     {
-        allocationInfoPtr->prevAllocationInfoIndex = allocationInfoPtr->nextAllocationInfoIndex = allocationInfoByteOffset;
+        atomic_fetch_and_explicit(gatePtr, ~MEMORY_MAP_GATE_EXCLUSIVE, memory_order_release);
     }
+}
 
-    pageHeaderPtr->allocationInfoByteOffsetList = allocationInfoByteOffset;
-    ++pageHeaderPtr->allocationInfoCount;
+// the first try happens under the context lock, so an uncontended map is one lock round trip. A contended 
+// one waits on the gate with the lock dropped, then takes it again to check the allocation survived the wait 
+// and to resolve the pointer; the gate keeps the allocation from moving from there on
+static memory_error_code
+_memory_map_alloc_gated(const struct memory_allocation_key *allocKeyPtr, enum memory_map_mode_t mapMode, 
+    b32 isWaiting, void **outAllocationPtr)
+{
+    if (!outAllocationPtr)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'outAllocationPtr' argument "
+            "cannot be NULL.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
 
-    if (pageHeaderPtr->activeAllocatorCount > 0)
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    *outAllocationPtr = NULL;
+
+    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)) || (!allocKeyPtr->isManaged))
     {
-        struct memory_allocator *nextAllocatorPtr = (void *)((p64)pageHeaderPtr + pageHeaderPtr->activeAllocatorByteOffsetList);
-        struct memory_allocator *prevAllocatorPtr = (void *)((p64)pageHeaderPtr + nextAllocatorPtr->prevAllocatorByteOffset);
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'allocKeyPtr' argument "
+            "is not a managed allocation key.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
 
-        prevAllocatorPtr->nextAllocatorByteOffset = allocatorByteOffset;
-        nextAllocatorPtr->prevAllocatorByteOffset = allocatorByteOffset;
+        return MEMORY_ERROR_NULL_ARGUMENT;
     }
-    else
+
+    if ((u32)mapMode >= MEMORY_MAP_MODE_TYPE_COUNT)
     {
-        allocatorPtr->prevAllocatorByteOffset = allocatorPtr->nextAllocatorByteOffset = allocatorByteOffset;
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'mapMode' argument "
+            "is not a map mode.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_INDEX_OUT_OF_RANGE);
+
+        return MEMORY_ERROR_INDEX_OUT_OF_RANGE;
+    }
+
+    struct memory_lock *lockPtr = _memory_get_allocation_lock(allocKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    struct memory_context *contextPtr;
+    struct memory_allocation_info *allocInfoPtr;
+
+    if ((_memory_get_context((void *)&allocKeyPtr->managed.contextKey, &contextPtr) != MEMORY_OK) || 
+        (_memory_get_allocation_info(contextPtr, allocKeyPtr, &allocInfoPtr) != MEMORY_OK))
+    {
+        _memory_lock_release(lockPtr);
+
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Allocation " 
+            "is not active. Cannot map allocation.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
     }
 
-    if (allocatorPtr->byteSize > byteSize)
+    _Atomic u32 *gatePtr = &allocInfoPtr->mapGate;
+
+    if (!_memory_map_gate_try_acquire(gatePtr, mapMode))
     {
-        u64 byteDiff = allocatorPtr->byteSize - byteSize;
+        ++contextPtr->stats.mapContendedCount;
 
-        if (byteDiff > sizeof(struct memory_allocator))
+        if (!isWaiting)
         {
-            struct memory_allocator *splitAllocatorPtr = (void *)(((u8 *)(allocatorPtr + 1)) + allocatorPtr->byteSize);
-
-            splitAllocatorPtr->byteSize = byteDiff - sizeof(struct memory_allocator);
+            _memory_lock_release(lockPtr);
 
-            if (pageHeaderPtr->freeAllocatorCount > 0)
-            {
-                splitAllocatorPtr->nextAllocatorByteOffset = pageHeaderPtr->freeAllocatorByteOffsetList;
+            return MEMORY_ERROR_ALLOCATION_BUSY;
+        }
 
-                struct memory_allocator *nextAllocatorPtr = (void *)((p64)pageHeaderPtr + 
-                    pageHeaderPtr->freeAllocatorByteOffsetList);
+        _memory_lock_release(lockPtr);
 
-                splitAllocatorPtr->prevAllocatorByteOffset = nextAllocatorPtr->prevAllocatorByteOffset;
-                
-                struct memory_allocator *prevAllocatorPtr = (void *)((p64)pageHeaderPtr + 
-                    nextAllocatorPtr->prevAllocatorByteOffset);
+        u64 waitStartNS = _memory_get_time_ns();
 
-                nextAllocatorPtr->prevAllocatorByteOffset = (p64)splitAllocatorPtr - pageHeaderByteOffset;
-                prevAllocatorPtr->nextAllocatorByteOffset = (p64)splitAllocatorPtr - pageHeaderByteOffset;
-            }
-            else 
+        for (u32 spinCount = 0; !_memory_map_gate_try_acquire(gatePtr, mapMode); ++spinCount)
+        {
+            if ((mapMode == MEMORY_MAP_MODE_EXCLUSIVE) && 
+                !(atomic_load_explicit(gatePtr, memory_order_relaxed) & MEMORY_MAP_GATE_EXCLUSIVE_PENDING))
             {
-                splitAllocatorPtr->prevAllocatorByteOffset = splitAllocatorPtr->nextAllocatorByteOffset =
-                    (p64)splitAllocatorPtr - pageHeaderByteOffset;
+                atomic_fetch_or_explicit(gatePtr, MEMORY_MAP_GATE_EXCLUSIVE_PENDING, memory_order_relaxed);
             }
 
-            pageHeaderPtr->freeAllocatorByteOffsetList = (p64)splitAllocatorPtr - pageHeaderByteOffset;
-            ++pageHeaderPtr->freeAllocatorCount;
+            _memory_wait_spin(spinCount);
+        }
+
+        u64 waitNS = _memory_get_time_ns() - waitStartNS;
+
+        _memory_lock_acquire(lockPtr);
+
+        contextPtr->stats.mapContendedWaitNS += waitNS;
+
+        // freed (or its page freed, or the context restored) while we waited; the gate now belongs to 
+        // whatever reuses the allocation info
+        if ((allocInfoPtr->generation != allocKeyPtr->managed.generation) || !allocInfoPtr->isActive)
+        {
+            _memory_map_gate_release(gatePtr, mapMode);
+
+            _memory_lock_release(lockPtr);
+
+            utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Allocation " 
+                "was freed while waiting. Cannot map allocation.",
+                __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
 
-            allocatorPtr->byteSize = byteSize;
+            return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
         }
     }
 
-    pageHeaderPtr->activeAllocatorByteOffsetList = allocatorByteOffset;
+    ++allocInfoPtr->mapCount;
 
-    ++pageHeaderPtr->activeAllocatorCount;
+    *outAllocationPtr = contextPtr->heap + contextPtr->pagesRegionByteOffset + 
+        contextPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1].pageHeaderByteOffset + 
+        allocInfoPtr->allocatorByteOffset + sizeof(struct memory_allocator);
 
-    ((struct memory_allocation_key *)(&resultKey))->allocInfoIndex = infoIndex;
+    _memory_lock_release(lockPtr);
 
-    memcpy((void *)&resultKey.contextKey, &pageKeyPtr->contextKey, sizeof(struct memory_context_key));
-    memcpy((void *)outAllocKeyPtr, &resultKey, sizeof(struct memory_allocation_key));
+    return MEMORY_OK;
+}
 
-    if (contextPtr->isDebug)
+memory_error_code
+memory_map_alloc_gated(const struct memory_allocation_key *allocKeyPtr, enum memory_map_mode_t mapMode, 
+    void **outAllocationPtr)
+{
+    return _memory_map_alloc_gated(allocKeyPtr, mapMode, B32_TRUE, outAllocationPtr);
+}
+
+memory_error_code
+memory_try_map_alloc_gated(const struct memory_allocation_key *allocKeyPtr, enum memory_map_mode_t mapMode, 
+    void **outAllocationPtr)
+{
+    return _memory_map_alloc_gated(allocKeyPtr, mapMode, B32_FALSE, outAllocationPtr);
+}
+
+static memory_error_code
+_memory_unmap_alloc_gated_locked(const struct memory_allocation_key *allocKeyPtr, enum memory_map_mode_t mapMode, 
+    void **outAllocationPtr)
+{
+    if (!outAllocationPtr || !(*outAllocationPtr))
     {
-        if (debugLabelStr)
-        {
-            struct memory_debug_context *debugContextPtr = (void *)contextPtr;
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'outAllocationPtr' argument "
+            "cannot be NULL.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
 
-            size_t debugLabelLength = strlen(debugLabelStr);
-            u64 capacityFilled = debugContextPtr->labelRegionNextAllocationByteOffset - debugContextPtr->labelRegionByteOffset;
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
 
-            if ((debugContextPtr->labelRegionByteCapacity - capacityFilled) > debugLabelLength)
-            {
-                char *labelRegionPtr = (char *)&(contextPtr->heap[debugContextPtr->labelRegionByteOffset + 
-                    debugContextPtr->labelRegionNextAllocationByteOffset]);
+    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)) || (!allocKeyPtr->isManaged))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'allocKeyPtr' argument "
+            "is not a managed allocation key.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
 
-                strcpy(labelRegionPtr, debugLabelStr);
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
 
-                allocationInfoPtr->labelStrByteOffset = debugContextPtr->labelRegionNextAllocationByteOffset;
+    struct memory_context *contextPtr;
+    struct memory_allocation_info *allocInfoPtr;
 
-                debugContextPtr->labelRegionNextAllocationByteOffset += debugLabelLength + 1;
-            }
-            else
-            {
-                allocationInfoPtr->labelStrByteOffset = MEMORY_LABEL_REGION_ALLOCATION_BYTE_OFFSET;
-            }
-        }
-        else 
-        {
-            allocationInfoPtr->labelStrByteOffset = MEMORY_LABEL_REGION_ALLOCATION_BYTE_OFFSET;
-        }
+    if ((_memory_get_context((void *)&allocKeyPtr->managed.contextKey, &contextPtr) != MEMORY_OK) || 
+        (_memory_get_allocation_info(contextPtr, allocKeyPtr, &allocInfoPtr) != MEMORY_OK))
+    {
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Allocation " 
+            "is not active. Cannot unmap allocation.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
     }
-    else 
+
+    u32 gate = atomic_load_explicit(&allocInfoPtr->mapGate, memory_order_relaxed);
+
+    if ((mapMode == MEMORY_MAP_MODE_SHARED) ? ((gate & MEMORY_MAP_GATE_EXCLUSIVE) || 
+        !(gate & MEMORY_MAP_GATE_SHARED_COUNT_MASK)) : ((mapMode != MEMORY_MAP_MODE_EXCLUSIVE) || 
+        !(gate & MEMORY_MAP_GATE_EXCLUSIVE)))
     {
-        allocationInfoPtr->labelStrByteOffset = MEMORY_LABEL_REGION_ALLOCATION_BYTE_OFFSET;
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Allocation " 
+            "is not mapped in this mode.", __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
+
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
     }
 
-    memcpy((void *)outAllocKeyPtr, &resultKey, sizeof(struct memory_allocation_key));
+    _memory_map_gate_release(&allocInfoPtr->mapGate, mapMode);
+
+    if (allocInfoPtr->mapCount > 0)
+    {
+        --allocInfoPtr->mapCount;
+    }
+
+    *outAllocationPtr = NULL;
 
     return MEMORY_OK;
 }
 
 memory_error_code
-memory_realloc(const struct memory_allocation_key *allocKeyPtr, u64 byteSize,
-    const struct memory_allocation_key *outAllocKeyPtr)
+memory_unmap_alloc_gated(const struct memory_allocation_key *allocKeyPtr, enum memory_map_mode_t mapMode, 
+    void **outAllocationPtr)
 {
-    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)))
-    {
-        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): 'allocKeyPtr' "
-            "argument cannot be NULL.\n", 
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
+    struct memory_lock *lockPtr = _memory_get_allocation_lock(allocKeyPtr);
 
-        if (outAllocKeyPtr)
-        {
-            memory_get_null_allocation_key(outAllocKeyPtr);
-        }
+    _memory_lock_acquire(lockPtr);
 
-        return MEMORY_ERROR_NULL_ARGUMENT;
-    }
+    memory_error_code resultCode = _memory_unmap_alloc_gated_locked(allocKeyPtr, mapMode, outAllocationPtr);
 
-    if (!outAllocKeyPtr)
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_set_alloc_offset_width_locked(const struct memory_allocation_key *allocationKeyPtr, p64 byteOffset, 
+    u64 byteWidth, u8 value)
+{
+    if ((MEMORY_IS_ALLOCATION_NULL(allocationKeyPtr)))
     {
-        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): 'outAllocKeyPtr' "
-            "argument cannot be NULL.\n", 
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'allocationKeyPtr' argument " 
+            "cannot be NULL.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
 
         return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
     struct memory_context *memoryPtr;
     {
-        memory_error_code resultCode;
+        memory_error_code resultCode = _memory_get_context_key_is_ok(&allocationKeyPtr->managed.contextKey);
 
-        if ((resultCode = _memory_get_context_key_is_ok(&allocKeyPtr->contextKey)) == MEMORY_OK)
+        if (resultCode != MEMORY_OK)
         {
-            resultCode = _memory_get_context((struct memory_context_key *)
-                &allocKeyPtr->contextKey, &memoryPtr);
+            utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Context key " 
+                "is not valid. Cannot get intended context.",
+                __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
 
-            if (resultCode != MEMORY_OK)
-            {
-                utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Could not "
-                    "find the intended context.\n", 
-                    __FUNCTION__, __LINE__, (u32)resultCode);
+            return resultCode;
+        }
 
-                memory_get_null_allocation_key(outAllocKeyPtr);
+        resultCode = _memory_get_context((void *)&allocationKeyPtr->managed.contextKey, &memoryPtr);
 
-                return resultCode;
-            }
-        }
-        else 
+        if (resultCode != MEMORY_OK)
         {
-            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Could not "
-                "find the intended context.\n", 
-                __FUNCTION__, __LINE__, (u32)resultCode);
-            
-            memory_get_null_allocation_key(outAllocKeyPtr);
+            utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Context key " 
+                "is not valid. Cannot get intended context.",
+                __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
 
             return resultCode;
         }
     }
 
-    struct memory_allocation_info *allocInfoPtr = &((struct memory_allocation_info *)&(
-        memoryPtr->heap[memoryPtr->allocationInfoRegionByteOffset]))[allocKeyPtr->allocInfoIndex];
-
-    struct memory_page_info *pageInfoPtr = &memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1];
+    struct memory_allocation_info *allocInfoPtr;
 
-    struct memory_page_header *pagePtr;
+    if (_memory_get_allocation_info(memoryPtr, allocationKeyPtr, &allocInfoPtr) != MEMORY_OK)
     {
-        if (pageInfoPtr->status == MEMORY_PAGE_STATUS_UNLOCKED)
-        {
-            pagePtr = (struct memory_page_header *)(&(memoryPtr->heap[
-                memoryPtr->pagesRegionByteOffset + pageInfoPtr->pageHeaderByteOffset]));
-        }
-        else 
-        {
-            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): The page "
-                "is currently locked.\n", 
-                __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
-            
-            memory_get_null_allocation_key(outAllocKeyPtr);
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Allocation " 
+            "is not active.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
 
-            return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
-        }
+        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
     }
 
-    struct memory_allocator *lhsAllocPtr = (void *)((u8 *)pagePtr + allocInfoPtr->allocatorByteOffset);
-    p64 rhsAllocatorByteOffset;
-    struct memory_allocator *rhsAllocatorPtr;
+    struct memory_page_info *pageInfoPtr = &memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1];
 
-    if (lhsAllocPtr->byteSize < byteSize)
+    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_LOCKED)
     {
-        if (pagePtr->freeAllocatorCount < 1)
-        {
-            utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): The page "
-                "has no free allocators available. Likely out of space to reallocate alloc.", 
-                __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_FAILED_ALLOCATION);
-            
-            memory_get_null_allocation_key(outAllocKeyPtr);
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Page " 
+            "is locked. Cannot set allocation value.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
 
-            return MEMORY_ERROR_FAILED_ALLOCATION;
-        }
+        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
+    }
 
-        rhsAllocatorByteOffset = pagePtr->freeAllocatorByteOffsetList;
-        rhsAllocatorPtr = (void *)((u8 *)pagePtr + rhsAllocatorByteOffset);
+    struct memory_page_header *pagePtr = (void *)((p64)memoryPtr->heap + memoryPtr->pagesRegionByteOffset +
+        pageInfoPtr->pageHeaderByteOffset);
 
-        do
-        {
-            if (rhsAllocatorPtr->byteSize >= byteSize)
-            {
-                break;
-            }
+    struct memory_allocator *allocatorPtr = (void *)((p64)pagePtr + allocInfoPtr->allocatorByteOffset);
+    u64 allocationByteSize = _memory_get_allocation_byte_size(pagePtr, allocInfoPtr);
 
-            if (rhsAllocatorPtr->nextAllocatorByteOffset != pagePtr->freeAllocatorByteOffsetList)
-            {
-                rhsAllocatorByteOffset = rhsAllocatorPtr->nextAllocatorByteOffset;
-                rhsAllocatorPtr = (void *)((u8 *)pagePtr + rhsAllocatorByteOffset);
-            }
-            else 
-            {
-                rhsAllocatorPtr = NULL;
-            }
-        } while(rhsAllocatorPtr);
+    if (byteWidth > allocationByteSize)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Bytewidth " 
+            "of value is too large for allocation.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE);
 
-        if (!rhsAllocatorPtr)
-        {
-            utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): The page "
-                "has no free allocators available that can meet the requested byteSize. "
-                "Likely out of space to reallocate alloc.", 
-                __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_FAILED_ALLOCATION);
-            
-            memory_get_null_allocation_key(outAllocKeyPtr);
+        return MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE;
+    }
 
-            return MEMORY_ERROR_FAILED_ALLOCATION;
-        }
+    if (byteOffset >= allocationByteSize)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Offset " 
+            "of value is too large for allocation.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE);
 
-        --pagePtr->freeAllocatorCount;
+        return MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE;
+    }
 
-        if (rhsAllocatorPtr->byteSize > byteSize)
-        {
-            u64 diff = rhsAllocatorPtr->byteSize - byteSize;
+    if ((allocationByteSize - byteOffset) < byteWidth)
+    {
+        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Bytewidth " 
+            "with offset of value is too large for allocation.",
+            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE);
+        
+        return MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE;
+    }
 
-            if (diff > sizeof(struct memory_allocator))
-            {
-                p64 splitAllocatorByteOffset = rhsAllocatorByteOffset + sizeof(struct memory_allocator) + 
-                    byteSize;
-                struct memory_allocator *splitAllocatorPtr = (void *)((u8 *)pagePtr + splitAllocatorByteOffset);
+    memset((void *)((p64)allocatorPtr + sizeof(struct memory_allocator) + byteOffset), value,
+        byteWidth);
 
-                splitAllocatorPtr->byteSize = diff - sizeof(struct memory_allocator);
-                splitAllocatorPtr->identifier = MEMORY_HEADER_ID;
+    return MEMORY_OK;
+}
 
-                memory_get_null_allocation_key(&splitAllocatorPtr->allocationKey);
+memory_error_code
+memory_set_alloc_offset_width(const struct memory_allocation_key *allocationKeyPtr, p64 byteOffset, 
+    u64 byteWidth, u8 value)
+{
+    struct memory_lock *lockPtr = _memory_get_allocation_lock(allocationKeyPtr);
 
-                if (pagePtr->freeAllocatorCount > 0)
-                {
-                    struct memory_allocator *headFreeAllocatorPtr = (void *)((u8 *)pagePtr +
-                        pagePtr->freeAllocatorByteOffsetList);
-                    struct memory_allocator *tailFreeAllocatorPtr = (void *)((u8 *)pagePtr +
-                        headFreeAllocatorPtr->prevAllocatorByteOffset);
+    _memory_lock_acquire(lockPtr);
 
-                    splitAllocatorPtr->prevAllocatorByteOffset = headFreeAllocatorPtr->prevAllocatorByteOffset;
-                    splitAllocatorPtr->nextAllocatorByteOffset = pagePtr->freeAllocatorByteOffsetList;
+    memory_error_code resultCode = _memory_set_alloc_offset_width_locked(allocationKeyPtr, byteOffset,
+        byteWidth, value);
 
-                    headFreeAllocatorPtr->prevAllocatorByteOffset = splitAllocatorByteOffset;
-                    tailFreeAllocatorPtr->nextAllocatorByteOffset = splitAllocatorByteOffset;
-                }
-                else 
-                {
-                    splitAllocatorPtr->prevAllocatorByteOffset = splitAllocatorPtr->nextAllocatorByteOffset =
-                        splitAllocatorByteOffset;
-                }
+    _memory_lock_release(lockPtr);
 
-                pagePtr->freeAllocatorByteOffsetList = splitAllocatorByteOffset;
-                ++pagePtr->freeAllocatorCount;
-            }
-        }
+    return resultCode;
+}
 
-        if (pagePtr->activeAllocatorCount > 0)
-        {
-            struct memory_allocator *headActiveAllocatorPtr = (void *)((u8 *)pagePtr + 
-                pagePtr->activeAllocatorByteOffsetList);
-            struct memory_allocator *tailActiveAllocatorPtr = (void *)((u8 *)pagePtr + 
-                headActiveAllocatorPtr->prevAllocatorByteOffset);
+static u64
+_memory_sizeof_locked(const struct memory_allocation_key *allocKeyPtr)
+{
+    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)))
+    {
+        return 0;
+    }
 
-            rhsAllocatorPtr->nextAllocatorByteOffset = pagePtr->activeAllocatorByteOffsetList;
-            rhsAllocatorPtr->prevAllocatorByteOffset = headActiveAllocatorPtr->prevAllocatorByteOffset;
+    struct memory_context *memoryPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)&allocKeyPtr->managed.contextKey, 
+        &memoryPtr);
 
-            headActiveAllocatorPtr->prevAllocatorByteOffset = rhsAllocatorByteOffset;
-            tailActiveAllocatorPtr->nextAllocatorByteOffset = rhsAllocatorByteOffset;
-        }
-        else
+        if (resultCode != MEMORY_OK)
         {
-            rhsAllocatorPtr->prevAllocatorByteOffset = rhsAllocatorPtr->nextAllocatorByteOffset =
-                rhsAllocatorByteOffset;
+            return 0;
         }
-        
-        // note: do not need to inc active count, since we're simply replacing 
-        // with new allocator the old one
+    }
 
-        pagePtr->activeAllocatorByteOffsetList = rhsAllocatorByteOffset;
+    struct memory_allocation_info *allocInfoPtr;
 
-        if (pagePtr->freeAllocatorCount > 0)
-        {
-            struct memory_allocator *headFreeAllocatorPtr = (void *)((u8 *)pagePtr + 
-                pagePtr->freeAllocatorByteOffsetList);
-            struct memory_allocator *tailFreeAllocatorPtr = (void *)((u8 *)pagePtr + 
-                headFreeAllocatorPtr->prevAllocatorByteOffset);
+    if (_memory_get_allocation_info(memoryPtr, allocKeyPtr, &allocInfoPtr) != MEMORY_OK)
+    {
+        return 0;
+    }
 
-            lhsAllocPtr->nextAllocatorByteOffset = pagePtr->freeAllocatorByteOffsetList;
-            lhsAllocPtr->prevAllocatorByteOffset = headFreeAllocatorPtr->prevAllocatorByteOffset;
+    struct memory_page_info *pageInfoPtr = &memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1];
 
-            headFreeAllocatorPtr->prevAllocatorByteOffset = allocInfoPtr->allocatorByteOffset;
-            tailFreeAllocatorPtr->nextAllocatorByteOffset = allocInfoPtr->allocatorByteOffset;
-        }
-        else 
+    struct memory_page_header *pagePtr = (void *)((p64)memoryPtr->heap + memoryPtr->pagesRegionByteOffset + 
+        pageInfoPtr->pageHeaderByteOffset);
+
+    return _memory_get_allocation_byte_size(pagePtr, allocInfoPtr);
+}
+
+u64
+memory_sizeof(const struct memory_allocation_key *allocKeyPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_allocation_lock(allocKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    u64 resultByteSize = _memory_sizeof_locked(allocKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultByteSize;
+}
+
+static memory_error_code
+_memory_context_get_diagnostic_info_locked(const struct memory_context_key *memoryContextKeyPtr, 
+    const struct memory_context_diagnostic_info *outDiagInfoPtr)
+{
+    if (!outDiagInfoPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
         {
-            lhsAllocPtr->prevAllocatorByteOffset = lhsAllocPtr->nextAllocatorByteOffset = 
-                allocInfoPtr->allocatorByteOffset;
+            return resultCode;
         }
+    }
 
-        pagePtr->freeAllocatorByteOffsetList = allocInfoPtr->allocatorByteOffset;
-        ++pagePtr->freeAllocatorCount;
+    struct memory_context_diagnostic_info *diagInfoPtr = (void *)outDiagInfoPtr;
+
+    diagInfoPtr->label = NULL;
+    diagInfoPtr->heapReservedBytes = contextPtr->reservedHeapBytes;
+    diagInfoPtr->heapCommittedBytes = contextPtr->allocationInfoRegionCommittedBytes + 
+        contextPtr->pagesRegionCommittedBytes;
+    diagInfoPtr->pagesRegionReservedBytes = contextPtr->pagesRegionByteCapacity;
+    diagInfoPtr->pagesRegionActiveCount = contextPtr->pagesRegionActiveCount;
+    diagInfoPtr->allocationCount = contextPtr->pagesRegionAccumActiveAllocationCount;
+    diagInfoPtr->liveByteCount = contextPtr->stats.liveByteCount;
+    diagInfoPtr->highWaterByteCount = contextPtr->stats.highWaterByteCount;
+    diagInfoPtr->totalAllocCount = contextPtr->stats.allocCount;
+    diagInfoPtr->totalFreeCount = contextPtr->stats.freeCount;
+    diagInfoPtr->frameIndex = contextPtr->stats.frameIndex;
+    diagInfoPtr->lastFrameAllocCount = contextPtr->stats.lastFrameAllocCount;
+    diagInfoPtr->lastFrameFreeCount = contextPtr->stats.lastFrameFreeCount;
+    diagInfoPtr->peakFrameAllocCount = contextPtr->stats.peakFrameAllocCount;
+    diagInfoPtr->peakFrameFreeCount = contextPtr->stats.peakFrameFreeCount;
+    diagInfoPtr->mapContendedCount = contextPtr->stats.mapContendedCount;
+    diagInfoPtr->mapContendedWaitNS = contextPtr->stats.mapContendedWaitNS;
+    diagInfoPtr->isDebug = contextPtr->isDebug;
 
-        allocInfoPtr->allocatorByteOffset = rhsAllocatorByteOffset;
+    if (contextPtr->isDebug)
+    {
+        struct memory_debug_context *debugContextPtr = (void *)contextPtr;
 
-        memcpy((u8 *)rhsAllocatorPtr + sizeof(struct memory_allocator), (u8 *)lhsAllocPtr + sizeof(
-            struct memory_allocator), byteSize);
+        diagInfoPtr->label = debugContextPtr->label;
+        diagInfoPtr->heapCommittedBytes += debugContextPtr->labelRegionCommittedBytes;
     }
-    else if (lhsAllocPtr->byteSize > byteSize)
-    {
-        u64 byteDiff = lhsAllocPtr->byteSize - byteSize;
 
-        if (byteDiff > sizeof(struct memory_allocator))
-        {
-            rhsAllocatorByteOffset = allocInfoPtr->allocatorByteOffset + sizeof(struct memory_allocator) + byteSize;
+    return MEMORY_OK;
+}
 
-            rhsAllocatorPtr = (void *)((u8 *)lhsAllocPtr + rhsAllocatorByteOffset);
+memory_error_code
+memory_context_get_diagnostic_info(const struct memory_context_key *memoryContextKeyPtr, 
+    const struct memory_context_diagnostic_info *outDiagInfoPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
 
-            rhsAllocatorPtr->byteSize = byteDiff - sizeof(struct memory_allocator);
-            rhsAllocatorPtr->identifier = MEMORY_HEADER_ID;
+    _memory_lock_acquire(lockPtr);
 
-            memory_get_null_allocation_key(&rhsAllocatorPtr->allocationKey);
+    memory_error_code resultCode = _memory_context_get_diagnostic_info_locked(memoryContextKeyPtr, outDiagInfoPtr);
 
-            if (pagePtr->freeAllocatorCount > 0)
-            {
-                struct memory_allocator *headFreeAllocatorPtr = (void *)((u8 *)pagePtr +
-                    pagePtr->freeAllocatorByteOffsetList);
-                
-                struct memory_allocator *tailFreeAllocatorPtr = (void *)((u8 *)pagePtr +
-                    headFreeAllocatorPtr->prevAllocatorByteOffset);
+    _memory_lock_release(lockPtr);
 
-                rhsAllocatorPtr->prevAllocatorByteOffset = headFreeAllocatorPtr->prevAllocatorByteOffset;
-                rhsAllocatorPtr->nextAllocatorByteOffset = pagePtr->freeAllocatorByteOffsetList;
+    return resultCode;
+}
 
-                headFreeAllocatorPtr->prevAllocatorByteOffset = rhsAllocatorByteOffset;
-                tailFreeAllocatorPtr->nextAllocatorByteOffset = rhsAllocatorByteOffset;
+static memory_error_code
+_memory_get_diagnostic_info_locked(const struct memory_diagnostic_info *outDiagInfoPtr)
+{
+    if (!outDiagInfoPtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
 
-                pagePtr->freeAllocatorByteOffsetList = rhsAllocatorByteOffset;
-            }
-            else 
-            {
-                rhsAllocatorPtr->prevAllocatorByteOffset = rhsAllocatorByteOffset;
-                rhsAllocatorPtr->nextAllocatorByteOffset = rhsAllocatorByteOffset;
-                pagePtr->freeAllocatorByteOffsetList = rhsAllocatorByteOffset;
-            }
+    struct memory_diagnostic_info *diagInfoPtr = (void *)outDiagInfoPtr;
 
-            lhsAllocPtr->byteSize -= byteDiff;
-            ++pagePtr->freeAllocatorCount;
-        }
-    }
+    diagInfoPtr->rawAllocationCount = (u16)g_MEMORY_RAW_ALLOCATION_TABLE.count;
+    diagInfoPtr->contextCount = g_CONTEXT_COUNT;
+    diagInfoPtr->debugContextCount = g_DEBUG_CONTEXT_COUNT;
 
     return MEMORY_OK;
 }
 
 memory_error_code
-memory_free(const struct memory_allocation_key *allocKeyPtr)
+memory_get_diagnostic_info(const struct memory_diagnostic_info *outDiagInfoPtr)
 {
-    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)))
+    struct memory_lock *lockPtr = &g_MEMORY_RAW_LOCK;
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_get_diagnostic_info_locked(outDiagInfoPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_page_get_diagnostic_info_locked(const struct memory_page_key *pageKeyPtr, 
+    struct memory_page_diagnostic_info *outDiagInfoPtr)
+{
+    if (!pageKeyPtr || !outDiagInfoPtr)
     {
-        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): 'allocKeyPtr' argument "
-            "cannot be NULL.\n", 
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NULL_ARGUMENT);
-    
         return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
-    if ((MEMORY_IS_CONTEXT_NULL(&allocKeyPtr->contextKey)))
+    struct memory_context *contextPtr;
     {
-        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Not an "
-            "active memory context.\n", 
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT);
+        memory_error_code resultCode = _memory_get_context((void *)&pageKeyPtr->contextKey, &contextPtr);
 
-        return MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT;
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
     }
 
-    struct memory_context *memoryPtr;
+    struct memory_page_info *pageInfoPtr;
     {
-        memory_error_code resultCode = _memory_get_context_key_is_ok(&allocKeyPtr->contextKey);
+        memory_error_code resultCode = _memory_get_page_info(contextPtr, pageKeyPtr, &pageInfoPtr);
 
         if (resultCode != MEMORY_OK)
         {
-            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Context key "
-                "is not valid.\n", 
-                __FUNCTION__, __LINE__, (u32)resultCode);
-
             return resultCode;
         }
+    }
 
-        resultCode = _memory_get_context((void *)&allocKeyPtr->contextKey, 
-        &memoryPtr);
+    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_FREED)
+    {
+        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
+    }
+
+    _memory_get_page_diagnostic_info((void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+        pageInfoPtr->pageHeaderByteOffset], pageInfoPtr->status, outDiagInfoPtr);
+
+    return MEMORY_OK;
+}
+
+memory_error_code
+memory_page_get_diagnostic_info(const struct memory_page_key *pageKeyPtr, 
+    struct memory_page_diagnostic_info *outDiagInfoPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_page_lock(pageKeyPtr);
+
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_page_get_diagnostic_info_locked(pageKeyPtr, outDiagInfoPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_context_next_frame_locked(const struct memory_context_key *memoryContextKeyPtr)
+{
+    struct memory_context *contextPtr;
+    {
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
 
         if (resultCode != MEMORY_OK)
         {
-            utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Could not "
-                "get the context using the provided key.\n", 
-                __FUNCTION__, __LINE__, (u32)resultCode);
-
             return resultCode;
         }
     }
 
-    struct memory_allocation_info *allocInfoPtr = &((struct memory_allocation_info *)((p64)memoryPtr->heap + 
-        memoryPtr->allocationInfoRegionByteOffset))[allocKeyPtr->allocInfoIndex];
+    struct memory_context_stats *statsPtr = &contextPtr->stats;
 
-    if (!allocInfoPtr->isActive)
+    statsPtr->lastFrameAllocCount = statsPtr->frameAllocCount;
+    statsPtr->lastFrameFreeCount = statsPtr->frameFreeCount;
+
+    if (statsPtr->frameAllocCount > statsPtr->peakFrameAllocCount)
     {
-        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Could not "
-            "get the context using the provided key.\n", 
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
+        statsPtr->peakFrameAllocCount = statsPtr->frameAllocCount;
+    }
 
-        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
+    if (statsPtr->frameFreeCount > statsPtr->peakFrameFreeCount)
+    {
+        statsPtr->peakFrameFreeCount = statsPtr->frameFreeCount;
     }
 
-    struct memory_page_info *pageInfoPtr = &memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1];
+    statsPtr->frameAllocCount = 0;
+    statsPtr->frameFreeCount = 0;
 
-    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_LOCKED)
-    {
-        utils_fprintf(stderr, "%s(Line: %d; Error Code: %u): Page is locked. "
-            "Cannot free allocation..\n", 
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
+    ++statsPtr->frameIndex;
 
-        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
-    }
+    return MEMORY_OK;
+}
 
-    struct memory_page_header *pagePtr = (void *)((p64)memoryPtr->heap + memoryPtr->pagesRegionByteOffset +
-        pageInfoPtr->pageHeaderByteOffset);
+memory_error_code
+memory_context_next_frame(const struct memory_context_key *memoryContextKeyPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
 
-    struct memory_allocator *allocatorPtr = (void *)((p64)pagePtr + allocInfoPtr->allocatorByteOffset);
+    _memory_lock_acquire(lockPtr);
 
-    if (pagePtr->activeAllocatorCount > 1)
+    memory_error_code resultCode = _memory_context_next_frame_locked(memoryContextKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
+
+static memory_error_code
+_memory_context_dump_diagnostics_locked(const struct memory_context_key *memoryContextKeyPtr, FILE *filePtr)
+{
+    if (!filePtr)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    struct memory_context *contextPtr;
     {
-        struct memory_allocator *prevAllocator = (void *)((p64)pagePtr + allocatorPtr->prevAllocatorByteOffset);
-        struct memory_allocator *nextAllocator = (void *)((p64)pagePtr + allocatorPtr->nextAllocatorByteOffset);
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
 
-        prevAllocator->nextAllocatorByteOffset = allocatorPtr->nextAllocatorByteOffset;
-        nextAllocator->prevAllocatorByteOffset = allocatorPtr->prevAllocatorByteOffset;
-        
-        if (allocInfoPtr->allocatorByteOffset == pagePtr->activeAllocatorByteOffsetList)
+        if (resultCode != MEMORY_OK)
         {
-            pagePtr->activeAllocatorByteOffsetList = allocatorPtr->nextAllocatorByteOffset;
+            return resultCode;
         }
     }
 
-    --pagePtr->activeAllocatorCount;
+    struct memory_context_diagnostic_info contextDiagInfo;
 
-    if (pagePtr->freeAllocatorCount > 0)
-    {
-        struct memory_allocator *headFreeAllocatorPtr = (void *)((p64)pagePtr + pagePtr->freeAllocatorByteOffsetList);
-        struct memory_allocator *tailFreeAllocatorPtr = (void *)((p64)pagePtr + 
-            headFreeAllocatorPtr->prevAllocatorByteOffset);
+    memory_context_get_diagnostic_info(memoryContextKeyPtr, &contextDiagInfo);
 
-        allocatorPtr->nextAllocatorByteOffset = pagePtr->freeAllocatorByteOffsetList;
-        allocatorPtr->prevAllocatorByteOffset = headFreeAllocatorPtr->prevAllocatorByteOffset;
+    utils_fprintf(filePtr, "memory context=%s frame=%llu live=%llu high_water=%llu committed=%llu reserved=%llu "
+        "allocs=%u total_allocs=%llu total_frees=%llu frame_allocs=%u frame_frees=%u peak_frame_allocs=%u "
+        "peak_frame_frees=%u map_contended=%llu map_contended_wait_ns=%llu\n", (contextDiagInfo.label && contextDiagInfo.label[0]) ? contextDiagInfo.label : "-", 
+        (unsigned long long)contextDiagInfo.frameIndex, (unsigned long long)contextDiagInfo.liveByteCount, 
+        (unsigned long long)contextDiagInfo.highWaterByteCount, (unsigned long long)contextDiagInfo.heapCommittedBytes, 
+        (unsigned long long)contextDiagInfo.heapReservedBytes, contextDiagInfo.allocationCount, 
+        (unsigned long long)contextDiagInfo.totalAllocCount, (unsigned long long)contextDiagInfo.totalFreeCount, 
+        contextDiagInfo.lastFrameAllocCount, contextDiagInfo.lastFrameFreeCount, contextDiagInfo.peakFrameAllocCount, 
+        contextDiagInfo.peakFrameFreeCount, (unsigned long long)contextDiagInfo.mapContendedCount, 
+        (unsigned long long)contextDiagInfo.mapContendedWaitNS);
 
-        headFreeAllocatorPtr->prevAllocatorByteOffset = allocInfoPtr->allocatorByteOffset;
-        headFreeAllocatorPtr->nextAllocatorByteOffset = allocInfoPtr->allocatorByteOffset;
-    }
-    else 
+    for (u16 pageInfoIndex = 0; pageInfoIndex < contextPtr->pagesRegionInfoCount; ++pageInfoIndex)
     {
-        allocatorPtr->prevAllocatorByteOffset = allocatorPtr->nextAllocatorByteOffset = 
-            allocInfoPtr->allocatorByteOffset;
-    }
+        struct memory_page_info *pageInfoPtr = &contextPtr->pagesRegionInfoArr[pageInfoIndex];
 
-    pagePtr->freeAllocatorByteOffsetList = allocInfoPtr->allocatorByteOffset;
-    ++pagePtr->freeAllocatorCount;
+        if (pageInfoPtr->status == MEMORY_PAGE_STATUS_FREED)
+        {
+            continue;
+        }
 
-    if (pagePtr->allocationInfoCount > 1)
-    {
-        struct memory_allocation_info *prevAllocInfoPtr = &((struct memory_allocation_info *)(
-            (p64)memoryPtr->heap + memoryPtr->allocationInfoRegionByteOffset))[
-            allocInfoPtr->prevAllocationInfoIndex];
-        struct memory_allocation_info *nextAllocInfoPtr = &((struct memory_allocation_info *)(
-            (p64)memoryPtr->heap + memoryPtr->allocationInfoRegionByteOffset))[
-            allocInfoPtr->nextAllocationInfoIndex];
+        struct memory_page_diagnostic_info pageDiagInfo;
+
+        _memory_get_page_diagnostic_info((void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+            pageInfoPtr->pageHeaderByteOffset], pageInfoPtr->status, &pageDiagInfo);
 
-        prevAllocInfoPtr->nextAllocationInfoIndex = allocInfoPtr->nextAllocationInfoIndex;
-        nextAllocInfoPtr->prevAllocationInfoIndex = allocInfoPtr->prevAllocationInfoIndex;
+        utils_fprintf(filePtr, "memory   page=%u locked=%d size=%llu live=%llu high_water=%llu allocs=%u free=%llu "
+            "largest_free=%llu free_blocks=%u frag=%.3f histogram=", (u32)(pageInfoIndex + 1), 
+            (pageInfoPtr->status == MEMORY_PAGE_STATUS_LOCKED), (unsigned long long)pageDiagInfo.heapByteSize, 
+            (unsigned long long)pageDiagInfo.liveByteCount, (unsigned long long)pageDiagInfo.highWaterByteCount, 
+            pageDiagInfo.allocationCount, (unsigned long long)pageDiagInfo.freeByteCount, 
+            (unsigned long long)pageDiagInfo.largestFreeByteCount, pageDiagInfo.freeBlockCount, 
+            (double)pageDiagInfo.fragmentation);
 
-        if (pagePtr->allocationInfoByteOffsetList == (sizeof(struct memory_allocation_info)*
-            allocKeyPtr->allocInfoIndex))
+        // only the occupied buckets, as log2(size):count
+        b32 isFirstBucket = B32_TRUE;
+
+        for (u32 bucketIndex = 0; bucketIndex < MEMORY_DIAGNOSTIC_HISTOGRAM_BUCKET_COUNT; ++bucketIndex)
         {
-            pagePtr->allocationInfoByteOffsetList = allocInfoPtr->nextAllocationInfoIndex*
-                sizeof(struct memory_allocation_info);
+            if (pageDiagInfo.freeBlockHistogramArr[bucketIndex] > 0)
+            {
+                utils_fprintf(filePtr, isFirstBucket ? "%u:%u" : ",%u:%u", bucketIndex, 
+                    pageDiagInfo.freeBlockHistogramArr[bucketIndex]);
+
+                isFirstBucket = B32_FALSE;
+            }
         }
+
+        utils_fprintf(filePtr, isFirstBucket ? "-\n" : "\n");
     }
-    
-    --pagePtr->allocationInfoCount;
 
-    if (memoryPtr->pagesRegionFreeAllocationInfoCount > 0)
-    {
-        struct memory_allocation_info *headFreeAllocationInfoPtr = (void *)((p64)memoryPtr->heap +
-            memoryPtr->allocationInfoRegionByteOffset +
-            memoryPtr->pagesRegionFreeAllocationInfoByteOffsetList);
-        struct memory_allocation_info *tailFreeAllocationInfoPtr = (void *)((p64)memoryPtr->heap + 
-            memoryPtr->allocationInfoRegionByteOffset +
-            (headFreeAllocationInfoPtr->prevAllocationInfoIndex*sizeof(struct memory_allocation_info)));
+    return MEMORY_OK;
+}
 
-        allocInfoPtr->prevAllocationInfoIndex = headFreeAllocationInfoPtr->prevAllocationInfoIndex;
-        allocInfoPtr->nextAllocationInfoIndex = memoryPtr->pagesRegionFreeAllocationInfoByteOffsetList/
-            sizeof(struct memory_allocation_info);
+memory_error_code
+memory_context_dump_diagnostics(const struct memory_context_key *memoryContextKeyPtr, FILE *filePtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
 
-        headFreeAllocationInfoPtr->prevAllocationInfoIndex = allocKeyPtr->allocInfoIndex;
-        tailFreeAllocationInfoPtr->nextAllocationInfoIndex = allocKeyPtr->allocInfoIndex;
-    }
-    else 
-    {
-        allocInfoPtr->prevAllocationInfoIndex = allocInfoPtr->nextAllocationInfoIndex =
-            allocKeyPtr->allocInfoIndex;
-    }
+    _memory_lock_acquire(lockPtr);
 
-    memoryPtr->pagesRegionFreeAllocationInfoByteOffsetList = sizeof(struct memory_allocation_info)*
-        allocKeyPtr->allocInfoIndex;
-    ++memoryPtr->pagesRegionFreeAllocationInfoCount;
+    memory_error_code resultCode = _memory_context_dump_diagnostics_locked(memoryContextKeyPtr, filePtr);
 
-    memory_get_null_allocation_key(allocKeyPtr);
+    _memory_lock_release(lockPtr);
 
-    return MEMORY_OK;
+    return resultCode;
 }
 
-memory_error_code
-memory_set_alloc_offset_width(const struct memory_allocation_key *allocationKeyPtr, p64 byteOffset, 
-    u64 byteWidth, u8 value)
+memory_handle
+memory_get_allocation_handle(const struct memory_allocation_key *allocKeyPtr)
 {
-    if ((MEMORY_IS_ALLOCATION_NULL(allocationKeyPtr)))
+    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)) || (!allocKeyPtr->isManaged))
     {
-        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): 'allocationKeyPtr' argument " 
-            "cannot be NULL.",
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
+        return MEMORY_HANDLE_NULL;
+    }
+
+    return ((memory_handle)allocKeyPtr->managed.generation << 32) | (memory_handle)allocKeyPtr->managed.allocInfoIndex;
+}
+
+static memory_error_code
+_memory_get_alloc_label_id_locked(const struct memory_allocation_key *allocKeyPtr, memory_short_id *outLabelId)
+{
+    if (!outLabelId)
+    {
+        return MEMORY_ERROR_NULL_ARGUMENT;
+    }
+
+    *outLabelId = MEMORY_SHORT_ID_NULL;
 
+    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)) || (!allocKeyPtr->isManaged))
+    {
         return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
-    struct memory_context *memoryPtr;
+    struct memory_context *contextPtr;
     {
-        memory_error_code resultCode = _memory_get_context_key_is_ok(&allocationKeyPtr->contextKey);
+        memory_error_code resultCode = _memory_get_context((void *)&allocKeyPtr->managed.contextKey, &contextPtr);
 
         if (resultCode != MEMORY_OK)
         {
-            utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Context key " 
-                "is not valid. Cannot get intended context.",
-                __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
-
             return resultCode;
         }
+    }
 
-        resultCode = _memory_get_context((void *)&allocationKeyPtr->contextKey, &memoryPtr);
+    struct memory_allocation_info *allocInfoPtr;
+    {
+        memory_error_code resultCode = _memory_get_allocation_info(contextPtr, allocKeyPtr, &allocInfoPtr);
 
         if (resultCode != MEMORY_OK)
         {
-            utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Context key " 
-                "is not valid. Cannot get intended context.",
-                __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
-
             return resultCode;
         }
     }
 
-    struct memory_allocation_info *allocInfoPtr = &((struct memory_allocation_info *)((p64)memoryPtr->heap +
-        memoryPtr->allocationInfoRegionByteOffset))[allocationKeyPtr->allocInfoIndex];
-
-    if (!allocInfoPtr->isActive)
-    {
-        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Allocation " 
-            "is not active.",
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION);
+    *outLabelId = allocInfoPtr->labelId;
 
-        return MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION;
-    }
+    return MEMORY_OK;
+}
 
-    struct memory_page_info *pageInfoPtr = &memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1];
+memory_error_code
+memory_get_alloc_label_id(const struct memory_allocation_key *allocKeyPtr, memory_short_id *outLabelId)
+{
+    struct memory_lock *lockPtr = _memory_get_allocation_lock(allocKeyPtr);
 
-    if (pageInfoPtr->status == MEMORY_PAGE_STATUS_LOCKED)
-    {
-        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Page " 
-            "is locked. Cannot set allocation value.",
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_NOT_AN_ACTIVE_PAGE);
+    _memory_lock_acquire(lockPtr);
 
-        return MEMORY_ERROR_NOT_AN_ACTIVE_PAGE;
-    }
+    memory_error_code resultCode = _memory_get_alloc_label_id_locked(allocKeyPtr, outLabelId);
 
-    struct memory_page_header *pagePtr = (void *)((p64)memoryPtr->heap + memoryPtr->pagesRegionByteOffset +
-        pageInfoPtr->pageHeaderByteOffset);
+    _memory_lock_release(lockPtr);
 
-    struct memory_allocator *allocatorPtr = (void *)((p64)pagePtr + allocInfoPtr->allocatorByteOffset);
+    return resultCode;
+}
 
-    if (byteWidth > allocatorPtr->byteSize)
+static memory_error_code
+_memory_get_allocation_key_from_handle_locked(const struct memory_context_key *memoryContextKeyPtr,
+    memory_handle handle, const struct memory_allocation_key *outAllocKeyPtr)
+{
+    if (!outAllocKeyPtr)
     {
-        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Bytewidth " 
-            "of value is too large for allocation.",
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE);
-
-        return MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE;
+        return MEMORY_ERROR_NULL_ARGUMENT;
     }
 
-    if (byteOffset >= allocatorPtr->byteSize)
-    {
-        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Offset " 
-            "of value is too large for allocation.",
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE);
+    memory_get_null_allocation_key(outAllocKeyPtr);
 
-        return MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE;
+    if (handle == MEMORY_HANDLE_NULL)
+    {
+        return MEMORY_ERROR_NULL_ID;
     }
 
-    if ((allocatorPtr->byteSize - byteOffset) < byteWidth)
+    struct memory_context *contextPtr;
     {
-        utils_fprintfln(stderr, "%s(Line: %d; Error Code: %u): Bytewidth " 
-            "with offset of value is too large for allocation.",
-            __FUNCTION__, __LINE__, (u32)MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE);
-        
-        return MEMORY_ERROR_REQUESTED_HEAP_REGION_SIZE_TOO_LARGE;
+        memory_error_code resultCode = _memory_get_context((void *)memoryContextKeyPtr, &contextPtr);
+
+        if (resultCode != MEMORY_OK)
+        {
+            return resultCode;
+        }
     }
 
-    memset((void *)((p64)allocatorPtr + sizeof(struct memory_allocator) + byteOffset), value,
-        byteWidth);
+    const struct memory_allocation_key allocKey;
 
-    return MEMORY_OK;
-}
+    memset((void *)&allocKey, '\0', sizeof(struct memory_allocation_key));
+    memcpy((void *)&allocKey.managed.contextKey, memoryContextKeyPtr, sizeof(struct memory_context_key));
 
-u64
-memory_sizeof(const struct memory_allocation_key *allocKeyPtr)
-{
-    if ((MEMORY_IS_ALLOCATION_NULL(allocKeyPtr)))
-    {
-        return 0;
-    }
+    ((struct memory_allocation_key *)&allocKey)->isManaged = B32_TRUE;
+    ((struct memory_allocation_key *)&allocKey)->managed.allocInfoIndex = (u32)(handle & UINT32_MAX);
+    ((struct memory_allocation_key *)&allocKey)->managed.generation = (memory_int_id)(handle >> 32);
 
-    struct memory_context *memoryPtr;
+    struct memory_allocation_info *allocInfoPtr;
     {
-        memory_error_code resultCode = _memory_get_context((void *)&allocKeyPtr->contextKey, 
-        &memoryPtr);
+        memory_error_code resultCode = _memory_get_allocation_info(contextPtr, &allocKey, &allocInfoPtr);
 
         if (resultCode != MEMORY_OK)
         {
-            return 0;
+            return resultCode;
         }
     }
 
-    struct memory_allocation_info *allocInfoPtr = &((struct memory_allocation_info *)((p64)memoryPtr->heap + 
-        memoryPtr->allocationInfoRegionByteOffset))[allocKeyPtr->allocInfoIndex];
+    memcpy((void *)outAllocKeyPtr, &allocKey, sizeof(struct memory_allocation_key));
 
-    struct memory_page_info *pageInfoPtr = &memoryPtr->pagesRegionInfoArr[allocInfoPtr->pageId - 1];
+    return MEMORY_OK;
+}
 
-    struct memory_page_header *pagePtr = (void *)((p64)memoryPtr->heap + memoryPtr->pagesRegionByteOffset + 
-        pageInfoPtr->pageHeaderByteOffset);
+memory_error_code
+memory_get_allocation_key_from_handle(const struct memory_context_key *memoryContextKeyPtr, memory_handle handle,
+    const struct memory_allocation_key *outAllocKeyPtr)
+{
+    struct memory_lock *lockPtr = _memory_get_context_lock(memoryContextKeyPtr);
 
-    struct memory_allocator *allocatorPtr = (void *)((p64)pagePtr + allocInfoPtr->allocatorByteOffset);
+    _memory_lock_acquire(lockPtr);
+
+    memory_error_code resultCode = _memory_get_allocation_key_from_handle_locked(memoryContextKeyPtr, handle,
+        outAllocKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultCode;
+}
 
-    return allocatorPtr->byteSize;
+static u64
+_memory_raw_sizeof_locked(const struct memory_raw_allocation_key *rawAllocKeyPtr)
+{
+    struct memory_raw_allocator *allocatorPtr = _memory_get_raw_allocator(rawAllocKeyPtr);
+
+    return allocatorPtr ? allocatorPtr->byteSize : 0;
 }
 
 u64
-memory_raw_sizeof(const struct memory_raw_allocation_key *rawAllocKeyPtr);
+memory_raw_sizeof(const struct memory_raw_allocation_key *rawAllocKeyPtr)
+{
+    struct memory_lock *lockPtr = &g_MEMORY_RAW_LOCK;
+
+    _memory_lock_acquire(lockPtr);
+
+    u64 resultByteSize = _memory_raw_sizeof_locked(rawAllocKeyPtr);
+
+    _memory_lock_release(lockPtr);
+
+    return resultByteSize;
+}
 
 b32
 memory_get_null_allocation_key(const struct memory_allocation_key *outAllocationKeyPtr)
@@ -4,6 +4,7 @@
 #include "types.h"
 
 #include <stdint.h>
+#include <stdio.h>
 
 typedef u64 memory_id;
 #define MEMORY_ID_NULL ((memory_id)0)
@@ -23,6 +24,10 @@ typedef u8 memory_byte_id;
 
 typedef u8 memory_error_code;
 
+// packed (generation << 32 | allocation info index); stable for the lifetime of an allocation
+typedef u64 memory_handle;
+#define MEMORY_HANDLE_NULL ((memory_handle)0)
+
 enum memory_page_status_t
 {
     MEMORY_PAGE_STATUS_UNKNOWN,
@@ -38,13 +43,24 @@ enum memory_event_type
     MEMORY_EVENT_BLOCK,
     MEMORY_EVENT_ALLOC,
     MEMORY_EVENT_FREE,
+    MEMORY_EVENT_REALLOC,
+    MEMORY_EVENT_PAGE_ALLOC,
+    MEMORY_EVENT_PAGE_FREE,
     MEMORY_EVENT_TYPE_COUNT
 };
 
+enum memory_map_mode_t
+{
+    MEMORY_MAP_MODE_SHARED,
+    MEMORY_MAP_MODE_EXCLUSIVE,
+    MEMORY_MAP_MODE_TYPE_COUNT
+};
+
 #define MEMORY_MAX_PAGES_REGION_PAGES (MEMORY_SHORT_ID_MAX)
 #define MEMORY_MAX_RAW_ALLOCS (MEMORY_SHORT_ID_MAX - 1)
 #define MEMORY_MAX_ALLOCS (MEMORY_INT_ID_MAX - 1)
 #define MEMORY_MAX_NAME_LENGTH (UINT8_MAX - 1)
+#define MEMORY_MAX_ALIGNMENT ((u64)4096)
 
 #define MEMORY_IS_CONTEXT_NULL(contextKeyPtr) ((contextKeyPtr) ? (((contextKeyPtr)->contextId == MEMORY_SHORT_ID_NULL) ? \
     B32_TRUE : B32_FALSE) : B32_TRUE)
@@ -52,13 +68,20 @@ enum memory_event_type
 #define MEMORY_IS_PAGE_NULL(pageKeyPtr) ((pageKeyPtr) ? (((pageKeyPtr)->pageId == MEMORY_SHORT_ID_NULL) ? \
     MEMORY_IS_CONTEXT_NULL((&(pageKeyPtr)->contextKey)) : B32_FALSE) : B32_TRUE)
 
-#define MEMORY_IS_ALLOCATION_NULL(allocationKeyPtr) (allocationKeyPtr ? (allocationKeyPtr->isManaged ? \
-    (allocationKeyPtr->managed.allocId == MEMORY_SHORT_ID_NULL) ? B32_TRUE : \
-    MEMORY_IS_CONTEXT_NULL(&allocationKeyPtr->managed.contextKey)) : B32_TRUE)
+#define MEMORY_IS_ALLOCATION_NULL(allocationKeyPtr) ((allocationKeyPtr) ? ((allocationKeyPtr)->isManaged ? \
+    (((allocationKeyPtr)->managed.generation == MEMORY_INT_ID_NULL) ? B32_TRUE : \
+    MEMORY_IS_CONTEXT_NULL(&(allocationKeyPtr)->managed.contextKey)) : \
+    (((allocationKeyPtr)->raw.generation == MEMORY_INT_ID_NULL) ? B32_TRUE : B32_FALSE)) : B32_TRUE)
 
-#define MEMORY_IS_ALLOCATION_KEY_EQUAL(lhsKeyPtr, rhsKeyPtr) 
+#define MEMORY_IS_ALLOCATION_KEY_EQUAL(lhsKeyPtr, rhsKeyPtr) ((lhsKeyPtr)->isManaged ? \
+    (((rhsKeyPtr)->isManaged) && ((lhsKeyPtr)->managed.allocInfoIndex == (rhsKeyPtr)->managed.allocInfoIndex) && \
+    ((lhsKeyPtr)->managed.generation == (rhsKeyPtr)->managed.generation) && \
+    ((lhsKeyPtr)->managed.contextKey.contextId == (rhsKeyPtr)->managed.contextKey.contextId) && \
+    ((lhsKeyPtr)->managed.contextKey.isDebug == (rhsKeyPtr)->managed.contextKey.isDebug)) : \
+    ((!(rhsKeyPtr)->isManaged) && ((lhsKeyPtr)->raw.rawAllocIndex == (rhsKeyPtr)->raw.rawAllocIndex) && \
+    ((lhsKeyPtr)->raw.generation == (rhsKeyPtr)->raw.generation)))
 
-#define MEMORY_LABEL_REGION_ALLOCATION_BYTE_OFFSET ((p64)0)
+#define MEMORY_MAX_LABELS (MEMORY_SHORT_ID_MAX - 1)
 
 struct memory_context_key
 {
@@ -66,21 +89,25 @@ struct memory_context_key
     b32 isDebug;
 };
 
+// pageId is the page info index + 1; the generation is bumped whenever the page is freed
 struct memory_page_key
 {
     memory_short_id pageId;
+    memory_int_id generation;
     const struct memory_context_key contextKey;
 };
 
+// like a managed key: the generation is bumped whenever the raw allocation's slot is freed
 struct memory_raw_allocation_key
 {
-    memory_short_id rawAllocationId;
-    u16 rawAllocationInfoBranchIndex;
+    memory_int_id generation;
+    u32 rawAllocIndex;
 };
 
+// the generation is bumped whenever the allocation info is released, so a stale key fails a single compare
 struct memory_managed_allocation_key
 {
-    memory_int_id allocId;
+    memory_int_id generation;
     u32 allocInfoIndex;
     const struct memory_context_key contextKey;
 };
@@ -98,16 +125,97 @@ struct memory_allocation_key
     b32 isManaged;
 };
 
+// bump allocator over a dedicated (locked) page; every allocation lives until the next reset
+struct memory_frame_arena
+{
+    const struct memory_page_key pageKey;
+    u8 *basePtr;
+    u64 byteCapacity;
+    u64 byteOffset;
+    u64 highWaterByteOffset;
+};
+
+// LIFO scratch over a dedicated (locked) page, committed as it grows. a marker is just a stack depth, so 
+// rolling back to one releases everything pushed after it at once
+typedef u64 memory_stack_marker;
+
+struct memory_stack
+{
+    const struct memory_page_key pageKey;
+    u8 *basePtr;
+    u64 byteCapacity;
+    u64 byteOffset;
+    u64 committedByteOffset;
+    u64 highWaterByteOffset;
+};
+
+// copy of a whole context (bookkeeping, allocation infos and the committed pages region) for level resets and
+// rollback. zero initialize before the first snapshot; snapshotting into it again reuses its buffer
+struct memory_context_snapshot
+{
+    const struct memory_context_key contextKey;
+    void *dataPtr;
+    u64 byteSize;
+    u64 byteCapacity;
+};
+
+#define MEMORY_POOL_NULL_SLOT_INDEX ((u32)UINT32_MAX)
+
+// fixed-size slots carved out of a single page allocation; free slots are threaded into an intrusive 
+// list, so there is no per-slot allocation info
+struct memory_pool
+{
+    const struct memory_allocation_key slotsAllocKey;
+    u8 *slotsBasePtr;
+    u64 slotByteSize;
+    u64 alignment;
+    u32 capacity;
+    u32 activeCount;
+    u32 freeListHeadSlotIndex;
+    u32 untouchedSlotIndex;
+};
+
 struct memory_context_diagnostic_info
 {
     const char *label;
     u64 heapReservedBytes;
+    u64 heapCommittedBytes;
     u64 pagesRegionReservedBytes;
     u16 pagesRegionActiveCount;
     u32 allocationCount;
+    u64 liveByteCount;
+    u64 highWaterByteCount;
+    u64 totalAllocCount;
+    u64 totalFreeCount;
+    // frame counters are latched by memory_context_next_frame
+    u64 frameIndex;
+    u32 lastFrameAllocCount;
+    u32 lastFrameFreeCount;
+    u32 peakFrameAllocCount;
+    u32 peakFrameFreeCount;
+    // gated maps that found the gate taken, and the time the waiting ones spent on it
+    u64 mapContendedCount;
+    u64 mapContendedWaitNS;
     b32 isDebug;
 };
 
+// bucket i counts free blocks of [2^i, 2^(i + 1)) bytes
+#define MEMORY_DIAGNOSTIC_HISTOGRAM_BUCKET_COUNT 32
+
+struct memory_page_diagnostic_info
+{
+    u64 heapByteSize;
+    u64 liveByteCount;
+    u64 highWaterByteCount;
+    u64 freeByteCount;
+    u64 largestFreeByteCount;
+    u32 allocationCount;
+    u32 freeBlockCount;
+    // 1 - largest free block/free bytes; 0 when the free space is one block (or there is none)
+    real32 fragmentation;
+    u32 freeBlockHistogramArr[MEMORY_DIAGNOSTIC_HISTOGRAM_BUCKET_COUNT];
+};
+
 struct memory_diagnostic_info
 {
     u16 rawAllocationCount;
@@ -131,29 +239,33 @@ struct memory_diagnostic_info
 #define MEMORY_ERROR_NOT_AN_ACTIVE_CONTEXT ((memory_error_code)13)
 #define MEMORY_ERROR_NOT_AN_ACTIVE_PAGE ((memory_error_code)14)
 #define MEMORY_ERROR_NOT_AN_ACTIVE_ALLOCATION ((memory_error_code)15)
+#define MEMORY_ERROR_ALLOCATION_BUSY ((memory_error_code)16)
 
 memory_error_code
-memory_raw_alloc(u64 byteSize, const struct memory_allocation_key *outRawAllocKeyPtr);
+memory_raw_alloc(const struct memory_raw_allocation_key *outRawAllocKeyPtr, u64 byteSize);
 
+// the data can move; pointers from memory_map_raw_allocation do not survive a realloc (the key does)
 memory_error_code
-memory_raw_realloc(const struct memory_allocation_key *rawAllocKeyPtr, u64 byteSize);
+memory_raw_realloc(const struct memory_raw_allocation_key *rawAllocKeyPtr, u64 byteSize);
 
 memory_error_code
-memory_raw_free(const struct memory_allocation_key *rawAllocKeyPtr);
+memory_raw_free(const struct memory_raw_allocation_key *rawAllocKeyPtr);
 
 memory_error_code
-memory_map_raw_allocation(const struct memory_allocation_key *rawAllocKeyPtr, void **outDataPtr);
+memory_map_raw_allocation(const struct memory_raw_allocation_key *rawAllocKeyPtr, void **outDataPtr);
 
 memory_error_code
-memory_unmap_raw_allocation(const struct memory_allocation_key *rawAllocKeyPtr, void **outDataPtr);
+memory_unmap_raw_allocation(void **outDataPtr);
 
 memory_error_code
-memory_set_raw_alloc_offset_width(const struct memory_allocation_key *rawAllocationKeyPtr, p64 byteOffset, 
+memory_set_raw_alloc_offset_width(const struct memory_raw_allocation_key *rawAllocationKeyPtr, p64 byteOffset, 
     u64 byteWidth, u8 value);
 
 memory_error_code
 memory_get_is_raw_allocation_operation_ok();
 
+// every call on a context (and on raw allocations) is safe from any thread, but creating a context moves the 
+// bookkeeping of all of them: create contexts before other threads start using any
 memory_error_code
 memory_create_debug_context(u64 allocationInfoRegionByteCapacity, u64 pagesRegionByteCapacity, u64 labelRegionByteCapacity, 
     const char *contextLabel, const struct memory_context_key *outputMemoryDebugContextKeyPtr);
@@ -162,6 +274,24 @@ memory_error_code
 memory_create_context(u64 allocationInfoRegionByteCapacity, u64 pagesRegionByteCapacity, 
     const struct memory_context_key *outputMemoryContextKeyPtr);
 
+// debug contexts only; records every alloc/free/realloc/page event into a ring of 'eventCapacity' (rounded up to 
+// a power of two) events, which a writer thread streams into a binary trace file until end_trace joins it
+memory_error_code
+memory_debug_context_begin_trace(const struct memory_context_key *memoryContextKeyPtr, u32 eventCapacity,
+    const char *traceFilePathStr);
+
+memory_error_code
+memory_debug_context_end_trace(const struct memory_context_key *memoryContextKeyPtr);
+
+// labels passed to memory_alloc are interned per debug context, so ids run from 1 to the label count and 
+// the returned strings live as long as the context
+memory_error_code
+memory_debug_context_get_label_count(const struct memory_context_key *memoryContextKeyPtr, u16 *outLabelCount);
+
+memory_error_code
+memory_debug_context_get_label(const struct memory_context_key *memoryContextKeyPtr, memory_short_id labelId,
+    const char **outLabelStr, u32 *outActiveAllocationCount);
+
 memory_error_code
 memory_get_context_key_is_ok(const struct memory_context_key *contextKeyPtr);
 
@@ -171,9 +301,17 @@ memory_alloc_page(const struct memory_context_key *memoryContextKeyPtr, u64 byte
 memory_error_code
 memory_free_page(const struct memory_page_key *pageKeyPtr);
 
+// grows the page in place over the free page right after it; fails when that page is taken or too small
 memory_error_code
 memory_realloc_page(const struct memory_page_key *pageKeyPtr, u64 byteSize);
 
+// every later allocation on the page gets at least this payload alignment (8 bytes by default)
+memory_error_code
+memory_page_set_alignment(const struct memory_page_key *pageKeyPtr, u64 alignment);
+
+memory_error_code
+memory_page_get_alignment(const struct memory_page_key *pageKeyPtr, u64 *outAlignment);
+
 enum memory_page_status_t
 memory_page_get_status(const struct memory_context_key *memoryContextKeyPtr, memory_short_id pageId);
 
@@ -189,12 +327,78 @@ memory_page_clean(const struct memory_context_key *memoryContextKeyPtr, memory_s
 memory_error_code
 memory_get_page_key_is_ok(const struct memory_page_key *pageKeyPtr);
 
+// incremental compaction: slides unmapped allocations down over free space until the budget runs out
+memory_error_code
+memory_pages_reorder(const struct memory_context_key *memoryContextKeyPtr, u64 timeBudgetNS);
+
+memory_error_code
+memory_context_snapshot(const struct memory_context_key *memoryContextKeyPtr, 
+    struct memory_context_snapshot *snapshotPtr);
+
+// keys taken before the snapshot are valid again afterwards; keys handed out after it are all stale. arenas, 
+// stacks and pools are plain structs on the caller's side and have to be snapshotted along with the context
+memory_error_code
+memory_context_restore(const struct memory_context_snapshot *snapshotPtr);
+
+memory_error_code
+memory_context_snapshot_free(struct memory_context_snapshot *snapshotPtr);
+
+memory_error_code
+memory_frame_arena_create(const struct memory_context_key *memoryContextKeyPtr, u64 byteCapacity,
+    struct memory_frame_arena *outArenaPtr);
+
 memory_error_code
-memory_pages_reorder(const struct memory_context_key *memoryContextKeyPtr);
+memory_frame_arena_alloc(struct memory_frame_arena *arenaPtr, u64 byteSize, void **outDataPtr);
 
+memory_error_code
+memory_frame_arena_reset(struct memory_frame_arena *arenaPtr);
+
+memory_error_code
+memory_frame_arena_destroy(struct memory_frame_arena *arenaPtr);
+
+memory_error_code
+memory_stack_create(const struct memory_context_key *memoryContextKeyPtr, u64 byteCapacity,
+    struct memory_stack *outStackPtr);
+
+memory_error_code
+memory_stack_push(struct memory_stack *stackPtr, u64 byteSize, void **outDataPtr);
+
+memory_error_code
+memory_stack_get_marker(const struct memory_stack *stackPtr, memory_stack_marker *outMarkerPtr);
+
+memory_error_code
+memory_stack_rollback_to_marker(struct memory_stack *stackPtr, memory_stack_marker marker);
+
+memory_error_code
+memory_stack_destroy(struct memory_stack *stackPtr);
+
+memory_error_code
+memory_pool_create(const struct memory_page_key *pageKeyPtr, u64 objectByteSize, u64 alignment, u32 capacity,
+    struct memory_pool *outPoolPtr);
+
+memory_error_code
+memory_pool_alloc(struct memory_pool *poolPtr, void **outDataPtr, u32 *outSlotIndexPtr);
+
+memory_error_code
+memory_pool_free(struct memory_pool *poolPtr, void *dataPtr);
+
+memory_error_code
+memory_pool_get_slot(const struct memory_pool *poolPtr, u32 slotIndex, void **outDataPtr);
+
+memory_error_code
+memory_pool_destroy(struct memory_pool *poolPtr);
+
+// allocations up to MEMORY_SLAB_MAX_BYTE_SIZE (256 bytes by default) share a slab per size class instead of 
+// getting an allocator header of their own; memory_sizeof reports the size class
 memory_error_code
 memory_alloc(const struct memory_page_key *pageKeyPtr, u64 byteSize, const char *debugLabelStr,
-    const struct memory_allocation_key *outAllocKeyPtr); // TODO: labels
+    const struct memory_allocation_key *outAllocKeyPtr);
+
+// 'alignment' is a power of two up to MEMORY_MAX_ALIGNMENT, or 0 for the page's alignment. the payload 
+// address stays aligned through realloc and compaction
+memory_error_code
+memory_alloc_aligned(const struct memory_page_key *pageKeyPtr, u64 byteSize, u64 alignment, 
+    const char *debugLabelStr, const struct memory_allocation_key *outAllocKeyPtr);
 
 memory_error_code
 memory_realloc(const struct memory_allocation_key *allocKeyPtr, u64 byteSize,
@@ -203,11 +407,43 @@ memory_realloc(const struct memory_allocation_key *allocKeyPtr, u64 byteSize,
 memory_error_code
 memory_free(const struct memory_allocation_key *allocKeyPtr);
 
+// small allocations on non-debug contexts are served from, and freed into, a cache per thread; parked blocks 
+// still count as allocated. A thread calls this before it exits (or to settle the diagnostics), so its cached 
+// blocks go back to their pages. A snapshot doesn't see into the caches either: blocks parked when it was 
+// taken stay allocated after restoring it.
+memory_error_code
+memory_thread_cache_flush(void);
+
+// debug builds (MEMORY_DEBUG) validate every map and count live mappings; release builds resolve the key 
+// with inlined pointer arithmetic and no checks at all, so the key must be valid. Release maps aren't counted, 
+// so a pointer held across memory_pages_reorder needs a gated map, which is counted in both builds
+#if defined(MEMORY_DEBUG)
 memory_error_code
 memory_map_alloc(const struct memory_allocation_key *allocKeyPtr, void **outAllocationPtr);
 
 memory_error_code
 memory_unmap_alloc(void **outAllocationPtr);
+#else
+    #define memory_map_alloc(allocKeyPtr, outAllocationPtr) _memory_map_alloc_unchecked((allocKeyPtr), \
+        (outAllocationPtr))
+    #define memory_unmap_alloc(outAllocationPtr) _memory_unmap_alloc_unchecked((outAllocationPtr))
+#endif
+
+// reader/writer gated maps, in both builds: any number of shared holders, or one exclusive holder. The 
+// context lock is only held to validate the key and resolve the pointer, never while a holder uses it or 
+// while a map waits on the gate. While gated, an allocation stays put and can't be freed or reallocated 
+// (MEMORY_ERROR_ALLOCATION_BUSY). The try variant returns MEMORY_ERROR_ALLOCATION_BUSY instead of waiting.
+memory_error_code
+memory_map_alloc_gated(const struct memory_allocation_key *allocKeyPtr, enum memory_map_mode_t mapMode, 
+    void **outAllocationPtr);
+
+memory_error_code
+memory_try_map_alloc_gated(const struct memory_allocation_key *allocKeyPtr, enum memory_map_mode_t mapMode, 
+    void **outAllocationPtr);
+
+memory_error_code
+memory_unmap_alloc_gated(const struct memory_allocation_key *allocKeyPtr, enum memory_map_mode_t mapMode, 
+    void **outAllocationPtr);
 
 memory_error_code
 memory_set_alloc_offset_width(const struct memory_allocation_key *allocationKeyPtr, p64 byteOffset, 
@@ -216,6 +452,10 @@ memory_set_alloc_offset_width(const struct memory_allocation_key *allocationKeyP
 memory_error_code
 memory_get_alloc_key_is_ok(const struct memory_allocation_key *allocKeyPtr);
 
+// MEMORY_SHORT_ID_NULL when the allocation has no label (or its context is not a debug context)
+memory_error_code
+memory_get_alloc_label_id(const struct memory_allocation_key *allocKeyPtr, memory_short_id *outLabelId);
+
 memory_error_code
 memory_context_get_diagnostic_info(const struct memory_context_key *memoryContextKeyPtr, 
     const struct memory_context_diagnostic_info *outDiagInfoPtr);
@@ -223,11 +463,31 @@ memory_context_get_diagnostic_info(const struct memory_context_key *memoryContex
 memory_error_code
 memory_get_diagnostic_info(const struct memory_diagnostic_info *outDiagInfoPtr);
 
+// the free block walk only touches the page's free lists, so it is cheap enough to call every frame
+memory_error_code
+memory_page_get_diagnostic_info(const struct memory_page_key *pageKeyPtr, 
+    struct memory_page_diagnostic_info *outDiagInfoPtr);
+
+// latches this frame's alloc/free counts into the last/peak frame counts; call once per frame
+memory_error_code
+memory_context_next_frame(const struct memory_context_key *memoryContextKeyPtr);
+
+// one line for the context, then one per live page
+memory_error_code
+memory_context_dump_diagnostics(const struct memory_context_key *memoryContextKeyPtr, FILE *filePtr);
+
+memory_handle
+memory_get_allocation_handle(const struct memory_allocation_key *allocKeyPtr);
+
+memory_error_code
+memory_get_allocation_key_from_handle(const struct memory_context_key *memoryContextKeyPtr, memory_handle handle,
+    const struct memory_allocation_key *outAllocKeyPtr);
+
 u64
 memory_sizeof(const struct memory_allocation_key *allocKeyPtr);
 
 u64
-memory_raw_sizeof(const struct memory_allocation_key *rawAllocKeyPtr);
+memory_raw_sizeof(const struct memory_raw_allocation_key *rawAllocKeyPtr);
 
 b32
 memory_get_null_allocation_key(const struct memory_allocation_key *outAllocationKeyPtr);
@@ -203,89 +203,6 @@ __opengl_sort_attrib_replace_func(struct memory *mem, void *lhs, size_t lhsIndex
     *lhsAttrib = *rhsAttrib;
 }
 
-static b32 
-_opengl_context_info_hash_func(struct basic_dict *dictPtr, void *key, 
-    utils_hash *outHashPtr)
-{
-    if (!dictPtr)
-    {
-        return B32_FALSE;
-    }
-
-    if (!key)
-    {
-        return B32_FALSE;
-    }
-
-    if (!outHashPtr)
-    {
-        return B32_FALSE;
-    }
-
-    const i32 c2 = 0x27d4eb2d; // a prime or an odd constant
-    i32 keyVal = *(i32 *)key;
-
-    keyVal = (keyVal ^ 61) ^ (keyVal >> 16);
-    keyVal = keyVal + (keyVal << 3);
-    keyVal = keyVal ^ (keyVal >> 4);
-    keyVal = keyVal * c2;
-    keyVal = keyVal ^ (keyVal >> 15);
-
-    *outHashPtr = (utils_hash)(((real32)keyVal/INT32_MAX)*UINT64_MAX);
-
-    return B32_TRUE;
-}
-
-static b32 
-_opengl_context_info_key_copy_func(struct basic_dict *dictPtr, void *keyPtr, 
-    const struct memory_raw_allocation_key *outRawKeyKeyPtr)
-{
-    if (!dictPtr)
-    {
-        return B32_FALSE;
-    }
-
-    if (!keyPtr)
-    {
-        return B32_FALSE;
-    }
-
-    if (!outRawKeyKeyPtr)
-    {
-        return B32_FALSE;
-    }
-
-    const struct memory_raw_allocation_key rawKeyKey;
-    i32 *allocPtr;
-    {
-        memory_error_code resultCode = memory_raw_alloc(&rawKeyKey, 
-        sizeof(i32));
-
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
-
-        resultCode = memory_map_raw_allocation(&rawKeyKey, 
-        (void **)&allocPtr);
-
-        if (resultCode != MEMORY_OK)
-        {
-            memory_raw_free(&rawKeyKey);
-
-            return B32_FALSE;
-        }
-    }
-
-    *allocPtr = *(i32 *)keyPtr;
-
-    memory_unmap_raw_allocation(&rawKeyKey, (void **)&allocPtr);
-
-    memcpy((void *)outRawKeyKeyPtr, &rawKeyKey, sizeof(struct memory_raw_allocation_key));
-
-    return B32_TRUE;
-}
-
 opengl_result_code
 opengl_helper_type_to_literal_str(u32 type, u64 bufferLength, char *outBuffer)
 {
@@ -673,8 +590,8 @@ opengl_create_context(const struct memory_context_key *memoryKeyPtr,
         const struct memory_allocation_key resultContextInfoDictKey;
         u64 keySize = sizeof(i32);
 
-        if ((basic_dict_create(&heapPageKey, &_opengl_context_info_hash_func, 
-            &_opengl_context_info_key_copy_func, (
+        if ((basic_dict_create(&heapPageKey, NULL, 
+            NULL, (
             utils_generate_next_prime_number(100)), &keySize, 
             NULL, &resultContextInfoDictKey)))
         {
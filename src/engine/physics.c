@@ -145,128 +145,12 @@ _physics_collision_hash_func(struct basic_dict *dictPtr, void *key,
 
     assert(lhsId != rhsId);
 
-    u64 resultHash;
-    ((physics_id *)&resultHash)[0] = (lhsId > rhsId) ? lhsId : rhsId;
-    ((physics_id *)&resultHash)[1] = (lhsId > rhsId) ? rhsId : lhsId;
+    // the pair is ordered first, so both orders hash the same
+    physics_id pairArr[2];
+    pairArr[0] = (lhsId > rhsId) ? lhsId : rhsId;
+    pairArr[1] = (lhsId > rhsId) ? rhsId : lhsId;
 
-    *outHashPtr = (utils_hash)resultHash;
-
-    return B32_TRUE;
-}
-
-static b32
-_physics_create_key_copy_func(struct basic_dict *dictPtr, void *keyPtr, 
-    const struct memory_raw_allocation_key *outRawKeyKeyPtr)
-{
-    const struct memory_raw_allocation_key rawKeyKey;
-    u64 *dataPtr;
-    {
-        memory_error_code resultCode = memory_raw_alloc(&rawKeyKey, sizeof(u64));
-
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
-
-        resultCode = memory_map_raw_allocation(&rawKeyKey, (void **)&dataPtr);
-
-        if (resultCode != MEMORY_OK)
-        {
-            memory_raw_free(&rawKeyKey);
-        }
-    }
-
-    memcpy(dataPtr, keyPtr, sizeof(u64));
-
-    memory_unmap_raw_allocation(&rawKeyKey, (void **)&dataPtr);
-
-    memcpy((void *)outRawKeyKeyPtr, &rawKeyKey, sizeof(struct memory_raw_allocation_key));
-
-    return B32_TRUE;
-}
-
-static b32
-_physics_force_hash_func(struct basic_dict *dictPtr, void *keyPtr, utils_hash *outHashPtr)
-{
-    if (!dictPtr)
-    {
-        if (outHashPtr)
-        {
-            *outHashPtr = 0;
-        }
-
-        return B32_FALSE;
-    }
-
-    if (!keyPtr)
-    {
-        if (outHashPtr)
-        {
-            *outHashPtr = 0;
-        }
-
-        return B32_FALSE;
-    }
-
-    if (!outHashPtr)
-    {
-        return B32_FALSE;
-    }
-
-    i32 key = *(i32 *)keyPtr;
-
-    // https://gist.github.com/badboy/6267743
-    // see "knuth" multiplicative method.
-    // multiply by sparse bit pattern
-    // and multiply using bit shifts and adds
-    // to obtain hash.
-    // different machines will either A) provide multiplication in hardware
-    // or B) not. a compromise is to use bit shifts and adds to simulate
-    // hardware multiplication, using a prime or odd constant. It does the same thing,
-    // has the same performance, and is guaranteed to work on all machines
-    const i32 c2=0x27d4eb2d;
-
-    key = (key ^ 61) ^ (key >> 16);
-    key = key + (key << 3);
-    key = key ^ (key >> 4);
-    key = key * c2;
-    key = key ^ (key >> 15);
-
-    *outHashPtr = (u64)(((real64)key/INT32_MAX)*(real64)(UINT64_MAX - 1)) + 1;
-
-    return B32_TRUE;
-}
-
-static b32
-_physics_force_key_copy_func(struct basic_dict *dictPtr, void *keyPtr, 
-    const struct memory_raw_allocation_key *outRawKeyKeyPtr)
-{
-    const struct memory_raw_allocation_key rawKeyKey;
-    u64 *dataPtr;
-    {
-        memory_error_code resultCode = memory_raw_alloc(&rawKeyKey, 
-        sizeof(physics_id));
-
-        if (resultCode != MEMORY_OK)
-        {
-            return B32_FALSE;
-        }
-
-        resultCode = memory_map_raw_allocation(&rawKeyKey, (void **)&dataPtr);
-
-        if (resultCode != MEMORY_OK)
-        {
-            memory_raw_free(&rawKeyKey);
-        }
-    }
-
-    memcpy(dataPtr, keyPtr, sizeof(physics_id));
-
-    memory_unmap_raw_allocation(&rawKeyKey, (void **)&dataPtr);
-
-    memcpy((void *)outRawKeyKeyPtr, &rawKeyKey, sizeof(struct memory_raw_allocation_key));
-
-    return B32_TRUE;
+    return utils_generate_hash_from_bytes(pairArr, sizeof(pairArr), outHashPtr);
 }
 
 static b32
@@ -1154,7 +1038,7 @@ physics_init(const struct memory_context_key *memoryKeyPtr,
     u64 keySize = sizeof(u64);
 
     if (!(basic_dict_create(&heapPage, &_physics_collision_hash_func, 
-        &_physics_create_key_copy_func, utils_generate_next_prime_number(100), 
+        NULL, utils_generate_next_prime_number(100), 
         &keySize, &physicsKey, &physicsPtr->collisionDictKey)))
     {
         memory_unmap_alloc((void **)&physicsPtr);
@@ -1170,8 +1054,8 @@ physics_init(const struct memory_context_key *memoryKeyPtr,
 
     keySize = sizeof(physics_id);
 
-    if (!(basic_dict_create(&heapPage, &_physics_force_hash_func, 
-        &_physics_force_key_copy_func, (
+    if (!(basic_dict_create(&heapPage, NULL, 
+        NULL, (
             utils_generate_next_prime_number(100)), &keySize, 
         &physicsKey, &physicsPtr->forceDictKey)))
     {
@@ -1287,7 +1171,7 @@ physics_init(const struct memory_context_key *memoryKeyPtr,
 
         strcpy(logPath, "physics.log");
 
-        memory_unmap_raw_allocation(&logPtr->rawOutputFilenameKey, (void **)&logPath);
+        memory_unmap_raw_allocation((void **)&logPath);
         memory_unmap_alloc((void **)&logPtr);
     }
 
@@ -1946,8 +1830,7 @@ physics_create_rigidbody(const struct memory_allocation_key *physicsKeyPtr, phys
 
     *maxSpeedConstraintPtr = 0.f;
 
-    memory_unmap_raw_allocation(&rigidbodyPtr->constraintArr[PHYSICS_RB_CONSTRAINT_MAX_SPEED].rawDataKey, 
-    (void **)&maxSpeedConstraintPtr);
+    memory_unmap_raw_allocation((void **)&maxSpeedConstraintPtr);
     
     rigidbodyPtr->constraintArr[PHYSICS_RB_CONSTRAINT_MAX_ROTATION].type = PHYSICS_RB_CONSTRAINT_MAX_ROTATION;
     rigidbodyPtr->constraintArr[PHYSICS_RB_CONSTRAINT_MAX_ROTATION].isActive = B32_FALSE;
@@ -1988,8 +1871,7 @@ physics_create_rigidbody(const struct memory_allocation_key *physicsKeyPtr, phys
 
     *maxRotationConstraintPtr = 0.f;
     
-    memory_unmap_raw_allocation(&rigidbodyPtr->constraintArr[PHYSICS_RB_CONSTRAINT_MAX_ROTATION].rawDataKey, 
-    (void **)&maxRotationConstraintPtr);
+    memory_unmap_raw_allocation((void **)&maxRotationConstraintPtr);
 
     memory_unmap_alloc((void **)&rbArrPtr);
     memory_unmap_alloc((void **)&physicsPtr);
@@ -5,6 +5,19 @@
 #include <math.h>
 #include <assert.h>
 #include <stdarg.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define UTILS_HASH_USE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define UTILS_HASH_USE_SSE2
+#endif
 
 static const u64 *g_ELAPSED_TIME_PTR;
 static const u32 *g_ELAPSED_TIME_INT_PTR;
@@ -67,6 +80,352 @@ utils_printfln(const char *formatStrPtr, ...)
     return resultCode;
 }
 
+// short keys go through wyhash (final version 4). Longer ones go through an xxh3 style accumulator of 8 lanes,
+// which AVX2 updates 4 lanes at a time and SSE2 2; every lane path computes the same values, so a hash doesn't
+// depend on the build
+#define UTILS_HASH_WIDE_MIN_BYTE_SIZE 256
+#define UTILS_HASH_STRIPE_BYTE_SIZE 64
+#define UTILS_HASH_BLOCK_STRIPE_COUNT 16
+#define UTILS_HASH_LANE_COUNT 8
+
+static const u64 g_UTILS_HASH_SHORT_SECRET_ARR[] =
+{
+    0xA0761D6478BD642Full, 0xE7037ED1A0B428DBull, 0x8EBC6AF09C88C6E3ull, 0x589965CC75374CC3ull
+};
+
+// _utils_hash_mix of the first two secrets, which is what wyhash starts from for a seed of 0
+#define UTILS_HASH_SHORT_SEED 0x1FF5C2923A788D2Cull
+
+// every stripe of a block reads it at its own 8 byte offset, and the last 64 bytes scramble the lanes
+static const u64 g_UTILS_HASH_WIDE_SECRET_ARR[] =
+{
+    0xC8179BD7C07BB38Dull, 0x898BED8F87BA6592ull, 0x80D932FBE2C1AC89ull, 0x23A60DF2728D7ED8ull,
+    0x246DBBBB5AC74A04ull, 0xBAF425E4FC357B49ull, 0x9E8A737F07491B8Dull, 0x39A97D3D651D1889ull,
+    0xEB16DCC61E14B6B4ull, 0x487CA5582CE77779ull, 0x7B5DCAB97F855972ull, 0xB1FB1CDB6FA1A8B4ull,
+    0x422BCF20260E0572ull, 0xF5055097445A05A2ull, 0xE01F8E4A0992107Full, 0x661423675CC4306Aull,
+    0xBBC759B402FA6299ull, 0x0A0D8CCABABAF634ull, 0x1EE96FE54E917A79ull, 0x654BAF6CBD93EEC4ull,
+    0xE6B5426528B4A835ull, 0x67DF799AF00763A9ull, 0xE30B8D66C65A2349ull, 0xD6130286E3284CE3ull
+};
+
+static inline u64
+_utils_hash_read_u64(const u8 *bytePtr)
+{
+    u64 value;
+    memcpy(&value, bytePtr, sizeof(u64));
+
+    return value;
+}
+
+static inline u64
+_utils_hash_read_u32(const u8 *bytePtr)
+{
+    u32 value;
+    memcpy(&value, bytePtr, sizeof(u32));
+
+    return value;
+}
+
+// the low and high halves of the 128-bit product replace the two factors
+static inline void
+_utils_hash_multiply(u64 *lhsPtr, u64 *rhsPtr)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t)(*lhsPtr)*(*rhsPtr);
+
+    *lhsPtr = (u64)product;
+    *rhsPtr = (u64)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *lhsPtr = _umul128(*lhsPtr, *rhsPtr, rhsPtr);
+#else
+    u64 lhsHigh = *lhsPtr >> 32;
+    u64 lhsLow = (u32)(*lhsPtr);
+    u64 rhsHigh = *rhsPtr >> 32;
+    u64 rhsLow = (u32)(*rhsPtr);
+    u64 middleLhs = lhsHigh*rhsLow;
+    u64 middleRhs = rhsHigh*lhsLow;
+    u64 low = lhsLow*rhsLow;
+    u64 partialLow = low + (middleLhs << 32);
+    u64 carry = partialLow < low;
+
+    low = partialLow + (middleRhs << 32);
+    carry += low < partialLow;
+
+    *lhsPtr = low;
+    *rhsPtr = lhsHigh*rhsHigh + (middleLhs >> 32) + (middleRhs >> 32) + carry;
+#endif
+}
+
+static inline u64
+_utils_hash_mix(u64 lhs, u64 rhs)
+{
+    _utils_hash_multiply(&lhs, &rhs);
+
+    return lhs ^ rhs;
+}
+
+static u64
+_utils_hash_bytes_short(const u8 *bytePtr, u64 byteSize)
+{
+    const u64 *secretArr = g_UTILS_HASH_SHORT_SECRET_ARR;
+    u64 seed = UTILS_HASH_SHORT_SEED;
+    u64 lhs;
+    u64 rhs;
+
+    if (byteSize <= 16)
+    {
+        if (byteSize >= 4)
+        {
+            // two overlapping reads cover 4 to 16 bytes
+            u64 middleOffset = (byteSize >> 3) << 2;
+
+            lhs = (_utils_hash_read_u32(bytePtr) << 32) | _utils_hash_read_u32(bytePtr + middleOffset);
+            rhs = (_utils_hash_read_u32(bytePtr + byteSize - 4) << 32) | 
+                _utils_hash_read_u32(bytePtr + byteSize - 4 - middleOffset);
+        }
+        else if (byteSize > 0)
+        {
+            lhs = ((u64)bytePtr[0] << 16) | ((u64)bytePtr[byteSize >> 1] << 8) | bytePtr[byteSize - 1];
+            rhs = 0;
+        }
+        else 
+        {
+            lhs = 0;
+            rhs = 0;
+        }
+    }
+    else 
+    {
+        u64 remainingByteSize = byteSize;
+
+        if (remainingByteSize > 48)
+        {
+            u64 seed1 = seed;
+            u64 seed2 = seed;
+
+            do
+            {
+                seed = _utils_hash_mix(_utils_hash_read_u64(bytePtr) ^ secretArr[1], 
+                    _utils_hash_read_u64(bytePtr + 8) ^ seed);
+                seed1 = _utils_hash_mix(_utils_hash_read_u64(bytePtr + 16) ^ secretArr[2], 
+                    _utils_hash_read_u64(bytePtr + 24) ^ seed1);
+                seed2 = _utils_hash_mix(_utils_hash_read_u64(bytePtr + 32) ^ secretArr[3], 
+                    _utils_hash_read_u64(bytePtr + 40) ^ seed2);
+
+                bytePtr += 48;
+                remainingByteSize -= 48;
+            } while (remainingByteSize > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (remainingByteSize > 16)
+        {
+            seed = _utils_hash_mix(_utils_hash_read_u64(bytePtr) ^ secretArr[1], 
+                _utils_hash_read_u64(bytePtr + 8) ^ seed);
+
+            bytePtr += 16;
+            remainingByteSize -= 16;
+        }
+
+        // the last 16 bytes, overlapping what was already mixed in
+        lhs = _utils_hash_read_u64(bytePtr + remainingByteSize - 16);
+        rhs = _utils_hash_read_u64(bytePtr + remainingByteSize - 8);
+    }
+
+    lhs ^= secretArr[1];
+    rhs ^= seed;
+
+    _utils_hash_multiply(&lhs, &rhs);
+
+    return _utils_hash_mix(lhs ^ secretArr[0] ^ byteSize, rhs ^ secretArr[1]);
+}
+
+// lane i takes stripe word i times the word mixed with the secret, and lane i^1 the plain word
+static void
+_utils_hash_accumulate(u64 *accArr, const u8 *bytePtr, u64 stripeCount, const u8 *secretPtr)
+{
+#if defined(UTILS_HASH_USE_AVX2)
+    __m256i accVecArr[2] = 
+    {
+        _mm256_loadu_si256((const __m256i *)accArr), _mm256_loadu_si256((const __m256i *)accArr + 1)
+    };
+
+    for (u64 stripeIndex = 0; stripeIndex < stripeCount; ++stripeIndex)
+    {
+        const u8 *stripePtr = bytePtr + stripeIndex*UTILS_HASH_STRIPE_BYTE_SIZE;
+        const u8 *stripeSecretPtr = secretPtr + stripeIndex*8;
+
+        for (u32 vecIndex = 0; vecIndex < 2; ++vecIndex)
+        {
+            __m256i dataVec = _mm256_loadu_si256((const __m256i *)stripePtr + vecIndex);
+            __m256i keyVec = _mm256_xor_si256(dataVec, _mm256_loadu_si256((const __m256i *)stripeSecretPtr + 
+                vecIndex));
+            __m256i productVec = _mm256_mul_epu32(keyVec, _mm256_srli_epi64(keyVec, 32));
+
+            accVecArr[vecIndex] = _mm256_add_epi64(accVecArr[vecIndex], _mm256_add_epi64(productVec, 
+                _mm256_shuffle_epi32(dataVec, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+    }
+
+    _mm256_storeu_si256((__m256i *)accArr, accVecArr[0]);
+    _mm256_storeu_si256((__m256i *)accArr + 1, accVecArr[1]);
+#elif defined(UTILS_HASH_USE_SSE2)
+    __m128i accVecArr[4];
+
+    for (u32 vecIndex = 0; vecIndex < 4; ++vecIndex)
+    {
+        accVecArr[vecIndex] = _mm_loadu_si128((const __m128i *)accArr + vecIndex);
+    }
+
+    for (u64 stripeIndex = 0; stripeIndex < stripeCount; ++stripeIndex)
+    {
+        const u8 *stripePtr = bytePtr + stripeIndex*UTILS_HASH_STRIPE_BYTE_SIZE;
+        const u8 *stripeSecretPtr = secretPtr + stripeIndex*8;
+
+        for (u32 vecIndex = 0; vecIndex < 4; ++vecIndex)
+        {
+            __m128i dataVec = _mm_loadu_si128((const __m128i *)stripePtr + vecIndex);
+            __m128i keyVec = _mm_xor_si128(dataVec, _mm_loadu_si128((const __m128i *)stripeSecretPtr + vecIndex));
+            __m128i productVec = _mm_mul_epu32(keyVec, _mm_srli_epi64(keyVec, 32));
+
+            accVecArr[vecIndex] = _mm_add_epi64(accVecArr[vecIndex], _mm_add_epi64(productVec, 
+                _mm_shuffle_epi32(dataVec, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+    }
+
+    for (u32 vecIndex = 0; vecIndex < 4; ++vecIndex)
+    {
+        _mm_storeu_si128((__m128i *)accArr + vecIndex, accVecArr[vecIndex]);
+    }
+#else
+    // a local copy, as the stores to 'accArr' could otherwise alias the bytes being read
+    u64 localAccArr[UTILS_HASH_LANE_COUNT];
+    memcpy(localAccArr, accArr, sizeof(localAccArr));
+
+    for (u64 stripeIndex = 0; stripeIndex < stripeCount; ++stripeIndex)
+    {
+        const u8 *stripePtr = bytePtr + stripeIndex*UTILS_HASH_STRIPE_BYTE_SIZE;
+        const u8 *stripeSecretPtr = secretPtr + stripeIndex*8;
+
+        for (u32 laneIndex = 0; laneIndex < UTILS_HASH_LANE_COUNT; ++laneIndex)
+        {
+            u64 data = _utils_hash_read_u64(stripePtr + laneIndex*8);
+            u64 key = data ^ _utils_hash_read_u64(stripeSecretPtr + laneIndex*8);
+
+            localAccArr[laneIndex ^ 1] += data;
+            localAccArr[laneIndex] += (u64)(u32)key*(key >> 32);
+        }
+    }
+
+    memcpy(accArr, localAccArr, sizeof(localAccArr));
+#endif
+}
+
+static void
+_utils_hash_scramble(u64 *accArr, const u8 *secretPtr)
+{
+#if defined(UTILS_HASH_USE_AVX2)
+    const __m256i primeVec = _mm256_set1_epi32((i32)0x9E3779B1);
+
+    for (u32 vecIndex = 0; vecIndex < 2; ++vecIndex)
+    {
+        __m256i accVec = _mm256_loadu_si256((const __m256i *)accArr + vecIndex);
+
+        accVec = _mm256_xor_si256(accVec, _mm256_srli_epi64(accVec, 47));
+        accVec = _mm256_xor_si256(accVec, _mm256_loadu_si256((const __m256i *)secretPtr + vecIndex));
+
+        // a 64x32-bit multiply, from two 32x32-bit ones
+        accVec = _mm256_add_epi64(_mm256_mul_epu32(accVec, primeVec), 
+            _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(accVec, 32), primeVec), 32));
+
+        _mm256_storeu_si256((__m256i *)accArr + vecIndex, accVec);
+    }
+#elif defined(UTILS_HASH_USE_SSE2)
+    const __m128i primeVec = _mm_set1_epi32((i32)0x9E3779B1);
+
+    for (u32 vecIndex = 0; vecIndex < 4; ++vecIndex)
+    {
+        __m128i accVec = _mm_loadu_si128((const __m128i *)accArr + vecIndex);
+
+        accVec = _mm_xor_si128(accVec, _mm_srli_epi64(accVec, 47));
+        accVec = _mm_xor_si128(accVec, _mm_loadu_si128((const __m128i *)secretPtr + vecIndex));
+        accVec = _mm_add_epi64(_mm_mul_epu32(accVec, primeVec), 
+            _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(accVec, 32), primeVec), 32));
+
+        _mm_storeu_si128((__m128i *)accArr + vecIndex, accVec);
+    }
+#else
+    for (u32 laneIndex = 0; laneIndex < UTILS_HASH_LANE_COUNT; ++laneIndex)
+    {
+        u64 acc = accArr[laneIndex];
+
+        acc ^= acc >> 47;
+        acc ^= _utils_hash_read_u64(secretPtr + laneIndex*8);
+        acc *= 0x9E3779B1ull;
+
+        accArr[laneIndex] = acc;
+    }
+#endif
+}
+
+static u64
+_utils_hash_bytes_wide(const u8 *bytePtr, u64 byteSize)
+{
+    const u8 *secretPtr = (const u8 *)g_UTILS_HASH_WIDE_SECRET_ARR;
+    const u8 *scrambleSecretPtr = secretPtr + sizeof(g_UTILS_HASH_WIDE_SECRET_ARR) - UTILS_HASH_STRIPE_BYTE_SIZE;
+    const u64 blockByteSize = UTILS_HASH_STRIPE_BYTE_SIZE*UTILS_HASH_BLOCK_STRIPE_COUNT;
+
+    u64 accArr[UTILS_HASH_LANE_COUNT] =
+    {
+        0xC2B2AE3Dull, 0x9E3779B185EBCA87ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull, 
+        0x85EBCA77C2B2AE63ull, 0x85EBCA77ull, 0x27D4EB2F165667C5ull, 0x9E3779B1ull
+    };
+
+    // the last byte is always left for the final stripe
+    u64 blockCount = (byteSize - 1)/blockByteSize;
+
+    for (u64 blockIndex = 0; blockIndex < blockCount; ++blockIndex)
+    {
+        _utils_hash_accumulate(accArr, bytePtr + blockIndex*blockByteSize, UTILS_HASH_BLOCK_STRIPE_COUNT, 
+            secretPtr);
+        _utils_hash_scramble(accArr, scrambleSecretPtr);
+    }
+
+    _utils_hash_accumulate(accArr, bytePtr + blockCount*blockByteSize, 
+        ((byteSize - 1) - blockCount*blockByteSize)/UTILS_HASH_STRIPE_BYTE_SIZE, secretPtr);
+
+    // the final stripe overlaps the ones before it, rather than being padded
+    _utils_hash_accumulate(accArr, bytePtr + byteSize - UTILS_HASH_STRIPE_BYTE_SIZE, 1, scrambleSecretPtr - 8);
+
+    u64 result = byteSize*0x9E3779B185EBCA87ull;
+
+    for (u32 laneIndex = 0; laneIndex < UTILS_HASH_LANE_COUNT; laneIndex += 2)
+    {
+        result += _utils_hash_mix(accArr[laneIndex] ^ _utils_hash_read_u64(secretPtr + 11 + laneIndex*8), 
+            accArr[laneIndex + 1] ^ _utils_hash_read_u64(secretPtr + 19 + laneIndex*8));
+    }
+
+    result ^= result >> 37;
+    result *= 0x165667919E3779F9ull;
+    result ^= result >> 32;
+
+    return result;
+}
+
+b32
+utils_generate_hash_from_bytes(const void *bytePtr, u64 byteSize, utils_hash *outResult)
+{
+    if (!outResult || (!bytePtr && byteSize))
+    {
+        return B32_FALSE;
+    }
+
+    *outResult = (byteSize < UTILS_HASH_WIDE_MIN_BYTE_SIZE) ? _utils_hash_bytes_short(bytePtr, byteSize) : 
+        _utils_hash_bytes_wide(bytePtr, byteSize);
+
+    return B32_TRUE;
+}
+
 b32 
 utils_generate_hash_from_string(const char *k, utils_hash *outResult)
 {
@@ -75,22 +434,33 @@ utils_generate_hash_from_string(const char *k, utils_hash *outResult)
         return B32_FALSE;
     }
 
-    // https://cp-algorithms.com/string/string-hashing.html
-    // # 'Polynomial Rolling Hash Function'
-    // # scroll to 'Calculation of the Hash of a String'
+    return utils_generate_hash_from_bytes(k, strlen(k), outResult);
+}
 
-    const i32 p = 59;
-    const i32 m = 1e9 + 9;
-    u64 hash = 0;
-    u64 pPow = 1;
+// byte at a time, exactly like UTILS_STRING_ID_HASH, so the ids made at runtime and at compile time agree
+utils_hash
+utils_get_string_id_hash(const char *str)
+{
+    utils_hash hash = UTILS_STRING_ID_OFFSET_BASIS;
 
-    for (const char *c = k; *c != '\0'; ++c)
+    for (const u8 *charPtr = (const u8 *)str; *charPtr; ++charPtr)
     {
-        hash = (hash + (*c - 'a' + 1)*pPow)%m;
-        pPow = (pPow*p)%m;
+        hash = (hash ^ *charPtr)*UTILS_STRING_ID_PRIME;
+    }
+
+    return hash;
+}
+
+b32
+utils_generate_string_id(const char *str, struct utils_string_id *outStringIdPtr)
+{
+    if (!str || !outStringIdPtr)
+    {
+        return B32_FALSE;
     }
 
-    *outResult = hash;
+    outStringIdPtr->hash = utils_get_string_id_hash(str);
+    outStringIdPtr->str = str;
 
     return B32_TRUE;
 }
@@ -191,11 +561,11 @@ utils_generate_random_u64_from_string(const char *str, u64 *outRandomPtr)
 {
     if (g_IS_RANDOM_SEED_SET && outRandomPtr)
     {
-        struct utils_string_hash resultHash;
+        utils_hash resultHash;
 
         utils_generate_hash_from_string(str, &resultHash);
 
-        *outRandomPtr = (u64)((real64)rand()/RAND_MAX*resultHash.hash);
+        *outRandomPtr = (u64)((real64)rand()/RAND_MAX*resultHash);
 
         return B32_TRUE;
     }
@@ -208,11 +578,11 @@ utils_generate_random_positive_normalized_real64_from_string(const char *str, re
 {
     if (g_IS_RANDOM_SEED_SET && outRandomPtr)
     {
-        struct utils_string_hash resultHash;
+        utils_hash resultHash;
         
         utils_generate_hash_from_string(str, &resultHash);
 
-        *outRandomPtr = (real64)rand()/RAND_MAX*(real64)resultHash.hash;
+        *outRandomPtr = (real64)rand()/RAND_MAX*(real64)resultHash;
 
         return B32_TRUE;
     }
@@ -19,6 +19,40 @@ typedef void (*utils_sort_replace_func)(void *database, void *lhsPtr, void *rhsP
 typedef u64 utils_hash_u64;
 typedef utils_hash_u64 utils_hash;
 
+// a string with its string id hash (64 bit FNV-1a), so a lookup by that string doesn't hash it again
+struct utils_string_id
+{
+    utils_hash hash;
+    const char *str;
+};
+
+#define UTILS_STRING_ID_OFFSET_BASIS 0xCBF29CE484222325ull
+#define UTILS_STRING_ID_PRIME 0x00000100000001B3ull
+// string literals up to this length are hashed by the macros below; longer ones by utils_get_string_id_hash
+#define UTILS_STRING_ID_FOLD_MAX_LENGTH 64
+
+// one FNV-1a step for character 'i' of 'literal', and none past its end. 'hash' appears once, so the nested
+// steps expand linearly, and the index is clamped, so no expansion reads out of bounds
+#define UTILS_STRING_ID_STEP(hash, literal, i) \
+    (((hash) ^ (((i) < (sizeof(literal) - 1)) ? (u8)(literal)[((i) < (sizeof(literal) - 1)) ? (i) : 0] : 0))* \
+    (((i) < (sizeof(literal) - 1)) ? UTILS_STRING_ID_PRIME : 1))
+#define UTILS_STRING_ID_STEP_4(hash, literal, i) \
+    UTILS_STRING_ID_STEP(UTILS_STRING_ID_STEP(UTILS_STRING_ID_STEP(UTILS_STRING_ID_STEP(hash, literal, i), \
+    literal, (i) + 1), literal, (i) + 2), literal, (i) + 3)
+#define UTILS_STRING_ID_STEP_16(hash, literal, i) \
+    UTILS_STRING_ID_STEP_4(UTILS_STRING_ID_STEP_4(UTILS_STRING_ID_STEP_4(UTILS_STRING_ID_STEP_4(hash, \
+    literal, i), literal, (i) + 4), literal, (i) + 8), literal, (i) + 12)
+
+// the string id hash of a string literal, equal to utils_get_string_id_hash of the same string. Up to
+// UTILS_STRING_ID_FOLD_MAX_LENGTH characters it's a constant expression (static initializers take it), which
+// optimized builds fold wherever it's used
+#define UTILS_STRING_ID_HASH(literal) \
+    (((sizeof("" literal) - 1) > UTILS_STRING_ID_FOLD_MAX_LENGTH) ? utils_get_string_id_hash(literal) : \
+    UTILS_STRING_ID_STEP_16(UTILS_STRING_ID_STEP_16(UTILS_STRING_ID_STEP_16(UTILS_STRING_ID_STEP_16( \
+    UTILS_STRING_ID_OFFSET_BASIS, literal, 0), literal, 16), literal, 32), literal, 48))
+
+#define UTILS_STRING_ID(literal) ((struct utils_string_id){ UTILS_STRING_ID_HASH(literal), (literal) })
+
 i32
 utils_fprintf(FILE *filePtr, const char *formatStrPtr, ...);
 
@@ -31,9 +65,18 @@ utils_printf(const char *formatStrPtr, ...);
 i32
 utils_printfln(const char *formatStrPtr, ...);
 
+b32
+utils_generate_hash_from_bytes(const void *bytePtr, u64 byteSize, utils_hash *outResult);
+
 b32 
 utils_generate_hash_from_string(const char *k, utils_hash *outResult);
 
+utils_hash
+utils_get_string_id_hash(const char *str);
+
+b32
+utils_generate_string_id(const char *str, struct utils_string_id *outStringIdPtr);
+
 void
 utils_set_elapsed_time_ns_ptr(u64 *ptr);
 
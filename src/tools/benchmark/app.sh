@@ -0,0 +1,35 @@
+#!/usr/bin/sh
+
+# Headless allocator benchmarks (no SDL/GL). The engine sources are built unity style, exactly
+# like the engine itself; each allocation policy gets its own binary, and the tlsf policy is also built with 
+# MEMORY_DEBUG to compare checked and unchecked key mapping.
+#
+# Every binary runs the lifo, fifo, churn, small, grow, frame, map_unmap and reorder workloads against the engine,
+# the raw allocator and glibc malloc ("./app.sh --run lifo grow" runs a subset) and prints one line of key=value
+# pairs per run: throughput, p50/p99 latency, fragmentation and footprint ratio. results.log keeps every run.
+
+if [ "$1" == "--build" ] 
+then
+    echo "Selected User Option: 'build'" | ts '[%Y-%m-%d %H:%M:%S]'
+    echo 
+    rm -rf ./build
+    mkdir ./build
+    pushd ./build
+
+    gcc -std=c11 -O2 -D_GNU_SOURCE -o benchmark_tlsf ../src/main.c -lm -lpthread 2>&1 | \
+        ts '[%Y-%m-%d %H:%M:%S]' >& ./build.log
+    gcc -std=c11 -O2 -D_GNU_SOURCE -DMEMORY_ALLOC_POLICY_FIRST_FIT -o benchmark_first_fit ../src/main.c -lm -lpthread 2>&1 | \
+        ts '[%Y-%m-%d %H:%M:%S]' >> ./build.log
+    gcc -std=c11 -O2 -D_GNU_SOURCE -DMEMORY_DEBUG -o benchmark_tlsf_debug ../src/main.c -lm -lpthread 2>&1 | \
+        ts '[%Y-%m-%d %H:%M:%S]' >> ./build.log
+
+    cat build.log
+
+    popd
+else
+    echo "Selected User Option: 'run'" | ts '[%Y-%m-%d %H:%M:%S]'
+    [ $# -gt 0 ] && shift
+    ./build/benchmark_tlsf "$@" 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' | tee -a ./results.log
+    ./build/benchmark_first_fit "$@" 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' | tee -a ./results.log
+    ./build/benchmark_tlsf_debug "$@" 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' | tee -a ./results.log
+fi
@@ -0,0 +1,971 @@
+#include "../../../engine/types.h"
+#include "../../../engine/memory.h"
+#include "../../../engine/utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <malloc.h>
+
+#include "../../../engine/memory.c"
+#include "../../../engine/utils.c"
+
+#if defined(MEMORY_ALLOC_POLICY_FIRST_FIT)
+    #define BENCHMARK_ALLOC_POLICY_NAME "first_fit"
+#else
+    #define BENCHMARK_ALLOC_POLICY_NAME "tlsf"
+#endif
+
+#if defined(MEMORY_DEBUG)
+    #define BENCHMARK_MEMORY_MODE_NAME "debug"
+#else
+    #define BENCHMARK_MEMORY_MODE_NAME "release"
+#endif
+
+// bumped whenever a key is renamed or its meaning changes, so tracked results stay comparable
+#define BENCHMARK_OUTPUT_FORMAT_VERSION 1
+
+#define BENCHMARK_ALLOCATION_INFO_REGION_SIZE (1024*1024*4)
+#define BENCHMARK_PAGES_REGION_SIZE (1024*1024*128)
+#define BENCHMARK_PAGE_SIZE (1024*1024*96)
+
+#define BENCHMARK_SLOT_COUNT 4096
+#define BENCHMARK_MAX_LATENCY_COUNT (1024*1024*4)
+
+#define BENCHMARK_STACK_ROUND_COUNT 64
+#define BENCHMARK_STACK_MIN_BYTE_SIZE 8
+#define BENCHMARK_STACK_MAX_BYTE_SIZE 1024
+
+#define BENCHMARK_CHURN_ITERATION_COUNT 1000000
+#define BENCHMARK_CHURN_MIN_BYTE_SIZE 8
+#define BENCHMARK_CHURN_MAX_BYTE_SIZE 4096
+
+// churn over the sizes most engine allocations have: keys, node structs, short strings
+#define BENCHMARK_SMALL_MIN_BYTE_SIZE 8
+#define BENCHMARK_SMALL_MAX_BYTE_SIZE 256
+
+// game_create_component style: a handful of component arrays grown one element at a time, interleaved
+#define BENCHMARK_GROW_ARRAY_COUNT 16
+#define BENCHMARK_GROW_ELEMENT_BYTE_SIZE 32
+#define BENCHMARK_GROW_ELEMENT_COUNT 1024
+#define BENCHMARK_GROW_ROUND_COUNT 8
+
+// frame shaped: short lived per frame scratch freed at the end of the frame, plus long lived entities
+// spawning and despawning underneath it
+#define BENCHMARK_FRAME_COUNT 2000
+#define BENCHMARK_FRAME_TRANSIENT_COUNT 256
+#define BENCHMARK_FRAME_TRANSIENT_MIN_BYTE_SIZE 16
+#define BENCHMARK_FRAME_TRANSIENT_MAX_BYTE_SIZE 512
+#define BENCHMARK_FRAME_ENTITY_TOGGLE_COUNT 16
+#define BENCHMARK_FRAME_ENTITY_MIN_BYTE_SIZE 32
+#define BENCHMARK_FRAME_ENTITY_MAX_BYTE_SIZE 256
+
+#define BENCHMARK_MAP_ITERATION_COUNT 10000000
+#define BENCHMARK_MAP_BATCH_COUNT 256
+#define BENCHMARK_MAP_BYTE_SIZE 64
+#define BENCHMARK_MAP_HEADER_BYTE_SIZE 1024
+
+// churn over two pages with a compaction pass after every round, next to a page nothing is ever allocated from;
+// the sizes straddle the slab limit, so slab slots sit among allocations with a header of their own
+#define BENCHMARK_REORDER_ROUND_COUNT 512
+#define BENCHMARK_REORDER_TOGGLE_COUNT 64
+#define BENCHMARK_REORDER_MIN_BYTE_SIZE 8
+#define BENCHMARK_REORDER_MAX_BYTE_SIZE 4096
+#define BENCHMARK_REORDER_PAGE_SIZE (1024*1024*8)
+#define BENCHMARK_REORDER_BUDGET_NS (1000*250)
+
+struct benchmark_slot
+{
+    union
+    {
+        const struct memory_allocation_key allocKey;
+        const struct memory_raw_allocation_key rawAllocKey;
+        void *dataPtr;
+    };
+
+    u64 byteSize;
+    b32 isActive;
+};
+
+struct benchmark_footprint
+{
+    // bytes the allocator holds on to for the live set, headers (and holes, when known) included
+    u64 footprintByteCount;
+    // free bytes trapped between live allocations, not the untouched tail; only the engine page can be walked
+    u64 holeByteCount;
+    b32 hasHoles;
+};
+
+struct benchmark_allocator
+{
+    const char *name;
+    const struct memory_context_key contextKey;
+    const struct memory_page_key pageKey;
+    b32 isManaged;
+
+    b32 (*alloc)(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr, u64 byteSize);
+    b32 (*realloc)(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr, u64 byteSize);
+    void (*free)(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr);
+    b32 (*get_footprint)(struct benchmark_allocator *allocatorPtr, const struct benchmark_slot *slotArr,
+        struct benchmark_footprint *outFootprintPtr);
+};
+
+struct benchmark_run
+{
+    struct benchmark_allocator *allocatorPtr;
+    struct benchmark_slot *slotArr;
+    u32 *latencyNSArr;
+    u64 latencyCount;
+    u64 opCount;
+    u64 failedCount;
+    u64 liveByteCount;
+    b32 hasFootprint;
+    b32 hasFragmentation;
+    real64 fragmentation;
+    real64 footprintRatio;
+};
+
+struct benchmark_workload
+{
+    const char *name;
+    void (*run)(struct benchmark_run *runPtr);
+    b32 isManagedOnly;
+};
+
+static u64
+benchmark_get_time_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (u64)ts.tv_sec*1000000000ull + (u64)ts.tv_nsec;
+}
+
+// xorshift, so that every allocator sees the exact same request stream regardless of libc
+static u64
+benchmark_next_random(u64 *statePtr)
+{
+    u64 x = *statePtr;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+
+    return (*statePtr = x);
+}
+
+static u64
+benchmark_next_random_byte_size(u64 *statePtr, u64 minByteSize, u64 maxByteSize)
+{
+    return minByteSize + benchmark_next_random(statePtr)%(maxByteSize - minByteSize);
+}
+
+/* engine (managed) allocator */
+
+static b32
+benchmark_engine_alloc(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr, u64 byteSize)
+{
+    return memory_alloc(&allocatorPtr->pageKey, byteSize, NULL, &slotPtr->allocKey) == MEMORY_OK;
+}
+
+static b32
+benchmark_engine_realloc(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr, u64 byteSize)
+{
+    return memory_realloc(&slotPtr->allocKey, byteSize, &slotPtr->allocKey) == MEMORY_OK;
+}
+
+static void
+benchmark_engine_free(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr)
+{
+    memory_free(&slotPtr->allocKey);
+}
+
+// walks the page's allocators in physical order; everything past the last live allocator is untouched tail
+static b32
+benchmark_engine_get_footprint(struct benchmark_allocator *allocatorPtr, const struct benchmark_slot *slotArr,
+    struct benchmark_footprint *outFootprintPtr)
+{
+    struct memory_context *contextPtr;
+
+    if (_memory_get_context((struct memory_context_key *)&allocatorPtr->contextKey, &contextPtr) != MEMORY_OK)
+    {
+        return B32_FALSE;
+    }
+
+    struct memory_page_header *pageHeaderPtr = (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset +
+        contextPtr->pagesRegionInfoArr[allocatorPtr->pageKey.pageId - 1].pageHeaderByteOffset];
+
+    p64 spanEndByteOffset = sizeof(struct memory_page_header);
+    u64 freeByteCount = 0;
+    u64 tailFreeByteCount = 0;
+
+    for (p64 allocatorByteOffset = sizeof(struct memory_page_header);
+        allocatorByteOffset != MEMORY_TLSF_NULL_BYTE_OFFSET;
+        allocatorByteOffset = _memory_get_next_physical_allocator_byte_offset(pageHeaderPtr, allocatorByteOffset))
+    {
+        struct memory_allocator *allocatorHeaderPtr = (void *)((u8 *)pageHeaderPtr + allocatorByteOffset);
+
+        if ((MEMORY_IS_ALLOCATOR_FREE(allocatorHeaderPtr)))
+        {
+            freeByteCount += allocatorHeaderPtr->byteSize;
+            tailFreeByteCount += allocatorHeaderPtr->byteSize;
+        }
+        else
+        {
+            spanEndByteOffset = allocatorByteOffset + sizeof(struct memory_allocator) + allocatorHeaderPtr->byteSize;
+            tailFreeByteCount = 0;
+        }
+    }
+
+    outFootprintPtr->footprintByteCount = spanEndByteOffset - sizeof(struct memory_page_header);
+    outFootprintPtr->holeByteCount = freeByteCount - tailFreeByteCount;
+    outFootprintPtr->hasHoles = B32_TRUE;
+
+    return B32_TRUE;
+}
+
+/* raw allocator */
+
+static b32
+benchmark_raw_alloc(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr, u64 byteSize)
+{
+    return memory_raw_alloc(&slotPtr->rawAllocKey, byteSize) == MEMORY_OK;
+}
+
+static b32
+benchmark_raw_realloc(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr, u64 byteSize)
+{
+    return memory_raw_realloc(&slotPtr->rawAllocKey, byteSize) == MEMORY_OK;
+}
+
+static void
+benchmark_raw_free(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr)
+{
+    memory_raw_free(&slotPtr->rawAllocKey);
+}
+
+/* glibc malloc */
+
+static b32
+benchmark_malloc_alloc(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr, u64 byteSize)
+{
+    return (slotPtr->dataPtr = malloc(byteSize)) != NULL;
+}
+
+static b32
+benchmark_malloc_realloc(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr, u64 byteSize)
+{
+    void *dataPtr = realloc(slotPtr->dataPtr, byteSize);
+
+    if (!dataPtr)
+    {
+        return B32_FALSE;
+    }
+
+    slotPtr->dataPtr = dataPtr;
+
+    return B32_TRUE;
+}
+
+static void
+benchmark_malloc_free(struct benchmark_allocator *allocatorPtr, struct benchmark_slot *slotPtr)
+{
+    free(slotPtr->dataPtr);
+}
+
+// glibc keeps a size word in front of every chunk and rounds the rest up; holes in its bins are not visible
+static b32
+benchmark_malloc_get_footprint(struct benchmark_allocator *allocatorPtr, const struct benchmark_slot *slotArr,
+    struct benchmark_footprint *outFootprintPtr)
+{
+    memset(outFootprintPtr, '\0', sizeof(struct benchmark_footprint));
+
+    for (u32 slotIndex = 0; slotIndex < BENCHMARK_SLOT_COUNT; ++slotIndex)
+    {
+        if (slotArr[slotIndex].isActive)
+        {
+            outFootprintPtr->footprintByteCount += sizeof(size_t) + malloc_usable_size(slotArr[slotIndex].dataPtr);
+        }
+    }
+
+    return B32_TRUE;
+}
+
+// raw allocations are malloc'd blocks behind the raw allocation table, so the table is part of the footprint too
+static b32
+benchmark_raw_get_footprint(struct benchmark_allocator *allocatorPtr, const struct benchmark_slot *slotArr,
+    struct benchmark_footprint *outFootprintPtr)
+{
+    memset(outFootprintPtr, '\0', sizeof(struct benchmark_footprint));
+
+    for (u32 slotIndex = 0; slotIndex < BENCHMARK_SLOT_COUNT; ++slotIndex)
+    {
+        if (slotArr[slotIndex].isActive)
+        {
+            outFootprintPtr->footprintByteCount += sizeof(size_t) + malloc_usable_size(
+                _memory_get_raw_allocator(&slotArr[slotIndex].rawAllocKey));
+        }
+    }
+
+    if (g_MEMORY_RAW_ALLOCATION_TABLE.slotArr)
+    {
+        outFootprintPtr->footprintByteCount += sizeof(size_t) + malloc_usable_size(
+            g_MEMORY_RAW_ALLOCATION_TABLE.slotArr);
+    }
+
+    return B32_TRUE;
+}
+
+/* timed operations */
+
+static void
+benchmark_run_push_latency(struct benchmark_run *runPtr, u64 latencyNS)
+{
+    if (runPtr->latencyCount < BENCHMARK_MAX_LATENCY_COUNT)
+    {
+        runPtr->latencyNSArr[runPtr->latencyCount++] = (latencyNS > UINT32_MAX) ? UINT32_MAX : (u32)latencyNS;
+    }
+
+    ++runPtr->opCount;
+}
+
+static void
+benchmark_run_alloc(struct benchmark_run *runPtr, struct benchmark_slot *slotPtr, u64 byteSize)
+{
+    u64 startNS = benchmark_get_time_ns();
+    b32 isOk = runPtr->allocatorPtr->alloc(runPtr->allocatorPtr, slotPtr, byteSize);
+    benchmark_run_push_latency(runPtr, benchmark_get_time_ns() - startNS);
+
+    if (isOk)
+    {
+        slotPtr->isActive = B32_TRUE;
+        slotPtr->byteSize = byteSize;
+        runPtr->liveByteCount += byteSize;
+    }
+    else
+    {
+        ++runPtr->failedCount;
+    }
+}
+
+static void
+benchmark_run_realloc(struct benchmark_run *runPtr, struct benchmark_slot *slotPtr, u64 byteSize)
+{
+    if (!slotPtr->isActive)
+    {
+        benchmark_run_alloc(runPtr, slotPtr, byteSize);
+
+        return;
+    }
+
+    u64 startNS = benchmark_get_time_ns();
+    b32 isOk = runPtr->allocatorPtr->realloc(runPtr->allocatorPtr, slotPtr, byteSize);
+    benchmark_run_push_latency(runPtr, benchmark_get_time_ns() - startNS);
+
+    if (isOk)
+    {
+        runPtr->liveByteCount += byteSize;
+        runPtr->liveByteCount -= slotPtr->byteSize;
+        slotPtr->byteSize = byteSize;
+    }
+    else
+    {
+        ++runPtr->failedCount;
+    }
+}
+
+static void
+benchmark_run_free(struct benchmark_run *runPtr, struct benchmark_slot *slotPtr)
+{
+    if (!slotPtr->isActive)
+    {
+        return;
+    }
+
+    u64 startNS = benchmark_get_time_ns();
+    runPtr->allocatorPtr->free(runPtr->allocatorPtr, slotPtr);
+    benchmark_run_push_latency(runPtr, benchmark_get_time_ns() - startNS);
+
+    runPtr->liveByteCount -= slotPtr->byteSize;
+    slotPtr->isActive = B32_FALSE;
+}
+
+// fragmentation is the share of the footprint lost to holes; the footprint ratio is footprint over the bytes
+// actually requested by the live set, so allocator headers and alignment show up there
+static void
+benchmark_run_sample_footprint(struct benchmark_run *runPtr)
+{
+    struct benchmark_footprint footprint;
+
+    if (!runPtr->allocatorPtr->get_footprint(runPtr->allocatorPtr, runPtr->slotArr, &footprint) || 
+        runPtr->liveByteCount == 0 || footprint.footprintByteCount == 0)
+    {
+        return;
+    }
+
+    runPtr->hasFootprint = B32_TRUE;
+    runPtr->footprintRatio = (real64)footprint.footprintByteCount/(real64)runPtr->liveByteCount;
+
+    if (footprint.hasHoles)
+    {
+        runPtr->hasFragmentation = B32_TRUE;
+        runPtr->fragmentation = (real64)footprint.holeByteCount/(real64)footprint.footprintByteCount;
+    }
+}
+
+/* workloads */
+
+static void
+benchmark_workload_stack(struct benchmark_run *runPtr, b32 isLIFO)
+{
+    u64 randomState = 0x9E3779B97F4A7C15ull;
+
+    for (u32 roundIndex = 0; roundIndex < BENCHMARK_STACK_ROUND_COUNT; ++roundIndex)
+    {
+        for (u32 slotIndex = 0; slotIndex < BENCHMARK_SLOT_COUNT; ++slotIndex)
+        {
+            benchmark_run_alloc(runPtr, &runPtr->slotArr[slotIndex], benchmark_next_random_byte_size(&randomState,
+                BENCHMARK_STACK_MIN_BYTE_SIZE, BENCHMARK_STACK_MAX_BYTE_SIZE));
+        }
+
+        for (u32 freeIndex = 0; freeIndex < BENCHMARK_SLOT_COUNT; ++freeIndex)
+        {
+            if (roundIndex == BENCHMARK_STACK_ROUND_COUNT - 1 && freeIndex == BENCHMARK_SLOT_COUNT/2)
+            {
+                benchmark_run_sample_footprint(runPtr);
+            }
+
+            benchmark_run_free(runPtr, &runPtr->slotArr[isLIFO ? (BENCHMARK_SLOT_COUNT - 1 - freeIndex) :
+                freeIndex]);
+        }
+    }
+}
+
+static void
+benchmark_workload_lifo(struct benchmark_run *runPtr)
+{
+    benchmark_workload_stack(runPtr, B32_TRUE);
+}
+
+static void
+benchmark_workload_fifo(struct benchmark_run *runPtr)
+{
+    benchmark_workload_stack(runPtr, B32_FALSE);
+}
+
+static void
+benchmark_workload_random(struct benchmark_run *runPtr, u64 minByteSize, u64 maxByteSize)
+{
+    u64 randomState = 0x9E3779B97F4A7C15ull;
+
+    for (u64 iteration = 0; iteration < BENCHMARK_CHURN_ITERATION_COUNT; ++iteration)
+    {
+        struct benchmark_slot *slotPtr = &runPtr->slotArr[benchmark_next_random(&randomState)%BENCHMARK_SLOT_COUNT];
+
+        if (slotPtr->isActive)
+        {
+            benchmark_run_free(runPtr, slotPtr);
+        }
+        else
+        {
+            benchmark_run_alloc(runPtr, slotPtr, benchmark_next_random_byte_size(&randomState, minByteSize, 
+                maxByteSize));
+        }
+    }
+
+    benchmark_run_sample_footprint(runPtr);
+}
+
+static void
+benchmark_workload_churn(struct benchmark_run *runPtr)
+{
+    benchmark_workload_random(runPtr, BENCHMARK_CHURN_MIN_BYTE_SIZE, BENCHMARK_CHURN_MAX_BYTE_SIZE);
+}
+
+static void
+benchmark_workload_small(struct benchmark_run *runPtr)
+{
+    benchmark_workload_random(runPtr, BENCHMARK_SMALL_MIN_BYTE_SIZE, BENCHMARK_SMALL_MAX_BYTE_SIZE);
+}
+
+static void
+benchmark_workload_grow(struct benchmark_run *runPtr)
+{
+    for (u32 roundIndex = 0; roundIndex < BENCHMARK_GROW_ROUND_COUNT; ++roundIndex)
+    {
+        for (u32 elementCount = 1; elementCount <= BENCHMARK_GROW_ELEMENT_COUNT; ++elementCount)
+        {
+            for (u32 arrayIndex = 0; arrayIndex < BENCHMARK_GROW_ARRAY_COUNT; ++arrayIndex)
+            {
+                benchmark_run_realloc(runPtr, &runPtr->slotArr[arrayIndex],
+                    (u64)elementCount*BENCHMARK_GROW_ELEMENT_BYTE_SIZE);
+            }
+        }
+
+        if (roundIndex == BENCHMARK_GROW_ROUND_COUNT - 1)
+        {
+            benchmark_run_sample_footprint(runPtr);
+        }
+
+        for (u32 arrayIndex = 0; arrayIndex < BENCHMARK_GROW_ARRAY_COUNT; ++arrayIndex)
+        {
+            benchmark_run_free(runPtr, &runPtr->slotArr[arrayIndex]);
+        }
+    }
+}
+
+// entities live in the upper half of the slots, per frame scratch in the lower half
+static void
+benchmark_workload_frame(struct benchmark_run *runPtr)
+{
+    u64 randomState = 0x9E3779B97F4A7C15ull;
+
+    struct benchmark_slot *transientSlotArr = runPtr->slotArr;
+    struct benchmark_slot *entitySlotArr = &runPtr->slotArr[BENCHMARK_SLOT_COUNT/2];
+
+    for (u32 frameIndex = 0; frameIndex < BENCHMARK_FRAME_COUNT; ++frameIndex)
+    {
+        for (u32 toggleIndex = 0; toggleIndex < BENCHMARK_FRAME_ENTITY_TOGGLE_COUNT; ++toggleIndex)
+        {
+            struct benchmark_slot *slotPtr = &entitySlotArr[benchmark_next_random(&randomState)%
+                (BENCHMARK_SLOT_COUNT/2)];
+
+            if (slotPtr->isActive)
+            {
+                benchmark_run_free(runPtr, slotPtr);
+            }
+            else
+            {
+                benchmark_run_alloc(runPtr, slotPtr, benchmark_next_random_byte_size(&randomState,
+                    BENCHMARK_FRAME_ENTITY_MIN_BYTE_SIZE, BENCHMARK_FRAME_ENTITY_MAX_BYTE_SIZE));
+            }
+        }
+
+        for (u32 transientIndex = 0; transientIndex < BENCHMARK_FRAME_TRANSIENT_COUNT; ++transientIndex)
+        {
+            benchmark_run_alloc(runPtr, &transientSlotArr[transientIndex], benchmark_next_random_byte_size(
+                &randomState, BENCHMARK_FRAME_TRANSIENT_MIN_BYTE_SIZE, BENCHMARK_FRAME_TRANSIENT_MAX_BYTE_SIZE));
+        }
+
+        if (frameIndex == BENCHMARK_FRAME_COUNT - 1)
+        {
+            benchmark_run_sample_footprint(runPtr);
+        }
+
+        for (u32 transientIndex = BENCHMARK_FRAME_TRANSIENT_COUNT; transientIndex > 0; --transientIndex)
+        {
+            benchmark_run_free(runPtr, &transientSlotArr[transientIndex - 1]);
+        }
+    }
+}
+
+// map + touch + unmap over a spread of live allocations; a single map is far below the clock resolution, so
+// every latency sample is the average over a batch. Half the allocations are slab slots and half have a header of
+// their own, and a map or unmap the debug checks reject counts as failed
+static void
+benchmark_workload_map_unmap(struct benchmark_run *runPtr)
+{
+    for (u32 slotIndex = 0; slotIndex < BENCHMARK_SLOT_COUNT; ++slotIndex)
+    {
+        struct benchmark_slot *slotPtr = &runPtr->slotArr[slotIndex];
+        u64 byteSize = (slotIndex & 1) ? BENCHMARK_MAP_HEADER_BYTE_SIZE : BENCHMARK_MAP_BYTE_SIZE;
+
+        if (!runPtr->allocatorPtr->alloc(runPtr->allocatorPtr, slotPtr, byteSize))
+        {
+            ++runPtr->failedCount;
+
+            return;
+        }
+
+        slotPtr->isActive = B32_TRUE;
+        slotPtr->byteSize = byteSize;
+    }
+
+    u64 checksum = 0;
+
+    for (u64 iteration = 0; iteration < BENCHMARK_MAP_ITERATION_COUNT; iteration += BENCHMARK_MAP_BATCH_COUNT)
+    {
+        u64 startNS = benchmark_get_time_ns();
+
+        for (u64 batchIndex = iteration; batchIndex < iteration + BENCHMARK_MAP_BATCH_COUNT; ++batchIndex)
+        {
+            u8 *dataPtr;
+
+            if (memory_map_alloc(&runPtr->slotArr[(batchIndex*2654435761ull)%BENCHMARK_SLOT_COUNT].allocKey,
+                (void **)&dataPtr) != MEMORY_OK)
+            {
+                ++runPtr->failedCount;
+
+                continue;
+            }
+
+            checksum += ++dataPtr[batchIndex%BENCHMARK_MAP_BYTE_SIZE];
+
+            if (memory_unmap_alloc((void **)&dataPtr) != MEMORY_OK)
+            {
+                ++runPtr->failedCount;
+            }
+        }
+
+        u64 batchNS = benchmark_get_time_ns() - startNS;
+
+        for (u32 batchIndex = 0; batchIndex < BENCHMARK_MAP_BATCH_COUNT; ++batchIndex)
+        {
+            benchmark_run_push_latency(runPtr, batchNS/BENCHMARK_MAP_BATCH_COUNT);
+        }
+    }
+
+    // keeps the touched bytes observable
+    if (checksum == 0)
+    {
+        fprintf(stderr, "benchmark(%d): Map checksum is zero.\n", __LINE__);
+    }
+}
+
+static b32
+benchmark_fill_slot(struct benchmark_slot *slotPtr, u8 value)
+{
+    u8 *dataPtr;
+
+    if (memory_map_alloc(&slotPtr->allocKey, (void **)&dataPtr) != MEMORY_OK)
+    {
+        return B32_FALSE;
+    }
+
+    memset(dataPtr, value, slotPtr->byteSize);
+
+    return memory_unmap_alloc((void **)&dataPtr) == MEMORY_OK;
+}
+
+static b32
+benchmark_check_slot(struct benchmark_slot *slotPtr, u8 value)
+{
+    u8 *dataPtr;
+
+    if (memory_map_alloc(&slotPtr->allocKey, (void **)&dataPtr) != MEMORY_OK)
+    {
+        return B32_FALSE;
+    }
+
+    b32 isOk = B32_TRUE;
+
+    for (u64 byteIndex = 0; byteIndex < slotPtr->byteSize; ++byteIndex)
+    {
+        isOk &= (dataPtr[byteIndex] == value);
+    }
+
+    return (memory_unmap_alloc((void **)&dataPtr) == MEMORY_OK) && isOk;
+}
+
+// a page nothing was allocated from has no allocators yet, and compaction has to leave it that way
+static b32
+benchmark_is_page_untouched(const struct memory_page_key *pageKeyPtr)
+{
+    struct memory_context *contextPtr;
+
+    if (_memory_get_context((struct memory_context_key *)&pageKeyPtr->contextKey, &contextPtr) != MEMORY_OK)
+    {
+        return B32_FALSE;
+    }
+
+    struct memory_page_header *pageHeaderPtr = (void *)&contextPtr->heap[contextPtr->pagesRegionByteOffset + 
+        contextPtr->pagesRegionInfoArr[pageKeyPtr->pageId - 1].pageHeaderByteOffset];
+
+    return (pageHeaderPtr->activeAllocatorCount == 0) && (pageHeaderPtr->freeAllocatorCount == 0);
+}
+
+// benchmark_run_alloc, on a page other than the allocator's own
+static void
+benchmark_run_alloc_on_page(struct benchmark_run *runPtr, const struct memory_page_key *pageKeyPtr, 
+    struct benchmark_slot *slotPtr, u64 byteSize)
+{
+    u64 startNS = benchmark_get_time_ns();
+    b32 isOk = memory_alloc(pageKeyPtr, byteSize, NULL, &slotPtr->allocKey) == MEMORY_OK;
+    benchmark_run_push_latency(runPtr, benchmark_get_time_ns() - startNS);
+
+    if (isOk)
+    {
+        slotPtr->isActive = B32_TRUE;
+        slotPtr->byteSize = byteSize;
+        runPtr->liveByteCount += byteSize;
+    }
+    else
+    {
+        ++runPtr->failedCount;
+    }
+}
+
+// every live allocation carries its slot index; one that moved wrong, or no longer maps, counts as failed. Odd 
+// slots live on the second page
+static void
+benchmark_workload_reorder(struct benchmark_run *runPtr)
+{
+    u64 randomState = 0x9E3779B97F4A7C15ull;
+
+    const struct memory_page_key sidePageKey = { 0 };
+    const struct memory_page_key emptyPageKey = { 0 };
+
+    if ((memory_alloc_page(&runPtr->allocatorPtr->contextKey, BENCHMARK_REORDER_PAGE_SIZE, &sidePageKey) != 
+        MEMORY_OK) || (memory_alloc_page(&runPtr->allocatorPtr->contextKey, BENCHMARK_REORDER_PAGE_SIZE, 
+        &emptyPageKey) != MEMORY_OK))
+    {
+        ++runPtr->failedCount;
+
+        return;
+    }
+
+    for (u32 roundIndex = 0; roundIndex < BENCHMARK_REORDER_ROUND_COUNT; ++roundIndex)
+    {
+        for (u32 toggleIndex = 0; toggleIndex < BENCHMARK_REORDER_TOGGLE_COUNT; ++toggleIndex)
+        {
+            u32 slotIndex = (u32)(benchmark_next_random(&randomState)%BENCHMARK_SLOT_COUNT);
+            struct benchmark_slot *slotPtr = &runPtr->slotArr[slotIndex];
+
+            if (slotPtr->isActive)
+            {
+                benchmark_run_free(runPtr, slotPtr);
+
+                continue;
+            }
+
+            u64 byteSize = benchmark_next_random_byte_size(&randomState, BENCHMARK_REORDER_MIN_BYTE_SIZE, 
+                BENCHMARK_REORDER_MAX_BYTE_SIZE);
+
+            if (slotIndex & 1)
+            {
+                benchmark_run_alloc_on_page(runPtr, &sidePageKey, slotPtr, byteSize);
+            }
+            else 
+            {
+                benchmark_run_alloc(runPtr, slotPtr, byteSize);
+            }
+
+            if (slotPtr->isActive && !benchmark_fill_slot(slotPtr, (u8)slotIndex))
+            {
+                ++runPtr->failedCount;
+            }
+        }
+
+        u64 startNS = benchmark_get_time_ns();
+        memory_pages_reorder(&runPtr->allocatorPtr->contextKey, BENCHMARK_REORDER_BUDGET_NS);
+        benchmark_run_push_latency(runPtr, benchmark_get_time_ns() - startNS);
+
+        if (!benchmark_is_page_untouched(&emptyPageKey))
+        {
+            ++runPtr->failedCount;
+        }
+
+        for (u32 slotIndex = 0; slotIndex < BENCHMARK_SLOT_COUNT; ++slotIndex)
+        {
+            if (runPtr->slotArr[slotIndex].isActive && !benchmark_check_slot(&runPtr->slotArr[slotIndex], 
+                (u8)slotIndex))
+            {
+                ++runPtr->failedCount;
+            }
+        }
+    }
+
+    // no footprint sample: the live set spans two pages, and the footprint only walks the allocator's own
+    for (u32 slotIndex = 1; slotIndex < BENCHMARK_SLOT_COUNT; slotIndex += 2)
+    {
+        benchmark_run_free(runPtr, &runPtr->slotArr[slotIndex]);
+    }
+
+    memory_free_page(&sidePageKey);
+    memory_free_page(&emptyPageKey);
+}
+
+static const struct benchmark_workload g_BENCHMARK_WORKLOAD_ARR[] =
+{
+    { "lifo", benchmark_workload_lifo, B32_FALSE },
+    { "fifo", benchmark_workload_fifo, B32_FALSE },
+    { "churn", benchmark_workload_churn, B32_FALSE },
+    { "small", benchmark_workload_small, B32_FALSE },
+    { "grow", benchmark_workload_grow, B32_FALSE },
+    { "frame", benchmark_workload_frame, B32_FALSE },
+    { "map_unmap", benchmark_workload_map_unmap, B32_TRUE },
+    { "reorder", benchmark_workload_reorder, B32_TRUE }, 
+};
+
+/* driver */
+
+static int
+benchmark_compare_u32(const void *lhsPtr, const void *rhsPtr)
+{
+    u32 lhs = *(const u32 *)lhsPtr;
+    u32 rhs = *(const u32 *)rhsPtr;
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static u32
+benchmark_get_percentile(const u32 *sortedArr, u64 count, u32 percentile)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    return sortedArr[((count - 1)*percentile)/100];
+}
+
+// every engine workload gets a fresh page so that one pattern's leftovers never skew the next
+static b32
+benchmark_allocator_reset(struct benchmark_allocator *allocatorPtr)
+{
+    if (!allocatorPtr->isManaged)
+    {
+        return B32_TRUE;
+    }
+
+    if (allocatorPtr->pageKey.pageId != MEMORY_SHORT_ID_NULL)
+    {
+        memory_free_page(&allocatorPtr->pageKey);
+    }
+
+    return memory_alloc_page(&allocatorPtr->contextKey, BENCHMARK_PAGE_SIZE, &allocatorPtr->pageKey) == MEMORY_OK;
+}
+
+static void
+benchmark_print_real(char *bufferStr, size_t bufferByteCount, b32 hasValue, real64 value)
+{
+    if (hasValue)
+    {
+        snprintf(bufferStr, bufferByteCount, "%.4f", value);
+    }
+    else 
+    {
+        snprintf(bufferStr, bufferByteCount, "na");
+    }
+}
+
+static b32
+benchmark_run_workload(const struct benchmark_workload *workloadPtr, struct benchmark_allocator *allocatorPtr,
+    struct benchmark_slot *slotArr, u32 *latencyNSArr)
+{
+    if (!benchmark_allocator_reset(allocatorPtr))
+    {
+        fprintf(stderr, "benchmark(%d): Failure to reset the '%s' allocator.\n", __LINE__, allocatorPtr->name);
+
+        return B32_FALSE;
+    }
+
+    memset(slotArr, '\0', sizeof(struct benchmark_slot)*BENCHMARK_SLOT_COUNT);
+
+    struct benchmark_run run = { 0 };
+    run.allocatorPtr = allocatorPtr;
+    run.slotArr = slotArr;
+    run.latencyNSArr = latencyNSArr;
+
+    u64 startNS = benchmark_get_time_ns();
+
+    workloadPtr->run(&run);
+
+    u64 elapsedNS = benchmark_get_time_ns() - startNS;
+
+    for (u32 slotIndex = 0; slotIndex < BENCHMARK_SLOT_COUNT; ++slotIndex)
+    {
+        if (slotArr[slotIndex].isActive)
+        {
+            allocatorPtr->free(allocatorPtr, &slotArr[slotIndex]);
+        }
+    }
+
+    qsort(latencyNSArr, run.latencyCount, sizeof(u32), benchmark_compare_u32);
+
+    char fragmentationStr[32];
+    char footprintRatioStr[32];
+
+    benchmark_print_real(fragmentationStr, sizeof(fragmentationStr), run.hasFragmentation, run.fragmentation);
+    benchmark_print_real(footprintRatioStr, sizeof(footprintRatioStr), run.hasFootprint, run.footprintRatio);
+
+    printf("format=%d allocator=%s policy=%s mode=%s bench=%s ops=%llu failed=%llu total_ms=%.3f "
+        "mops_per_sec=%.3f p50_ns=%u p99_ns=%u frag=%s footprint_ratio=%s\n", BENCHMARK_OUTPUT_FORMAT_VERSION,
+        allocatorPtr->name, BENCHMARK_ALLOC_POLICY_NAME, BENCHMARK_MEMORY_MODE_NAME, workloadPtr->name,
+        (unsigned long long)run.opCount, (unsigned long long)run.failedCount, (real64)elapsedNS/1000000.0,
+        (elapsedNS) ? ((real64)run.opCount*1000.0)/(real64)elapsedNS : 0.0,
+        benchmark_get_percentile(latencyNSArr, run.latencyCount, 50),
+        benchmark_get_percentile(latencyNSArr, run.latencyCount, 99), fragmentationStr, footprintRatioStr);
+
+    fflush(stdout);
+
+    return B32_TRUE;
+}
+
+// usage: benchmark [workload...]; runs every workload when none are named. output is one line of key=value
+// pairs per (workload, allocator), meant to be grepped or loaded as is
+int
+main(int argc, char **argv)
+{
+    utils_set_random_seed(0);
+
+    struct benchmark_allocator allocatorArr[] =
+    {
+        { .name = "engine", .isManaged = B32_TRUE, .alloc = benchmark_engine_alloc,
+            .realloc = benchmark_engine_realloc, .free = benchmark_engine_free,
+            .get_footprint = benchmark_engine_get_footprint },
+        { .name = "raw", .isManaged = B32_FALSE, .alloc = benchmark_raw_alloc,
+            .realloc = benchmark_raw_realloc, .free = benchmark_raw_free,
+            .get_footprint = benchmark_raw_get_footprint },
+        { .name = "malloc", .isManaged = B32_FALSE, .alloc = benchmark_malloc_alloc,
+            .realloc = benchmark_malloc_realloc, .free = benchmark_malloc_free,
+            .get_footprint = benchmark_malloc_get_footprint },
+    };
+
+    if (memory_create_context(BENCHMARK_ALLOCATION_INFO_REGION_SIZE, BENCHMARK_PAGES_REGION_SIZE,
+        &allocatorArr[0].contextKey) != MEMORY_OK)
+    {
+        fprintf(stderr, "benchmark(%d): Failure to create memory context.\n", __LINE__);
+
+        return -1;
+    }
+
+    struct benchmark_slot *slotArr = calloc(BENCHMARK_SLOT_COUNT, sizeof(struct benchmark_slot));
+    u32 *latencyNSArr = malloc(sizeof(u32)*BENCHMARK_MAX_LATENCY_COUNT);
+
+    if (!slotArr || !latencyNSArr)
+    {
+        fprintf(stderr, "benchmark(%d): Failure to allocate benchmark state.\n", __LINE__);
+
+        return -1;
+    }
+
+    for (u32 workloadIndex = 0; workloadIndex < sizeof(g_BENCHMARK_WORKLOAD_ARR)/sizeof(g_BENCHMARK_WORKLOAD_ARR[0]); ++workloadIndex)
+    {
+        const struct benchmark_workload *workloadPtr = &g_BENCHMARK_WORKLOAD_ARR[workloadIndex];
+
+        if (argc > 1)
+        {
+            b32 isSelected = B32_FALSE;
+
+            for (int argIndex = 1; argIndex < argc; ++argIndex)
+            {
+                isSelected |= (strcmp(argv[argIndex], workloadPtr->name) == 0);
+            }
+
+            if (!isSelected)
+            {
+                continue;
+            }
+        }
+
+        for (u32 allocatorIndex = 0; allocatorIndex < sizeof(allocatorArr)/sizeof(allocatorArr[0]); ++allocatorIndex)
+        {
+            if (workloadPtr->isManagedOnly && !allocatorArr[allocatorIndex].isManaged)
+            {
+                continue;
+            }
+
+            if (!benchmark_run_workload(workloadPtr, &allocatorArr[allocatorIndex], slotArr, latencyNSArr))
+            {
+                return -1;
+            }
+        }
+    }
+
+    free(latencyNSArr);
+    free(slotArr);
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/sh
+
+# Headless basic_dict benchmarks (no SDL/GL). The engine sources are built unity style, exactly like the engine
+# itself, once with and once without MEMORY_DEBUG.
+#
+# Each binary runs the id (integer ids, like physics_id) and name (short strings, like asset and layer names)
+# key sets at 100, 10k and 1M entries ("./app.sh --run name 10000" runs a subset), and prints one line of
+# key=value pairs per insert, hit, hit_id (names only), miss and remove phase. results.log keeps every run.
+
+if [ "$1" == "--build" ] 
+then
+    echo "Selected User Option: 'build'" | ts '[%Y-%m-%d %H:%M:%S]'
+    echo 
+    rm -rf ./build
+    mkdir ./build
+    pushd ./build
+
+    gcc -std=c11 -O2 -D_GNU_SOURCE -o dict_benchmark ../src/main.c -lm -lpthread 2>&1 | \
+        ts '[%Y-%m-%d %H:%M:%S]' >& ./build.log
+    gcc -std=c11 -O2 -D_GNU_SOURCE -DMEMORY_DEBUG -o dict_benchmark_debug ../src/main.c -lm -lpthread 2>&1 | \
+        ts '[%Y-%m-%d %H:%M:%S]' >> ./build.log
+
+    cat build.log
+
+    popd
+else
+    echo "Selected User Option: 'run'" | ts '[%Y-%m-%d %H:%M:%S]'
+    [ $# -gt 0 ] && shift
+    ./build/dict_benchmark "$@" 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' | tee -a ./results.log
+    ./build/dict_benchmark_debug "$@" 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' | tee -a ./results.log
+fi
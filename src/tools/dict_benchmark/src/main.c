@@ -0,0 +1,385 @@
+#include "../../../engine/types.h"
+#include "../../../engine/memory.h"
+#include "../../../engine/utils.h"
+#include "../../../engine/basic_dict.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../../engine/memory.c"
+#include "../../../engine/utils.c"
+#include "../../../engine/basic_dict.c"
+
+#if defined(MEMORY_DEBUG)
+    #define BENCHMARK_MEMORY_MODE_NAME "debug"
+#else
+    #define BENCHMARK_MEMORY_MODE_NAME "release"
+#endif
+
+// bumped whenever a key is renamed or its meaning changes, so tracked results stay comparable
+#define BENCHMARK_OUTPUT_FORMAT_VERSION 2
+
+#define BENCHMARK_ALLOCATION_INFO_REGION_SIZE (1024*1024*64)
+#define BENCHMARK_PAGES_REGION_SIZE ((u64)1024*1024*1024*2)
+#define BENCHMARK_PAGE_SIZE ((u64)1024*1024*1024)
+
+// small dicts are rebuilt until every phase has done about this many operations
+#define BENCHMARK_TARGET_OP_COUNT 1000000
+#define BENCHMARK_MAX_NAME_LENGTH 32
+
+static const u32 g_BENCHMARK_ENTRY_COUNT_ARR[] = { 100, 10000, 1000000 };
+
+struct benchmark_key_set
+{
+    const char *name;
+    basic_dict_hash_func hashFunc;
+    u64 keyByteSize;
+    // the key for entry 'keyIndex'; misses use indices past the entry count
+    void *(*get_key)(struct benchmark_key_set *keySetPtr, u32 keyIndex);
+    u8 *keyArr;
+    // the string id of every name, as UTILS_STRING_ID would make it; NULL for the id keys
+    struct utils_string_id *stringIdArr;
+};
+
+struct benchmark_phase
+{
+    const char *name;
+    u64 opCount;
+    u64 failedCount;
+    u64 elapsedNS;
+    // the slowest single operation, for the phases that time each one
+    u64 maxOpNS;
+};
+
+enum benchmark_phase_type
+{
+    BENCHMARK_PHASE_INSERT,
+    BENCHMARK_PHASE_HIT,
+    // the hits again, looked up by string id, so none of them hashes the name
+    BENCHMARK_PHASE_HIT_ID,
+    BENCHMARK_PHASE_MISS,
+    BENCHMARK_PHASE_REMOVE,
+    BENCHMARK_PHASE_TYPE_COUNT
+};
+
+static u64
+benchmark_get_time_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (u64)ts.tv_sec*1000000000ull + (u64)ts.tv_nsec;
+}
+
+/* key sets */
+
+// physics_id style: small, dense integer ids
+static b32
+benchmark_id_hash_func(struct basic_dict *dictPtr, void *keyPtr, utils_hash *outHashPtr)
+{
+    *outHashPtr = (utils_hash)(*(u32 *)keyPtr)*0x9E3779B97F4A7C15ull;
+
+    return B32_TRUE;
+}
+
+static void *
+benchmark_id_get_key(struct benchmark_key_set *keySetPtr, u32 keyIndex)
+{
+    return &((u32 *)keySetPtr->keyArr)[keyIndex];
+}
+
+// asset, layer and config variable style: short names, with the default string hashing and key copy
+static void *
+benchmark_name_get_key(struct benchmark_key_set *keySetPtr, u32 keyIndex)
+{
+    return &keySetPtr->keyArr[(u64)keyIndex*BENCHMARK_MAX_NAME_LENGTH];
+}
+
+static b32
+benchmark_key_set_create(struct benchmark_key_set *keySetPtr, u32 keyCount)
+{
+    if (keySetPtr->get_key == benchmark_id_get_key)
+    {
+        if (!(keySetPtr->keyArr = malloc(sizeof(u32)*keyCount)))
+        {
+            return B32_FALSE;
+        }
+
+        for (u32 keyIndex = 0; keyIndex < keyCount; ++keyIndex)
+        {
+            ((u32 *)keySetPtr->keyArr)[keyIndex] = keyIndex + 1;
+        }
+
+        return B32_TRUE;
+    }
+
+    if (!(keySetPtr->keyArr = malloc((u64)BENCHMARK_MAX_NAME_LENGTH*keyCount)))
+    {
+        return B32_FALSE;
+    }
+
+    if (!(keySetPtr->stringIdArr = malloc(sizeof(struct utils_string_id)*keyCount)))
+    {
+        free(keySetPtr->keyArr);
+
+        return B32_FALSE;
+    }
+
+    for (u32 keyIndex = 0; keyIndex < keyCount; ++keyIndex)
+    {
+        snprintf((char *)benchmark_name_get_key(keySetPtr, keyIndex), BENCHMARK_MAX_NAME_LENGTH, "entity_%u",
+            keyIndex);
+        utils_generate_string_id(benchmark_name_get_key(keySetPtr, keyIndex), &keySetPtr->stringIdArr[keyIndex]);
+    }
+
+    return B32_TRUE;
+}
+
+/* driver */
+
+// one dict lifetime: insert every entry, look every one of them up, look up as many absent keys, then remove
+// every entry again. Lookups go in a scattered order, so the large dicts don't get to walk memory linearly
+static b32
+benchmark_run_round(struct benchmark_key_set *keySetPtr, const struct memory_page_key *pageKeyPtr,
+    u32 entryCount, struct benchmark_phase *phaseArr)
+{
+    const struct memory_allocation_key dictKey;
+
+    if (!(basic_dict_create(pageKeyPtr, keySetPtr->hashFunc, NULL,
+        utils_generate_next_prime_number(100), &keySetPtr->keyByteSize, NULL, &dictKey)))
+    {
+        fprintf(stderr, "benchmark(%d): Failure to create a dict.\n", __LINE__);
+
+        return B32_FALSE;
+    }
+
+    // the key index stride is odd, so it visits every entry once
+    u64 strideIndex = 2654435761ull;
+
+    for (u32 phaseIndex = 0; phaseIndex < BENCHMARK_PHASE_TYPE_COUNT; ++phaseIndex)
+    {
+        struct benchmark_phase *phasePtr = &phaseArr[phaseIndex];
+
+        if ((phaseIndex == BENCHMARK_PHASE_HIT_ID) && !keySetPtr->stringIdArr)
+        {
+            continue;
+        }
+        // a resize happens inside one insert or remove, so those are timed one by one as well; the clock reads
+        // are part of their totals
+        b32 isTimingEachOp = ((phaseIndex == BENCHMARK_PHASE_INSERT) || (phaseIndex == BENCHMARK_PHASE_REMOVE)) ?
+            B32_TRUE : B32_FALSE;
+        u64 startNS = benchmark_get_time_ns();
+
+        for (u32 opIndex = 0; opIndex < entryCount; ++opIndex)
+        {
+            u32 keyIndex = (phaseIndex == BENCHMARK_PHASE_INSERT) ? opIndex : (u32)((opIndex*strideIndex)%entryCount);
+            b32 isResult = B32_FALSE;
+            u64 opStartNS = isTimingEachOp ? benchmark_get_time_ns() : 0;
+
+            switch (phaseIndex)
+            {
+                case BENCHMARK_PHASE_INSERT:
+                {
+                    p64 dataByteOffset = keyIndex;
+
+                    isResult = basic_dict_push_data(&dictKey, keySetPtr->get_key(keySetPtr, keyIndex),
+                        &dataByteOffset, NULL, NULL);
+                } break;
+
+                case BENCHMARK_PHASE_HIT:
+                {
+                    p64 dataByteOffset;
+
+                    isResult = basic_dict_get_data(&dictKey, keySetPtr->get_key(keySetPtr, keyIndex),
+                        &dataByteOffset, NULL, NULL) && (dataByteOffset == keyIndex);
+                } break;
+
+                case BENCHMARK_PHASE_HIT_ID:
+                {
+                    p64 dataByteOffset;
+
+                    isResult = basic_dict_get_data_by_id(&dictKey, &keySetPtr->stringIdArr[keyIndex],
+                        &dataByteOffset, NULL, NULL) && (dataByteOffset == keyIndex);
+                } break;
+
+                case BENCHMARK_PHASE_MISS:
+                {
+                    isResult = !basic_dict_get_is_found(&dictKey, keySetPtr->get_key(keySetPtr,
+                        entryCount + keyIndex));
+                } break;
+
+                case BENCHMARK_PHASE_REMOVE:
+                {
+                    isResult = basic_dict_remove(&dictKey, keySetPtr->get_key(keySetPtr, keyIndex));
+                } break;
+            }
+
+            phasePtr->failedCount += !isResult;
+
+            if (isTimingEachOp)
+            {
+                u64 opElapsedNS = benchmark_get_time_ns() - opStartNS;
+
+                if (opElapsedNS > phasePtr->maxOpNS)
+                {
+                    phasePtr->maxOpNS = opElapsedNS;
+                }
+            }
+        }
+
+        phasePtr->elapsedNS += benchmark_get_time_ns() - startNS;
+        phasePtr->opCount += entryCount;
+    }
+
+    basic_dict_destroy(&dictKey);
+
+    return B32_TRUE;
+}
+
+static b32
+benchmark_run_key_set(struct benchmark_key_set *keySetPtr, const struct memory_context_key *contextKeyPtr,
+    u32 entryCount)
+{
+    const struct memory_page_key pageKey;
+
+    if (memory_alloc_page(contextKeyPtr, BENCHMARK_PAGE_SIZE, &pageKey) != MEMORY_OK)
+    {
+        fprintf(stderr, "benchmark(%d): Failure to allocate the dict page.\n", __LINE__);
+
+        return B32_FALSE;
+    }
+
+    struct benchmark_phase phaseArr[BENCHMARK_PHASE_TYPE_COUNT] =
+    {
+        { .name = "insert" }, { .name = "hit" }, { .name = "hit_id" }, { .name = "miss" }, { .name = "remove" }
+    };
+
+    u32 roundCount = (entryCount < BENCHMARK_TARGET_OP_COUNT) ? BENCHMARK_TARGET_OP_COUNT/entryCount : 1;
+
+    for (u32 roundIndex = 0; roundIndex < roundCount; ++roundIndex)
+    {
+        if (!benchmark_run_round(keySetPtr, &pageKey, entryCount, phaseArr))
+        {
+            memory_free_page(&pageKey);
+
+            return B32_FALSE;
+        }
+    }
+
+    memory_free_page(&pageKey);
+
+    for (u32 phaseIndex = 0; phaseIndex < BENCHMARK_PHASE_TYPE_COUNT; ++phaseIndex)
+    {
+        const struct benchmark_phase *phasePtr = &phaseArr[phaseIndex];
+
+        if (!phasePtr->opCount)
+        {
+            continue;
+        }
+
+        printf("format=%d dict=flat mode=%s keys=%s entries=%u bench=%s ops=%llu failed=%llu total_ms=%.3f "
+            "ns_per_op=%.1f mops_per_sec=%.3f max_op_us=%.1f\n", BENCHMARK_OUTPUT_FORMAT_VERSION,
+            BENCHMARK_MEMORY_MODE_NAME, keySetPtr->name, entryCount, phasePtr->name,
+            (unsigned long long)phasePtr->opCount, (unsigned long long)phasePtr->failedCount, (real64)phasePtr->elapsedNS/1000000.0,
+            (phasePtr->opCount) ? (real64)phasePtr->elapsedNS/(real64)phasePtr->opCount : 0.0,
+            (phasePtr->elapsedNS) ? ((real64)phasePtr->opCount*1000.0)/(real64)phasePtr->elapsedNS : 0.0,
+            (real64)phasePtr->maxOpNS/1000.0);
+    }
+
+    fflush(stdout);
+
+    return B32_TRUE;
+}
+
+// usage: dict_benchmark [id|name...] [entry count...]; runs every key set at 100, 10k and 1M entries when
+// none are named. output is one line of key=value pairs per (key set, entry count, phase)
+int
+main(int argc, char **argv)
+{
+    utils_set_random_seed(0);
+
+    struct benchmark_key_set keySetArr[] =
+    {
+        { .name = "id", .hashFunc = benchmark_id_hash_func, .keyByteSize = sizeof(u32),
+            .get_key = benchmark_id_get_key },
+        { .name = "name", .get_key = benchmark_name_get_key },
+    };
+
+    const struct memory_context_key contextKey = {0};
+
+    if (memory_create_context(BENCHMARK_ALLOCATION_INFO_REGION_SIZE, BENCHMARK_PAGES_REGION_SIZE,
+        &contextKey) != MEMORY_OK)
+    {
+        fprintf(stderr, "benchmark(%d): Failure to create memory context.\n", __LINE__);
+
+        return -1;
+    }
+
+    u32 entryCountArr[sizeof(g_BENCHMARK_ENTRY_COUNT_ARR)/sizeof(g_BENCHMARK_ENTRY_COUNT_ARR[0])];
+    u32 entryCountCount = 0;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex)
+    {
+        u32 entryCount = (u32)strtoul(argv[argIndex], NULL, 10);
+
+        if (entryCount && (entryCountCount < sizeof(entryCountArr)/sizeof(entryCountArr[0])))
+        {
+            entryCountArr[entryCountCount++] = entryCount;
+        }
+    }
+
+    if (entryCountCount == 0)
+    {
+        memcpy(entryCountArr, g_BENCHMARK_ENTRY_COUNT_ARR, sizeof(g_BENCHMARK_ENTRY_COUNT_ARR));
+        entryCountCount = sizeof(g_BENCHMARK_ENTRY_COUNT_ARR)/sizeof(g_BENCHMARK_ENTRY_COUNT_ARR[0]);
+    }
+
+    for (u32 keySetIndex = 0; keySetIndex < sizeof(keySetArr)/sizeof(keySetArr[0]); ++keySetIndex)
+    {
+        struct benchmark_key_set *keySetPtr = &keySetArr[keySetIndex];
+        b32 isSelected = B32_TRUE;
+
+        for (int argIndex = 1; argIndex < argc; ++argIndex)
+        {
+            if (!strtoul(argv[argIndex], NULL, 10))
+            {
+                isSelected = (strcmp(argv[argIndex], keySetPtr->name) == 0);
+
+                if (isSelected)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (!isSelected)
+        {
+            continue;
+        }
+
+        for (u32 entryCountIndex = 0; entryCountIndex < entryCountCount; ++entryCountIndex)
+        {
+            // the misses use the keys past the entries
+            if (!benchmark_key_set_create(keySetPtr, entryCountArr[entryCountIndex]*2))
+            {
+                fprintf(stderr, "benchmark(%d): Failure to allocate the key set.\n", __LINE__);
+
+                return -1;
+            }
+
+            b32 isResult = benchmark_run_key_set(keySetPtr, &contextKey, entryCountArr[entryCountIndex]);
+
+            free(keySetPtr->stringIdArr);
+            free(keySetPtr->keyArr);
+
+            if (!isResult)
+            {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+#!/usr/bin/sh
+
+# Headless hash benchmarks (no SDL/GL). utils.c is built unity style, like the engine, once for the baseline
+# target (SSE2 on x86-64) and once with AVX2.
+#
+# "quality" hashes the engine's key sets (its own names, entity names, asset paths, physics force ids and
+# collision pairs) with the legacy, the new and the string id hash, and counts bucket, 32-bit and 64-bit collisions
+# against what a random function would give, and checks compile time string ids against their runtime hash.
+# "throughput" times the hashes at 4 bytes to 64KB ("./app.sh --run quality" runs one of them). Every result is
+# one line of key=value pairs; results.log keeps every run.
+
+if [ "$1" == "--build" ] 
+then
+    echo "Selected User Option: 'build'" | ts '[%Y-%m-%d %H:%M:%S]'
+    echo 
+    rm -rf ./build
+    mkdir ./build
+    pushd ./build
+
+    gcc -std=c11 -O2 -D_GNU_SOURCE -o hash_benchmark ../src/main.c -lm 2>&1 | \
+        ts '[%Y-%m-%d %H:%M:%S]' >& ./build.log
+    gcc -std=c11 -O2 -D_GNU_SOURCE -mavx2 -o hash_benchmark_avx2 ../src/main.c -lm 2>&1 | \
+        ts '[%Y-%m-%d %H:%M:%S]' >> ./build.log
+
+    cat build.log
+
+    popd
+else
+    echo "Selected User Option: 'run'" | ts '[%Y-%m-%d %H:%M:%S]'
+    [ $# -gt 0 ] && shift
+    ./build/hash_benchmark "$@" 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' | tee -a ./results.log
+    ./build/hash_benchmark_avx2 "$@" 2>&1 | ts '[%Y-%m-%d %H:%M:%S]' | tee -a ./results.log
+fi
@@ -0,0 +1,522 @@
+#include "../../../engine/types.h"
+#include "../../../engine/utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "../../../engine/utils.c"
+
+#if defined(UTILS_HASH_USE_AVX2)
+    #define BENCHMARK_HASH_PATH_NAME "avx2"
+#elif defined(UTILS_HASH_USE_SSE2)
+    #define BENCHMARK_HASH_PATH_NAME "sse2"
+#else
+    #define BENCHMARK_HASH_PATH_NAME "scalar"
+#endif
+
+// bumped whenever a key is renamed or its meaning changes, so tracked results stay comparable
+#define BENCHMARK_OUTPUT_FORMAT_VERSION 1
+
+// every throughput size hashes about this many bytes, in no fewer than BENCHMARK_MIN_OP_COUNT calls; the
+// legacy hash is byte at a time, so it gets fewer
+#define BENCHMARK_TARGET_BYTE_COUNT ((u64)1024*1024*256)
+#define BENCHMARK_LEGACY_TARGET_BYTE_COUNT ((u64)1024*1024*16)
+#define BENCHMARK_MIN_OP_COUNT 1000000
+#define BENCHMARK_MAX_NAME_LENGTH 48
+
+#define BENCHMARK_ENTITY_NAME_COUNT 1000000
+#define BENCHMARK_ASSET_PATH_COUNT 200000
+#define BENCHMARK_FORCE_ID_COUNT 1000000
+// every pair of this many bodies, about 1.1M collision keys
+#define BENCHMARK_COLLISION_BODY_COUNT 1500
+
+// physics.h's physics_id, without pulling in the physics headers
+typedef i32 benchmark_physics_id;
+
+static const u32 g_BENCHMARK_BYTE_SIZE_ARR[] = { 4, 8, 16, 32, 64, 256, 1024, 4096, 65536 };
+
+// the names the engine looks up in its string dicts: layers, input keys, shader uniforms, programs, meshes,
+// textures and config vars
+#define BENCHMARK_ENGINE_NAMES(X) \
+    X("default") X("ui") X("player") X("foreground") X("background") \
+    X("escape") X("space") X("a") X("s") X("d") X("w") X("f") \
+    X("u_Proj") X("u_ModelView") X("u_Color") X("u_Width") X("u_Height") X("u_WindowWidth") X("u_WindowHeight") \
+    X("u_TexWidth") X("u_TexHeight") X("u_IsTex") X("u_IsBorder") X("u_BorderColor") X("u_BorderThickness") \
+    X("u_IsGradient") X("u_GradientTopLeftColor") X("u_GradientTopRightColor") X("u_GradientBottomLeftColor") \
+    X("u_GradientBottomRightColor") X("u_FrameColor") X("u_FrameThickness") \
+    X("unlit") X("unlit_texture") X("unlit_frame") X("interface") X("transparent_box") X("test_unlit_texture") \
+    X("texture_quad") X("frame_triangle") X("interface_quad") X("test") X("test1") \
+    X("GAME_grid_width") X("GAME_grid_height") X("SYSTEM_screen_width") X("SYSTEM_screen_height") \
+    X("SYSTEM_target_fps") X("SYSTEM_initial_graphics_memory_mb") X("SYSTEM_initial_game_memory_mb") \
+    X("SYSTEM_initial_physics_memory_mb")
+
+#define BENCHMARK_ENGINE_NAME_STRING(name) name,
+#define BENCHMARK_ENGINE_NAME_ID_HASH(name) UTILS_STRING_ID_HASH(name),
+
+static const char *g_BENCHMARK_ENGINE_NAME_ARR[] =
+{
+    BENCHMARK_ENGINE_NAMES(BENCHMARK_ENGINE_NAME_STRING)
+};
+
+// hashed by the compiler; a static initializer only takes constants, so this also checks that they fold
+static const utils_hash g_BENCHMARK_ENGINE_NAME_ID_HASH_ARR[] =
+{
+    BENCHMARK_ENGINE_NAMES(BENCHMARK_ENGINE_NAME_ID_HASH)
+};
+
+enum benchmark_key_set_type
+{
+    BENCHMARK_KEY_SET_ENGINE_NAMES,
+    BENCHMARK_KEY_SET_ENTITY_NAMES,
+    BENCHMARK_KEY_SET_ASSET_PATHS,
+    BENCHMARK_KEY_SET_FORCE_IDS,
+    BENCHMARK_KEY_SET_COLLISION_PAIRS,
+    BENCHMARK_KEY_SET_TYPE_COUNT
+};
+
+static const char *g_BENCHMARK_KEY_SET_NAME_ARR[BENCHMARK_KEY_SET_TYPE_COUNT] =
+{
+    "engine_names", "entity_names", "asset_paths", "force_ids", "collision_pairs"
+};
+
+enum benchmark_hash_type
+{
+    BENCHMARK_HASH_FAST_BYTES,
+    BENCHMARK_HASH_FAST_STRING,
+    BENCHMARK_HASH_LEGACY_STRING,
+    // basic_dict's hash for string keys, the one UTILS_STRING_ID folds at compile time
+    BENCHMARK_HASH_STRING_ID,
+    BENCHMARK_HASH_TYPE_COUNT
+};
+
+static const char *g_BENCHMARK_HASH_NAME_ARR[BENCHMARK_HASH_TYPE_COUNT] =
+{
+    "fast", "fast_string", "legacy", "string_id"
+};
+
+static u64
+benchmark_get_time_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (u64)ts.tv_sec*1000000000ull + (u64)ts.tv_nsec;
+}
+
+/* the hashes the engine used before utils_generate_hash_from_bytes */
+
+// the polynomial rolling hash, modulo 1e9 + 9
+static utils_hash
+benchmark_legacy_string_hash(const char *str)
+{
+    const i32 p = 59;
+    const i32 m = 1e9 + 9;
+    u64 hash = 0;
+    u64 pPow = 1;
+
+    for (const char *c = str; *c != '\0'; ++c)
+    {
+        hash = (hash + (*c - 'a' + 1)*pPow)%m;
+        pPow = (pPow*p)%m;
+    }
+
+    return hash;
+}
+
+// the physics force dict's: an integer mix, scaled through a double
+static utils_hash
+benchmark_legacy_force_hash(benchmark_physics_id id)
+{
+    i32 key = id;
+    const i32 c2 = 0x27d4eb2d;
+
+    key = (key ^ 61) ^ (key >> 16);
+    key = key + (key << 3);
+    key = key ^ (key >> 4);
+    key = key*c2;
+    key = key ^ (key >> 15);
+
+    return (u64)(((real64)key/INT32_MAX)*(real64)(UINT64_MAX - 1)) + 1;
+}
+
+// the physics collision dict's: the ordered pair of ids, packed as they are
+static utils_hash
+benchmark_legacy_collision_hash(const benchmark_physics_id *pairArr)
+{
+    u64 hash;
+    memcpy(&hash, pairArr, sizeof(u64));
+
+    return hash;
+}
+
+/* key sets */
+
+// writes the hash of every key in the set, and returns the key count. The fast hash is the one basic_dict takes
+// for keys of that kind; the string id hash only applies to the name sets
+static u32
+benchmark_hash_key_set(enum benchmark_key_set_type keySetType, enum benchmark_hash_type hashType,
+    utils_hash *outHashArr)
+{
+    char name[BENCHMARK_MAX_NAME_LENGTH];
+    u32 keyCount = 0;
+
+    switch (keySetType)
+    {
+        case BENCHMARK_KEY_SET_ENGINE_NAMES:
+        case BENCHMARK_KEY_SET_ENTITY_NAMES:
+        case BENCHMARK_KEY_SET_ASSET_PATHS:
+        {
+            u32 nameCount = (keySetType == BENCHMARK_KEY_SET_ENGINE_NAMES) ?
+                sizeof(g_BENCHMARK_ENGINE_NAME_ARR)/sizeof(g_BENCHMARK_ENGINE_NAME_ARR[0]) :
+                (keySetType == BENCHMARK_KEY_SET_ENTITY_NAMES) ? BENCHMARK_ENTITY_NAME_COUNT :
+                BENCHMARK_ASSET_PATH_COUNT;
+
+            for (u32 nameIndex = 0; nameIndex < nameCount; ++nameIndex)
+            {
+                const char *namePtr = name;
+
+                if (keySetType == BENCHMARK_KEY_SET_ENGINE_NAMES)
+                {
+                    namePtr = g_BENCHMARK_ENGINE_NAME_ARR[nameIndex];
+                }
+                else if (keySetType == BENCHMARK_KEY_SET_ENTITY_NAMES)
+                {
+                    snprintf(name, sizeof(name), "entity_%u", nameIndex);
+                }
+                else
+                {
+                    snprintf(name, sizeof(name), "resources/textures/texture_%u.tex", nameIndex);
+                }
+
+                if (hashType == BENCHMARK_HASH_LEGACY_STRING)
+                {
+                    outHashArr[keyCount++] = benchmark_legacy_string_hash(namePtr);
+                }
+                else if (hashType == BENCHMARK_HASH_STRING_ID)
+                {
+                    outHashArr[keyCount++] = utils_get_string_id_hash(namePtr);
+                }
+                else
+                {
+                    utils_generate_hash_from_string(namePtr, &outHashArr[keyCount++]);
+                }
+            }
+        } break;
+
+        case BENCHMARK_KEY_SET_FORCE_IDS:
+        {
+            // ids are handed out by a counter
+            for (benchmark_physics_id id = 1; id <= BENCHMARK_FORCE_ID_COUNT; ++id)
+            {
+                if (hashType == BENCHMARK_HASH_LEGACY_STRING)
+                {
+                    outHashArr[keyCount++] = benchmark_legacy_force_hash(id);
+                }
+                else
+                {
+                    utils_generate_hash_from_bytes(&id, sizeof(id), &outHashArr[keyCount++]);
+                }
+            }
+        } break;
+
+        case BENCHMARK_KEY_SET_COLLISION_PAIRS:
+        {
+            for (benchmark_physics_id lhsId = 1; lhsId <= BENCHMARK_COLLISION_BODY_COUNT; ++lhsId)
+            {
+                for (benchmark_physics_id rhsId = 1; rhsId < lhsId; ++rhsId)
+                {
+                    benchmark_physics_id pairArr[2] = { lhsId, rhsId };
+
+                    if (hashType == BENCHMARK_HASH_LEGACY_STRING)
+                    {
+                        outHashArr[keyCount++] = benchmark_legacy_collision_hash(pairArr);
+                    }
+                    else
+                    {
+                        utils_generate_hash_from_bytes(pairArr, sizeof(pairArr), &outHashArr[keyCount++]);
+                    }
+                }
+            }
+        } break;
+
+        default:
+        {
+        } break;
+    }
+
+    return keyCount;
+}
+
+static u32
+benchmark_get_max_key_count()
+{
+    u32 maxKeyCount = (BENCHMARK_COLLISION_BODY_COUNT*(BENCHMARK_COLLISION_BODY_COUNT - 1))/2;
+
+    if (maxKeyCount < BENCHMARK_ENTITY_NAME_COUNT)
+    {
+        maxKeyCount = BENCHMARK_ENTITY_NAME_COUNT;
+    }
+
+    if (maxKeyCount < BENCHMARK_FORCE_ID_COUNT)
+    {
+        maxKeyCount = BENCHMARK_FORCE_ID_COUNT;
+    }
+
+    return maxKeyCount;
+}
+
+/* quality */
+
+static i32
+benchmark_compare_hash(const void *lhsPtr, const void *rhsPtr)
+{
+    utils_hash lhs = *(const utils_hash *)lhsPtr;
+    utils_hash rhs = *(const utils_hash *)rhsPtr;
+
+    return (lhs < rhs) ? -1 : (lhs > rhs) ? 1 : 0;
+}
+
+// keys whose hash equals the one of an earlier key; sorts the array
+static u64
+benchmark_count_collisions(utils_hash *hashArr, u32 hashCount)
+{
+    qsort(hashArr, hashCount, sizeof(utils_hash), benchmark_compare_hash);
+
+    u64 collisionCount = 0;
+
+    for (u32 hashIndex = 1; hashIndex < hashCount; ++hashIndex)
+    {
+        collisionCount += (hashArr[hashIndex] == hashArr[hashIndex - 1]);
+    }
+
+    return collisionCount;
+}
+
+// bucket collisions are keys landing in a taken bucket, with as many buckets as the next power of two above the
+// key count, indexed by the low bits the way a dict picks its group; the expected counts are a random
+// function's. The 32-bit collisions only look at the low half of the hash
+static b32
+benchmark_report_quality(enum benchmark_key_set_type keySetType, enum benchmark_hash_type hashType, utils_hash *hashArr,
+    utils_hash *scratchHashArr)
+{
+    u32 keyCount = benchmark_hash_key_set(keySetType, hashType, hashArr);
+    u64 bucketCount = 1;
+
+    while (bucketCount < keyCount)
+    {
+        bucketCount *= 2;
+    }
+
+    u8 *bucketArr = calloc(bucketCount, sizeof(u8));
+
+    if (!bucketArr)
+    {
+        return B32_FALSE;
+    }
+
+    u64 bucketCollisionCount = 0;
+
+    for (u32 keyIndex = 0; keyIndex < keyCount; ++keyIndex)
+    {
+        u8 *bucketPtr = &bucketArr[hashArr[keyIndex] & (bucketCount - 1)];
+
+        bucketCollisionCount += *bucketPtr;
+        *bucketPtr = 1;
+
+        scratchHashArr[keyIndex] = (u32)hashArr[keyIndex];
+    }
+
+    free(bucketArr);
+
+    real64 expectedBucketCollisionCount = (real64)keyCount -
+        (real64)bucketCount*(1.0 - pow(1.0 - 1.0/(real64)bucketCount, (real64)keyCount));
+    real64 expected32CollisionCount = ((real64)keyCount*((real64)keyCount - 1.0)/2.0)/4294967296.0;
+
+    printf("format=%d path=%s bench=quality hash=%s keys=%s count=%u buckets=%llu bucket_collisions=%llu "
+        "bucket_collisions_expected=%.1f collisions_32=%llu collisions_32_expected=%.1f collisions_64=%llu\n",
+        BENCHMARK_OUTPUT_FORMAT_VERSION, BENCHMARK_HASH_PATH_NAME, g_BENCHMARK_HASH_NAME_ARR[hashType],
+        g_BENCHMARK_KEY_SET_NAME_ARR[keySetType], keyCount, (unsigned long long)bucketCount,
+        (unsigned long long)bucketCollisionCount, expectedBucketCollisionCount,
+        (unsigned long long)benchmark_count_collisions(scratchHashArr, keyCount), expected32CollisionCount,
+        (unsigned long long)benchmark_count_collisions(hashArr, keyCount));
+
+    return B32_TRUE;
+}
+
+// the engine names hashed by UTILS_STRING_ID_HASH at compile time, against utils_get_string_id_hash at runtime;
+// every one of them has to match, or a dict lookup by string id misses
+static b32
+benchmark_report_string_id_fold()
+{
+    u32 nameCount = sizeof(g_BENCHMARK_ENGINE_NAME_ARR)/sizeof(g_BENCHMARK_ENGINE_NAME_ARR[0]);
+    u32 matchCount = 0;
+
+    for (u32 nameIndex = 0; nameIndex < nameCount; ++nameIndex)
+    {
+        matchCount += (g_BENCHMARK_ENGINE_NAME_ID_HASH_ARR[nameIndex] ==
+            utils_get_string_id_hash(g_BENCHMARK_ENGINE_NAME_ARR[nameIndex]));
+    }
+
+    printf("format=%d path=%s bench=string_id_fold keys=%s count=%u matches=%u\n", BENCHMARK_OUTPUT_FORMAT_VERSION,
+        BENCHMARK_HASH_PATH_NAME, g_BENCHMARK_KEY_SET_NAME_ARR[BENCHMARK_KEY_SET_ENGINE_NAMES], nameCount, matchCount);
+
+    return (matchCount == nameCount) ? B32_TRUE : B32_FALSE;
+}
+
+/* throughput */
+
+// 'bufferPtr' holds 'byteSize' letters and a NUL. The first byte changes every call, so the hash can't be
+// hoisted out of the loop
+static void
+benchmark_report_throughput(enum benchmark_hash_type hashType, char *bufferPtr, u32 byteSize)
+{
+    b32 isByteAtATime = ((hashType == BENCHMARK_HASH_LEGACY_STRING) || (hashType == BENCHMARK_HASH_STRING_ID)) ?
+        B32_TRUE : B32_FALSE;
+    u64 opCount = (isByteAtATime ? BENCHMARK_LEGACY_TARGET_BYTE_COUNT : BENCHMARK_TARGET_BYTE_COUNT)/byteSize;
+
+    if (!isByteAtATime && (opCount < BENCHMARK_MIN_OP_COUNT))
+    {
+        opCount = BENCHMARK_MIN_OP_COUNT;
+    }
+
+    utils_hash sinkHash = 0;
+    u64 startNS = benchmark_get_time_ns();
+
+    for (u64 opIndex = 0; opIndex < opCount; ++opIndex)
+    {
+        utils_hash hash;
+
+        bufferPtr[0] = 'a' + (char)(opIndex & 15);
+
+        switch (hashType)
+        {
+            case BENCHMARK_HASH_FAST_BYTES:
+            {
+                utils_generate_hash_from_bytes(bufferPtr, byteSize, &hash);
+            } break;
+
+            case BENCHMARK_HASH_FAST_STRING:
+            {
+                utils_generate_hash_from_string(bufferPtr, &hash);
+            } break;
+
+            case BENCHMARK_HASH_STRING_ID:
+            {
+                hash = utils_get_string_id_hash(bufferPtr);
+            } break;
+
+            default:
+            {
+                hash = benchmark_legacy_string_hash(bufferPtr);
+            } break;
+        }
+
+        sinkHash ^= hash;
+    }
+
+    u64 elapsedNS = benchmark_get_time_ns() - startNS;
+
+    printf("format=%d path=%s bench=throughput hash=%s bytes=%u ops=%llu total_ms=%.3f ns_per_hash=%.2f "
+        "gb_per_sec=%.3f sink=%llx\n", BENCHMARK_OUTPUT_FORMAT_VERSION, BENCHMARK_HASH_PATH_NAME,
+        g_BENCHMARK_HASH_NAME_ARR[hashType], byteSize, (unsigned long long)opCount, (real64)elapsedNS/1000000.0,
+        (real64)elapsedNS/(real64)opCount, (elapsedNS) ? ((real64)opCount*byteSize)/(real64)elapsedNS : 0.0,
+        (unsigned long long)(sinkHash & 0xFF));
+}
+
+// usage: hash_benchmark [quality] [throughput]; runs both when neither is named. output is one line of
+// key=value pairs per (hash, key set) for quality, and per (hash, key byte size) for throughput
+int
+main(int argc, char **argv)
+{
+    b32 isQuality = (argc < 2) ? B32_TRUE : B32_FALSE;
+    b32 isThroughput = (argc < 2) ? B32_TRUE : B32_FALSE;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex)
+    {
+        isQuality |= (strcmp(argv[argIndex], "quality") == 0);
+        isThroughput |= (strcmp(argv[argIndex], "throughput") == 0);
+    }
+
+    if (isQuality)
+    {
+        u32 maxKeyCount = benchmark_get_max_key_count();
+        utils_hash *hashArr = malloc(sizeof(utils_hash)*maxKeyCount);
+        utils_hash *scratchHashArr = malloc(sizeof(utils_hash)*maxKeyCount);
+
+        if (!hashArr || !scratchHashArr)
+        {
+            fprintf(stderr, "benchmark(%d): Failure to allocate the hash arrays.\n", __LINE__);
+
+            return -1;
+        }
+
+        for (u32 keySetIndex = 0; keySetIndex < BENCHMARK_KEY_SET_TYPE_COUNT; ++keySetIndex)
+        {
+            b32 isNameKeySet = (keySetIndex <= BENCHMARK_KEY_SET_ASSET_PATHS) ? B32_TRUE : B32_FALSE;
+
+            if (!benchmark_report_quality(keySetIndex, BENCHMARK_HASH_LEGACY_STRING, hashArr, scratchHashArr) ||
+                !benchmark_report_quality(keySetIndex, BENCHMARK_HASH_FAST_BYTES, hashArr, scratchHashArr) ||
+                (isNameKeySet && !benchmark_report_quality(keySetIndex, BENCHMARK_HASH_STRING_ID, hashArr,
+                scratchHashArr)))
+            {
+                fprintf(stderr, "benchmark(%d): Failure to allocate the buckets.\n", __LINE__);
+
+                return -1;
+            }
+        }
+
+        if (!benchmark_report_string_id_fold())
+        {
+            fprintf(stderr, "benchmark(%d): A compile time string id doesn't match its runtime hash.\n", __LINE__);
+
+            return -1;
+        }
+
+        free(scratchHashArr);
+        free(hashArr);
+    }
+
+    if (isThroughput)
+    {
+        u32 maxByteSize = g_BENCHMARK_BYTE_SIZE_ARR[sizeof(g_BENCHMARK_BYTE_SIZE_ARR)/
+            sizeof(g_BENCHMARK_BYTE_SIZE_ARR[0]) - 1];
+        char *bufferPtr = malloc(maxByteSize + 1);
+
+        if (!bufferPtr)
+        {
+            fprintf(stderr, "benchmark(%d): Failure to allocate the key buffer.\n", __LINE__);
+
+            return -1;
+        }
+
+        for (u32 byteIndex = 0; byteIndex < maxByteSize; ++byteIndex)
+        {
+            bufferPtr[byteIndex] = 'a' + (char)((byteIndex*7) % 26);
+        }
+
+        for (u32 byteSizeIndex = 0; byteSizeIndex < sizeof(g_BENCHMARK_BYTE_SIZE_ARR)/
+            sizeof(g_BENCHMARK_BYTE_SIZE_ARR[0]); ++byteSizeIndex)
+        {
+            u32 byteSize = g_BENCHMARK_BYTE_SIZE_ARR[byteSizeIndex];
+            char endByte = bufferPtr[byteSize];
+
+            bufferPtr[byteSize] = '\0';
+
+            for (u32 hashType = 0; hashType < BENCHMARK_HASH_TYPE_COUNT; ++hashType)
+            {
+                benchmark_report_throughput(hashType, bufferPtr, byteSize);
+            }
+
+            bufferPtr[byteSize] = endByte;
+        }
+
+        free(bufferPtr);
+    }
+
+    fflush(stdout);
+
+    return 0;
+}